@@ -0,0 +1,84 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_ADJACENCY_CODEC_H
+#define OPENSEARCH_KNN_ADJACENCY_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace knn_jni {
+    namespace adjacency_codec {
+
+        // How the neighbor lists of a graph are stored once it is built
+        enum class GraphEncoding {
+            FIXED,  // Library native layout: fixed width ids, padded to the maximum degree of each layer
+            DELTA   // Sorted, delta encoded lists in group varint form, padding dropped
+        };
+
+        // Parse "fixed" or "delta". Throws for anything else
+        GraphEncoding ParseGraphEncoding(const std::string& encoding);
+
+        // Decoding reads 4 bytes at a time, so this many bytes must be readable past the end of encoded data
+        const size_t DECODE_PADDING = 3;
+
+        // Append the encoding of a neighbor list to out. Negative ids are padding and are dropped, the rest are sorted
+        // and deduplicated, so the list decodes in ascending order.
+        //
+        // Layout: the number of ids as a varint, then groups of 4 deltas. Each group starts with a control byte
+        // holding the byte length minus one of each delta on 2 bits, followed by the deltas in little endian. This
+        // is the group varint layout, which decodes without per-byte branches and is amenable to shuffle based SIMD
+        // decoding.
+        void EncodeList(const int32_t* ids, size_t n, std::vector<uint8_t>& out);
+
+        // Decode the list starting at in into out, replacing its contents. Return a pointer past the list
+        const uint8_t* DecodeList(const uint8_t* in, std::vector<int32_t>& out);
+
+        // Return a pointer past the list starting at in, without decoding it
+        const uint8_t* SkipList(const uint8_t* in);
+
+        // Multi layer graph whose neighbor lists are stored with EncodeList. Nodes are numbered 0 to NumNodes() - 1
+        // in the order they were appended, and each node record holds its number of layers followed by one list per
+        // layer, base layer first so that the hot path decodes without skipping.
+        class CompressedGraph {
+        public:
+            CompressedGraph();
+
+            // Rebuild a graph from the output of Offsets() and Data(). Throws if they do not match
+            CompressedGraph(std::vector<uint64_t> offsets, std::vector<uint8_t> data);
+
+            // Append the next node. layers[l] holds its neighbors on layer l
+            void AppendNode(const std::vector<std::vector<int32_t>>& layers);
+
+            // Decode the neighbors of node on layer into out. A layer above the top layer of node decodes as empty
+            void Neighbors(int32_t node, int layer, std::vector<int32_t>& out) const;
+
+            int32_t NumNodes() const;
+
+            // Bytes held by the graph
+            size_t MemoryUsage() const;
+
+            // Offset of each node record in Data(), plus the end offset
+            const std::vector<uint64_t>& Offsets() const;
+
+            // Encoded node records, followed by DECODE_PADDING zero bytes
+            const std::vector<uint8_t>& Data() const;
+
+        private:
+            std::vector<uint64_t> offsets;
+            std::vector<uint8_t> data;
+        };
+    }
+}
+
+#endif //OPENSEARCH_KNN_ADJACENCY_CODEC_H
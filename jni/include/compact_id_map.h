@@ -0,0 +1,79 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_COMPACT_ID_MAP_H
+#define OPENSEARCH_KNN_COMPACT_ID_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace knn_jni {
+    namespace compact_id_map {
+
+        // Mapping from the position of a vector in an index to its Lucene doc id. Doc ids fit in 32 bits and are
+        // usually dense within a segment, so the mapping is either the identity, which takes no memory, or an array
+        // of 32 bit ids.
+        class CompactIdMap {
+        public:
+            // Identity over positions 0 to size - 1
+            explicit CompactIdMap(int64_t size = 0);
+
+            // Map position i to ids[i]. Becomes the identity when ids are 0 to n - 1. Throws if an id is negative or
+            // does not fit in 32 bits
+            explicit CompactIdMap(const std::vector<int64_t>& ids);
+
+            // Map position i to ids[i]. Becomes the identity when ids are 0 to n - 1. Throws if an id is negative
+            explicit CompactIdMap(std::vector<int32_t> ids);
+
+            bool IsIdentity() const;
+
+            int64_t Size() const;
+
+            // Return the id at position. Negative positions, which faiss uses for missing results, map to themselves
+            inline int64_t Map(int64_t position) const {
+                if (position < 0 || identity) {
+                    return position;
+                }
+                return ids[position];
+            }
+
+            // Replace each of the n positions in labels by its id
+            void MapLabels(int64_t* labels, size_t n) const;
+
+            // Id of every position as a 32 bit value. Empty for the identity
+            const std::vector<int32_t>& Ids() const;
+
+            // Id of every position as a 64 bit value, as faiss::IndexIDMap stores them
+            std::vector<int64_t> ToVector() const;
+
+            // Bytes held by the mapping
+            size_t MemoryUsage() const;
+
+        private:
+            bool identity;
+            int64_t size;
+            std::vector<int32_t> ids;
+
+            void CompactIfIdentity();
+        };
+
+        // Write ids to file: a flag for the identity, the number of ids and then, unless the mapping is the identity,
+        // the 32 bit ids. Throws if the write fails
+        void WriteCompactIdMap(const CompactIdMap& ids, FILE* file);
+
+        // Read ids written by WriteCompactIdMap from file. Throws if the file ends early
+        CompactIdMap ReadCompactIdMap(FILE* file);
+    }
+}
+
+#endif //OPENSEARCH_KNN_COMPACT_ID_MAP_H
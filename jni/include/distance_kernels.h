@@ -0,0 +1,53 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+
+#ifndef OPENSEARCH_KNN_DISTANCE_KERNELS_H
+#define OPENSEARCH_KNN_DISTANCE_KERNELS_H
+
+#include <cstddef>
+
+namespace knn_jni {
+    namespace distance_kernels {
+
+        enum class Metric {
+            L2,             // Squared euclidean distance
+            INNER_PRODUCT,  // Dot product
+            COSINE          // Cosine similarity. 0 when either vector is zero
+        };
+
+        // Value of a metric between x and y, both of the dimension the function was selected for. The size is passed
+        // on for the generic kernels; specialized ones ignore it
+        using DistanceFunction = float (*)(const float* x, const float* y, size_t dim);
+
+        struct Kernel {
+            // Null when no kernel applies, such as for vectors that are not stored as floats
+            DistanceFunction distance;
+            size_t dim;
+            // Whether the loops were compiled for dim, rather than taking it at run time
+            bool specialized;
+
+            float operator()(const float* x, const float* y) const {
+                return distance(x, y, dim);
+            }
+        };
+
+        // Kernel for metric between vectors of dim floats. The embedding sizes used in practice, 128, 384, 768, 1024
+        // and 1536, get kernels compiled for their size; others fall back on a generic loop. Both use AVX2 and FMA when
+        // the CPU has them
+        Kernel SelectKernel(Metric metric, size_t dim);
+
+        // Whether dim has kernels compiled for it
+        bool IsSpecializedDimension(size_t dim);
+    }
+}
+
+#endif //OPENSEARCH_KNN_DISTANCE_KERNELS_H
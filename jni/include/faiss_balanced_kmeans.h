@@ -0,0 +1,43 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+
+#ifndef OPENSEARCH_KNN_FAISS_BALANCED_KMEANS_H
+#define OPENSEARCH_KNN_FAISS_BALANCED_KMEANS_H
+
+#include "faiss/Clustering.h"
+#include "faiss/Index.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace knn_jni {
+    namespace faiss_wrapper {
+
+        // Train k centroids of dimension d on the n vectors of x and write them to centroids, k * d floats. Training
+        // starts with faiss k-means, configured by parameters, and then evens out the clusters over the given number of
+        // iterations. Nearness is measured with metric, which must be L2 or inner product, the metric of the IVF index
+        // the centroids are for. Each iteration places every vector in the nearest of its closest centroids that holds
+        // fewer than maxImbalance times the average number of vectors, and moves each centroid to the mean of its
+        // vectors. Vectors that have the most to lose from their second choice are placed first. The overflow of dense
+        // regions pulls neighboring centroids in, so that the lists of an IVF index, which assigns each vector to its
+        // nearest centroid, come out closer in size.
+        void TrainBalancedCentroids(faiss::Index::idx_t n, int d, const float* x, int k, faiss::MetricType metric,
+                                    const faiss::ClusteringParameters& parameters, float maxImbalance, int iterations,
+                                    float* centroids);
+
+        // Number of the n vectors of x that the IVF index behind index would add to each of its lists. Vectors go
+        // through the transforms of an IndexPreTransform first. Throws if index is not an IVF index
+        std::vector<int64_t> AssignedListSizes(const faiss::Index* index, faiss::Index::idx_t n, const float* x);
+    }
+}
+
+#endif //OPENSEARCH_KNN_FAISS_BALANCED_KMEANS_H
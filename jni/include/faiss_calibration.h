@@ -0,0 +1,69 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_FAISS_CALIBRATION_H
+#define OPENSEARCH_KNN_FAISS_CALIBRATION_H
+
+#include "vecs_io.h"
+
+#include "faiss/Index.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace knn_jni {
+    namespace faiss_wrapper {
+
+        // Recall and mean latency of a sample of queries searched with one value of the search parameter of an
+        // index: efSearch for HNSW, nprobe for IVF
+        struct CalibrationPoint {
+            int64_t value;
+            double recall;
+            double latencyMicros;
+        };
+
+        // Settings worth considering for an index, by increasing value, and the position among them of the one
+        // recommended for the target recall
+        struct Calibration {
+            std::vector<CalibrationPoint> frontier;
+            size_t recommended;
+        };
+
+        // Values of the search parameter of index that a calibration tries: efSearch doubling from k up to 1024 for
+        // HNSW, nprobe doubling from 1 up to nlist for IVF. Id maps and pre-transforms around them are looked through.
+        // Throws for any other index
+        std::vector<int64_t> SweepValues(const faiss::Index * index, int k);
+
+        // Points that no other point beats on both recall and latency, by increasing value. A point beats another
+        // when it is at least as accurate and as fast, and strictly better on one of them
+        std::vector<CalibrationPoint> ParetoFrontier(const std::vector<CalibrationPoint>& points);
+
+        // Position in frontier of its fastest point reaching targetRecall, or of its most accurate point when none
+        // does
+        size_t RecommendedPoint(const std::vector<CalibrationPoint>& frontier, double targetRecall);
+
+        // Ids of the k nearest neighbors of the numQueries queries among all vectors index holds, in the same id
+        // space as index->search. The HNSW graph or the IVF probing is bypassed so that every stored vector, or code
+        // for compressed indices, is compared. Padded with -1 when index holds fewer than k vectors
+        knn_jni::vecs_io::Matrix<int32_t> ExhaustiveNeighbors(const faiss::Index * index, const float * queries,
+                                                              int64_t numQueries, int k);
+
+        // Search the numQueries queries one at a time through index for every value of SweepValues and return the
+        // frontier of recall@k against groundTruth, the ids of the true k nearest neighbors of every query, by mean
+        // latency. Each value is passed to the searches rather than set on index, so index may serve queries, with its
+        // own settings, while it is calibrated
+        Calibration Calibrate(const faiss::Index * index, const float * queries, int64_t numQueries, int k,
+                              double targetRecall, const knn_jni::vecs_io::Matrix<int32_t>& groundTruth);
+    }
+}
+
+#endif //OPENSEARCH_KNN_FAISS_CALIBRATION_H
@@ -0,0 +1,68 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_FAISS_COMPACT_ID_MAP_INDEX_H
+#define OPENSEARCH_KNN_FAISS_COMPACT_ID_MAP_INDEX_H
+
+#include "compact_id_map.h"
+#include "distance_kernels.h"
+#include "faiss_early_termination.h"
+
+#include "faiss/Index.h"
+#include "faiss/MetaIndexes.h"
+
+namespace knn_jni {
+    namespace faiss_wrapper {
+
+        // Replacement for faiss::IndexIDMap on loaded indices: results of the wrapped index are translated through a
+        // CompactIdMap instead of an array of 64 bit ids. The index is read only. When the wrapped index is an IndexFlat or
+        // an IndexHNSW over one, and its dimension has a specialized kernel, searches compare vectors with that kernel
+        // rather than through faiss.
+        class CompactIdMapIndex : public faiss::Index {
+        public:
+            // Position i of index has id ids.Map(i). If ownFields is true, index is deleted with this one
+            CompactIdMapIndex(faiss::Index * index, knn_jni::compact_id_map::CompactIdMap ids, bool ownFields);
+
+            ~CompactIdMapIndex() override;
+
+            void add(idx_t n, const float* x) override;
+
+            void reset() override;
+
+            void search(idx_t n, const float* x, idx_t k, float* distances, idx_t* labels) const override;
+
+            faiss::Index * GetIndex() const;
+
+            const knn_jni::compact_id_map::CompactIdMap& GetIds() const;
+
+            // Kernel for the vectors of the wrapped index, selected on construction
+            const knn_jni::distance_kernels::Kernel& GetKernel() const;
+
+            // Early termination of later searches. Searches are exhaustive until it is set
+            void SetEarlyTermination(EarlyTermination earlyTermination);
+
+            EarlyTermination GetEarlyTermination() const;
+
+        private:
+            faiss::Index * index;
+            knn_jni::compact_id_map::CompactIdMap ids;
+            bool ownFields;
+            knn_jni::distance_kernels::Kernel kernel;
+            EarlyTermination earlyTermination;
+        };
+
+        // Take over the index wrapped by idMap and its ids, and delete idMap. Throws, leaving idMap untouched, if its
+        // ids do not fit in 32 bits
+        CompactIdMapIndex * CompactIds(faiss::IndexIDMap * idMap);
+    }
+}
+
+#endif //OPENSEARCH_KNN_FAISS_COMPACT_ID_MAP_INDEX_H
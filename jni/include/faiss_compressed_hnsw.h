@@ -0,0 +1,84 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_FAISS_COMPRESSED_HNSW_H
+#define OPENSEARCH_KNN_FAISS_COMPRESSED_HNSW_H
+
+#include "adjacency_codec.h"
+#include "compact_id_map.h"
+#include "distance_kernels.h"
+#include "faiss_compact_id_map_index.h"
+#include "faiss_early_termination.h"
+
+#include "faiss/Index.h"
+#include "faiss/IndexHNSW.h"
+
+#include <string>
+
+namespace knn_jni {
+    namespace faiss_wrapper {
+
+        // Faiss HNSW index whose graph is held in a CompressedGraph. Searches decode neighbor lists on the fly; the
+        // vectors stay in the storage of the wrapped IndexHNSW and are compared with the kernel selected for it on
+        // construction, or through its distance computer for storages that do not hold floats. Results are translated to ids through a CompactIdMap. The index is read only.
+        class CompressedHnswIndex : public faiss::Index {
+        public:
+            // Compress the graph of indexHnsw and free its fixed width links. Position i of indexHnsw has id ids.Map(i).
+            // If ownFields is true, indexHnsw is deleted with this index
+            CompressedHnswIndex(faiss::IndexHNSW * indexHnsw, knn_jni::compact_id_map::CompactIdMap ids,
+                                bool ownFields);
+
+            // Wrap an indexHnsw whose links were already compressed into graph
+            CompressedHnswIndex(faiss::IndexHNSW * indexHnsw, knn_jni::compact_id_map::CompactIdMap ids,
+                                knn_jni::adjacency_codec::CompressedGraph graph, bool ownFields);
+
+            ~CompressedHnswIndex() override;
+
+            void add(idx_t n, const float* x) override;
+
+            void reset() override;
+
+            void search(idx_t n, const float* x, idx_t k, float* distances, idx_t* labels) const override;
+
+            faiss::IndexHNSW * GetIndexHnsw() const;
+
+            const knn_jni::compact_id_map::CompactIdMap& GetIds() const;
+
+            const knn_jni::adjacency_codec::CompressedGraph& GetGraph() const;
+
+            const knn_jni::distance_kernels::Kernel& GetKernel() const;
+
+            // Early termination of later searches. Searches are exhaustive until it is set
+            void SetEarlyTermination(EarlyTermination earlyTermination);
+
+            EarlyTermination GetEarlyTermination() const;
+
+        private:
+            faiss::IndexHNSW * indexHnsw;
+            knn_jni::compact_id_map::CompactIdMap ids;
+            knn_jni::adjacency_codec::CompressedGraph graph;
+            bool ownFields;
+            knn_jni::distance_kernels::Kernel kernel;
+            EarlyTermination earlyTermination;
+        };
+
+        // Write index to path. The file starts with a marker that ReadIndex recognizes, followed by the faiss HNSW index
+        // without its links, the ids and then the compressed graph
+        void WriteCompressedHnswIndex(const CompressedHnswIndex& index, const std::string& path);
+
+        // Read an index written by WriteCompressedHnswIndex or faiss::write_index. Any index
+        // other than a CompressedHnswIndex is returned as a CompactIdMapIndex: the ids of a faiss::IndexIDMap are
+        // compacted, and an index without an id map gets the identity
+        faiss::Index * ReadIndex(const std::string& path, int ioFlags);
+    }
+}
+
+#endif //OPENSEARCH_KNN_FAISS_COMPRESSED_HNSW_H
@@ -0,0 +1,36 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_FAISS_DESCRIPTION_H
+#define OPENSEARCH_KNN_FAISS_DESCRIPTION_H
+
+#include "faiss/Index.h"
+
+#include <string>
+
+namespace knn_jni {
+    namespace faiss_wrapper {
+
+        // Describe the structure of a loaded index as a JSON object:
+        //
+        //   engine, count, dimension, metric
+        //   memory      bytes held by ids, vectors (or codes), graph, quantizer and transforms, and their total
+        //   hnsw        for HNSW indices: entry point, top layer, efSearch, graph encoding and the graph summary
+        //               written by knn_jni::index_description::JsonWriter::Graph
+        //   ivf         for IVF indices: nprobe and, under list_sizes, the summary written by JsonWriter::Lists
+        //
+        // Every node and link of the graph is visited to count unreachable nodes, so this is meant for debugging
+        // rather than for every request
+        std::string Describe(const faiss::Index * index);
+    }
+}
+
+#endif //OPENSEARCH_KNN_FAISS_DESCRIPTION_H
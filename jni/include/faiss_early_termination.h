@@ -0,0 +1,48 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_FAISS_EARLY_TERMINATION_H
+#define OPENSEARCH_KNN_FAISS_EARLY_TERMINATION_H
+
+#include "faiss/Index.h"
+
+#include <cstddef>
+#include <string>
+
+namespace knn_jni {
+    namespace faiss_wrapper {
+
+        // Whether searches of a loaded index may stop before efSearch or nprobe is exhausted. NONE searches exactly
+        // as configured; ADAPTIVE stops once more work is unlikely to change the results
+        enum class EarlyTermination {
+            NONE,
+            ADAPTIVE
+        };
+
+        // Early termination named by the "early_termination" load parameter, "none" or "adaptive". Throws on any
+        // other name
+        EarlyTermination ParseEarlyTermination(const std::string& name);
+
+        // Beam expansions without a change to the k nearest results after which an adaptive HNSW search of width ef
+        // stops. A quarter of the beam, and never fewer than k
+        size_t AdaptivePatience(size_t ef, size_t k);
+
+        // Search index, an IndexIVF, possibly behind an IndexPreTransform, probing at most nprobe lists, nearest
+        // first. With the L2 metric and a flat coarse quantizer, a list is skipped when the distance gap between its
+        // centroid and the nearest one puts all of its vectors beyond the current k-th result: a vector of the list
+        // is nearer to its centroid than to the nearest one, so it lies past the bisector of the two. Other indices
+        // are searched by faiss. Results are ordered and padded like those of faiss::Index::search
+        void SearchIvfAdaptive(const faiss::Index* index, faiss::Index::idx_t n, const float* x,
+                               faiss::Index::idx_t k, float* distances, faiss::Index::idx_t* labels);
+    }
+}
+
+#endif //OPENSEARCH_KNN_FAISS_EARLY_TERMINATION_H
@@ -0,0 +1,70 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_FAISS_FILTERED_SEARCH_H
+#define OPENSEARCH_KNN_FAISS_FILTERED_SEARCH_H
+
+#include "distance_kernels.h"
+#include "live_docs.h"
+
+#include "faiss/Index.h"
+#include "faiss/IndexFlat.h"
+#include "faiss/IndexHNSW.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace knn_jni {
+    namespace faiss_wrapper {
+
+        // Fill out with the neighbors of node on layer
+        using NeighborFetcher = std::function<void(int32_t node, int layer, std::vector<int32_t>& out)>;
+
+        // Return true if the node may be returned as a result
+        using NodeFilter = std::function<bool(int32_t node)>;
+
+        // Neighbors as stored by faiss::HNSW, without the -1 padding
+        NeighborFetcher FixedNeighbors(const faiss::HNSW& hnsw);
+
+        // Kernel for the vectors of index, by its metric and dimension, if it is an IndexFlat and so holds them as
+        // floats. Otherwise the kernel has no distance function. Indices select it once, when they are loaded
+        knn_jni::distance_kernels::Kernel SelectFlatKernel(const faiss::Index* index);
+
+        // Search the vectors of indexHnsw through the graph given by neighbors, with the parameters of indexHnsw.hnsw.
+        // Nodes rejected by filter are still traversed, so that deleted docs do not disconnect the graph, but never
+        // returned. An empty filter accepts every node. Distances are computed with kernel, the one SelectFlatKernel
+        // returns for the storage, or through the distance computer of the storage when it has no distance function.
+        // Labels are positions in indexHnsw, padded with -1 when fewer than k nodes are accepted. A nonzero patience
+        // ends the beam search once that many expansions in a row leave the k nearest accepted nodes unchanged, so that
+        // easy queries stop short of efSearch. A nonzero efSearch replaces the one of indexHnsw.hnsw for this search
+        void SearchHnsw(const faiss::IndexHNSW& indexHnsw, const NeighborFetcher& neighbors, const NodeFilter& filter,
+                        const knn_jni::distance_kernels::Kernel& kernel, faiss::Index::idx_t n, const float* x,
+                        faiss::Index::idx_t k, float* distances, faiss::Index::idx_t* labels, size_t patience = 0,
+                        size_t efSearch = 0);
+
+        // Compare every vector of indexFlat accepted by filter with the queries, using kernel, which must have a
+        // distance function. Results are ordered and padded like those of IndexFlat::search
+        void SearchFlat(const faiss::IndexFlat& indexFlat, const knn_jni::distance_kernels::Kernel& kernel,
+                        const NodeFilter& filter, faiss::Index::idx_t n, const float* x, faiss::Index::idx_t k,
+                        float* distances, faiss::Index::idx_t* labels);
+
+        // Search index for the k nearest live docs. HNSW indices, compressed or not, skip deleted docs while
+        // traversing the graph, and flat indices while scanning. Other indices fetch extra results to make up for the
+        // deleted docs, as many as OverFetchSize allows, and may return fewer than k docs from heavily deleted
+        // segments. Loaded indices with adaptive early termination keep it
+        void SearchLiveDocs(const faiss::Index* index, const knn_jni::live_docs::LiveDocs& liveDocs,
+                            faiss::Index::idx_t n, const float* x, faiss::Index::idx_t k, float* distances,
+                            faiss::Index::idx_t* labels);
+    }
+}
+
+#endif //OPENSEARCH_KNN_FAISS_FILTERED_SEARCH_H
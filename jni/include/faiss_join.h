@@ -0,0 +1,46 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_FAISS_JOIN_H
+#define OPENSEARCH_KNN_FAISS_JOIN_H
+
+#include "qos.h"
+
+#include "faiss/Index.h"
+
+#include <cstdint>
+#include <string>
+
+namespace knn_jni {
+    namespace faiss_wrapper {
+
+        // Join results are streamed to a file made of a uint32 k followed by one row per query: the int32 query id, the
+        // int32 ids of its k nearest neighbors and their k float distances. Rows with fewer than k neighbors are padded
+        // with id -1. Rows are written in query order. All values are in native byte order.
+
+        // Search index for the k nearest neighbors of each of the numQueries vectors in queries and write them to
+        // outputPath. The id of a query is its position in queries. If exact is true, the vectors stored by the index
+        // are scanned in blocks instead of searched through its graph or lists; that needs an index that keeps its
+        // vectors in a flat array. The work is spread over numThreads OpenMP threads, or the OpenMP default when it is
+        // 0. Joins scheduled with a lowered policy yield to in-flight queries between windows of results.
+        void KnnJoinIndex(const faiss::Index * index, const float * queries, int64_t numQueries, int k, bool exact,
+                          int numThreads, knn_jni::qos::SchedulingPolicy schedulingPolicy,
+                          const std::string& outputPath);
+
+        // Search index for the k nearest neighbors of each vector it holds, leaving the vector itself out, and write
+        // them to outputPath. The id of a query is the id of its vector. Needs an index that can reconstruct its
+        // vectors.
+        void SelfJoinIndex(const faiss::Index * index, int k, bool exact, int numThreads,
+                           knn_jni::qos::SchedulingPolicy schedulingPolicy, const std::string& outputPath);
+    }
+}
+
+#endif //OPENSEARCH_KNN_FAISS_JOIN_H
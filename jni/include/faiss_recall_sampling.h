@@ -0,0 +1,102 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_FAISS_RECALL_SAMPLING_H
+#define OPENSEARCH_KNN_FAISS_RECALL_SAMPLING_H
+
+#include "faiss/Index.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace knn_jni {
+    namespace faiss_wrapper {
+
+        // Samples whose recall is averaged by the stats of an index
+        const size_t RECALL_WINDOW_SIZE = 1000;
+
+        // Checks of an index that may wait for the background worker. Samples taken while that many are waiting are
+        // dropped, so a busy worker sheds checks rather than piling up exhaustive searches
+        const int MAX_PENDING_RECALL_CHECKS = 4;
+
+        // Recall measured on the sampled queries of an index
+        struct RecallStats {
+            int64_t windowSamples;  // Samples in the window, at most RECALL_WINDOW_SIZE
+            double recall;          // Mean recall@k of those samples; 0 when there are none
+            int64_t totalSamples;   // Samples checked since sampling was enabled
+            int64_t droppedSamples; // Samples dropped because too many checks were pending
+        };
+
+        // Shadow exact searches of a fraction of the queries of one loaded index. A sampled query is searched again
+        // on the native background worker, with the graph or list probing bypassed as ExhaustiveNeighbors does, and
+        // the share of its true k nearest neighbors that the query returned is recorded.
+        class RecallSampler : public std::enable_shared_from_this<RecallSampler> {
+        public:
+            RecallSampler(const faiss::Index * index, double rate);
+
+            RecallSampler(const RecallSampler&) = delete;
+            RecallSampler& operator=(const RecallSampler&) = delete;
+
+            void SetRate(double rate);
+
+            // Draw whether the next query is sampled. Cheap enough to call on every query
+            bool ShouldSample() const;
+
+            // Queue the check of a query that returned labels, its k result ids. query and labels are copied
+            void Sample(const float * query, int k, const faiss::Index::idx_t * labels);
+
+            RecallStats GetStats();
+
+            // Stop checking: checks still queued are skipped and the call returns once running ones are done. The
+            // index may be freed afterwards
+            void Close();
+
+            // Block until no check is queued or running. For tests
+            void WaitForChecks();
+
+            // Record the recall of a check. Exposed for tests
+            void Record(double recall);
+
+        private:
+            void Check(const std::vector<float>& query, int k, const std::vector<faiss::Index::idx_t>& labels);
+
+            const faiss::Index * index;
+            std::atomic<double> rate;
+            std::mutex mutex;
+            std::condition_variable idle;
+            bool closed;
+            int pendingChecks;
+            int runningChecks;
+            std::vector<double> window;
+            size_t next;
+            double windowSum;
+            int64_t totalSamples;
+            int64_t droppedSamples;
+        };
+
+        // Sample a fraction rate, in [0, 1], of the queries of the loaded index. A rate of 0 stops sampling and drops
+        // the stats of the index
+        void SetRecallSampling(const faiss::Index * index, double rate);
+
+        // Sampler of index, or null when its queries are not sampled
+        std::shared_ptr<RecallSampler> GetRecallSampler(const faiss::Index * index);
+
+        // Stop sampling the queries of index before it is freed
+        void RemoveRecallSampler(const faiss::Index * index);
+    }
+}
+
+#endif //OPENSEARCH_KNN_FAISS_RECALL_SAMPLING_H
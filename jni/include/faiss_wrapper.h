@@ -23,16 +23,40 @@ namespace knn_jni {
         void CreateIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ, jobjectArray vectorsJ,
                          jstring indexPathJ, jobject parametersJ);
 
+        // Same as CreateIndex, but the vectors of dimension dimJ are laid out back to back in vectorsJ, which is
+        // either a float[] or a direct ByteBuffer in native byte order, and are copied in one bulk copy.
+        void CreateIndexFromFlatVectors(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ,
+                                        jobject vectorsJ, jint dimJ, jstring indexPathJ, jobject parametersJ);
+
+        // Same as CreateIndexFromFlatVectors, but the vectors are 16 bit floats held in a short[] or a direct
+        // ByteBuffer, in the encoding named by encodingJ, "fp16" or "bf16". They are widened to float as they are
+        // copied; use the SQfp16 encoder to also keep them as 16 bit floats in the index.
+        void CreateIndexFromHalfVectors(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ,
+                                        jobject vectorsJ, jint dimJ, jstring encodingJ, jstring indexPathJ,
+                                        jobject parametersJ);
+
+        // Same as CreateIndexFromFlatVectors for int8 vectors held in a byte[] or a direct ByteBuffer. When the index
+        // stores its vectors with an 8 bit scalar quantizer, such as "SQ8" or "HNSW32,SQ8", the quantizer is set to
+        // the int8 range instead of being trained, and keeps each value exactly in one byte.
+        void CreateIndexFromByteVectors(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ,
+                                        jobject vectorsJ, jint dimJ, jstring indexPathJ, jobject parametersJ);
+
         // Create an index with ids and vectors. Instead of creating a new index, this function creates the index
         // based off of the template index passed in. The index is serialized to indexPathJ.
         void CreateIndexFromTemplate(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ,
                                      jobjectArray vectorsJ, jstring indexPathJ, jbyteArray templateIndexJ,
                                      jobject parametersJ);
 
-        // Load an index from indexPathJ into memory.
+        // Same as CreateIndexFromTemplate, but the vectors are flat, as in CreateIndexFromFlatVectors.
+        void CreateIndexFromTemplateWithFlatVectors(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ,
+                                                    jobject vectorsJ, jint dimJ, jstring indexPathJ,
+                                                    jbyteArray templateIndexJ, jobject parametersJ);
+
+        // Load an index from indexPathJ into memory. Load time settings come from the Java map, parametersJ, which
+        // may be null; its "early_termination" entry lets searches stop short of efSearch or nprobe.
         //
         // Return a pointer to the loaded index
-        jlong LoadIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jstring indexPathJ);
+        jlong LoadIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jstring indexPathJ, jobject parametersJ);
 
         // Execute a query against the index located in memory at indexPointerJ.
         //
@@ -40,9 +64,67 @@ namespace knn_jni {
         jobjectArray QueryIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
                                 jfloatArray queryVectorJ, jint kJ);
 
+        // Same as QueryIndex for a query vector of 16 bit floats in the encoding named by encodingJ
+        //
+        // Return an array of KNNQueryResults
+        jobjectArray QueryIndexWithHalfVector(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                              jshortArray queryVectorJ, jstring encodingJ, jint kJ);
+
+        // Same as QueryIndex for an int8 query vector
+        //
+        // Return an array of KNNQueryResults
+        jobjectArray QueryIndexWithByteVector(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                              jbyteArray queryVectorJ, jint kJ);
+
+        // Execute a query against the index located in memory at indexPointerJ, skipping deleted docs. liveDocsJ
+        // holds the words of the segment's live docs bitset; if it is null, every doc is live.
+        //
+        // Return an array of KNNQueryResults
+        jobjectArray QueryIndexWithLiveDocs(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                            jfloatArray queryVectorJ, jint kJ, jlongArray liveDocsJ);
+
+        // Find the kJ nearest neighbors of every vector held by the index located in memory at indexPointerJ and write
+        // them to outputPathJ, in the format described in faiss_join.h. If exactJ is true, the vectors are scanned
+        // instead of searched through the index structure. Threads and scheduling come from the Java map, parametersJ.
+        void SelfJoin(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ, jint kJ, jboolean exactJ,
+                      jstring outputPathJ, jobject parametersJ);
+
+        // Find the kJ nearest neighbors in the index located in memory at indexPointerJ of every vector located at
+        // queryVectorsPointerJ and write them to outputPathJ, in the format described in faiss_join.h. Otherwise the
+        // same as SelfJoin.
+        void KnnJoin(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ, jlong queryVectorsPointerJ,
+                     jint kJ, jboolean exactJ, jstring outputPathJ, jobject parametersJ);
+
         // Free the index located in memory at indexPointerJ
         void Free(jlong indexPointer);
 
+        // Check a fraction rateJ, in [0, 1], of the later queries of the index located in memory at indexPointerJ
+        // against an exhaustive search run in the background, as described in faiss_recall_sampling.h. A rate of 0
+        // stops sampling.
+        void SetRecallSampling(jlong indexPointerJ, jfloat rateJ);
+
+        // Return the recall measured on the sampled queries of the index located in memory at indexPointerJ, as a
+        // Java float[] of the samples in the rolling window, their mean recall, the samples checked since sampling was
+        // enabled and the samples dropped because too many checks were pending. All zero when queries are not sampled
+        jfloatArray GetRecallStats(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ);
+
+        // Return the structure of the index located in memory at indexPointerJ, as a Java byte[] holding the UTF-8
+        // JSON document described in faiss_description.h
+        jbyteArray DescribeIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ);
+
+        // Start capturing a fraction rateJ, in [0, 1], of the queries into the ring log at pathJ of capacityJ bytes, as
+        // described in query_capture.h. The capture lives in the common library, so it covers the queries of nmslib
+        // indices as well.
+        void StartQueryCapture(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jstring pathJ, jlong capacityJ,
+                               jfloat rateJ);
+
+        // Stop capturing queries
+        void StopQueryCapture();
+
+        // Resize the native CPU budget that builds and trainings borrow their threads from, see thread_pool.h. The
+        // budget lives in the common library, so it bounds nmslib builds as well. 0 means one thread per hardware thread
+        void SetThreadPoolSize(jint numThreadsJ);
+
         // Perform initilization operations for the library
         void InitLibrary();
 
@@ -52,6 +134,28 @@ namespace knn_jni {
         // Return the serialized representation
         jbyteArray TrainIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jobject parametersJ, jint dimension,
                               jlong trainVectorsPointerJ);
+
+        // Deserialize the trained template index templateIndexJ and return the number of vectors located at
+        // trainVectorsPointerJ that each of its inverted lists would receive, as a Java int[]. Throws if the template
+        // is not an IVF index
+        jintArray ListSizes(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jbyteArray templateIndexJ,
+                            jlong trainVectorsPointerJ);
+
+        // Sweep the search parameter of the index located in memory at indexPointerJ, efSearch for HNSW or nprobe
+        // for IVF, over the query vectors located at queryVectorsPointerJ, as described in faiss_calibration.h. The
+        // ground truth is the exact kJ nearest neighbors among the vectors the index stores. The index must not be
+        // searched while it is calibrated.
+        //
+        // Return a Java float[] of (value, recall, mean latency in microseconds) triples: first the setting
+        // recommended for targetRecallJ, then the recall/latency frontier by increasing value
+        jfloatArray Calibrate(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                              jlong queryVectorsPointerJ, jint kJ, jfloat targetRecallJ);
+
+        // Same as Calibrate for an index built from the trained template index templateIndexJ and the vectors
+        // located at trainVectorsPointerJ, whose exact kJ nearest neighbors are the ground truth
+        jfloatArray CalibrateTemplate(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jbyteArray templateIndexJ,
+                                      jlong trainVectorsPointerJ, jlong queryVectorsPointerJ, jint kJ,
+                                      jfloat targetRecallJ);
     }
 }
 
@@ -0,0 +1,57 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_GRAPH_REORDER_H
+#define OPENSEARCH_KNN_GRAPH_REORDER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace knn_jni {
+    namespace graph_reorder {
+
+        // Node renumbering that puts neighbors close to each other in memory, so that a search touches fewer cache
+        // lines and pages. BFS and RCM renumber a graph after it is built (faiss). LOCALITY orders the vectors before
+        // they are inserted, for libraries whose graph cannot be rewritten after the build (nmslib).
+        enum class ReorderStrategy {
+            NONE,
+            BFS,      // Breadth first traversal from the entry point
+            RCM,      // Reverse Cuthill-McKee: breadth first, visiting low degree neighbors first, then reversed
+            LOCALITY  // Insertion in ComputeLocalityOrder order
+        };
+
+        // Parse "none", "bfs", "rcm" or "locality". Throws for anything else
+        ReorderStrategy ParseReorderStrategy(const std::string& strategy);
+
+        // Compute a new order for the nodes of a graph given in compressed sparse row form: the neighbors of node i
+        // are adjacency[offsets[i]] to adjacency[offsets[i + 1] - 1]. Negative entries are treated as padding.
+        // Traversal starts at start; nodes it cannot reach are appended one component at a time. Throws for LOCALITY,
+        // which does not work on a graph.
+        //
+        // Return order, where order[newId] = oldId
+        std::vector<int32_t> ComputeOrder(ReorderStrategy strategy, const std::vector<int64_t>& offsets,
+                                          const std::vector<int32_t>& adjacency, int32_t start);
+
+        // Order vectors so that similar ones are adjacent, without needing a graph. Vectors are bucketed by the signs
+        // of their projections on random hyperplanes and buckets are laid out in Gray code order, so neighboring
+        // buckets differ in one hyperplane only. Used for libraries whose graph layout follows insertion order but
+        // cannot be rewritten after the build.
+        //
+        // Return order, where order[newPosition] = oldPosition
+        std::vector<int32_t> ComputeLocalityOrder(const std::vector<const float*>& vectors, int dim);
+
+        // Return the inverse of a permutation: inverse[order[i]] = i
+        std::vector<int32_t> InvertOrder(const std::vector<int32_t>& order);
+    }
+}
+
+#endif //OPENSEARCH_KNN_GRAPH_REORDER_H
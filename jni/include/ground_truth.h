@@ -0,0 +1,47 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_GROUND_TRUTH_H
+#define OPENSEARCH_KNN_GROUND_TRUTH_H
+
+#include "vecs_io.h"
+
+#include <cstdint>
+#include <string>
+
+namespace knn_jni {
+    namespace ground_truth {
+
+        // Find the exact k nearest neighbors among base of every query, for the space types l2, innerproduct and
+        // cosinesimil. Base is scanned with the blocked BLAS kernels of faiss on numThreads threads. Distances follow
+        // the conventions of the ann-benchmarks datasets the perf-tool reads: the euclidean distance for l2, one minus
+        // the cosine for cosinesimil and the inner product itself for innerproduct. Neighbor ids are row numbers in
+        // base, padded with -1 when base has fewer than k rows.
+        void ComputeGroundTruth(const knn_jni::vecs_io::Matrix<float>& base,
+                                const knn_jni::vecs_io::Matrix<float>& queries, int k, const std::string& spaceType,
+                                int numThreads, knn_jni::vecs_io::Matrix<int32_t>& neighbors,
+                                knn_jni::vecs_io::Matrix<float>& distances);
+
+        // Same as above, for numBase base vectors and numQueries queries of dimension dim that are laid out row after
+        // row in memory owned by the caller. Nothing is copied unless the space type is cosinesimil.
+        void ComputeGroundTruth(const float* base, int64_t numBase, const float* queries, int64_t numQueries, int dim,
+                                int k, const std::string& spaceType, int numThreads,
+                                knn_jni::vecs_io::Matrix<int32_t>& neighbors,
+                                knn_jni::vecs_io::Matrix<float>& distances);
+
+        // Fraction of the first r results of each query that are among its first k true neighbors, as recall_at_r of
+        // the perf-tool computes it
+        double RecallAtR(const knn_jni::vecs_io::Matrix<int32_t>& results,
+                         const knn_jni::vecs_io::Matrix<int32_t>& groundTruth, int r, int k);
+    }
+}
+
+#endif //OPENSEARCH_KNN_GROUND_TRUTH_H
@@ -0,0 +1,49 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+
+#ifndef OPENSEARCH_KNN_HALF_PRECISION_H
+#define OPENSEARCH_KNN_HALF_PRECISION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace knn_jni {
+    namespace half_precision {
+
+        // 16 bit float formats vectors can be handed over in. Both are widened to float before they reach the
+        // libraries
+        enum class Encoding {
+            FP16,  // IEEE 754 binary16: 5 exponent bits, 10 mantissa bits
+            BF16   // bfloat16: the upper half of a float, 8 exponent bits, 7 mantissa bits
+        };
+
+        // Parse "fp16" or "bf16". Throws for anything else
+        Encoding ParseEncoding(const std::string& encoding);
+
+        // Widen n 16 bit values to floats. FP16 uses the F16C conversion instructions when the CPU has them
+        void Decode(Encoding encoding, const uint16_t* src, size_t n, float* dst);
+
+        // Narrow n floats to 16 bit values, rounding to nearest even
+        void Encode(Encoding encoding, const float* src, size_t n, uint16_t* dst);
+
+        float Fp16ToFloat(uint16_t value);
+
+        uint16_t FloatToFp16(float value);
+
+        float Bf16ToFloat(uint16_t value);
+
+        uint16_t FloatToBf16(float value);
+    }
+}
+
+#endif //OPENSEARCH_KNN_HALF_PRECISION_H
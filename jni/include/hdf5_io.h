@@ -0,0 +1,42 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_HDF5_IO_H
+#define OPENSEARCH_KNN_HDF5_IO_H
+
+#include "vecs_io.h"
+
+#include <cstdint>
+#include <string>
+
+namespace knn_jni {
+    namespace hdf5_io {
+
+        // Readers and writers for the two dimensional datasets of the ann-benchmarks HDF5 files the perf-tool uses:
+        // "train" and "test" hold float vectors, "neighbors" int32 ids and "distances" floats. Values are converted
+        // to the requested type on read. Throw if the file or dataset cannot be read.
+        knn_jni::vecs_io::Matrix<float> ReadFloatDataset(const std::string& path, const std::string& name);
+
+        knn_jni::vecs_io::Matrix<int32_t> ReadIntDataset(const std::string& path, const std::string& name);
+
+        // Create the file at path, replacing any existing one
+        void CreateFile(const std::string& path);
+
+        // Add a dataset to an existing file
+        void WriteDataset(const std::string& path, const std::string& name,
+                          const knn_jni::vecs_io::Matrix<float>& matrix);
+
+        void WriteDataset(const std::string& path, const std::string& name,
+                          const knn_jni::vecs_io::Matrix<int32_t>& matrix);
+    }
+}
+
+#endif //OPENSEARCH_KNN_HDF5_IO_H
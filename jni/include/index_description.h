@@ -0,0 +1,96 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_INDEX_DESCRIPTION_H
+#define OPENSEARCH_KNN_INDEX_DESCRIPTION_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace knn_jni {
+    namespace index_description {
+
+        // Fill out with the neighbors of node on layer
+        using NeighborFetcher = std::function<void(int32_t node, int layer, std::vector<int32_t>& out)>;
+
+        // Structure of a layered graph such as HNSW
+        struct GraphSummary {
+            std::vector<int64_t> levelCounts;      // levelCounts[l] nodes have l as their top layer
+            std::vector<int64_t> degreeHistogram;  // degreeHistogram[d] nodes have d neighbors on the base layer
+            double meanDegree;                     // Mean number of neighbors on the base layer
+            int64_t unreachable;                   // Nodes no search can reach from the entry point
+        };
+
+        // Summarize the graph of numNodes nodes whose top layers are topLayers and whose links neighbors returns.
+        // A node is reachable when a path of links on any layers leads to it from entryPoint; a negative entry point
+        // leaves every node unreachable
+        GraphSummary SummarizeGraph(int32_t numNodes, const std::vector<int>& topLayers, int32_t entryPoint,
+                                    const NeighborFetcher& neighbors);
+
+        // Sizes of the inverted lists of an IVF index
+        struct ListSummary {
+            int64_t numLists;
+            int64_t total;
+            int64_t min;
+            int64_t max;
+            double mean;
+            int64_t p50;
+            int64_t p90;
+            int64_t p99;
+            int64_t empty;
+            // faiss's imbalance factor, numLists * sum(size^2) / total^2: 1 when lists are even, numLists when one
+            // list holds everything. Searches scan that many times the codes an even split would make them scan
+            double imbalance;
+        };
+
+        ListSummary SummarizeLists(std::vector<int64_t> sizes);
+
+        // Writes the compact JSON document describeIndex returns. Keys and values are appended in order; the writer
+        // places the commas. Names are written as they are, so they must not need escaping
+        class JsonWriter {
+        public:
+            JsonWriter();
+
+            void BeginObject(const std::string& name);
+
+            void EndObject();
+
+            void Number(const std::string& name, int64_t value);
+
+            void Number(const std::string& name, double value);
+
+            void String(const std::string& name, const std::string& value);
+
+            void Boolean(const std::string& name, bool value);
+
+            void Numbers(const std::string& name, const std::vector<int64_t>& values);
+
+            // Members for the fields of graph, into the current object
+            void Graph(const GraphSummary& graph);
+
+            // Members for the fields of lists, into the current object
+            void Lists(const ListSummary& lists);
+
+            // The document, closing the top level object
+            std::string Finish();
+
+        private:
+            void Key(const std::string& name);
+
+            std::string out;
+            std::vector<bool> firstMember;
+        };
+    }
+}
+
+#endif //OPENSEARCH_KNN_INDEX_DESCRIPTION_H
@@ -0,0 +1,67 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+
+#ifndef OPENSEARCH_KNN_INDEX_SPEC_H
+#define OPENSEARCH_KNN_INDEX_SPEC_H
+
+#include "json_value.h"
+#include "replay_jni_util.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace knn_jni {
+    namespace index_spec {
+
+        // The k-NN method of one knn_vector field, resolved the way the plugin resolves it from an index mapping or a
+        // model. Parameters the plugin defaults are filled in
+        struct IndexSpec {
+            std::string engine;
+            std::string method;
+            std::string spaceType;
+            std::map<std::string, int> intParameters;
+            std::map<std::string, std::string> stringParameters;
+
+            // Faiss encoder, "flat" unless the method names one
+            std::string encoder;
+            std::map<std::string, int> encoderParameters;
+
+            // The knn.algo_param.ef_search index setting, which only nmslib reads
+            int efSearch;
+
+            // The knn.early_termination index setting, which only faiss reads
+            std::string earlyTermination;
+        };
+
+        // Resolve field of indexSpec, a perf-tool index-spec.json document. If field is empty, the first knn_vector
+        // field is used. A field that refers to a model takes its method from methodSpec, a method-spec.json document,
+        // which must then not be null. Throw if the spec has no such field.
+        IndexSpec ParseIndexSpec(const knn_jni::json::Value& indexSpec, const knn_jni::json::Value* methodSpec,
+                                 const std::string& field);
+
+        // Whether the index has to be trained before vectors are added, in which case the plugin builds it from a
+        // trained template
+        bool RequiresTraining(const IndexSpec& spec);
+
+        // Faiss index factory description of the method, built like KNNLibrary.Faiss does
+        std::string FaissIndexDescription(const IndexSpec& spec);
+
+        // Parameters map the plugin passes to CreateIndex and TrainIndex
+        std::unique_ptr<knn_jni::replay::Map> BuildParameters(const IndexSpec& spec, int threadCount);
+
+        // Parameters map the plugin passes to LoadIndex
+        std::unique_ptr<knn_jni::replay::Map> LoadParameters(const IndexSpec& spec);
+    }
+}
+
+#endif //OPENSEARCH_KNN_INDEX_SPEC_H
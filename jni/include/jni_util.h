@@ -12,6 +12,11 @@
 #ifndef OPENSEARCH_KNN_JNI_UTIL_H
 #define OPENSEARCH_KNN_JNI_UTIL_H
 
+#include "adjacency_codec.h"
+#include "graph_reorder.h"
+#include "half_precision.h"
+#include "qos.h"
+
 #include <jni.h>
 #include <stdexcept>
 #include <string>
@@ -70,6 +75,19 @@ namespace knn_jni {
 
         virtual std::vector<int64_t> ConvertJavaIntArrayToCppIntVector(JNIEnv *env, jintArray arrayJ) = 0;
 
+        // Copy vectors laid out back to back in either a float[] or a direct ByteBuffer in native byte order with one
+        // bulk copy. Throws if the number of floats is not a multiple of dim
+        virtual std::vector<float> ConvertFlatJavaVectorsToCppFloatVector(JNIEnv *env, jobject vectorsJ, int dim) = 0;
+
+        // Same as ConvertFlatJavaVectorsToCppFloatVector for 16 bit floats held in a short[] or a direct ByteBuffer,
+        // widened to float as they are copied
+        virtual std::vector<float> ConvertHalfJavaVectorsToCppFloatVector(JNIEnv *env, jobject vectorsJ, int dim,
+                                                                          knn_jni::half_precision::Encoding encoding) = 0;
+
+        // Same as ConvertFlatJavaVectorsToCppFloatVector for int8 vectors held in a byte[] or a direct ByteBuffer,
+        // widened to float as they are copied
+        virtual std::vector<float> ConvertByteJavaVectorsToCppFloatVector(JNIEnv *env, jobject vectorsJ, int dim) = 0;
+
         // --------------------------------------------------------------------------
 
         // ------------------------------ MISC HELPERS ------------------------------
@@ -83,6 +101,8 @@ namespace knn_jni {
 
         virtual int GetJavaFloatArrayLength(JNIEnv *env, jfloatArray arrayJ) = 0;
 
+        virtual int GetJavaLongArrayLength(JNIEnv *env, jlongArray arrayJ) = 0;
+
         // ---------------------------- Direct calls to JNIEnv ----------------------------
 
         virtual void DeleteLocalRef(JNIEnv *env, jobject obj) = 0;
@@ -93,6 +113,8 @@ namespace knn_jni {
 
         virtual jint * GetIntArrayElements(JNIEnv *env, jintArray array, jboolean * isCopy) = 0;
 
+        virtual jlong * GetLongArrayElements(JNIEnv *env, jlongArray array, jboolean * isCopy) = 0;
+
         virtual jobject GetObjectArrayElement(JNIEnv *env, jobjectArray array, jsize index) = 0;
 
         virtual jobject NewObject(JNIEnv *env, jclass clazz, jmethodID methodId, int id, float distance) = 0;
@@ -101,21 +123,56 @@ namespace knn_jni {
 
         virtual jbyteArray NewByteArray(JNIEnv *env, jsize len) = 0;
 
+        virtual jintArray NewIntArray(JNIEnv *env, jsize len) = 0;
+
+        virtual jfloatArray NewFloatArray(JNIEnv *env, jsize len) = 0;
+
         virtual void ReleaseByteArrayElements(JNIEnv *env, jbyteArray array, jbyte *elems, int mode) = 0;
 
         virtual void ReleaseFloatArrayElements(JNIEnv *env, jfloatArray array, jfloat *elems, int mode) = 0;
 
         virtual void ReleaseIntArrayElements(JNIEnv *env, jintArray array, jint *elems, jint mode) = 0;
 
+        virtual void ReleaseLongArrayElements(JNIEnv *env, jlongArray array, jlong *elems, jint mode) = 0;
+
         virtual void SetObjectArrayElement(JNIEnv *env, jobjectArray array, jsize index, jobject val) = 0;
 
         virtual void SetByteArrayRegion(JNIEnv *env, jbyteArray array, jsize start, jsize len, const jbyte * buf) = 0;
 
+        virtual void SetIntArrayRegion(JNIEnv *env, jintArray array, jsize start, jsize len, const jint * buf) = 0;
+
+        virtual void SetFloatArrayRegion(JNIEnv *env, jfloatArray array, jsize start, jsize len,
+                                         const jfloat * buf) = 0;
+
         // --------------------------------------------------------------------------
     };
 
     jobject GetJObjectFromMapOrThrow(std::unordered_map<std::string, jobject> map, std::string key);
 
+    // Return the number of threads requested for this operation through indexThreadQty, or 0 if none was requested
+    int GetRequestedThreadCount(JNIUtilInterface * jniUtil, JNIEnv * env,
+                                std::unordered_map<std::string, jobject>& parametersCpp);
+
+    // Return the scheduling policy for build and training work passed in parametersCpp, or NORMAL if none was passed
+    knn_jni::qos::SchedulingPolicy GetBuildSchedulingPolicy(JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                           std::unordered_map<std::string, jobject>& parametersCpp);
+
+    // Return the graph reorder strategy passed in parametersCpp, or NONE if none was passed
+    knn_jni::graph_reorder::ReorderStrategy GetGraphReorderStrategy(JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                                   std::unordered_map<std::string, jobject>& parametersCpp);
+
+    // Return the graph encoding passed in parametersCpp, or FIXED if none was passed
+    knn_jni::adjacency_codec::GraphEncoding GetGraphEncoding(JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                             std::unordered_map<std::string, jobject>& parametersCpp);
+
+    // Return whether parametersCpp asks for balanced clustering of IVF lists. Plain k-means is the default
+    bool IsBalancedClustering(JNIUtilInterface * jniUtil, JNIEnv * env,
+                              std::unordered_map<std::string, jobject>& parametersCpp);
+
+    // Parse the 16 bit float encoding named by encodingJ. Throws if it is null or unknown
+    knn_jni::half_precision::Encoding GetHalfPrecisionEncoding(JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                               jstring encodingJ);
+
     // Class that implements JNIUtilInterface methods
     class JNIUtil: public JNIUtilInterface {
     public:
@@ -135,25 +192,38 @@ namespace knn_jni {
         int ConvertJavaObjectToCppInteger(JNIEnv *env, jobject objectJ);
         std::vector<float> Convert2dJavaObjectArrayToCppFloatVector(JNIEnv *env, jobjectArray array2dJ, int dim);
         std::vector<int64_t> ConvertJavaIntArrayToCppIntVector(JNIEnv *env, jintArray arrayJ);
+        std::vector<float> ConvertFlatJavaVectorsToCppFloatVector(JNIEnv *env, jobject vectorsJ, int dim);
+        std::vector<float> ConvertHalfJavaVectorsToCppFloatVector(JNIEnv *env, jobject vectorsJ, int dim,
+                                                                  knn_jni::half_precision::Encoding encoding);
+        std::vector<float> ConvertByteJavaVectorsToCppFloatVector(JNIEnv *env, jobject vectorsJ, int dim);
         int GetInnerDimensionOf2dJavaFloatArray(JNIEnv *env, jobjectArray array2dJ);
         int GetJavaObjectArrayLength(JNIEnv *env, jobjectArray arrayJ);
         int GetJavaIntArrayLength(JNIEnv *env, jintArray arrayJ);
         int GetJavaBytesArrayLength(JNIEnv *env, jbyteArray arrayJ);
         int GetJavaFloatArrayLength(JNIEnv *env, jfloatArray arrayJ);
+        int GetJavaLongArrayLength(JNIEnv *env, jlongArray arrayJ);
 
         void DeleteLocalRef(JNIEnv *env, jobject obj);
         jbyte * GetByteArrayElements(JNIEnv *env, jbyteArray array, jboolean * isCopy);
         jfloat * GetFloatArrayElements(JNIEnv *env, jfloatArray array, jboolean * isCopy);
         jint * GetIntArrayElements(JNIEnv *env, jintArray array, jboolean * isCopy);
+        jlong * GetLongArrayElements(JNIEnv *env, jlongArray array, jboolean * isCopy);
         jobject GetObjectArrayElement(JNIEnv *env, jobjectArray array, jsize index);
         jobject NewObject(JNIEnv *env, jclass clazz, jmethodID methodId, int id, float distance);
         jobjectArray NewObjectArray(JNIEnv *env, jsize len, jclass clazz, jobject init);
         jbyteArray NewByteArray(JNIEnv *env, jsize len);
+        jintArray NewIntArray(JNIEnv *env, jsize len);
+        jfloatArray NewFloatArray(JNIEnv *env, jsize len);
+        jfloatArray NewFloatArray(JNIEnv *env, jsize len);
         void ReleaseByteArrayElements(JNIEnv *env, jbyteArray array, jbyte *elems, int mode);
         void ReleaseFloatArrayElements(JNIEnv *env, jfloatArray array, jfloat *elems, int mode);
         void ReleaseIntArrayElements(JNIEnv *env, jintArray array, jint *elems, jint mode);
+        void ReleaseLongArrayElements(JNIEnv *env, jlongArray array, jlong *elems, jint mode);
         void SetObjectArrayElement(JNIEnv *env, jobjectArray array, jsize index, jobject val);
         void SetByteArrayRegion(JNIEnv *env, jbyteArray array, jsize start, jsize len, const jbyte * buf);
+        void SetIntArrayRegion(JNIEnv *env, jintArray array, jsize start, jsize len, const jint * buf);
+        void SetFloatArrayRegion(JNIEnv *env, jfloatArray array, jsize start, jsize len, const jfloat * buf);
+        void SetFloatArrayRegion(JNIEnv *env, jfloatArray array, jsize start, jsize len, const jfloat * buf);
 
     private:
         std::unordered_map<std::string, jclass> cachedClasses;
@@ -172,6 +242,7 @@ namespace knn_jni {
     extern const std::string PARAMETERS;
     extern const std::string TRAINING_DATASET_SIZE_LIMIT;
     extern const std::string INDEX_THREAD_QUANTITY;
+    extern const std::string BUILD_SCHEDULING_POLICY;
 
     extern const std::string L2;
     extern const std::string L1;
@@ -182,11 +253,26 @@ namespace knn_jni {
 
     extern const std::string NPROBES;
     extern const std::string COARSE_QUANTIZER;
+    extern const std::string CLUSTERING;
+    extern const std::string CLUSTERING_KMEANS;
+    extern const std::string CLUSTERING_BALANCED;
     extern const std::string M;
     extern const std::string M_NMSLIB;
     extern const std::string EF_CONSTRUCTION;
     extern const std::string EF_CONSTRUCTION_NMSLIB;
     extern const std::string EF_SEARCH;
+    extern const std::string GRAPH_REORDER;
+    extern const std::string GRAPH_ENCODING;
+    extern const std::string COSINE_MODE;
+    extern const std::string COSINE_MODE_RAW;
+    extern const std::string COSINE_MODE_NORMALIZED;
+    extern const std::string INDEX_LAYOUT;
+    extern const std::string INDEX_LAYOUT_OPTIMIZED;
+    extern const std::string INDEX_LAYOUT_REGULAR;
+    extern const std::string EARLY_TERMINATION;
+    extern const std::string EARLY_TERMINATION_NONE;
+    extern const std::string EARLY_TERMINATION_ADAPTIVE;
+    extern const std::string SKIP_OPTIMIZED_INDEX_NMSLIB;
 
     // --------------------------------------------------------------------------
 }
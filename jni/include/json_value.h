@@ -0,0 +1,75 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+
+#ifndef OPENSEARCH_KNN_JSON_VALUE_H
+#define OPENSEARCH_KNN_JSON_VALUE_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace knn_jni {
+    namespace json {
+
+        // A parsed JSON document, enough to read the index and method specs of the perf-tool. Numbers are held as
+        // doubles and object members are sorted by name
+        class Value {
+        public:
+            enum class Type { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+            // Parse text, which must hold exactly one value. Throw on malformed input
+            static Value Parse(const std::string& text);
+
+            static Value ParseFile(const std::string& path);
+
+            Value();
+
+            Type GetType() const;
+
+            bool IsNumber() const;
+
+            bool IsString() const;
+
+            bool IsObject() const;
+
+            // Typed accessors throw if the value has a different type
+            bool AsBool() const;
+
+            double AsNumber() const;
+
+            // Throw if the number is not an integer
+            int AsInt() const;
+
+            const std::string& AsString() const;
+
+            const std::vector<std::shared_ptr<const Value>>& Elements() const;
+
+            const std::map<std::string, std::shared_ptr<const Value>>& Members() const;
+
+            // Member called name, or nullptr if this is not an object or has no such member
+            const Value* Find(const std::string& name) const;
+
+        private:
+            friend class Parser;
+
+            Type type;
+            bool boolean;
+            double number;
+            std::string string;
+            std::vector<std::shared_ptr<const Value>> elements;
+            std::map<std::string, std::shared_ptr<const Value>> members;
+        };
+    }
+}
+
+#endif //OPENSEARCH_KNN_JSON_VALUE_H
@@ -0,0 +1,54 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_LIVE_DOCS_H
+#define OPENSEARCH_KNN_LIVE_DOCS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace knn_jni {
+    namespace live_docs {
+
+        // View over the words of a Lucene FixedBitSet in which bit i is set when doc i is live. The words are not
+        // copied, so they must outlive the view.
+        class LiveDocs {
+        public:
+            LiveDocs(const uint64_t* words, size_t numWords);
+
+            // Docs past the end of the bitset are live, as Lucene does not track deletes it has not seen
+            inline bool IsLive(int64_t docId) const {
+                auto word = (uint64_t) docId >> 6;
+                if (docId < 0 || word >= numWords) {
+                    return true;
+                }
+                return (words[word] >> (docId & 63)) & 1u;
+            }
+
+            // Upper bound on the number of deleted docs: unused bits in the last word count as deleted
+            int64_t NumDeleted() const;
+
+        private:
+            const uint64_t* words;
+            size_t numWords;
+        };
+
+        // Upper bound on the results fetched per returned doc by a search that cannot skip deleted docs
+        const int64_t MAX_OVER_FETCH_FACTOR = 10;
+
+        // Number of results such a search fetches to return k live docs: one extra for each deleted doc, but no more
+        // than MAX_OVER_FETCH_FACTOR * k. Segments with more deletes than that may return fewer than k docs rather
+        // than fetching close to all of their vectors for every query; Lucene merges them away over time.
+        int64_t OverFetchSize(const LiveDocs& liveDocs, int64_t k);
+    }
+}
+
+#endif //OPENSEARCH_KNN_LIVE_DOCS_H
@@ -28,6 +28,18 @@ namespace knn_jni {
         void CreateIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ, jobjectArray vectorsJ,
                          jstring indexPathJ, jobject parametersJ);
 
+        // Same as CreateIndex, but the vectors of dimension dimJ are laid out back to back in vectorsJ, which is
+        // either a float[] or a direct ByteBuffer in native byte order.
+        void CreateIndexFromFlatVectors(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ,
+                                        jobject vectorsJ, jint dimJ, jstring indexPathJ, jobject parametersJ);
+
+        // Same as CreateIndexFromFlatVectors, but the vectors are 16 bit floats held in a short[] or a direct
+        // ByteBuffer, in the encoding named by encodingJ, "fp16" or "bf16". nmslib spaces are float only, so the
+        // vectors are widened as they are copied.
+        void CreateIndexFromHalfVectors(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ,
+                                        jobject vectorsJ, jint dimJ, jstring encodingJ, jstring indexPathJ,
+                                        jobject parametersJ);
+
         // Load an index from indexPathJ into memory. Use parametersJ to set any query time parameters
         //
         // Return a pointer to the loaded index
@@ -39,6 +51,31 @@ namespace knn_jni {
         jobjectArray QueryIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
                                 jfloatArray queryVectorJ, jint kJ);
 
+        // Same as QueryIndex for a query vector of 16 bit floats in the encoding named by encodingJ
+        //
+        // Return an array of KNNQueryResults
+        jobjectArray QueryIndexWithHalfVector(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                              jshortArray queryVectorJ, jstring encodingJ, jint kJ);
+
+        // Execute a query against the index located in memory at indexPointerJ, skipping deleted docs. liveDocsJ
+        // holds the words of the segment's live docs bitset; if it is null, every doc is live.
+        //
+        // Return an array of KNNQueryResults
+        jobjectArray QueryIndexWithLiveDocs(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                            jfloatArray queryVectorJ, jint kJ, jlongArray liveDocsJ);
+
+        // Whether the index located in memory at indexPointerJ uses nmslib's optimized layout, which keeps each
+        // node's vector and level 0 links together in one flat block. The regular layout is used when it was asked
+        // for with index_layout or when the space has no optimized kernels
+        bool IsOptimizedLayout(jlong indexPointerJ);
+
+        // Return the structure of the index located in memory at indexPointerJ, as a Java byte[] holding a UTF-8 JSON
+        // document with the same fields as the faiss one described in faiss_description.h: engine, count, dimension,
+        // metric, memory by component and, under hnsw, the graph summary. nmslib keeps its graph private, so all but
+        // the engine and metric are read back from the file the index was loaded from, which must still exist. Only
+        // the optimized layout is read; for the regular one the file size is reported as the total memory.
+        jbyteArray DescribeIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ);
+
         // Free the index located in memory at indexPointerJ
         void Free(jlong indexPointer);
 
@@ -46,7 +83,7 @@ namespace knn_jni {
         void InitLibrary();
 
         struct IndexWrapper {
-            explicit IndexWrapper(const std::string& spaceType) {
+            explicit IndexWrapper(const std::string& spaceType) : spaceType(spaceType) {
                 // Index gets constructed with a reference to data (see above) but is otherwise unused
                 similarity::ObjectVector data;
                 space.reset(similarity::SpaceFactoryRegistry<float>::Instance().CreateSpace(spaceType, similarity::AnyParams()));
@@ -54,6 +91,15 @@ namespace knn_jni {
             }
             std::unique_ptr<similarity::Space<float>> space;
             std::unique_ptr<similarity::Index<float>> index;
+            // Set for cosine indices built from normalized vectors. Queries are normalized before the search, and
+            // distances are turned back into cosine distances
+            bool cosineNormalized = false;
+            // Layout the index file was written in, see IsOptimizedLayout
+            bool optimizedLayout = false;
+            // nmslib space the index is searched in
+            std::string spaceType;
+            // File the index was loaded from, read by DescribeIndex
+            std::string indexPath;
         };
     }
 }
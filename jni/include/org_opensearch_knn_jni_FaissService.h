@@ -26,6 +26,30 @@ extern "C" {
 JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_createIndex
   (JNIEnv *, jclass, jintArray, jobjectArray, jstring, jobject);
 
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    createIndexFromFlatVectors
+ * Signature: ([ILjava/lang/Object;ILjava/lang/String;Ljava/util/Map;)V
+ */
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_createIndexFromFlatVectors
+  (JNIEnv *, jclass, jintArray, jobject, jint, jstring, jobject);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    createIndexFromHalfVectors
+ * Signature: ([ILjava/lang/Object;ILjava/lang/String;Ljava/lang/String;Ljava/util/Map;)V
+ */
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_createIndexFromHalfVectors
+  (JNIEnv *, jclass, jintArray, jobject, jint, jstring, jstring, jobject);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    createIndexFromByteVectors
+ * Signature: ([ILjava/lang/Object;ILjava/lang/String;Ljava/util/Map;)V
+ */
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_createIndexFromByteVectors
+  (JNIEnv *, jclass, jintArray, jobject, jint, jstring, jobject);
+
 /*
  * Class:     org_opensearch_knn_jni_FaissService
  * Method:    createIndexFromTemplate
@@ -34,13 +58,21 @@ JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_createIndex
 JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_createIndexFromTemplate
   (JNIEnv *, jclass, jintArray, jobjectArray, jstring, jbyteArray, jobject);
 
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    createIndexFromTemplateWithFlatVectors
+ * Signature: ([ILjava/lang/Object;ILjava/lang/String;[BLjava/util/Map;)V
+ */
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_createIndexFromTemplateWithFlatVectors
+  (JNIEnv *, jclass, jintArray, jobject, jint, jstring, jbyteArray, jobject);
+
 /*
  * Class:     org_opensearch_knn_jni_FaissService
  * Method:    loadIndex
- * Signature: (Ljava/lang/String;)J
+ * Signature: (Ljava/lang/String;Ljava/util/Map;)J
  */
 JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_loadIndex
-  (JNIEnv *, jclass, jstring);
+  (JNIEnv *, jclass, jstring, jobject);
 
 /*
  * Class:     org_opensearch_knn_jni_FaissService
@@ -50,6 +82,46 @@ JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_loadIndex
 JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_FaissService_queryIndex
   (JNIEnv *, jclass, jlong, jfloatArray, jint);
 
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    queryIndexWithHalfVector
+ * Signature: (J[SLjava/lang/String;I)[Lorg/opensearch/knn/index/KNNQueryResult;
+ */
+JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_FaissService_queryIndexWithHalfVector
+  (JNIEnv *, jclass, jlong, jshortArray, jstring, jint);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    queryIndexWithByteVector
+ * Signature: (J[BI)[Lorg/opensearch/knn/index/KNNQueryResult;
+ */
+JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_FaissService_queryIndexWithByteVector
+  (JNIEnv *, jclass, jlong, jbyteArray, jint);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    queryIndexWithLiveDocs
+ * Signature: (J[FI[J)[Lorg/opensearch/knn/index/KNNQueryResult;
+ */
+JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_FaissService_queryIndexWithLiveDocs
+  (JNIEnv *, jclass, jlong, jfloatArray, jint, jlongArray);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    selfJoin
+ * Signature: (JIZLjava/lang/String;Ljava/util/Map;)V
+ */
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_selfJoin
+  (JNIEnv *, jclass, jlong, jint, jboolean, jstring, jobject);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    knnJoin
+ * Signature: (JJIZLjava/lang/String;Ljava/util/Map;)V
+ */
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_knnJoin
+  (JNIEnv *, jclass, jlong, jlong, jint, jboolean, jstring, jobject);
+
 /*
  * Class:     org_opensearch_knn_jni_FaissService
  * Method:    free
@@ -58,6 +130,54 @@ JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_FaissService_queryInd
 JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_free
   (JNIEnv *, jclass, jlong);
 
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    setRecallSampling
+ * Signature: (JF)V
+ */
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_setRecallSampling
+  (JNIEnv *, jclass, jlong, jfloat);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    getRecallStats
+ * Signature: (J)[F
+ */
+JNIEXPORT jfloatArray JNICALL Java_org_opensearch_knn_jni_FaissService_getRecallStats
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    describeIndex
+ * Signature: (J)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_org_opensearch_knn_jni_FaissService_describeIndex
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    startQueryCapture
+ * Signature: (Ljava/lang/String;JF)V
+ */
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_startQueryCapture
+  (JNIEnv *, jclass, jstring, jlong, jfloat);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    stopQueryCapture
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_stopQueryCapture
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    setThreadPoolSize
+ * Signature: (I)V
+ */
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_setThreadPoolSize
+  (JNIEnv *, jclass, jint);
+
 /*
  * Class:     org_opensearch_knn_jni_FaissService
  * Method:    initLibrary
@@ -74,6 +194,30 @@ JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_initLibrary
 JNIEXPORT jbyteArray JNICALL Java_org_opensearch_knn_jni_FaissService_trainIndex
   (JNIEnv *, jclass, jobject, jint, jlong);
 
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    listSizes
+ * Signature: ([BJ)[I
+ */
+JNIEXPORT jintArray JNICALL Java_org_opensearch_knn_jni_FaissService_listSizes
+  (JNIEnv *, jclass, jbyteArray, jlong);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    calibrate
+ * Signature: (JJIF)[F
+ */
+JNIEXPORT jfloatArray JNICALL Java_org_opensearch_knn_jni_FaissService_calibrate
+  (JNIEnv *, jclass, jlong, jlong, jint, jfloat);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    calibrateTemplate
+ * Signature: ([BJJIF)[F
+ */
+JNIEXPORT jfloatArray JNICALL Java_org_opensearch_knn_jni_FaissService_calibrateTemplate
+  (JNIEnv *, jclass, jbyteArray, jlong, jlong, jint, jfloat);
+
 /*
  * Class:     org_opensearch_knn_jni_FaissService
  * Method:    transferVectors
@@ -82,6 +226,22 @@ JNIEXPORT jbyteArray JNICALL Java_org_opensearch_knn_jni_FaissService_trainIndex
 JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_transferVectors
   (JNIEnv *, jclass, jlong, jobjectArray);
 
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    transferFlatVectors
+ * Signature: (JLjava/lang/Object;I)J
+ */
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_transferFlatVectors
+  (JNIEnv *, jclass, jlong, jobject, jint);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    transferHalfVectors
+ * Signature: (JLjava/lang/Object;ILjava/lang/String;)J
+ */
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_transferHalfVectors
+  (JNIEnv *, jclass, jlong, jobject, jint, jstring);
+
 /*
  * Class:     org_opensearch_knn_jni_FaissService
  * Method:    freeVectors
@@ -26,6 +26,22 @@ extern "C" {
 JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_NmslibService_createIndex
   (JNIEnv *, jclass, jintArray, jobjectArray, jstring, jobject);
 
+/*
+ * Class:     org_opensearch_knn_jni_NmslibService
+ * Method:    createIndexFromFlatVectors
+ * Signature: ([ILjava/lang/Object;ILjava/lang/String;Ljava/util/Map;)V
+ */
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_NmslibService_createIndexFromFlatVectors
+  (JNIEnv *, jclass, jintArray, jobject, jint, jstring, jobject);
+
+/*
+ * Class:     org_opensearch_knn_jni_NmslibService
+ * Method:    createIndexFromHalfVectors
+ * Signature: ([ILjava/lang/Object;ILjava/lang/String;Ljava/lang/String;Ljava/util/Map;)V
+ */
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_NmslibService_createIndexFromHalfVectors
+  (JNIEnv *, jclass, jintArray, jobject, jint, jstring, jstring, jobject);
+
 /*
  * Class:     org_opensearch_knn_jni_NmslibService
  * Method:    loadIndex
@@ -42,6 +58,38 @@ JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_NmslibService_loadIndex
 JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_NmslibService_queryIndex
   (JNIEnv *, jclass, jlong, jfloatArray, jint);
 
+/*
+ * Class:     org_opensearch_knn_jni_NmslibService
+ * Method:    queryIndexWithHalfVector
+ * Signature: (J[SLjava/lang/String;I)[Lorg/opensearch/knn/index/KNNQueryResult;
+ */
+JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_NmslibService_queryIndexWithHalfVector
+  (JNIEnv *, jclass, jlong, jshortArray, jstring, jint);
+
+/*
+ * Class:     org_opensearch_knn_jni_NmslibService
+ * Method:    queryIndexWithLiveDocs
+ * Signature: (J[FI[J)[Lorg/opensearch/knn/index/KNNQueryResult;
+ */
+JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_NmslibService_queryIndexWithLiveDocs
+  (JNIEnv *, jclass, jlong, jfloatArray, jint, jlongArray);
+
+/*
+ * Class:     org_opensearch_knn_jni_NmslibService
+ * Method:    isOptimizedLayout
+ * Signature: (J)Z
+ */
+JNIEXPORT jboolean JNICALL Java_org_opensearch_knn_jni_NmslibService_isOptimizedLayout
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     org_opensearch_knn_jni_NmslibService
+ * Method:    describeIndex
+ * Signature: (J)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_org_opensearch_knn_jni_NmslibService_describeIndex
+  (JNIEnv *, jclass, jlong);
+
 /*
  * Class:     org_opensearch_knn_jni_NmslibService
  * Method:    free
@@ -0,0 +1,59 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_QOS_H
+#define OPENSEARCH_KNN_QOS_H
+
+#include <functional>
+#include <string>
+
+namespace knn_jni {
+    namespace qos {
+
+        // How build and training work is scheduled relative to queries
+        enum class SchedulingPolicy {
+            NORMAL,  // Run on the calling thread with its current priority
+            NICE,    // Run on a dedicated thread with a raised nice value
+            IDLE     // Run on a dedicated thread under SCHED_IDLE, so it only gets CPU no query thread wants
+        };
+
+        // Parse "normal", "nice" or "idle". Throws for anything else
+        SchedulingPolicy ParseSchedulingPolicy(const std::string& policy);
+
+        // Marks a query as in flight for as long as it is alive. Build loops back off while any query is in flight.
+        class ScopedQuery {
+        public:
+            ScopedQuery();
+            ~ScopedQuery();
+
+            ScopedQuery(const ScopedQuery&) = delete;
+            ScopedQuery& operator=(const ScopedQuery&) = delete;
+        };
+
+        // Number of queries currently in flight in either library
+        int ActiveQueries();
+
+        // Cooperative yield point for build loops scheduled with policy. While queries are in flight, sleep with
+        // exponential backoff. The total wait is capped so that a steady query load can slow a build down but never
+        // starve it. NORMAL work runs like any other work and never backs off.
+        void YieldToQueries(SchedulingPolicy policy);
+
+        // Run task with the scheduling priority defined by policy. For NICE and IDLE the task runs on a new thread
+        // whose priority is lowered before it starts, so that every thread the task spawns (OpenMP teams, nmslib
+        // workers) inherits the lower priority. The calling thread keeps its own priority. Exceptions thrown by task
+        // are rethrown on the calling thread.
+        //
+        // Per-thread priorities are a Linux feature. On other platforms the task runs on the calling thread.
+        void RunWithPolicy(SchedulingPolicy policy, const std::function<void()>& task);
+    }
+}
+
+#endif //OPENSEARCH_KNN_QOS_H
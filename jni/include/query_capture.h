@@ -0,0 +1,90 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_QUERY_CAPTURE_H
+#define OPENSEARCH_KNN_QUERY_CAPTURE_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Opt-in capture of sampled queries into a ring log on local disk, so that production traffic can be replayed offline
+// against the same index files with knn_capture_replay.
+//
+// The log is a memory mapped file of fixed size: a 64 byte header followed by a ring of records. Writers reserve their
+// record with a compare and swap on the write cursor stored in the header and copy it in without taking a lock, so
+// concurrent queries never wait on each other or on the disk. Once the ring is full the oldest records are overwritten.
+// Each record carries its absolute position and a checksum, so records torn by a crash or overwritten while being
+// written are skipped by the reader.
+
+namespace knn_jni {
+    namespace query_capture {
+
+        enum class Engine : uint8_t {
+            FAISS = 0,
+            NMSLIB = 1
+        };
+
+        // What is needed to load an index again the way the plugin loaded it: its engine, its file, and the load
+        // parameters as strings
+        struct IndexIdentity {
+            Engine engine;
+            std::string path;
+            std::vector<std::pair<std::string, std::string>> parameters;
+        };
+
+        // A captured query
+        struct Record {
+            uint64_t timestampMicros;          // Wall clock time the query finished, since the epoch
+            uint64_t latencyNanos;             // Time spent in the engine search
+            int32_t k;
+            bool filtered;                     // Searched with deleted docs left out. The replay cannot reproduce these
+            IndexIdentity index;
+            std::vector<float> query;
+            std::vector<int32_t> resultIds;    // Nearest first
+        };
+
+        // Smallest ring Start accepts
+        constexpr int64_t MIN_CAPACITY = 64 * 1024;
+
+        // Remember the identity of a loaded index, so queries on it can be captured. Called on load
+        void RegisterIndex(const void * index, IndexIdentity identity);
+
+        // Forget a freed index
+        void UnregisterIndex(const void * index);
+
+        // Start capturing a fraction sampleRate of the queries into the log at path, with a ring of capacityBytes. A log
+        // at path of the same capacity is appended to, anything else there is replaced. Calling Start again while
+        // capturing switches to the new log and rate. Throws if the log cannot be created
+        void Start(const std::string& path, int64_t capacityBytes, double sampleRate);
+
+        // Stop capturing. Records written so far stay in the log
+        void Stop();
+
+        // Whether the current query should be captured. Without a capture running this is a single atomic load
+        bool ShouldCapture();
+
+        // Append a query on index to the log, if a capture is running and the index was registered. ids holds numIds
+        // result ids, nearest first. Never throws: a record that cannot be written is counted as dropped
+        void Capture(const void * index, const float * query, int dim, int k, bool filtered, uint64_t latencyNanos,
+                     const int64_t * ids, int numIds);
+
+        // Number of records written and dropped since the library was loaded
+        int64_t CapturedRecords();
+        int64_t DroppedRecords();
+
+        // Read the records of the log at path, oldest first
+        std::vector<Record> ReadLog(const std::string& path);
+    }
+}
+
+#endif //OPENSEARCH_KNN_QUERY_CAPTURE_H
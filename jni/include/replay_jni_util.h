@@ -0,0 +1,152 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+
+#ifndef OPENSEARCH_KNN_REPLAY_JNI_UTIL_H
+#define OPENSEARCH_KNN_REPLAY_JNI_UTIL_H
+
+#include "jni_util.h"
+
+#include <jni.h>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace knn_jni {
+    namespace replay {
+
+        // Java objects as seen by the wrappers when they run outside of a JVM. Every jobject handed to the wrappers
+        // points to one of these; arrays and maps own their elements
+        struct Object {
+            virtual ~Object() = default;
+        };
+
+        struct String : Object {
+            explicit String(std::string value) : value(std::move(value)) {}
+            std::string value;
+        };
+
+        struct Integer : Object {
+            explicit Integer(int value) : value(value) {}
+            int value;
+        };
+
+        struct FloatArray : Object {
+            std::vector<float> values;
+        };
+
+        // Raw 16 bit floats, as a Java short[] holds them
+        struct ShortArray : Object {
+            std::vector<uint16_t> values;
+        };
+
+        struct IntArray : Object {
+            std::vector<int32_t> values;
+        };
+
+        struct LongArray : Object {
+            std::vector<int64_t> values;
+        };
+
+        struct ByteArray : Object {
+            std::vector<jbyte> values;
+        };
+
+        struct ObjectArray : Object {
+            std::vector<std::unique_ptr<Object>> elements;
+        };
+
+        struct Map : Object {
+            std::unordered_map<std::string, std::unique_ptr<Object>> entries;
+        };
+
+        // Built by NewObject in place of a KNNQueryResult
+        struct QueryResult : Object {
+            QueryResult(int id, float score) : id(id), score(score) {}
+            int id;
+            float score;
+        };
+
+        // Reinterpret an object as the JNI reference type the wrappers take
+        template <typename J>
+        J ToJava(Object * object) {
+            return reinterpret_cast<J>(object);
+        }
+
+        // Object behind a reference the wrappers returned, such as the result array of a query. Throw if it is not a T
+        template <typename T>
+        T& FromJava(void * reference) {
+            auto * object = dynamic_cast<T*>(reinterpret_cast<Object*>(reference));
+            if (object == nullptr) {
+                throw std::runtime_error("Unexpected Java object type");
+            }
+            return *object;
+        }
+
+        // JNIUtilInterface over the objects above, so that faiss_wrapper and nmslib_wrapper can be driven from native
+        // tools with the same calls the JVM makes. JNIEnv is never used and may be null. Exceptions the wrappers would
+        // throw into Java are thrown as std::runtime_error. All methods are thread safe.
+        class ReplayJNIUtil : public JNIUtilInterface {
+        public:
+            void ThrowJavaException(JNIEnv* env, const char* type, const char* message) override;
+            void HasExceptionInStack(JNIEnv* env) override;
+            void HasExceptionInStack(JNIEnv* env, const std::string& message) override;
+            void CatchCppExceptionAndThrowJava(JNIEnv* env) override;
+            jclass FindClass(JNIEnv * env, const std::string& className) override;
+            jmethodID FindMethod(JNIEnv * env, const std::string& className, const std::string& methodName) override;
+            std::string ConvertJavaStringToCppString(JNIEnv * env, jstring javaString) override;
+            std::unordered_map<std::string, jobject> ConvertJavaMapToCppMap(JNIEnv *env, jobject parametersJ) override;
+            std::string ConvertJavaObjectToCppString(JNIEnv *env, jobject objectJ) override;
+            int ConvertJavaObjectToCppInteger(JNIEnv *env, jobject objectJ) override;
+            std::vector<float> Convert2dJavaObjectArrayToCppFloatVector(JNIEnv *env, jobjectArray array2dJ,
+                                                                        int dim) override;
+            std::vector<int64_t> ConvertJavaIntArrayToCppIntVector(JNIEnv *env, jintArray arrayJ) override;
+            std::vector<float> ConvertFlatJavaVectorsToCppFloatVector(JNIEnv *env, jobject vectorsJ, int dim) override;
+            std::vector<float> ConvertHalfJavaVectorsToCppFloatVector(JNIEnv *env, jobject vectorsJ, int dim,
+                                                                      half_precision::Encoding encoding) override;
+            std::vector<float> ConvertByteJavaVectorsToCppFloatVector(JNIEnv *env, jobject vectorsJ, int dim) override;
+            int GetInnerDimensionOf2dJavaFloatArray(JNIEnv *env, jobjectArray array2dJ) override;
+            int GetJavaObjectArrayLength(JNIEnv *env, jobjectArray arrayJ) override;
+            int GetJavaIntArrayLength(JNIEnv *env, jintArray arrayJ) override;
+            int GetJavaBytesArrayLength(JNIEnv *env, jbyteArray arrayJ) override;
+            int GetJavaFloatArrayLength(JNIEnv *env, jfloatArray arrayJ) override;
+            int GetJavaLongArrayLength(JNIEnv *env, jlongArray arrayJ) override;
+
+            void DeleteLocalRef(JNIEnv *env, jobject obj) override;
+            jbyte * GetByteArrayElements(JNIEnv *env, jbyteArray array, jboolean * isCopy) override;
+            jfloat * GetFloatArrayElements(JNIEnv *env, jfloatArray array, jboolean * isCopy) override;
+            jint * GetIntArrayElements(JNIEnv *env, jintArray array, jboolean * isCopy) override;
+            jlong * GetLongArrayElements(JNIEnv *env, jlongArray array, jboolean * isCopy) override;
+            jobject GetObjectArrayElement(JNIEnv *env, jobjectArray array, jsize index) override;
+            jobject NewObject(JNIEnv *env, jclass clazz, jmethodID methodId, int id, float distance) override;
+            jobjectArray NewObjectArray(JNIEnv *env, jsize len, jclass clazz, jobject init) override;
+            jbyteArray NewByteArray(JNIEnv *env, jsize len) override;
+            jintArray NewIntArray(JNIEnv *env, jsize len) override;
+            jfloatArray NewFloatArray(JNIEnv *env, jsize len) override;
+            void ReleaseByteArrayElements(JNIEnv *env, jbyteArray array, jbyte *elems, int mode) override;
+            void ReleaseFloatArrayElements(JNIEnv *env, jfloatArray array, jfloat *elems, int mode) override;
+            void ReleaseIntArrayElements(JNIEnv *env, jintArray array, jint *elems, jint mode) override;
+            void ReleaseLongArrayElements(JNIEnv *env, jlongArray array, jlong *elems, jint mode) override;
+            void SetObjectArrayElement(JNIEnv *env, jobjectArray array, jsize index, jobject val) override;
+            void SetByteArrayRegion(JNIEnv *env, jbyteArray array, jsize start, jsize len, const jbyte * buf) override;
+            void SetIntArrayRegion(JNIEnv *env, jintArray array, jsize start, jsize len, const jint * buf) override;
+            void SetFloatArrayRegion(JNIEnv *env, jfloatArray array, jsize start, jsize len,
+                                     const jfloat * buf) override;
+        };
+    }
+}
+
+#endif //OPENSEARCH_KNN_REPLAY_JNI_UTIL_H
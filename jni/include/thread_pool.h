@@ -0,0 +1,106 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_THREAD_POOL_H
+#define OPENSEARCH_KNN_THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace knn_jni {
+    namespace thread_pool {
+
+        // Upper bound on the size of the CPU budget
+        const int MAX_POOL_SIZE = 512;
+
+        // Process wide budget of threads for native builds and trainings, shared by the faiss and nmslib libraries.
+        // The libraries do their own threading (OpenMP in faiss, std::thread in nmslib), so the budget does not run
+        // any work itself: each build borrows its threads from it for the duration of the build. A build that finds
+        // the budget used up waits until another one returns its threads, so the total number of native build threads
+        // never exceeds the size no matter how many builds run concurrently.
+        class CpuBudget {
+        public:
+            // Return the budget of the process. It starts with one thread per hardware thread
+            static CpuBudget& Instance();
+
+            explicit CpuBudget(int numThreads);
+
+            CpuBudget(const CpuBudget&) = delete;
+            CpuBudget& operator=(const CpuBudget&) = delete;
+
+            // Change the size of the budget. Threads already borrowed are kept until they are released, so the
+            // budget may be exceeded until then; new requests wait for the total to drop below the new size.
+            void Resize(int numThreads);
+
+            int Size();
+
+            // Borrow between 1 and requested threads, waiting until at least one is free
+            int AcquireThreads(int requested);
+
+            void ReleaseThreads(int count);
+
+            // Threads currently borrowed through AcquireThreads
+            int BorrowedThreads();
+
+        private:
+            std::mutex mutex;
+            std::condition_variable released;
+            int size;
+            int borrowedThreads;
+        };
+
+        // Borrow threads from CpuBudget::Instance for the lifetime of the object. A request of 0 or less borrows
+        // nothing and Count returns 0, in which case the library's own default thread count is to be kept.
+        class ThreadBudget {
+        public:
+            explicit ThreadBudget(int requested);
+            ~ThreadBudget();
+
+            ThreadBudget(const ThreadBudget&) = delete;
+            ThreadBudget& operator=(const ThreadBudget&) = delete;
+
+            int Count() const { return count; }
+
+        private:
+            int count;
+        };
+
+        // Single thread running background tasks in submission order, such as recall checks. The thread is started
+        // with the first task. Callers bound how much they queue.
+        class BackgroundWorker {
+        public:
+            // Return the worker of the process
+            static BackgroundWorker& Instance();
+
+            BackgroundWorker();
+            ~BackgroundWorker();
+
+            BackgroundWorker(const BackgroundWorker&) = delete;
+            BackgroundWorker& operator=(const BackgroundWorker&) = delete;
+
+            void Submit(std::function<void()> task);
+
+        private:
+            void Run();
+
+            std::mutex mutex;
+            std::condition_variable wake;
+            std::deque<std::function<void()>> tasks;
+            std::thread thread;
+            bool stop;
+        };
+    }
+}
+
+#endif //OPENSEARCH_KNN_THREAD_POOL_H
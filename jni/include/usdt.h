@@ -0,0 +1,81 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_USDT_H
+#define OPENSEARCH_KNN_USDT_H
+
+#include <chrono>
+#include <cstdint>
+
+// Statically defined tracepoints (USDT probes) for perf, bpftrace and other eBPF tools. The faiss library fires its
+// probes under the provider opensearch_knn_faiss and the nmslib library under opensearch_knn_nmslib:
+//
+//   load_start(path)                          load_done(index, path, count, duration)
+//   query_start(index, k, filtered)           query_done(index, k, results, duration)
+//   build_start(count, dimension)             build_done(count, dimension, path, duration)
+//   train_start(count, dimension)             train_done(count, dimension, bytes, duration)    faiss only
+//   free_start(index)                         free_done(index, duration)
+//
+// index is the pointer handed to Java, path a NUL terminated string and durations are in nanoseconds. count is the
+// number of vectors in the index, or -1 for nmslib, which does not expose it. Done probes only fire when the call
+// succeeds.
+//
+// When built with KNN_WITH_USDT, which CMake sets on Linux when systemtap's sys/sdt.h is found, each probe is a single
+// nop plus a note in the ELF file. Every probe has a semaphore that tracers raise while attached, and the clock reads
+// for durations are skipped while it is 0, so an untraced call pays for one load and branch. A call already running
+// when a tracer attaches reports a duration of 0. Without KNN_WITH_USDT the probes compile to nothing.
+//
+// With semaphores on, the note of every probe in a translation unit refers to its semaphore, so each probe fired in a
+// file needs a KNN_USDT_SEMAPHORE definition in that file.
+
+#ifdef KNN_WITH_USDT
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+
+#define KNN_USDT_SEMAPHORE(provider, name) \
+    extern "C" { \
+        __extension__ unsigned short provider##_##name##_semaphore __attribute__((unused)) \
+                __attribute__((section(".probes"))); \
+    }
+#define KNN_USDT_ENABLED(provider, name) __builtin_expect(provider##_##name##_semaphore != 0, 0)
+#define KNN_USDT(provider, name, ...) STAP_PROBEV(provider, name, ##__VA_ARGS__)
+#else
+#define KNN_USDT_SEMAPHORE(provider, name)
+#define KNN_USDT_ENABLED(provider, name) false
+#define KNN_USDT(provider, name, ...) do {} while (0)
+#endif
+
+namespace knn_jni {
+    namespace usdt {
+
+        // Measures the duration passed to a done probe. It only reads the clock when running is set, which callers
+        // take from KNN_USDT_ENABLED of the done probe
+        class Stopwatch {
+        public:
+            explicit Stopwatch(bool running) : start(running ? Now() : 0) {}
+
+            // Nanoseconds since construction, or 0 if the stopwatch was not running
+            int64_t Elapsed() const {
+                return start == 0 ? 0 : Now() - start;
+            }
+
+        private:
+            static int64_t Now() {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch()).count();
+            }
+
+            int64_t start;
+        };
+    }
+}
+
+#endif //OPENSEARCH_KNN_USDT_H
@@ -0,0 +1,61 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_VECS_IO_H
+#define OPENSEARCH_KNN_VECS_IO_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace knn_jni {
+    namespace vecs_io {
+
+        // Row major matrix, one vector per row
+        template <typename T>
+        struct Matrix {
+            int64_t rows;
+            int64_t cols;
+            std::vector<T> data;
+
+            Matrix() : rows(0), cols(0) {}
+
+            Matrix(int64_t rows, int64_t cols) : rows(rows), cols(cols), data(rows * cols) {}
+
+            T* Row(int64_t row) {
+                return data.data() + row * cols;
+            }
+
+            const T* Row(int64_t row) const {
+                return data.data() + row * cols;
+            }
+        };
+
+        // Readers for the TEXMEX formats used by the SIFT and GIST datasets: every vector is stored as its int32
+        // dimension followed by its components as float (fvecs), uint8 (bvecs) or int32 (ivecs). All vectors of a file
+        // must have the same dimension. Throw if the file cannot be read or is malformed.
+        Matrix<float> ReadFvecs(const std::string& path);
+
+        // Components are converted to float
+        Matrix<float> ReadBvecs(const std::string& path);
+
+        Matrix<int32_t> ReadIvecs(const std::string& path);
+
+        // Read fvecs or bvecs, depending on the extension of path
+        Matrix<float> ReadVectors(const std::string& path);
+
+        void WriteFvecs(const std::string& path, const Matrix<float>& matrix);
+
+        void WriteIvecs(const std::string& path, const Matrix<int32_t>& matrix);
+    }
+}
+
+#endif //OPENSEARCH_KNN_VECS_IO_H
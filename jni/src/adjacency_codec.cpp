@@ -0,0 +1,194 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "adjacency_codec.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+
+namespace {
+    const uint32_t BYTE_MASKS[4] = {0xffu, 0xffffu, 0xffffffu, 0xffffffffu};
+
+    void WriteVarint(uint32_t value, std::vector<uint8_t>& out) {
+        while (value >= 0x80u) {
+            out.push_back((uint8_t) (value | 0x80u));
+            value >>= 7;
+        }
+        out.push_back((uint8_t) value);
+    }
+
+    const uint8_t* ReadVarint(const uint8_t* in, uint32_t& value) {
+        value = 0;
+        for (int shift = 0; ; shift += 7) {
+            uint8_t byte = *in++;
+            value |= (uint32_t) (byte & 0x7fu) << shift;
+            if (byte < 0x80u) {
+                return in;
+            }
+        }
+    }
+
+    uint32_t ByteLength(uint32_t value) {
+        if (value < (1u << 8)) {
+            return 1;
+        }
+        if (value < (1u << 16)) {
+            return 2;
+        }
+        if (value < (1u << 24)) {
+            return 3;
+        }
+        return 4;
+    }
+
+    // Read 4 little endian bytes. Callers guarantee they are readable, see DECODE_PADDING
+    uint32_t LoadLittleEndian(const uint8_t* in) {
+        uint32_t value;
+        std::memcpy(&value, in, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        value = __builtin_bswap32(value);
+#endif
+        return value;
+    }
+}
+
+knn_jni::adjacency_codec::GraphEncoding knn_jni::adjacency_codec::ParseGraphEncoding(const std::string& encoding) {
+    if (encoding == "fixed") {
+        return GraphEncoding::FIXED;
+    }
+
+    if (encoding == "delta") {
+        return GraphEncoding::DELTA;
+    }
+
+    throw std::runtime_error("Invalid graph encoding \"" + encoding + "\"");
+}
+
+void knn_jni::adjacency_codec::EncodeList(const int32_t* ids, size_t n, std::vector<uint8_t>& out) {
+    std::vector<int32_t> sorted;
+    sorted.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (ids[i] >= 0) {
+            sorted.push_back(ids[i]);
+        }
+    }
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    WriteVarint((uint32_t) sorted.size(), out);
+    uint32_t previous = 0;
+    for (size_t group = 0; group < sorted.size(); group += 4) {
+        size_t controlPosition = out.size();
+        out.push_back(0);
+
+        uint8_t control = 0;
+        size_t groupSize = std::min<size_t>(4, sorted.size() - group);
+        for (size_t j = 0; j < groupSize; ++j) {
+            auto value = (uint32_t) sorted[group + j];
+            uint32_t delta = value - previous;
+            previous = value;
+
+            uint32_t length = ByteLength(delta);
+            control |= (uint8_t) ((length - 1) << (2 * j));
+            for (uint32_t b = 0; b < length; ++b) {
+                out.push_back((uint8_t) (delta >> (8 * b)));
+            }
+        }
+        out[controlPosition] = control;
+    }
+}
+
+const uint8_t* knn_jni::adjacency_codec::DecodeList(const uint8_t* in, std::vector<int32_t>& out) {
+    uint32_t count;
+    in = ReadVarint(in, count);
+    out.resize(count);
+
+    uint32_t previous = 0;
+    for (uint32_t group = 0; group < count; group += 4) {
+        uint32_t control = *in++;
+        uint32_t groupSize = std::min<uint32_t>(4, count - group);
+        for (uint32_t j = 0; j < groupSize; ++j) {
+            uint32_t length = ((control >> (2 * j)) & 3u) + 1;
+            previous += LoadLittleEndian(in) & BYTE_MASKS[length - 1];
+            out[group + j] = (int32_t) previous;
+            in += length;
+        }
+    }
+    return in;
+}
+
+const uint8_t* knn_jni::adjacency_codec::SkipList(const uint8_t* in) {
+    uint32_t count;
+    in = ReadVarint(in, count);
+    for (uint32_t group = 0; group < count; group += 4) {
+        uint32_t control = *in++;
+        uint32_t groupSize = std::min<uint32_t>(4, count - group);
+        for (uint32_t j = 0; j < groupSize; ++j) {
+            in += ((control >> (2 * j)) & 3u) + 1;
+        }
+    }
+    return in;
+}
+
+knn_jni::adjacency_codec::CompressedGraph::CompressedGraph() : offsets(1, 0), data(DECODE_PADDING, 0) {}
+
+knn_jni::adjacency_codec::CompressedGraph::CompressedGraph(std::vector<uint64_t> offsets, std::vector<uint8_t> data)
+        : offsets(std::move(offsets)), data(std::move(data)) {
+    if (this->offsets.empty() || this->offsets.front() != 0 ||
+        this->offsets.back() + DECODE_PADDING != this->data.size() ||
+        !std::is_sorted(this->offsets.begin(), this->offsets.end())) {
+        throw std::runtime_error("Compressed graph is corrupted");
+    }
+}
+
+void knn_jni::adjacency_codec::CompressedGraph::AppendNode(const std::vector<std::vector<int32_t>>& layers) {
+    data.resize(offsets.back());
+    WriteVarint((uint32_t) layers.size(), data);
+    for (const auto& layer : layers) {
+        EncodeList(layer.data(), layer.size(), data);
+    }
+    offsets.push_back(data.size());
+    data.resize(data.size() + DECODE_PADDING, 0);
+}
+
+void knn_jni::adjacency_codec::CompressedGraph::Neighbors(int32_t node, int layer, std::vector<int32_t>& out) const {
+    const uint8_t* in = data.data() + offsets[node];
+    uint32_t numLayers;
+    in = ReadVarint(in, numLayers);
+    if (layer < 0 || (uint32_t) layer >= numLayers) {
+        out.clear();
+        return;
+    }
+
+    for (int l = 0; l < layer; ++l) {
+        in = SkipList(in);
+    }
+    DecodeList(in, out);
+}
+
+int32_t knn_jni::adjacency_codec::CompressedGraph::NumNodes() const {
+    return (int32_t) (offsets.size() - 1);
+}
+
+size_t knn_jni::adjacency_codec::CompressedGraph::MemoryUsage() const {
+    return offsets.capacity() * sizeof(uint64_t) + data.capacity();
+}
+
+const std::vector<uint64_t>& knn_jni::adjacency_codec::CompressedGraph::Offsets() const {
+    return offsets;
+}
+
+const std::vector<uint8_t>& knn_jni::adjacency_codec::CompressedGraph::Data() const {
+    return data;
+}
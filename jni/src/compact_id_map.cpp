@@ -0,0 +1,120 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "compact_id_map.h"
+
+#include <limits>
+#include <string>
+#include <stdexcept>
+#include <utility>
+
+
+knn_jni::compact_id_map::CompactIdMap::CompactIdMap(int64_t size) : identity(true), size(size) {
+    if (size < 0) {
+        throw std::runtime_error("Id map size cannot be negative");
+    }
+}
+
+knn_jni::compact_id_map::CompactIdMap::CompactIdMap(const std::vector<int64_t>& ids)
+        : identity(false), size((int64_t) ids.size()) {
+    this->ids.reserve(ids.size());
+    for (auto id : ids) {
+        if (id < 0 || id > std::numeric_limits<int32_t>::max()) {
+            throw std::runtime_error("Id " + std::to_string(id) + " does not fit in 32 bits");
+        }
+        this->ids.push_back((int32_t) id);
+    }
+    CompactIfIdentity();
+}
+
+knn_jni::compact_id_map::CompactIdMap::CompactIdMap(std::vector<int32_t> ids)
+        : identity(false), size((int64_t) ids.size()), ids(std::move(ids)) {
+    for (auto id : this->ids) {
+        if (id < 0) {
+            throw std::runtime_error("Id " + std::to_string(id) + " cannot be negative");
+        }
+    }
+    CompactIfIdentity();
+}
+
+bool knn_jni::compact_id_map::CompactIdMap::IsIdentity() const {
+    return identity;
+}
+
+int64_t knn_jni::compact_id_map::CompactIdMap::Size() const {
+    return size;
+}
+
+void knn_jni::compact_id_map::CompactIdMap::MapLabels(int64_t* labels, size_t n) const {
+    if (identity) {
+        return;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        labels[i] = Map(labels[i]);
+    }
+}
+
+const std::vector<int32_t>& knn_jni::compact_id_map::CompactIdMap::Ids() const {
+    return ids;
+}
+
+std::vector<int64_t> knn_jni::compact_id_map::CompactIdMap::ToVector() const {
+    std::vector<int64_t> result(size);
+    for (int64_t i = 0; i < size; ++i) {
+        result[i] = Map(i);
+    }
+    return result;
+}
+
+size_t knn_jni::compact_id_map::CompactIdMap::MemoryUsage() const {
+    return ids.capacity() * sizeof(int32_t);
+}
+
+void knn_jni::compact_id_map::CompactIdMap::CompactIfIdentity() {
+    for (int64_t i = 0; i < size; ++i) {
+        if (ids[i] != i) {
+            return;
+        }
+    }
+
+    identity = true;
+    std::vector<int32_t>().swap(ids);
+}
+
+void knn_jni::compact_id_map::WriteCompactIdMap(const CompactIdMap& ids, FILE* file) {
+    uint8_t identity = ids.IsIdentity() ? 1 : 0;
+    int64_t numIds = ids.Size();
+    if (fwrite(&identity, sizeof(identity), 1, file) != 1 || fwrite(&numIds, sizeof(numIds), 1, file) != 1 ||
+        fwrite(ids.Ids().data(), sizeof(int32_t), ids.Ids().size(), file) != ids.Ids().size()) {
+        throw std::runtime_error("Unable to write id map");
+    }
+}
+
+knn_jni::compact_id_map::CompactIdMap knn_jni::compact_id_map::ReadCompactIdMap(FILE* file) {
+    uint8_t identity;
+    int64_t numIds;
+    if (fread(&identity, sizeof(identity), 1, file) != 1 || fread(&numIds, sizeof(numIds), 1, file) != 1) {
+        throw std::runtime_error("Unable to read id map");
+    }
+    if (identity != 0) {
+        return CompactIdMap(numIds);
+    }
+    if (numIds < 0) {
+        throw std::runtime_error("Id map size cannot be negative");
+    }
+
+    std::vector<int32_t> ids(numIds);
+    if (fread(ids.data(), sizeof(int32_t), ids.size(), file) != ids.size()) {
+        throw std::runtime_error("Unable to read id map");
+    }
+    return CompactIdMap(std::move(ids));
+}
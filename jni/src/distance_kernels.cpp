@@ -0,0 +1,264 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+
+#include "distance_kernels.h"
+
+#include <cmath>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <cpuid.h>
+#include <immintrin.h>
+#define KNN_DISTANCE_KERNELS_AVX2
+#endif
+
+
+using knn_jni::distance_kernels::DistanceFunction;
+using knn_jni::distance_kernels::Kernel;
+using knn_jni::distance_kernels::Metric;
+
+namespace {
+    // Kernels are templates over the dimension. DIM is the size the loops are compiled for, or 0 for the generic
+    // kernels, which read it from dim. With DIM set the trip count of the block loop is a constant the compiler
+    // unrolls, and the scalar tail is compiled out, since the specialized sizes are multiples of the block.
+    template <size_t DIM>
+    size_t Size(size_t dim) {
+        return DIM != 0 ? DIM : dim;
+    }
+
+    float Cosine(float dot, float normX, float normY) {
+        if (normX == 0 || normY == 0) {
+            return 0;
+        }
+        return dot / std::sqrt(normX * normY);
+    }
+
+    // Sums are kept in this many independent lanes, so that the compiler can vectorize without reassociating them
+    const size_t LANES = 16;
+
+    float SumLanes(const float* lanes) {
+        float sum = 0;
+        for (size_t j = 0; j < LANES; ++j) {
+            sum += lanes[j];
+        }
+        return sum;
+    }
+
+    template <size_t DIM>
+    float L2Portable(const float* x, const float* y, size_t dim) {
+        const size_t n = Size<DIM>(dim);
+        float lanes[LANES] = {};
+        size_t i = 0;
+        for (; i + LANES <= n; i += LANES) {
+            for (size_t j = 0; j < LANES; ++j) {
+                float diff = x[i + j] - y[i + j];
+                lanes[j] += diff * diff;
+            }
+        }
+        float sum = SumLanes(lanes);
+        for (; DIM == 0 && i < n; ++i) {
+            float diff = x[i] - y[i];
+            sum += diff * diff;
+        }
+        return sum;
+    }
+
+    template <size_t DIM>
+    float InnerProductPortable(const float* x, const float* y, size_t dim) {
+        const size_t n = Size<DIM>(dim);
+        float lanes[LANES] = {};
+        size_t i = 0;
+        for (; i + LANES <= n; i += LANES) {
+            for (size_t j = 0; j < LANES; ++j) {
+                lanes[j] += x[i + j] * y[i + j];
+            }
+        }
+        float sum = SumLanes(lanes);
+        for (; DIM == 0 && i < n; ++i) {
+            sum += x[i] * y[i];
+        }
+        return sum;
+    }
+
+    template <size_t DIM>
+    float CosinePortable(const float* x, const float* y, size_t dim) {
+        const size_t n = Size<DIM>(dim);
+        float dotLanes[LANES] = {};
+        float normXLanes[LANES] = {};
+        float normYLanes[LANES] = {};
+        size_t i = 0;
+        for (; i + LANES <= n; i += LANES) {
+            for (size_t j = 0; j < LANES; ++j) {
+                dotLanes[j] += x[i + j] * y[i + j];
+                normXLanes[j] += x[i + j] * x[i + j];
+                normYLanes[j] += y[i + j] * y[i + j];
+            }
+        }
+        float dot = SumLanes(dotLanes);
+        float normX = SumLanes(normXLanes);
+        float normY = SumLanes(normYLanes);
+        for (; DIM == 0 && i < n; ++i) {
+            dot += x[i] * y[i];
+            normX += x[i] * x[i];
+            normY += y[i] * y[i];
+        }
+        return Cosine(dot, normX, normY);
+    }
+
+#ifdef KNN_DISTANCE_KERNELS_AVX2
+    // AVX2 and FMA are VEX encoded, so the OS also has to save the AVX registers
+    bool HasAvx2Fma() {
+        unsigned int eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+            return false;
+        }
+        const unsigned int fma = 1u << 12, osxsave = 1u << 27, avx = 1u << 28;
+        if ((ecx & (fma | osxsave | avx)) != (fma | osxsave | avx)) {
+            return false;
+        }
+        unsigned int xcr0Low, xcr0High;
+        __asm__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+        if ((xcr0Low & 6u) != 6u) {
+            return false;
+        }
+        const unsigned int avx2 = 1u << 5;
+        return __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & avx2) != 0;
+    }
+
+    const bool HAS_AVX2_FMA = HasAvx2Fma();
+
+    __attribute__((target("avx2,fma")))
+    float SumAvx2(__m256 sum) {
+        __m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+        half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+        half = _mm_add_ss(half, _mm_movehdup_ps(half));
+        return _mm_cvtss_f32(half);
+    }
+
+    // Two accumulators of 8 lanes hide the latency of the fused multiply adds
+    template <size_t DIM>
+    __attribute__((target("avx2,fma")))
+    float L2Avx2(const float* x, const float* y, size_t dim) {
+        const size_t n = Size<DIM>(dim);
+        __m256 sum0 = _mm256_setzero_ps();
+        __m256 sum1 = _mm256_setzero_ps();
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m256 diff0 = _mm256_sub_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i));
+            __m256 diff1 = _mm256_sub_ps(_mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(y + i + 8));
+            sum0 = _mm256_fmadd_ps(diff0, diff0, sum0);
+            sum1 = _mm256_fmadd_ps(diff1, diff1, sum1);
+        }
+        float sum = SumAvx2(_mm256_add_ps(sum0, sum1));
+        for (; DIM == 0 && i < n; ++i) {
+            float diff = x[i] - y[i];
+            sum += diff * diff;
+        }
+        return sum;
+    }
+
+    template <size_t DIM>
+    __attribute__((target("avx2,fma")))
+    float InnerProductAvx2(const float* x, const float* y, size_t dim) {
+        const size_t n = Size<DIM>(dim);
+        __m256 sum0 = _mm256_setzero_ps();
+        __m256 sum1 = _mm256_setzero_ps();
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), sum0);
+            sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(y + i + 8), sum1);
+        }
+        float sum = SumAvx2(_mm256_add_ps(sum0, sum1));
+        for (; DIM == 0 && i < n; ++i) {
+            sum += x[i] * y[i];
+        }
+        return sum;
+    }
+
+    template <size_t DIM>
+    __attribute__((target("avx2,fma")))
+    float CosineAvx2(const float* x, const float* y, size_t dim) {
+        const size_t n = Size<DIM>(dim);
+        __m256 dotSum = _mm256_setzero_ps();
+        __m256 normXSum = _mm256_setzero_ps();
+        __m256 normYSum = _mm256_setzero_ps();
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 xs = _mm256_loadu_ps(x + i);
+            __m256 ys = _mm256_loadu_ps(y + i);
+            dotSum = _mm256_fmadd_ps(xs, ys, dotSum);
+            normXSum = _mm256_fmadd_ps(xs, xs, normXSum);
+            normYSum = _mm256_fmadd_ps(ys, ys, normYSum);
+        }
+        float dot = SumAvx2(dotSum);
+        float normX = SumAvx2(normXSum);
+        float normY = SumAvx2(normYSum);
+        for (; DIM == 0 && i < n; ++i) {
+            dot += x[i] * y[i];
+            normX += x[i] * x[i];
+            normY += y[i] * y[i];
+        }
+        return Cosine(dot, normX, normY);
+    }
+#endif
+
+    template <size_t DIM>
+    DistanceFunction Function(Metric metric) {
+#ifdef KNN_DISTANCE_KERNELS_AVX2
+        if (HAS_AVX2_FMA) {
+            switch (metric) {
+                case Metric::L2:
+                    return &L2Avx2<DIM>;
+                case Metric::INNER_PRODUCT:
+                    return &InnerProductAvx2<DIM>;
+                case Metric::COSINE:
+                    return &CosineAvx2<DIM>;
+            }
+        }
+#endif
+        switch (metric) {
+            case Metric::L2:
+                return &L2Portable<DIM>;
+            case Metric::INNER_PRODUCT:
+                return &InnerProductPortable<DIM>;
+            case Metric::COSINE:
+                return &CosinePortable<DIM>;
+        }
+        return nullptr;
+    }
+
+    template <size_t DIM>
+    Kernel Specialized(Metric metric) {
+        static_assert(DIM % LANES == 0, "Specialized kernels have no tail loop");
+        return Kernel{Function<DIM>(metric), DIM, true};
+    }
+}
+
+Kernel knn_jni::distance_kernels::SelectKernel(Metric metric, size_t dim) {
+    switch (dim) {
+        case 128:
+            return Specialized<128>(metric);
+        case 384:
+            return Specialized<384>(metric);
+        case 768:
+            return Specialized<768>(metric);
+        case 1024:
+            return Specialized<1024>(metric);
+        case 1536:
+            return Specialized<1536>(metric);
+        default:
+            return Kernel{Function<0>(metric), dim, false};
+    }
+}
+
+bool knn_jni::distance_kernels::IsSpecializedDimension(size_t dim) {
+    return SelectKernel(Metric::L2, dim).specialized;
+}
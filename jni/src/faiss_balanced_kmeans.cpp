@@ -0,0 +1,140 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+
+#include "faiss_balanced_kmeans.h"
+
+#include "faiss/IndexFlat.h"
+#include "faiss/IndexIVF.h"
+#include "faiss/IndexPreTransform.h"
+#include "faiss/utils/distances.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+
+
+namespace {
+    // Centroids each vector may be placed in, nearest first. Beyond a handful, a vector would land in a cluster so
+    // far away that it hurts recall more than the even lists help latency
+    const int BALANCE_CANDIDATES = 8;
+}
+
+void knn_jni::faiss_wrapper::TrainBalancedCentroids(faiss::Index::idx_t n, int d, const float* x, int k,
+                                                    faiss::MetricType metric,
+                                                    const faiss::ClusteringParameters& parameters,
+                                                    float maxImbalance, int iterations, float* centroids) {
+    if (metric != faiss::METRIC_L2 && metric != faiss::METRIC_INNER_PRODUCT) {
+        throw std::runtime_error("Balanced clustering only supports the L2 and inner product metrics");
+    }
+    if (n < k) {
+        throw std::runtime_error("Number of training vectors must be at least the number of centroids");
+    }
+
+    faiss::Clustering clustering(d, k, parameters);
+    faiss::IndexFlat assignIndex(d, metric);
+    clustering.train(n, x, assignIndex);
+    std::copy(clustering.centroids.begin(), clustering.centroids.end(), centroids);
+
+    // Room for at least every vector, however tight maxImbalance is
+    auto capacity = (int64_t) std::ceil(maxImbalance * (double) n / k);
+    capacity = std::max(capacity, (int64_t) ((n + k - 1) / k));
+
+    int candidates = std::min(k, BALANCE_CANDIDATES);
+    std::vector<float> distances(n * candidates);
+    std::vector<faiss::Index::idx_t> labels(n * candidates);
+    std::vector<faiss::Index::idx_t> order(n);
+    std::vector<int64_t> sizes(k);
+    std::vector<double> sums((size_t) k * d);
+
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        assignIndex.reset();
+        assignIndex.add(k, centroids);
+        assignIndex.search(n, x, candidates, distances.data(), labels.data());
+
+        std::iota(order.begin(), order.end(), 0);
+        if (candidates > 1) {
+            // Inner product results come largest first, so the gap to the second choice is taken either way round
+            std::sort(order.begin(), order.end(), [&distances, candidates](faiss::Index::idx_t a,
+                                                                           faiss::Index::idx_t b) {
+                return std::fabs(distances[a * candidates + 1] - distances[a * candidates])
+                       > std::fabs(distances[b * candidates + 1] - distances[b * candidates]);
+            });
+        }
+
+        std::fill(sizes.begin(), sizes.end(), 0);
+        std::fill(sums.begin(), sums.end(), 0.0);
+        for (auto i : order) {
+            // Fall back on the least loaded candidate when all of them are full
+            faiss::Index::idx_t chosen = labels[i * candidates];
+            for (int c = 0; c < candidates; ++c) {
+                auto label = labels[i * candidates + c];
+                if (sizes[label] < capacity) {
+                    chosen = label;
+                    break;
+                }
+                if (sizes[label] < sizes[chosen]) {
+                    chosen = label;
+                }
+            }
+
+            sizes[chosen]++;
+            for (int j = 0; j < d; ++j) {
+                sums[chosen * d + j] += x[i * d + j];
+            }
+        }
+
+        // Clusters left empty keep their centroid
+        for (int c = 0; c < k; ++c) {
+            if (sizes[c] == 0) {
+                continue;
+            }
+            for (int j = 0; j < d; ++j) {
+                centroids[(size_t) c * d + j] = (float) (sums[(size_t) c * d + j] / sizes[c]);
+            }
+        }
+        if (parameters.spherical) {
+            faiss::fvec_renorm_L2(d, k, centroids);
+        }
+    }
+}
+
+std::vector<int64_t> knn_jni::faiss_wrapper::AssignedListSizes(const faiss::Index* index, faiss::Index::idx_t n,
+                                                               const float* x) {
+    // apply_chain returns x itself when there is nothing to apply
+    std::unique_ptr<const float[]> transformed;
+    if (auto *indexPreTransform = dynamic_cast<const faiss::IndexPreTransform *>(index)) {
+        const float* xt = indexPreTransform->apply_chain(n, x);
+        if (xt != x) {
+            transformed.reset(xt);
+            x = xt;
+        }
+        index = indexPreTransform->index;
+    }
+
+    auto *indexIvf = dynamic_cast<const faiss::IndexIVF *>(index);
+    if (indexIvf == nullptr) {
+        throw std::runtime_error("Index is not an IVF index");
+    }
+
+    std::vector<faiss::Index::idx_t> lists(n);
+    indexIvf->quantizer->assign(n, x, lists.data());
+
+    std::vector<int64_t> sizes(indexIvf->nlist, 0);
+    for (auto list : lists) {
+        if (list >= 0) {
+            sizes[list]++;
+        }
+    }
+    return sizes;
+}
@@ -0,0 +1,336 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "faiss_calibration.h"
+#include "faiss_compact_id_map_index.h"
+#include "faiss_compressed_hnsw.h"
+#include "faiss_early_termination.h"
+#include "faiss_filtered_search.h"
+#include "ground_truth.h"
+
+#include "faiss/IndexHNSW.h"
+#include "faiss/IndexIVF.h"
+#include "faiss/IndexPreTransform.h"
+#include "faiss/MetaIndexes.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+
+namespace {
+    // Largest efSearch a calibration tries
+    const int64_t MAX_EF_SEARCH = 1024;
+
+    // Queries searched together by an exhaustive search. Bounds the coarse assignment of an IVF index, which has one
+    // entry per list and query
+    const int64_t EXHAUSTIVE_BLOCK_SIZE = 64;
+
+    // The HNSW or IVF index whose search parameter a calibration sweeps; exactly one of them is set
+    struct SearchKnob {
+        const faiss::IndexHNSW * indexHnsw;
+        const faiss::IndexIVF * indexIvf;
+    };
+
+    // Look through the wrappers of index for its HNSW or IVF index
+    SearchKnob FindKnob(const faiss::Index * index) {
+        if (auto *compressedIndex = dynamic_cast<const knn_jni::faiss_wrapper::CompressedHnswIndex *>(index)) {
+            return FindKnob(compressedIndex->GetIndexHnsw());
+        }
+        if (auto *compactIndex = dynamic_cast<const knn_jni::faiss_wrapper::CompactIdMapIndex *>(index)) {
+            return FindKnob(compactIndex->GetIndex());
+        }
+        if (auto *idMap = dynamic_cast<const faiss::IndexIDMap *>(index)) {
+            return FindKnob(idMap->index);
+        }
+        if (auto *indexPreTransform = dynamic_cast<const faiss::IndexPreTransform *>(index)) {
+            return FindKnob(indexPreTransform->index);
+        }
+        if (auto *indexHnsw = dynamic_cast<const faiss::IndexHNSW *>(index)) {
+            return {indexHnsw, nullptr};
+        }
+        if (auto *indexIvf = dynamic_cast<const faiss::IndexIVF *>(index)) {
+            return {nullptr, indexIvf};
+        }
+        throw std::runtime_error("Calibration needs an HNSW or IVF index");
+    }
+
+    // Patience of an HNSW search of width ef from an index with earlyTermination, zero when it is not adaptive
+    size_t Patience(knn_jni::faiss_wrapper::EarlyTermination earlyTermination, int64_t ef, faiss::Index::idx_t k) {
+        if (earlyTermination != knn_jni::faiss_wrapper::EarlyTermination::ADAPTIVE) {
+            return 0;
+        }
+        return knn_jni::faiss_wrapper::AdaptivePatience((size_t) ef, (size_t) k);
+    }
+
+    // Search index like index->search, with value as its efSearch or nprobe. The value is passed down to the search
+    // rather than set on the index, which may be serving queries meanwhile. HNSW graphs are always searched by
+    // SearchHnsw, which is how loaded indices with a specialized kernel or early termination search them anyway;
+    // IVF indices ignore early termination
+    void SearchWithValue(const faiss::Index * index, int64_t value, faiss::Index::idx_t n, const float * x,
+                         faiss::Index::idx_t k, float * distances, faiss::Index::idx_t * labels) {
+        if (auto *compressedIndex = dynamic_cast<const knn_jni::faiss_wrapper::CompressedHnswIndex *>(index)) {
+            const auto& graph = compressedIndex->GetGraph();
+            auto neighbors = [&graph](int32_t node, int layer, std::vector<int32_t>& out) {
+                graph.Neighbors(node, layer, out);
+            };
+            knn_jni::faiss_wrapper::SearchHnsw(*compressedIndex->GetIndexHnsw(), neighbors, nullptr,
+                                               compressedIndex->GetKernel(), n, x, k, distances, labels,
+                                               Patience(compressedIndex->GetEarlyTermination(), value, k),
+                                               (size_t) value);
+            compressedIndex->GetIds().MapLabels(labels, n * k);
+            return;
+        }
+
+        if (auto *compactIndex = dynamic_cast<const knn_jni::faiss_wrapper::CompactIdMapIndex *>(index)) {
+            if (auto *indexHnsw = dynamic_cast<const faiss::IndexHNSW *>(compactIndex->GetIndex())) {
+                knn_jni::faiss_wrapper::SearchHnsw(*indexHnsw, knn_jni::faiss_wrapper::FixedNeighbors(indexHnsw->hnsw),
+                                                   nullptr, compactIndex->GetKernel(), n, x, k, distances, labels,
+                                                   Patience(compactIndex->GetEarlyTermination(), value, k),
+                                                   (size_t) value);
+            } else {
+                SearchWithValue(compactIndex->GetIndex(), value, n, x, k, distances, labels);
+            }
+            compactIndex->GetIds().MapLabels(labels, n * k);
+            return;
+        }
+
+        if (auto *idMap = dynamic_cast<const faiss::IndexIDMap *>(index)) {
+            SearchWithValue(idMap->index, value, n, x, k, distances, labels);
+            for (faiss::Index::idx_t i = 0; i < n * k; ++i) {
+                labels[i] = labels[i] < 0 ? labels[i] : idMap->id_map[labels[i]];
+            }
+            return;
+        }
+
+        if (auto *indexPreTransform = dynamic_cast<const faiss::IndexPreTransform *>(index)) {
+            const float * transformed = indexPreTransform->apply_chain(n, x);
+            std::unique_ptr<const float[]> transformedOwner(transformed == x ? nullptr : transformed);
+            SearchWithValue(indexPreTransform->index, value, n, transformed, k, distances, labels);
+            return;
+        }
+
+        if (auto *indexHnsw = dynamic_cast<const faiss::IndexHNSW *>(index)) {
+            knn_jni::faiss_wrapper::SearchHnsw(*indexHnsw, knn_jni::faiss_wrapper::FixedNeighbors(indexHnsw->hnsw),
+                                               nullptr, knn_jni::faiss_wrapper::SelectFlatKernel(indexHnsw->storage),
+                                               n, x, k, distances, labels, 0, (size_t) value);
+            return;
+        }
+
+        auto *indexIvf = dynamic_cast<const faiss::IndexIVF *>(index);
+        if (indexIvf == nullptr) {
+            throw std::runtime_error("Calibration needs an HNSW or IVF index");
+        }
+
+        // Same as IndexIVF::search, with the number of lists to probe given per call
+        auto nprobe = (faiss::Index::idx_t) std::min<size_t>((size_t) value, indexIvf->nlist);
+        faiss::IVFSearchParameters parameters;
+        parameters.nprobe = (size_t) nprobe;
+        parameters.max_codes = indexIvf->max_codes;
+        std::vector<float> coarseDistances(n * nprobe);
+        std::vector<faiss::Index::idx_t> coarseLabels(n * nprobe);
+        indexIvf->quantizer->search(n, x, nprobe, coarseDistances.data(), coarseLabels.data());
+        indexIvf->search_preassigned(n, x, k, coarseLabels.data(), coarseDistances.data(), distances, labels, false,
+                                     &parameters);
+    }
+
+    // Index under the id mapping of index, whose results are positions, and how positions translate to ids
+    struct PositionIndex {
+        const faiss::Index * index;
+        std::function<int64_t(int64_t)> idOf;
+    };
+
+    PositionIndex Unwrap(const faiss::Index * index) {
+        if (auto *compressedIndex = dynamic_cast<const knn_jni::faiss_wrapper::CompressedHnswIndex *>(index)) {
+            const auto& ids = compressedIndex->GetIds();
+            return {compressedIndex->GetIndexHnsw(), [&ids](int64_t position) { return ids.Map(position); }};
+        }
+        if (auto *compactIndex = dynamic_cast<const knn_jni::faiss_wrapper::CompactIdMapIndex *>(index)) {
+            const auto& ids = compactIndex->GetIds();
+            return {compactIndex->GetIndex(), [&ids](int64_t position) { return ids.Map(position); }};
+        }
+        if (auto *idMap = dynamic_cast<const faiss::IndexIDMap *>(index)) {
+            const auto& ids = idMap->id_map;
+            return {idMap->index, [&ids](int64_t position) { return position < 0 ? position : ids[position]; }};
+        }
+        return {index, [](int64_t position) { return position; }};
+    }
+
+    // Search every vector of index: the storage of an HNSW index, or all lists of an IVF index
+    void ExhaustiveSearch(const faiss::Index * index, faiss::Index::idx_t n, const float * x, faiss::Index::idx_t k,
+                          float * distances, faiss::Index::idx_t * labels) {
+        if (auto *indexPreTransform = dynamic_cast<const faiss::IndexPreTransform *>(index)) {
+            const float * transformed = indexPreTransform->apply_chain(n, x);
+            std::unique_ptr<const float[]> transformedOwner(transformed == x ? nullptr : transformed);
+            ExhaustiveSearch(indexPreTransform->index, n, transformed, k, distances, labels);
+            return;
+        }
+
+        if (auto *indexHnsw = dynamic_cast<const faiss::IndexHNSW *>(index)) {
+            indexHnsw->storage->search(n, x, k, distances, labels);
+            return;
+        }
+
+        auto *indexIvf = dynamic_cast<const faiss::IndexIVF *>(index);
+        if (indexIvf == nullptr) {
+            index->search(n, x, k, distances, labels);
+            return;
+        }
+
+        auto nlist = (faiss::Index::idx_t) indexIvf->nlist;
+        faiss::IVFSearchParameters parameters;
+        parameters.nprobe = indexIvf->nlist;
+        parameters.max_codes = 0;
+        std::vector<float> coarseDistances;
+        std::vector<faiss::Index::idx_t> coarseLabels;
+        for (faiss::Index::idx_t begin = 0; begin < n; begin += EXHAUSTIVE_BLOCK_SIZE) {
+            faiss::Index::idx_t blockSize = std::min(EXHAUSTIVE_BLOCK_SIZE, n - begin);
+            coarseDistances.resize(blockSize * nlist);
+            coarseLabels.resize(blockSize * nlist);
+            const float * block = x + begin * indexIvf->d;
+            indexIvf->quantizer->search(blockSize, block, nlist, coarseDistances.data(), coarseLabels.data());
+            indexIvf->search_preassigned(blockSize, block, k, coarseLabels.data(), coarseDistances.data(),
+                                         distances + begin * k, labels + begin * k, false, &parameters);
+        }
+    }
+}
+
+std::vector<int64_t> knn_jni::faiss_wrapper::SweepValues(const faiss::Index * index, int k) {
+    if (k <= 0) {
+        throw std::runtime_error("k must be positive");
+    }
+
+    SearchKnob knob = FindKnob(index);
+    std::vector<int64_t> values;
+    if (knob.indexHnsw != nullptr) {
+        for (int64_t ef = k; ef <= std::max<int64_t>(MAX_EF_SEARCH, k); ef *= 2) {
+            values.push_back(ef);
+        }
+        return values;
+    }
+
+    auto nlist = (int64_t) knob.indexIvf->nlist;
+    for (int64_t nprobe = 1; nprobe < nlist; nprobe *= 2) {
+        values.push_back(nprobe);
+    }
+    values.push_back(nlist);
+    return values;
+}
+
+std::vector<knn_jni::faiss_wrapper::CalibrationPoint> knn_jni::faiss_wrapper::ParetoFrontier(
+        const std::vector<CalibrationPoint>& points) {
+    // Fastest first; a point is on the frontier when it is more accurate than every faster one
+    std::vector<CalibrationPoint> sorted(points);
+    std::sort(sorted.begin(), sorted.end(), [](const CalibrationPoint& a, const CalibrationPoint& b) {
+        if (a.latencyMicros != b.latencyMicros) {
+            return a.latencyMicros < b.latencyMicros;
+        }
+        if (a.recall != b.recall) {
+            return a.recall > b.recall;
+        }
+        return a.value < b.value;
+    });
+
+    std::vector<CalibrationPoint> frontier;
+    for (const auto& point : sorted) {
+        if (frontier.empty() || point.recall > frontier.back().recall) {
+            frontier.push_back(point);
+        }
+    }
+    std::sort(frontier.begin(), frontier.end(), [](const CalibrationPoint& a, const CalibrationPoint& b) {
+        return a.value < b.value;
+    });
+    return frontier;
+}
+
+size_t knn_jni::faiss_wrapper::RecommendedPoint(const std::vector<CalibrationPoint>& frontier, double targetRecall) {
+    if (frontier.empty()) {
+        throw std::runtime_error("Frontier cannot be empty");
+    }
+
+    size_t fastest = frontier.size();
+    size_t mostAccurate = 0;
+    for (size_t i = 0; i < frontier.size(); ++i) {
+        if (frontier[i].recall >= targetRecall &&
+            (fastest == frontier.size() || frontier[i].latencyMicros < frontier[fastest].latencyMicros)) {
+            fastest = i;
+        }
+        if (frontier[i].recall > frontier[mostAccurate].recall) {
+            mostAccurate = i;
+        }
+    }
+    return fastest == frontier.size() ? mostAccurate : fastest;
+}
+
+knn_jni::vecs_io::Matrix<int32_t> knn_jni::faiss_wrapper::ExhaustiveNeighbors(const faiss::Index * index,
+                                                                             const float * queries,
+                                                                             int64_t numQueries, int k) {
+    if (k <= 0) {
+        throw std::runtime_error("k must be positive");
+    }
+
+    PositionIndex target = Unwrap(index);
+    std::vector<float> distances(numQueries * k);
+    std::vector<faiss::Index::idx_t> labels(numQueries * k);
+    ExhaustiveSearch(target.index, numQueries, queries, k, distances.data(), labels.data());
+
+    knn_jni::vecs_io::Matrix<int32_t> neighbors(numQueries, k);
+    for (size_t i = 0; i < labels.size(); ++i) {
+        neighbors.data[i] = (int32_t) target.idOf(labels[i]);
+    }
+    return neighbors;
+}
+
+knn_jni::faiss_wrapper::Calibration knn_jni::faiss_wrapper::Calibrate(
+        const faiss::Index * index, const float * queries, int64_t numQueries, int k, double targetRecall,
+        const knn_jni::vecs_io::Matrix<int32_t>& groundTruth) {
+    if (numQueries <= 0) {
+        throw std::runtime_error("Calibration needs at least one query");
+    }
+
+    if (groundTruth.rows != numQueries || groundTruth.cols < k) {
+        throw std::runtime_error("Ground truth does not match the queries");
+    }
+
+    std::vector<int64_t> values = SweepValues(index, k);
+
+    // Queries are searched one at a time, as QueryIndex searches them, so that latencies compare to production
+    auto searchAll = [&](int64_t value, knn_jni::vecs_io::Matrix<int32_t>& results) {
+        std::vector<float> distances(k);
+        std::vector<faiss::Index::idx_t> labels(k);
+        for (int64_t q = 0; q < numQueries; ++q) {
+            SearchWithValue(index, value, 1, queries + q * index->d, k, distances.data(), labels.data());
+            std::copy(labels.begin(), labels.end(), results.Row(q));
+        }
+    };
+
+    std::vector<CalibrationPoint> points;
+    knn_jni::vecs_io::Matrix<int32_t> results(numQueries, k);
+
+    // An untimed pass pages the index in, so the first value is not charged for it
+    searchAll(values.front(), results);
+
+    for (int64_t value : values) {
+        auto start = std::chrono::steady_clock::now();
+        searchAll(value, results);
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        double recall = knn_jni::ground_truth::RecallAtR(results, groundTruth, k, k);
+        points.push_back({value, recall, elapsed.count() / (double) numQueries});
+    }
+
+    Calibration calibration;
+    calibration.frontier = ParetoFrontier(points);
+    calibration.recommended = RecommendedPoint(calibration.frontier, targetRecall);
+    return calibration;
+}
@@ -0,0 +1,107 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "faiss_compact_id_map_index.h"
+#include "faiss_filtered_search.h"
+
+#include "faiss/IndexFlat.h"
+#include "faiss/IndexHNSW.h"
+#include "faiss/utils/distances.h"
+
+#include <stdexcept>
+#include <utility>
+
+
+namespace {
+    // Kernel for the vectors of index, looking through an IndexHNSW to its storage
+    knn_jni::distance_kernels::Kernel SelectWrappedKernel(const faiss::Index* index) {
+        if (auto *indexHnsw = dynamic_cast<const faiss::IndexHNSW *>(index)) {
+            return knn_jni::faiss_wrapper::SelectFlatKernel(indexHnsw->storage);
+        }
+        return knn_jni::faiss_wrapper::SelectFlatKernel(index);
+    }
+}
+
+knn_jni::faiss_wrapper::CompactIdMapIndex::CompactIdMapIndex(faiss::Index * index,
+                                                             knn_jni::compact_id_map::CompactIdMap ids,
+                                                             bool ownFields)
+        : faiss::Index(index->d, index->metric_type), index(index), ids(std::move(ids)), ownFields(ownFields),
+          kernel(SelectWrappedKernel(index)), earlyTermination(EarlyTermination::NONE) {
+    if (this->ids.Size() != index->ntotal) {
+        throw std::runtime_error("Number of ids does not match the number of vectors in the index");
+    }
+
+    ntotal = index->ntotal;
+    is_trained = index->is_trained;
+}
+
+knn_jni::faiss_wrapper::CompactIdMapIndex::~CompactIdMapIndex() {
+    if (ownFields) {
+        delete index;
+    }
+}
+
+void knn_jni::faiss_wrapper::CompactIdMapIndex::add(idx_t n, const float* x) {
+    throw std::runtime_error("Compact id map index is read only");
+}
+
+void knn_jni::faiss_wrapper::CompactIdMapIndex::reset() {
+    throw std::runtime_error("Compact id map index is read only");
+}
+
+void knn_jni::faiss_wrapper::CompactIdMapIndex::search(idx_t n, const float* x, idx_t k, float* distances,
+                                                       idx_t* labels) const {
+    // Only specialized kernels beat faiss; generic dimensions and large batches, which faiss hands to BLAS, stay with
+    // it. Adaptive searches always run here, as faiss cannot stop them early
+    auto *indexHnsw = dynamic_cast<const faiss::IndexHNSW *>(index);
+    auto *indexFlat = dynamic_cast<const faiss::IndexFlat *>(index);
+    if (earlyTermination == EarlyTermination::ADAPTIVE && indexHnsw != nullptr) {
+        SearchHnsw(*indexHnsw, FixedNeighbors(indexHnsw->hnsw), nullptr, kernel, n, x, k, distances, labels,
+                   AdaptivePatience(indexHnsw->hnsw.efSearch, k));
+    } else if (earlyTermination == EarlyTermination::ADAPTIVE && indexFlat == nullptr) {
+        SearchIvfAdaptive(index, n, x, k, distances, labels);
+    } else if (kernel.specialized && indexHnsw != nullptr) {
+        SearchHnsw(*indexHnsw, FixedNeighbors(indexHnsw->hnsw), nullptr, kernel, n, x, k, distances, labels);
+    } else if (kernel.specialized && indexFlat != nullptr && n < faiss::distance_compute_blas_threshold) {
+        SearchFlat(*indexFlat, kernel, nullptr, n, x, k, distances, labels);
+    } else {
+        index->search(n, x, k, distances, labels);
+    }
+    ids.MapLabels(labels, n * k);
+}
+
+faiss::Index * knn_jni::faiss_wrapper::CompactIdMapIndex::GetIndex() const {
+    return index;
+}
+
+const knn_jni::compact_id_map::CompactIdMap& knn_jni::faiss_wrapper::CompactIdMapIndex::GetIds() const {
+    return ids;
+}
+
+const knn_jni::distance_kernels::Kernel& knn_jni::faiss_wrapper::CompactIdMapIndex::GetKernel() const {
+    return kernel;
+}
+
+void knn_jni::faiss_wrapper::CompactIdMapIndex::SetEarlyTermination(EarlyTermination earlyTermination) {
+    this->earlyTermination = earlyTermination;
+}
+
+knn_jni::faiss_wrapper::EarlyTermination knn_jni::faiss_wrapper::CompactIdMapIndex::GetEarlyTermination() const {
+    return earlyTermination;
+}
+
+knn_jni::faiss_wrapper::CompactIdMapIndex * knn_jni::faiss_wrapper::CompactIds(faiss::IndexIDMap * idMap) {
+    knn_jni::compact_id_map::CompactIdMap ids(idMap->id_map);
+    auto * compactIndex = new CompactIdMapIndex(idMap->index, std::move(ids), idMap->own_fields);
+    idMap->own_fields = false;
+    delete idMap;
+    return compactIndex;
+}
@@ -0,0 +1,224 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "faiss_compressed_hnsw.h"
+#include "faiss_compact_id_map_index.h"
+#include "faiss_filtered_search.h"
+
+#include "faiss/index_io.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace {
+    // Files written by WriteCompressedHnswIndex start with this marker, which a faiss index file never does: those
+    // start with a 4 character index type code
+    const char COMPRESSED_HNSW_MAGIC[8] = {'K', 'N', 'N', 'C', 'H', 'N', 'S', 'W'};
+    const uint32_t COMPRESSED_HNSW_VERSION = 1;
+
+    using FilePointer = std::unique_ptr<FILE, int(*)(FILE*)>;
+
+    void WriteOrThrow(const void* ptr, size_t size, size_t count, FILE* file) {
+        if (count > 0 && fwrite(ptr, size, count, file) != count) {
+            throw std::runtime_error("Unable to write compressed HNSW index");
+        }
+    }
+
+    void ReadOrThrow(void* ptr, size_t size, size_t count, FILE* file) {
+        if (count > 0 && fread(ptr, size, count, file) != count) {
+            throw std::runtime_error("Unable to read compressed HNSW index");
+        }
+    }
+
+    knn_jni::adjacency_codec::CompressedGraph CompressHnswGraph(const faiss::HNSW& hnsw, faiss::Index::idx_t numNodes) {
+        knn_jni::adjacency_codec::CompressedGraph graph;
+        std::vector<std::vector<int32_t>> layers;
+        for (faiss::Index::idx_t i = 0; i < numNodes; ++i) {
+            layers.resize(hnsw.levels[i]);
+            for (int layer = 0; layer < hnsw.levels[i]; ++layer) {
+                size_t begin, end;
+                hnsw.neighbor_range(i, layer, &begin, &end);
+                layers[layer].assign(hnsw.neighbors.begin() + begin, hnsw.neighbors.begin() + end);
+            }
+            graph.AppendNode(layers);
+        }
+        return graph;
+    }
+}
+
+knn_jni::faiss_wrapper::CompressedHnswIndex::CompressedHnswIndex(faiss::IndexHNSW * indexHnsw,
+                                                                 knn_jni::compact_id_map::CompactIdMap ids,
+                                                                 bool ownFields)
+        : faiss::Index(indexHnsw->d, indexHnsw->metric_type), indexHnsw(indexHnsw), ids(std::move(ids)),
+          ownFields(ownFields), kernel(SelectFlatKernel(indexHnsw->storage)),
+          earlyTermination(EarlyTermination::NONE) {
+    if (this->ids.Size() != indexHnsw->ntotal) {
+        throw std::runtime_error("Number of ids does not match the number of vectors in the index");
+    }
+
+    graph = CompressHnswGraph(indexHnsw->hnsw, indexHnsw->ntotal);
+    std::vector<faiss::HNSW::storage_idx_t>().swap(indexHnsw->hnsw.neighbors);
+    std::vector<size_t>().swap(indexHnsw->hnsw.offsets);
+
+    ntotal = indexHnsw->ntotal;
+    is_trained = true;
+}
+
+knn_jni::faiss_wrapper::CompressedHnswIndex::CompressedHnswIndex(faiss::IndexHNSW * indexHnsw,
+                                                                 knn_jni::compact_id_map::CompactIdMap ids,
+                                                                 knn_jni::adjacency_codec::CompressedGraph graph,
+                                                                 bool ownFields)
+        : faiss::Index(indexHnsw->d, indexHnsw->metric_type), indexHnsw(indexHnsw), ids(std::move(ids)),
+          graph(std::move(graph)), ownFields(ownFields), kernel(SelectFlatKernel(indexHnsw->storage)),
+          earlyTermination(EarlyTermination::NONE) {
+    if (this->ids.Size() != indexHnsw->ntotal || this->graph.NumNodes() != indexHnsw->ntotal) {
+        throw std::runtime_error("Compressed graph does not match the index");
+    }
+
+    ntotal = indexHnsw->ntotal;
+    is_trained = true;
+}
+
+knn_jni::faiss_wrapper::CompressedHnswIndex::~CompressedHnswIndex() {
+    if (ownFields) {
+        delete indexHnsw;
+    }
+}
+
+void knn_jni::faiss_wrapper::CompressedHnswIndex::add(idx_t n, const float* x) {
+    throw std::runtime_error("Compressed HNSW index is read only");
+}
+
+void knn_jni::faiss_wrapper::CompressedHnswIndex::reset() {
+    throw std::runtime_error("Compressed HNSW index is read only");
+}
+
+void knn_jni::faiss_wrapper::CompressedHnswIndex::search(idx_t n, const float* x, idx_t k, float* distances,
+                                                         idx_t* labels) const {
+    auto neighbors = [this](int32_t node, int layer, std::vector<int32_t>& out) {
+        graph.Neighbors(node, layer, out);
+    };
+    size_t patience = 0;
+    if (earlyTermination == EarlyTermination::ADAPTIVE) {
+        patience = AdaptivePatience(indexHnsw->hnsw.efSearch, k);
+    }
+    SearchHnsw(*indexHnsw, neighbors, nullptr, kernel, n, x, k, distances, labels, patience);
+    ids.MapLabels(labels, n * k);
+}
+
+faiss::IndexHNSW * knn_jni::faiss_wrapper::CompressedHnswIndex::GetIndexHnsw() const {
+    return indexHnsw;
+}
+
+const knn_jni::compact_id_map::CompactIdMap& knn_jni::faiss_wrapper::CompressedHnswIndex::GetIds() const {
+    return ids;
+}
+
+const knn_jni::adjacency_codec::CompressedGraph& knn_jni::faiss_wrapper::CompressedHnswIndex::GetGraph() const {
+    return graph;
+}
+
+const knn_jni::distance_kernels::Kernel& knn_jni::faiss_wrapper::CompressedHnswIndex::GetKernel() const {
+    return kernel;
+}
+
+void knn_jni::faiss_wrapper::CompressedHnswIndex::SetEarlyTermination(EarlyTermination earlyTermination) {
+    this->earlyTermination = earlyTermination;
+}
+
+knn_jni::faiss_wrapper::EarlyTermination knn_jni::faiss_wrapper::CompressedHnswIndex::GetEarlyTermination() const {
+    return earlyTermination;
+}
+
+void knn_jni::faiss_wrapper::WriteCompressedHnswIndex(const CompressedHnswIndex& index, const std::string& path) {
+    FilePointer file(fopen(path.c_str(), "wb"), &fclose);
+    if (file == nullptr) {
+        throw std::runtime_error("Unable to open " + path + " for writing");
+    }
+
+    WriteOrThrow(COMPRESSED_HNSW_MAGIC, 1, sizeof(COMPRESSED_HNSW_MAGIC), file.get());
+    WriteOrThrow(&COMPRESSED_HNSW_VERSION, sizeof(COMPRESSED_HNSW_VERSION), 1, file.get());
+    faiss::write_index(index.GetIndexHnsw(), file.get());
+
+    knn_jni::compact_id_map::WriteCompactIdMap(index.GetIds(), file.get());
+
+    const auto& offsets = index.GetGraph().Offsets();
+    uint64_t numOffsets = offsets.size();
+    WriteOrThrow(&numOffsets, sizeof(numOffsets), 1, file.get());
+    WriteOrThrow(offsets.data(), sizeof(uint64_t), offsets.size(), file.get());
+
+    const auto& data = index.GetGraph().Data();
+    uint64_t dataSize = data.size();
+    WriteOrThrow(&dataSize, sizeof(dataSize), 1, file.get());
+    WriteOrThrow(data.data(), 1, data.size(), file.get());
+
+    if (fclose(file.release()) != 0) {
+        throw std::runtime_error("Unable to write compressed HNSW index");
+    }
+}
+
+faiss::Index * knn_jni::faiss_wrapper::ReadIndex(const std::string& path, int ioFlags) {
+    FilePointer file(fopen(path.c_str(), "rb"), &fclose);
+    char magic[sizeof(COMPRESSED_HNSW_MAGIC)] = {};
+    if (file != nullptr && fread(magic, 1, sizeof(magic), file.get()) != sizeof(magic)) {
+        std::fill(magic, magic + sizeof(magic), 0);
+    }
+
+    if (memcmp(magic, COMPRESSED_HNSW_MAGIC, sizeof(magic)) != 0) {
+        // Written by faiss
+        file.reset();
+        std::unique_ptr<faiss::Index> index(faiss::read_index(path.c_str(), ioFlags));
+        CompactIdMapIndex * compactIndex;
+        if (auto * idMap = dynamic_cast<faiss::IndexIDMap*>(index.get())) {
+            compactIndex = CompactIds(idMap);
+        } else {
+            compactIndex = new CompactIdMapIndex(index.get(), knn_jni::compact_id_map::CompactIdMap(index->ntotal),
+                                                 true);
+        }
+        index.release();
+        return compactIndex;
+    }
+
+    uint32_t version;
+    ReadOrThrow(&version, sizeof(version), 1, file.get());
+    if (version != COMPRESSED_HNSW_VERSION) {
+        throw std::runtime_error("Unsupported compressed HNSW index version " + std::to_string(version));
+    }
+
+    std::unique_ptr<faiss::Index> index(faiss::read_index(file.get(), ioFlags));
+    auto * indexHnsw = dynamic_cast<faiss::IndexHNSW*>(index.get());
+    if (indexHnsw == nullptr) {
+        throw std::runtime_error("Compressed HNSW index does not hold an HNSW index");
+    }
+
+    auto ids = knn_jni::compact_id_map::ReadCompactIdMap(file.get());
+
+    uint64_t numOffsets;
+    ReadOrThrow(&numOffsets, sizeof(numOffsets), 1, file.get());
+    std::vector<uint64_t> offsets(numOffsets);
+    ReadOrThrow(offsets.data(), sizeof(uint64_t), offsets.size(), file.get());
+
+    uint64_t dataSize;
+    ReadOrThrow(&dataSize, sizeof(dataSize), 1, file.get());
+    std::vector<uint8_t> data(dataSize);
+    ReadOrThrow(data.data(), 1, data.size(), file.get());
+
+    knn_jni::adjacency_codec::CompressedGraph graph(std::move(offsets), std::move(data));
+    auto * compressedIndex = new CompressedHnswIndex(indexHnsw, std::move(ids), std::move(graph), true);
+    index.release();
+    return compressedIndex;
+}
@@ -0,0 +1,206 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "faiss_description.h"
+#include "faiss_compact_id_map_index.h"
+#include "faiss_compressed_hnsw.h"
+#include "faiss_filtered_search.h"
+#include "index_description.h"
+#include "jni_util.h"
+
+#include "faiss/IndexFlatCodes.h"
+#include "faiss/IndexHNSW.h"
+#include "faiss/IndexIVF.h"
+#include "faiss/IndexPreTransform.h"
+#include "faiss/MetaIndexes.h"
+#include "faiss/VectorTransform.h"
+#include "faiss/invlists/InvertedLists.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace {
+    // Bytes held by each part of an index
+    struct Memory {
+        int64_t ids = 0;
+        int64_t vectors = 0;
+        int64_t graph = 0;
+        int64_t quantizer = 0;
+        int64_t transforms = 0;
+
+        int64_t Total() const {
+            return ids + vectors + graph + quantizer + transforms;
+        }
+    };
+
+    // What a walk down the wrappers of an index found
+    struct Walk {
+        Memory memory;
+        const faiss::IndexHNSW * indexHnsw = nullptr;
+        knn_jni::faiss_wrapper::NeighborFetcher neighbors;
+        std::string graphEncoding;
+        const faiss::IndexIVF * indexIvf = nullptr;
+    };
+
+    void Visit(const faiss::Index * index, Walk& walk) {
+        if (auto *compressedIndex = dynamic_cast<const knn_jni::faiss_wrapper::CompressedHnswIndex *>(index)) {
+            const auto& graph = compressedIndex->GetGraph();
+            walk.memory.ids += (int64_t) compressedIndex->GetIds().MemoryUsage();
+            walk.memory.graph += (int64_t) graph.MemoryUsage();
+            walk.indexHnsw = compressedIndex->GetIndexHnsw();
+            walk.neighbors = [&graph](int32_t node, int layer, std::vector<int32_t>& out) {
+                graph.Neighbors(node, layer, out);
+            };
+            walk.graphEncoding = "delta";
+            Visit(compressedIndex->GetIndexHnsw(), walk);
+            return;
+        }
+
+        if (auto *compactIndex = dynamic_cast<const knn_jni::faiss_wrapper::CompactIdMapIndex *>(index)) {
+            walk.memory.ids += (int64_t) compactIndex->GetIds().MemoryUsage();
+            Visit(compactIndex->GetIndex(), walk);
+            return;
+        }
+
+        if (auto *idMap = dynamic_cast<const faiss::IndexIDMap *>(index)) {
+            walk.memory.ids += (int64_t) (idMap->id_map.size() * sizeof(faiss::Index::idx_t));
+            Visit(idMap->index, walk);
+            return;
+        }
+
+        if (auto *indexPreTransform = dynamic_cast<const faiss::IndexPreTransform *>(index)) {
+            for (const faiss::VectorTransform * transform : indexPreTransform->chain) {
+                if (auto *linearTransform = dynamic_cast<const faiss::LinearTransform *>(transform)) {
+                    walk.memory.transforms += (int64_t) ((linearTransform->A.size() + linearTransform->b.size()) *
+                                                         sizeof(float));
+                }
+            }
+            Visit(indexPreTransform->index, walk);
+            return;
+        }
+
+        if (auto *indexHnsw = dynamic_cast<const faiss::IndexHNSW *>(index)) {
+            // A compressed graph already set its own fetcher and left only the levels in place
+            const faiss::HNSW& hnsw = indexHnsw->hnsw;
+            if (walk.indexHnsw == nullptr) {
+                walk.indexHnsw = indexHnsw;
+                walk.neighbors = knn_jni::faiss_wrapper::FixedNeighbors(hnsw);
+                walk.graphEncoding = "fixed";
+            }
+            walk.memory.graph += (int64_t) (hnsw.neighbors.size() * sizeof(faiss::HNSW::storage_idx_t) +
+                                            hnsw.offsets.size() * sizeof(size_t) + hnsw.levels.size() * sizeof(int));
+            Visit(indexHnsw->storage, walk);
+            return;
+        }
+
+        if (auto *indexIvf = dynamic_cast<const faiss::IndexIVF *>(index)) {
+            walk.indexIvf = indexIvf;
+            Walk quantizerWalk;
+            Visit(indexIvf->quantizer, quantizerWalk);
+            walk.memory.quantizer += quantizerWalk.memory.Total();
+
+            // Each list entry holds a code and a 64 bit id
+            int64_t listed = 0;
+            for (size_t list = 0; list < indexIvf->nlist; ++list) {
+                listed += (int64_t) indexIvf->invlists->list_size(list);
+            }
+            walk.memory.vectors += listed * (int64_t) indexIvf->code_size;
+            walk.memory.ids += listed * (int64_t) sizeof(faiss::Index::idx_t);
+            return;
+        }
+
+        if (auto *indexFlatCodes = dynamic_cast<const faiss::IndexFlatCodes *>(index)) {
+            walk.memory.vectors += (int64_t) indexFlatCodes->codes.size();
+            return;
+        }
+
+        // Any other index counts as its standalone codes, when it has a standalone codec
+        try {
+            walk.memory.vectors += index->ntotal * (int64_t) index->sa_code_size();
+        } catch (...) {
+        }
+    }
+
+    std::string MetricName(faiss::MetricType metric) {
+        switch (metric) {
+            case faiss::METRIC_L2:
+                return knn_jni::L2;
+            case faiss::METRIC_INNER_PRODUCT:
+                return knn_jni::INNER_PRODUCT;
+            case faiss::METRIC_L1:
+                return knn_jni::L1;
+            case faiss::METRIC_Linf:
+                return knn_jni::LINF;
+            default:
+                return "metric_" + std::to_string((int) metric);
+        }
+    }
+}
+
+std::string knn_jni::faiss_wrapper::Describe(const faiss::Index * index) {
+    if (index == nullptr) {
+        throw std::runtime_error("Index cannot be null");
+    }
+
+    Walk walk;
+    Visit(index, walk);
+
+    knn_jni::index_description::JsonWriter writer;
+    writer.String("engine", knn_jni::FAISS_NAME);
+    writer.Number("count", (int64_t) index->ntotal);
+    writer.Number("dimension", (int64_t) index->d);
+    writer.String("metric", MetricName(index->metric_type));
+
+    writer.BeginObject("memory");
+    writer.Number("ids", walk.memory.ids);
+    writer.Number("vectors", walk.memory.vectors);
+    writer.Number("graph", walk.memory.graph);
+    writer.Number("quantizer", walk.memory.quantizer);
+    writer.Number("transforms", walk.memory.transforms);
+    writer.Number("total", walk.memory.Total());
+    writer.EndObject();
+
+    if (walk.indexHnsw != nullptr) {
+        const faiss::HNSW& hnsw = walk.indexHnsw->hnsw;
+        auto numNodes = (int32_t) walk.indexHnsw->ntotal;
+        std::vector<int> topLayers(numNodes);
+        for (int32_t node = 0; node < numNodes; ++node) {
+            topLayers[node] = hnsw.levels[node] - 1;
+        }
+
+        writer.BeginObject("hnsw");
+        writer.Number("entry_point", (int64_t) hnsw.entry_point);
+        writer.Number("max_level", (int64_t) hnsw.max_level);
+        writer.Number("ef_search", (int64_t) hnsw.efSearch);
+        writer.String("graph_encoding", walk.graphEncoding);
+        writer.Graph(knn_jni::index_description::SummarizeGraph(numNodes, topLayers, hnsw.entry_point,
+                                                                walk.neighbors));
+        writer.EndObject();
+    }
+
+    if (walk.indexIvf != nullptr) {
+        std::vector<int64_t> sizes(walk.indexIvf->nlist);
+        for (size_t list = 0; list < walk.indexIvf->nlist; ++list) {
+            sizes[list] = (int64_t) walk.indexIvf->invlists->list_size(list);
+        }
+
+        writer.BeginObject("ivf");
+        writer.Number("nprobe", (int64_t) walk.indexIvf->nprobe);
+        writer.BeginObject("list_sizes");
+        writer.Lists(knn_jni::index_description::SummarizeLists(sizes));
+        writer.EndObject();
+        writer.EndObject();
+    }
+
+    return writer.Finish();
+}
@@ -0,0 +1,110 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "faiss_early_termination.h"
+#include "jni_util.h"
+
+#include "faiss/IndexFlat.h"
+#include "faiss/IndexIVF.h"
+#include "faiss/IndexPreTransform.h"
+#include "faiss/invlists/InvertedLists.h"
+#include "faiss/utils/distances.h"
+#include "faiss/utils/Heap.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+
+namespace {
+    void SearchIvfSkippingLists(const faiss::IndexIVF& indexIvf, const faiss::IndexFlat& quantizer,
+                                faiss::Index::idx_t n, const float* x, faiss::Index::idx_t k, float* distances,
+                                faiss::Index::idx_t* labels) {
+        auto nprobe = (faiss::Index::idx_t) std::min<size_t>(indexIvf.nprobe, indexIvf.nlist);
+        std::vector<float> coarseDistances(n * nprobe);
+        std::vector<faiss::Index::idx_t> coarseLabels(n * nprobe);
+        quantizer.search(n, x, nprobe, coarseDistances.data(), coarseLabels.data());
+
+        std::unique_ptr<faiss::InvertedListScanner> scanner(indexIvf.get_InvertedListScanner(false));
+        const float* centroids = quantizer.get_xb();
+        size_t d = indexIvf.d;
+        for (faiss::Index::idx_t q = 0; q < n; ++q) {
+            float* queryDistances = distances + q * k;
+            faiss::Index::idx_t* queryLabels = labels + q * k;
+            const float* probeDistances = coarseDistances.data() + q * nprobe;
+            const faiss::Index::idx_t* probeLists = coarseLabels.data() + q * nprobe;
+            faiss::maxheap_heapify(k, queryDistances, queryLabels);
+            scanner->set_query(x + q * d);
+
+            for (faiss::Index::idx_t p = 0; p < nprobe && probeLists[p] >= 0; ++p) {
+                faiss::Index::idx_t list = probeLists[p];
+                size_t listSize = indexIvf.invlists->list_size(list);
+                if (listSize == 0) {
+                    continue;
+                }
+
+                // Squared distance from the query to the bisector of this centroid and the nearest one. Until k
+                // results are found, the k-th distance is the largest float and nothing is skipped
+                if (p > 0) {
+                    float gap = probeDistances[p] - probeDistances[0];
+                    float centroidDistance = faiss::fvec_L2sqr(centroids + list * d, centroids + probeLists[0] * d, d);
+                    if (centroidDistance > 0 && gap * gap / (4 * centroidDistance) > queryDistances[0]) {
+                        continue;
+                    }
+                }
+
+                scanner->set_list(list, probeDistances[p]);
+                faiss::InvertedLists::ScopedCodes codes(indexIvf.invlists, list);
+                faiss::InvertedLists::ScopedIds ids(indexIvf.invlists, list);
+                scanner->scan_codes(listSize, codes.get(), ids.get(), queryDistances, queryLabels, k);
+            }
+            faiss::maxheap_reorder(k, queryDistances, queryLabels);
+        }
+    }
+}
+
+knn_jni::faiss_wrapper::EarlyTermination knn_jni::faiss_wrapper::ParseEarlyTermination(const std::string& name) {
+    if (name == knn_jni::EARLY_TERMINATION_NONE) {
+        return EarlyTermination::NONE;
+    }
+
+    if (name == knn_jni::EARLY_TERMINATION_ADAPTIVE) {
+        return EarlyTermination::ADAPTIVE;
+    }
+
+    throw std::runtime_error("Invalid early termination \"" + name + "\"");
+}
+
+size_t knn_jni::faiss_wrapper::AdaptivePatience(size_t ef, size_t k) {
+    return std::max(ef / 4, k);
+}
+
+void knn_jni::faiss_wrapper::SearchIvfAdaptive(const faiss::Index* index, faiss::Index::idx_t n, const float* x,
+                                               faiss::Index::idx_t k, float* distances,
+                                               faiss::Index::idx_t* labels) {
+    if (auto *indexPreTransform = dynamic_cast<const faiss::IndexPreTransform *>(index)) {
+        const float* transformed = indexPreTransform->apply_chain(n, x);
+        std::unique_ptr<const float[]> transformedOwner(transformed == x ? nullptr : transformed);
+        SearchIvfAdaptive(indexPreTransform->index, n, transformed, k, distances, labels);
+        return;
+    }
+
+    // The bisector bound only holds for L2, with centroids at hand
+    auto *indexIvf = dynamic_cast<const faiss::IndexIVF *>(index);
+    auto *quantizer = indexIvf == nullptr ? nullptr : dynamic_cast<const faiss::IndexFlat *>(indexIvf->quantizer);
+    if (quantizer == nullptr || indexIvf->metric_type != faiss::METRIC_L2 || indexIvf->nprobe <= 1) {
+        index->search(n, x, k, distances, labels);
+        return;
+    }
+
+    SearchIvfSkippingLists(*indexIvf, *quantizer, n, x, k, distances, labels);
+}
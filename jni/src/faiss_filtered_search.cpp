@@ -0,0 +1,338 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "faiss_filtered_search.h"
+#include "faiss_compact_id_map_index.h"
+#include "faiss_compressed_hnsw.h"
+#include "faiss_early_termination.h"
+
+#include "faiss/impl/AuxIndexStructures.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <utility>
+
+
+namespace {
+    // Value faiss gives to the distance of missing results
+    float MissingDistance(faiss::MetricType metric) {
+        return metric == faiss::METRIC_INNER_PRODUCT ? -std::numeric_limits<float>::max()
+                                                     : std::numeric_limits<float>::max();
+    }
+
+    void SearchCompactHnsw(const faiss::IndexHNSW& indexHnsw, const knn_jni::faiss_wrapper::NeighborFetcher& neighbors,
+                           const knn_jni::distance_kernels::Kernel& kernel,
+                           const knn_jni::compact_id_map::CompactIdMap& ids,
+                           const knn_jni::live_docs::LiveDocs& liveDocs, faiss::Index::idx_t n, const float* x,
+                           faiss::Index::idx_t k, float* distances, faiss::Index::idx_t* labels,
+                           knn_jni::faiss_wrapper::EarlyTermination earlyTermination) {
+        size_t patience = 0;
+        if (earlyTermination == knn_jni::faiss_wrapper::EarlyTermination::ADAPTIVE) {
+            patience = knn_jni::faiss_wrapper::AdaptivePatience(indexHnsw.hnsw.efSearch, k);
+        }
+        knn_jni::faiss_wrapper::SearchHnsw(indexHnsw, neighbors, [&ids, &liveDocs](int32_t node) {
+            return liveDocs.IsLive(ids.Map(node));
+        }, kernel, n, x, k, distances, labels, patience);
+        ids.MapLabels(labels, n * k);
+    }
+
+    void SearchCompactFlat(const faiss::IndexFlat& indexFlat, const knn_jni::distance_kernels::Kernel& kernel,
+                           const knn_jni::compact_id_map::CompactIdMap& ids,
+                           const knn_jni::live_docs::LiveDocs& liveDocs, faiss::Index::idx_t n, const float* x,
+                           faiss::Index::idx_t k, float* distances, faiss::Index::idx_t* labels) {
+        knn_jni::faiss_wrapper::SearchFlat(indexFlat, kernel, [&ids, &liveDocs](int32_t node) {
+            return liveDocs.IsLive(ids.Map(node));
+        }, n, x, k, distances, labels);
+        ids.MapLabels(labels, n * k);
+    }
+
+    // Over fetch by the number of deleted docs, up to a bounded multiple of k, and drop the deleted ones
+    void SearchAndDropDeleted(const faiss::Index* index, const knn_jni::live_docs::LiveDocs& liveDocs,
+                              faiss::Index::idx_t n, const float* x, faiss::Index::idx_t k, float* distances,
+                              faiss::Index::idx_t* labels) {
+        faiss::Index::idx_t fetchK = std::max<faiss::Index::idx_t>(
+                k, std::min<faiss::Index::idx_t>(index->ntotal, knn_jni::live_docs::OverFetchSize(liveDocs, k)));
+        std::vector<float> fetchedDistances(n * fetchK);
+        std::vector<faiss::Index::idx_t> fetchedLabels(n * fetchK);
+        index->search(n, x, fetchK, fetchedDistances.data(), fetchedLabels.data());
+
+        std::fill(labels, labels + n * k, -1);
+        std::fill(distances, distances + n * k, MissingDistance(index->metric_type));
+        for (faiss::Index::idx_t q = 0; q < n; ++q) {
+            faiss::Index::idx_t found = 0;
+            for (faiss::Index::idx_t i = q * fetchK; i < (q + 1) * fetchK && found < k; ++i) {
+                if (fetchedLabels[i] < 0) {
+                    break;
+                }
+                if (liveDocs.IsLive(fetchedLabels[i])) {
+                    labels[q * k + found] = fetchedLabels[i];
+                    distances[q * k + found] = fetchedDistances[i];
+                    ++found;
+                }
+            }
+        }
+    }
+}
+
+knn_jni::faiss_wrapper::NeighborFetcher knn_jni::faiss_wrapper::FixedNeighbors(const faiss::HNSW& hnsw) {
+    return [&hnsw](int32_t node, int layer, std::vector<int32_t>& out) {
+        out.clear();
+        if (layer >= hnsw.levels[node]) {
+            return;
+        }
+
+        size_t begin, end;
+        hnsw.neighbor_range(node, layer, &begin, &end);
+        for (size_t i = begin; i < end && hnsw.neighbors[i] >= 0; ++i) {
+            out.push_back(hnsw.neighbors[i]);
+        }
+    };
+}
+
+knn_jni::distance_kernels::Kernel knn_jni::faiss_wrapper::SelectFlatKernel(const faiss::Index* index) {
+    knn_jni::distance_kernels::Kernel kernel = {};
+    if (dynamic_cast<const faiss::IndexFlat *>(index) == nullptr) {
+        return kernel;
+    }
+
+    if (index->metric_type == faiss::METRIC_L2) {
+        return knn_jni::distance_kernels::SelectKernel(knn_jni::distance_kernels::Metric::L2, index->d);
+    }
+
+    if (index->metric_type == faiss::METRIC_INNER_PRODUCT) {
+        return knn_jni::distance_kernels::SelectKernel(knn_jni::distance_kernels::Metric::INNER_PRODUCT, index->d);
+    }
+    return kernel;
+}
+
+void knn_jni::faiss_wrapper::SearchHnsw(const faiss::IndexHNSW& indexHnsw, const NeighborFetcher& neighbors,
+                                        const NodeFilter& filter, const knn_jni::distance_kernels::Kernel& kernel,
+                                        faiss::Index::idx_t n, const float* x, faiss::Index::idx_t k,
+                                        float* distances, faiss::Index::idx_t* labels, size_t patience,
+                                        size_t efSearch) {
+    // Same search as faiss::HNSW: greedy descent through the upper layers, then a beam search of width efSearch on
+    // the base layer. Inner product is turned into a distance by negation, as faiss does. Only accepted nodes enter
+    // the results, so with a filter the beam keeps widening until it holds ef of them
+    const faiss::HNSW& hnsw = indexHnsw.hnsw;
+    bool negate = indexHnsw.metric_type == faiss::METRIC_INNER_PRODUCT;
+    faiss::Index::idx_t width = efSearch > 0 ? (faiss::Index::idx_t) efSearch : hnsw.efSearch;
+    auto ef = (size_t) std::max<faiss::Index::idx_t>(width, k);
+
+    std::fill(labels, labels + n * k, -1);
+    std::fill(distances, distances + n * k, MissingDistance(indexHnsw.metric_type));
+    if (indexHnsw.ntotal == 0 || hnsw.entry_point < 0) {
+        return;
+    }
+
+    using Candidate = std::pair<float, int32_t>;
+    std::unique_ptr<faiss::DistanceComputer> distanceComputer;
+    const float* vectors = nullptr;
+    if (kernel.distance != nullptr) {
+        vectors = dynamic_cast<const faiss::IndexFlat&>(*indexHnsw.storage).get_xb();
+    } else {
+        distanceComputer.reset(indexHnsw.storage->get_distance_computer());
+    }
+    faiss::VisitedTable visited((int) indexHnsw.ntotal);
+    std::vector<int32_t> nodeNeighbors;
+    auto accepted = [&filter](int32_t node) {
+        return !filter || filter(node);
+    };
+
+    for (faiss::Index::idx_t q = 0; q < n; ++q) {
+        const float* query = x + q * indexHnsw.d;
+        if (distanceComputer) {
+            distanceComputer->set_query(query);
+        }
+        auto distance = [&distanceComputer, &kernel, vectors, query, negate](int32_t node) {
+            float value = distanceComputer ? (*distanceComputer)(node) : kernel(query, vectors + node * kernel.dim);
+            return negate ? -value : value;
+        };
+
+        int32_t nearest = hnsw.entry_point;
+        float nearestDistance = distance(nearest);
+        for (int layer = hnsw.max_level; layer > 0; --layer) {
+            bool improved = true;
+            while (improved) {
+                improved = false;
+                neighbors(nearest, layer, nodeNeighbors);
+                for (int32_t neighbor : nodeNeighbors) {
+                    float neighborDistance = distance(neighbor);
+                    if (neighborDistance < nearestDistance) {
+                        nearest = neighbor;
+                        nearestDistance = neighborDistance;
+                        improved = true;
+                    }
+                }
+            }
+        }
+
+        std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> candidates;
+        std::priority_queue<Candidate> results;
+        // Distances of the k nearest accepted nodes, tracked only to measure convergence under a patience
+        std::priority_queue<float> nearestK;
+        auto improvesNearestK = [&nearestK, k](float value) {
+            if (nearestK.size() < (size_t) k) {
+                nearestK.push(value);
+                return true;
+            }
+            if (value < nearestK.top()) {
+                nearestK.pop();
+                nearestK.push(value);
+                return true;
+            }
+            return false;
+        };
+        size_t staleExpansions = 0;
+
+        candidates.emplace(nearestDistance, nearest);
+        if (accepted(nearest)) {
+            results.emplace(nearestDistance, nearest);
+            if (patience > 0) {
+                improvesNearestK(nearestDistance);
+            }
+        }
+        visited.set(nearest);
+
+        while (!candidates.empty()) {
+            Candidate candidate = candidates.top();
+            if (results.size() >= ef && candidate.first > results.top().first) {
+                break;
+            }
+            if (patience > 0 && nearestK.size() >= (size_t) k && staleExpansions >= patience) {
+                break;
+            }
+            candidates.pop();
+
+            bool improved = false;
+            neighbors(candidate.second, 0, nodeNeighbors);
+            for (int32_t neighbor : nodeNeighbors) {
+                if (visited.get(neighbor)) {
+                    continue;
+                }
+                visited.set(neighbor);
+
+                float neighborDistance = distance(neighbor);
+                if (results.size() < ef || neighborDistance < results.top().first) {
+                    candidates.emplace(neighborDistance, neighbor);
+                    if (accepted(neighbor)) {
+                        results.emplace(neighborDistance, neighbor);
+                        if (results.size() > ef) {
+                            results.pop();
+                        }
+                        if (patience > 0 && improvesNearestK(neighborDistance)) {
+                            improved = true;
+                        }
+                    }
+                }
+            }
+            staleExpansions = improved ? 0 : staleExpansions + 1;
+        }
+        visited.advance();
+
+        while (results.size() > (size_t) k) {
+            results.pop();
+        }
+        for (auto i = (faiss::Index::idx_t) results.size() - 1; i >= 0; --i) {
+            labels[q * k + i] = results.top().second;
+            distances[q * k + i] = negate ? -results.top().first : results.top().first;
+            results.pop();
+        }
+    }
+}
+
+void knn_jni::faiss_wrapper::SearchFlat(const faiss::IndexFlat& indexFlat,
+                                        const knn_jni::distance_kernels::Kernel& kernel, const NodeFilter& filter,
+                                        faiss::Index::idx_t n, const float* x, faiss::Index::idx_t k,
+                                        float* distances, faiss::Index::idx_t* labels) {
+    // Inner product is negated so that the heap keeps the nearest results for both metrics, as in SearchHnsw
+    bool negate = indexFlat.metric_type == faiss::METRIC_INNER_PRODUCT;
+    std::fill(labels, labels + n * k, -1);
+    std::fill(distances, distances + n * k, MissingDistance(indexFlat.metric_type));
+
+    using Candidate = std::pair<float, faiss::Index::idx_t>;
+    const float* vectors = indexFlat.get_xb();
+    for (faiss::Index::idx_t q = 0; q < n; ++q) {
+        const float* query = x + q * indexFlat.d;
+        std::priority_queue<Candidate> results;
+        for (faiss::Index::idx_t i = 0; i < indexFlat.ntotal; ++i) {
+            if (filter && !filter((int32_t) i)) {
+                continue;
+            }
+
+            float distance = kernel(query, vectors + i * indexFlat.d);
+            if (negate) {
+                distance = -distance;
+            }
+            if (results.size() < (size_t) k) {
+                results.emplace(distance, i);
+            } else if (distance < results.top().first) {
+                results.pop();
+                results.emplace(distance, i);
+            }
+        }
+
+        for (auto i = (faiss::Index::idx_t) results.size() - 1; i >= 0; --i) {
+            labels[q * k + i] = results.top().second;
+            distances[q * k + i] = negate ? -results.top().first : results.top().first;
+            results.pop();
+        }
+    }
+}
+
+void knn_jni::faiss_wrapper::SearchLiveDocs(const faiss::Index* index, const knn_jni::live_docs::LiveDocs& liveDocs,
+                                            faiss::Index::idx_t n, const float* x, faiss::Index::idx_t k,
+                                            float* distances, faiss::Index::idx_t* labels) {
+    if (auto *compressedIndex = dynamic_cast<const CompressedHnswIndex *>(index)) {
+        const auto& graph = compressedIndex->GetGraph();
+        auto neighbors = [&graph](int32_t node, int layer, std::vector<int32_t>& out) {
+            graph.Neighbors(node, layer, out);
+        };
+        SearchCompactHnsw(*compressedIndex->GetIndexHnsw(), neighbors, compressedIndex->GetKernel(),
+                          compressedIndex->GetIds(), liveDocs, n, x, k, distances, labels,
+                          compressedIndex->GetEarlyTermination());
+        return;
+    }
+
+    if (auto *compactIndex = dynamic_cast<const CompactIdMapIndex *>(index)) {
+        if (auto *indexHnsw = dynamic_cast<const faiss::IndexHNSW *>(compactIndex->GetIndex())) {
+            SearchCompactHnsw(*indexHnsw, FixedNeighbors(indexHnsw->hnsw), compactIndex->GetKernel(),
+                              compactIndex->GetIds(), liveDocs, n, x, k, distances, labels,
+                              compactIndex->GetEarlyTermination());
+            return;
+        }
+
+        auto *indexFlat = dynamic_cast<const faiss::IndexFlat *>(compactIndex->GetIndex());
+        if (indexFlat != nullptr && compactIndex->GetKernel().distance != nullptr) {
+            SearchCompactFlat(*indexFlat, compactIndex->GetKernel(), compactIndex->GetIds(), liveDocs, n, x, k,
+                              distances, labels);
+            return;
+        }
+    }
+
+    if (auto *indexHnsw = dynamic_cast<const faiss::IndexHNSW *>(index)) {
+        SearchCompactHnsw(*indexHnsw, FixedNeighbors(indexHnsw->hnsw), SelectFlatKernel(indexHnsw->storage),
+                          knn_jni::compact_id_map::CompactIdMap(indexHnsw->ntotal), liveDocs, n, x, k, distances,
+                          labels, EarlyTermination::NONE);
+        return;
+    }
+
+    auto flatKernel = SelectFlatKernel(index);
+    if (flatKernel.distance != nullptr) {
+        SearchCompactFlat(dynamic_cast<const faiss::IndexFlat&>(*index), flatKernel,
+                          knn_jni::compact_id_map::CompactIdMap(index->ntotal), liveDocs, n, x, k, distances,
+                          labels);
+        return;
+    }
+
+    SearchAndDropDeleted(index, liveDocs, n, x, k, distances, labels);
+}
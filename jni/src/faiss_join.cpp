@@ -0,0 +1,224 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "faiss_join.h"
+#include "faiss_compact_id_map_index.h"
+#include "faiss_compressed_hnsw.h"
+#include "qos.h"
+
+#include "faiss/IndexFlat.h"
+#include "faiss/IndexHNSW.h"
+#include "faiss/MetaIndexes.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <omp.h>
+#include <stdexcept>
+#include <vector>
+
+
+namespace {
+    // Queries searched by one call to faiss. Large enough for faiss to switch flat scans to BLAS
+    const int64_t JOIN_BLOCK_SIZE = 1024;
+
+    // Queries whose results are held in memory before being written out
+    const int64_t JOIN_WINDOW_SIZE = 64 * JOIN_BLOCK_SIZE;
+
+    using FilePointer = std::unique_ptr<FILE, int(*)(FILE*)>;
+
+    void WriteOrThrow(const void* ptr, size_t size, size_t count, FILE* file) {
+        if (count > 0 && fwrite(ptr, size, count, file) != count) {
+            throw std::runtime_error("Unable to write join results");
+        }
+    }
+
+    // Index that is searched and how its result positions translate to ids
+    struct JoinTarget {
+        // Index over positions, which reconstruct and exact scans take
+        const faiss::Index * index;
+        std::function<int64_t(int64_t)> idOf;
+
+        // Index for approximate searches and how its results translate to ids
+        const faiss::Index * approximateIndex;
+        std::function<int64_t(int64_t)> approximateIdOf;
+    };
+
+    // Strip the id mapping from index so that positions, which reconstruct takes, are visible
+    JoinTarget Unwrap(const faiss::Index * index) {
+        auto identity = [](int64_t position) { return position; };
+        if (auto *compressedIndex = dynamic_cast<const knn_jni::faiss_wrapper::CompressedHnswIndex *>(index)) {
+            // The wrapped IndexHNSW lost its links to the compressed graph, so approximate searches go through the
+            // compressed index, which returns ids
+            const auto& ids = compressedIndex->GetIds();
+            auto idOf = [&ids](int64_t position) { return ids.Map(position); };
+            return {compressedIndex->GetIndexHnsw(), idOf, compressedIndex, identity};
+        }
+        if (auto *compactIndex = dynamic_cast<const knn_jni::faiss_wrapper::CompactIdMapIndex *>(index)) {
+            const auto& ids = compactIndex->GetIds();
+            auto idOf = [&ids](int64_t position) { return ids.Map(position); };
+            return {compactIndex->GetIndex(), idOf, compactIndex->GetIndex(), idOf};
+        }
+        if (auto *idMap = dynamic_cast<const faiss::IndexIDMap *>(index)) {
+            const auto& ids = idMap->id_map;
+            auto idOf = [&ids](int64_t position) { return position < 0 ? position : ids[position]; };
+            return {idMap->index, idOf, idMap->index, idOf};
+        }
+        return {index, identity, index, identity};
+    }
+
+    // Flat array of vectors behind an unwrapped index, which faiss scans with BLAS
+    const faiss::Index * ExactIndex(const faiss::Index * index) {
+        if (auto *indexHnsw = dynamic_cast<const faiss::IndexHNSW *>(index)) {
+            index = indexHnsw->storage;
+        }
+        if (dynamic_cast<const faiss::IndexFlat *>(index) == nullptr) {
+            throw std::runtime_error("Exact join needs an index that stores its vectors in a flat array");
+        }
+        return index;
+    }
+
+    // readQueries(begin, end, out) fills out with queries begin to end - 1, and idOf translates the labels index
+    // returns to ids. With excludeSelf, query i is the vector with id queryId(i) and is dropped from its own neighbors
+    void Join(const faiss::Index * index, const std::function<int64_t(int64_t)>& idOf, int64_t numQueries,
+              const std::function<void(int64_t, int64_t, float*)>& readQueries,
+              const std::function<int64_t(int64_t)>& queryId, bool excludeSelf, int k, int numThreads,
+              knn_jni::qos::SchedulingPolicy schedulingPolicy, const std::string& outputPath) {
+        if (k <= 0) {
+            throw std::runtime_error("k must be positive");
+        }
+
+        FilePointer file(fopen(outputPath.c_str(), "wb"), &fclose);
+        if (file == nullptr) {
+            throw std::runtime_error("Unable to open " + outputPath);
+        }
+        auto kCpp = (uint32_t) k;
+        WriteOrThrow(&kCpp, sizeof(kCpp), 1, file.get());
+
+        int64_t d = index->d;
+        int64_t fetchK = excludeSelf ? k + 1 : k;
+        std::vector<int32_t> windowIds;
+        std::vector<float> windowDistances;
+
+        for (int64_t windowBegin = 0; windowBegin < numQueries; windowBegin += JOIN_WINDOW_SIZE) {
+            int64_t windowEnd = std::min(numQueries, windowBegin + JOIN_WINDOW_SIZE);
+            int64_t numBlocks = (windowEnd - windowBegin + JOIN_BLOCK_SIZE - 1) / JOIN_BLOCK_SIZE;
+            windowIds.assign((windowEnd - windowBegin) * k, -1);
+            windowDistances.assign((windowEnd - windowBegin) * k, 0);
+
+            // Blocks are searched in parallel; the searches themselves stay single threaded because OpenMP does not
+            // nest by default
+            std::exception_ptr error;
+            if (numThreads > 0) {
+                omp_set_num_threads(numThreads);
+            }
+#pragma omp parallel
+            {
+                std::vector<float> queries;
+                std::vector<float> distances;
+                std::vector<faiss::Index::idx_t> labels;
+#pragma omp for schedule(dynamic)
+                for (int64_t block = 0; block < numBlocks; ++block) {
+                    try {
+                        int64_t begin = windowBegin + block * JOIN_BLOCK_SIZE;
+                        int64_t end = std::min(windowEnd, begin + JOIN_BLOCK_SIZE);
+                        int64_t n = end - begin;
+                        queries.resize(n * d);
+                        distances.resize(n * fetchK);
+                        labels.resize(n * fetchK);
+                        readQueries(begin, end, queries.data());
+                        index->search(n, queries.data(), fetchK, distances.data(), labels.data());
+
+                        for (int64_t q = 0; q < n; ++q) {
+                            int64_t row = begin + q - windowBegin;
+                            int found = 0;
+                            for (int64_t i = q * fetchK; i < (q + 1) * fetchK && found < k; ++i) {
+                                if (labels[i] < 0) {
+                                    continue;
+                                }
+                                int64_t id = idOf(labels[i]);
+                                if (excludeSelf && id == queryId(begin + q)) {
+                                    continue;
+                                }
+                                windowIds[row * k + found] = (int32_t) id;
+                                windowDistances[row * k + found] = distances[i];
+                                ++found;
+                            }
+                        }
+                    } catch (...) {
+#pragma omp critical
+                        {
+                            if (!error) {
+                                error = std::current_exception();
+                            }
+                        }
+                    }
+                }
+            }
+            if (error) {
+                std::rethrow_exception(error);
+            }
+
+            for (int64_t q = windowBegin; q < windowEnd; ++q) {
+                auto id = (int32_t) queryId(q);
+                int64_t row = q - windowBegin;
+                WriteOrThrow(&id, sizeof(id), 1, file.get());
+                WriteOrThrow(windowIds.data() + row * k, sizeof(int32_t), k, file.get());
+                WriteOrThrow(windowDistances.data() + row * k, sizeof(float), k, file.get());
+            }
+
+            // Joins run for minutes, so they step aside for queries like builds do
+            knn_jni::qos::YieldToQueries(schedulingPolicy);
+        }
+
+        if (fflush(file.get()) != 0) {
+            throw std::runtime_error("Unable to write join results");
+        }
+    }
+}
+
+void knn_jni::faiss_wrapper::KnnJoinIndex(const faiss::Index * index, const float * queries, int64_t numQueries,
+                                          int k, bool exact, int numThreads,
+                                          knn_jni::qos::SchedulingPolicy schedulingPolicy,
+                                          const std::string& outputPath) {
+    JoinTarget target = Unwrap(index);
+    int64_t d = index->d;
+    auto readQueries = [queries, d](int64_t begin, int64_t end, float* out) {
+        std::copy(queries + begin * d, queries + end * d, out);
+    };
+    auto queryId = [](int64_t position) { return position; };
+    if (exact) {
+        Join(ExactIndex(target.index), target.idOf, numQueries, readQueries, queryId, false, k, numThreads,
+             schedulingPolicy, outputPath);
+    } else {
+        Join(target.approximateIndex, target.approximateIdOf, numQueries, readQueries, queryId, false, k, numThreads,
+             schedulingPolicy, outputPath);
+    }
+}
+
+void knn_jni::faiss_wrapper::SelfJoinIndex(const faiss::Index * index, int k, bool exact, int numThreads,
+                                           knn_jni::qos::SchedulingPolicy schedulingPolicy,
+                                           const std::string& outputPath) {
+    JoinTarget target = Unwrap(index);
+    const faiss::Index * source = target.index;
+    auto readQueries = [source](int64_t begin, int64_t end, float* out) {
+        source->reconstruct_n(begin, end - begin, out);
+    };
+    if (exact) {
+        Join(ExactIndex(target.index), target.idOf, index->ntotal, readQueries, target.idOf, true, k, numThreads,
+             schedulingPolicy, outputPath);
+    } else {
+        Join(target.approximateIndex, target.approximateIdOf, index->ntotal, readQueries, target.idOf, true, k,
+             numThreads, schedulingPolicy, outputPath);
+    }
+}
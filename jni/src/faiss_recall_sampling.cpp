@@ -0,0 +1,204 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "faiss_recall_sampling.h"
+#include "faiss_calibration.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+
+namespace {
+    // Samplers of the loaded indices whose queries are sampled. The count lets queries of other indices skip the
+    // lookup, and its lock, while nothing is sampled
+    std::mutex samplersMutex;
+    std::unordered_map<const faiss::Index *, std::shared_ptr<knn_jni::faiss_wrapper::RecallSampler>> samplers;
+    std::atomic<int> numSamplers(0);
+
+    double UniformDraw() {
+        thread_local std::minstd_rand generator(
+                (unsigned) std::random_device{}() ^ (unsigned) std::hash<std::thread::id>()(std::this_thread::get_id()));
+        thread_local std::uniform_real_distribution<double> distribution(0.0, 1.0);
+        return distribution(generator);
+    }
+
+    void CheckRate(double rate) {
+        if (!(rate >= 0 && rate <= 1)) {
+            throw std::runtime_error("Recall sampling rate must be between 0 and 1");
+        }
+    }
+
+    std::shared_ptr<knn_jni::faiss_wrapper::RecallSampler> TakeSampler(const faiss::Index * index) {
+        std::lock_guard<std::mutex> lock(samplersMutex);
+        auto it = samplers.find(index);
+        if (it == samplers.end()) {
+            return nullptr;
+        }
+        auto sampler = it->second;
+        samplers.erase(it);
+        numSamplers--;
+        return sampler;
+    }
+}
+
+knn_jni::faiss_wrapper::RecallSampler::RecallSampler(const faiss::Index * index, double rate)
+        : index(index), rate(rate), closed(false), pendingChecks(0), runningChecks(0), next(0), windowSum(0),
+          totalSamples(0), droppedSamples(0) {
+    CheckRate(rate);
+}
+
+void knn_jni::faiss_wrapper::RecallSampler::SetRate(double rate) {
+    CheckRate(rate);
+    this->rate = rate;
+}
+
+bool knn_jni::faiss_wrapper::RecallSampler::ShouldSample() const {
+    double currentRate = rate;
+    return currentRate > 0 && UniformDraw() < currentRate;
+}
+
+void knn_jni::faiss_wrapper::RecallSampler::Sample(const float * query, int k, const faiss::Index::idx_t * labels) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (closed) {
+            return;
+        }
+        if (pendingChecks >= MAX_PENDING_RECALL_CHECKS) {
+            droppedSamples++;
+            return;
+        }
+        pendingChecks++;
+    }
+
+    // The task holds the sampler, so a check skipped after Close still has somewhere to report to
+    std::shared_ptr<RecallSampler> self = shared_from_this();
+    std::vector<float> queryCopy(query, query + index->d);
+    std::vector<faiss::Index::idx_t> labelsCopy(labels, labels + k);
+    knn_jni::thread_pool::BackgroundWorker::Instance().Submit(
+            [self, queryCopy, k, labelsCopy]() { self->Check(queryCopy, k, labelsCopy); });
+}
+
+void knn_jni::faiss_wrapper::RecallSampler::Check(const std::vector<float>& query, int k,
+                                                  const std::vector<faiss::Index::idx_t>& labels) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (closed) {
+            pendingChecks--;
+            idle.notify_all();
+            return;
+        }
+        runningChecks++;
+    }
+
+    // A check that fails is not recorded; the query it shadows already succeeded
+    double recall = -1;
+    try {
+        auto truth = ExhaustiveNeighbors(index, query.data(), 1, k);
+        int expected = 0;
+        int found = 0;
+        for (int i = 0; i < k; ++i) {
+            if (truth.data[i] < 0) {
+                continue;
+            }
+            expected++;
+            if (std::find(labels.begin(), labels.end(), (faiss::Index::idx_t) truth.data[i]) != labels.end()) {
+                found++;
+            }
+        }
+        if (expected > 0) {
+            recall = (double) found / expected;
+        }
+    } catch (...) {}
+
+    if (recall >= 0) {
+        Record(recall);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    runningChecks--;
+    pendingChecks--;
+    idle.notify_all();
+}
+
+void knn_jni::faiss_wrapper::RecallSampler::Record(double recall) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (window.size() < RECALL_WINDOW_SIZE) {
+        window.push_back(recall);
+    } else {
+        windowSum -= window[next];
+        window[next] = recall;
+        next = (next + 1) % RECALL_WINDOW_SIZE;
+    }
+    windowSum += recall;
+    totalSamples++;
+}
+
+knn_jni::faiss_wrapper::RecallStats knn_jni::faiss_wrapper::RecallSampler::GetStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    RecallStats stats;
+    stats.windowSamples = (int64_t) window.size();
+    stats.recall = window.empty() ? 0 : windowSum / (double) window.size();
+    stats.totalSamples = totalSamples;
+    stats.droppedSamples = droppedSamples;
+    return stats;
+}
+
+void knn_jni::faiss_wrapper::RecallSampler::Close() {
+    std::unique_lock<std::mutex> lock(mutex);
+    closed = true;
+    idle.wait(lock, [this] { return runningChecks == 0; });
+}
+
+void knn_jni::faiss_wrapper::RecallSampler::WaitForChecks() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return pendingChecks == 0; });
+}
+
+void knn_jni::faiss_wrapper::SetRecallSampling(const faiss::Index * index, double rate) {
+    CheckRate(rate);
+    if (rate == 0) {
+        RemoveRecallSampler(index);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(samplersMutex);
+    auto it = samplers.find(index);
+    if (it != samplers.end()) {
+        it->second->SetRate(rate);
+        return;
+    }
+    samplers[index] = std::make_shared<RecallSampler>(index, rate);
+    numSamplers++;
+}
+
+std::shared_ptr<knn_jni::faiss_wrapper::RecallSampler> knn_jni::faiss_wrapper::GetRecallSampler(
+        const faiss::Index * index) {
+    if (numSamplers == 0) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(samplersMutex);
+    auto it = samplers.find(index);
+    return it == samplers.end() ? nullptr : it->second;
+}
+
+void knn_jni::faiss_wrapper::RemoveRecallSampler(const faiss::Index * index) {
+    // Closed outside of the registry lock: waiting for a running check must not hold up queries of other indices
+    auto sampler = TakeSampler(index);
+    if (sampler != nullptr) {
+        sampler->Close();
+    }
+}
@@ -11,29 +11,122 @@
 
 #include "jni_util.h"
 #include "faiss_wrapper.h"
+#include "faiss_compact_id_map_index.h"
+#include "faiss_balanced_kmeans.h"
+#include "faiss_calibration.h"
+#include "faiss_compressed_hnsw.h"
+#include "faiss_description.h"
+#include "faiss_early_termination.h"
+#include "faiss_filtered_search.h"
+#include "faiss_join.h"
+#include "faiss_recall_sampling.h"
+#include "graph_reorder.h"
+#include "ground_truth.h"
+#include "live_docs.h"
+#include "qos.h"
+#include "query_capture.h"
+#include "thread_pool.h"
+#include "usdt.h"
 
 #include "faiss/impl/io.h"
 #include "faiss/index_factory.h"
 #include "faiss/index_io.h"
+#include "faiss/IndexFlat.h"
 #include "faiss/IndexHNSW.h"
 #include "faiss/IndexIVFFlat.h"
+#include "faiss/IndexPreTransform.h"
+#include "faiss/IndexScalarQuantizer.h"
 #include "faiss/MetaIndexes.h"
 
 #include <algorithm>
+#include <chrono>
 #include <jni.h>
+#include <omp.h>
 #include <string>
+#include <utility>
 #include <vector>
 
+KNN_USDT_SEMAPHORE(opensearch_knn_faiss, load_start)
+KNN_USDT_SEMAPHORE(opensearch_knn_faiss, load_done)
+KNN_USDT_SEMAPHORE(opensearch_knn_faiss, query_start)
+KNN_USDT_SEMAPHORE(opensearch_knn_faiss, query_done)
+KNN_USDT_SEMAPHORE(opensearch_knn_faiss, build_start)
+KNN_USDT_SEMAPHORE(opensearch_knn_faiss, build_done)
+KNN_USDT_SEMAPHORE(opensearch_knn_faiss, train_start)
+KNN_USDT_SEMAPHORE(opensearch_knn_faiss, train_done)
+KNN_USDT_SEMAPHORE(opensearch_knn_faiss, free_start)
+KNN_USDT_SEMAPHORE(opensearch_knn_faiss, free_done)
+
+// Balanced clustering caps the training vectors of a list at this multiple of the average, and refines the k-means
+// centroids over this many rounds
+const float BALANCED_MAX_IMBALANCE = 1.2f;
+const int BALANCED_ITERATIONS = 10;
 
 // Translate space type to faiss metric
 faiss::MetricType TranslateSpaceToMetric(const std::string& spaceType);
 
-// Set additional parameters on faiss index
+// Set additional parameters on faiss index. Parameters of an IndexPreTransform apply to the index it wraps
 void SetExtraParameters(knn_jni::JNIUtilInterface * jniUtil, JNIEnv *env,
                         const std::unordered_map<std::string, jobject>& parametersCpp, faiss::Index * index);
 
-// Train an index with data provided
-void InternalTrainIndex(faiss::Index * index, faiss::Index::idx_t n, const float* x);
+// Build an index from a converted data set and write it to indexPathJ. Shared by the float[][] and flat entry points.
+// int8Vectors tells that every value of the data set is an int8, widened to float
+void InternalCreateIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ,
+                         const std::vector<float>& dataset, int numVectors, int dim, jstring indexPathJ,
+                         jobject parametersJ, bool int8Vectors = false);
+
+// If index stores its vectors with an untrained 8 bit scalar quantizer, set the quantizer's range to that of int8, so
+// that each int8 value gets a code of its own and decodes back exactly. Other indices are left as they are
+void SetInt8ScalarQuantizerRange(faiss::Index * index);
+
+// Add a converted data set to a trained template index and write it to indexPathJ
+void InternalCreateIndexFromTemplate(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ,
+                                     const std::vector<float>& dataset, int numVectors, int dim, jstring indexPathJ,
+                                     jbyteArray templateIndexJ, jobject parametersJ);
+
+// Train an index with data provided. The transforms of an IndexPreTransform are trained in order, each on the output
+// of the previous one, and the wrapped index on the output of the last. If balanced is true, the coarse quantizer of an
+// IVF index is trained with TrainBalancedCentroids instead of plain k-means
+void InternalTrainIndex(faiss::Index * index, faiss::Index::idx_t n, const float* x, bool balanced = false);
+
+// Train the flat coarse quantizer of indexIvf with balanced k-means, so that faiss leaves it as it is
+void TrainBalancedQuantizer(faiss::IndexIVF * indexIvf, faiss::Index::idx_t n, const float* x);
+
+// Deserialize a template index built by TrainIndex
+faiss::Index * ReadTemplateIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jbyteArray templateIndexJ);
+
+// Query vectors at queryVectorsPointerJ, checked against the dimension of index
+const std::vector<float>& CalibrationQueries(jlong queryVectorsPointerJ, const faiss::Index * index);
+
+// Encode a calibration as the float[] returned by Calibrate
+jfloatArray CalibrationToJava(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                              const knn_jni::faiss_wrapper::Calibration& calibration);
+
+// Add vectors to an index in batches. Builds scheduled with a lowered policy yield to in-flight queries between
+// batches
+void InternalAddWithIds(faiss::Index * index, faiss::Index::idx_t n, int dim, const float* x,
+                        const faiss::Index::idx_t* ids, knn_jni::qos::SchedulingPolicy schedulingPolicy);
+
+// Throw unless index is an HNSW graph over flat storage that strategy can renumber. Checked before the build, so that
+// an unsupported strategy fails fast instead of being skipped
+void CheckGraphReorder(const faiss::Index * index, knn_jni::graph_reorder::ReorderStrategy strategy);
+
+// Renumber the nodes of an HNSW graph so that graph neighbors sit close in memory. The id map is permuted along with
+// the graph, so searches keep returning the same ids. The index must pass CheckGraphReorder
+void ReorderHnswGraph(faiss::IndexIDMap * idMap, knn_jni::graph_reorder::ReorderStrategy strategy);
+
+// Write an index built with ids to disk in the faiss format, so that any faiss reader can load it. Ids are only
+// compacted when the index is loaded. The graph of an HNSW index is compressed when the delta encoding is requested
+void InternalWriteIndex(faiss::IndexIDMap * idMap, knn_jni::adjacency_codec::GraphEncoding graphEncoding,
+                        const std::string& indexPath);
+
+// Query an index, returning only docs live in liveDocs when it is not null
+jobjectArray InternalQueryIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                jfloatArray queryVectorJ, jint kJ, const knn_jni::live_docs::LiveDocs * liveDocs);
+
+// Same as InternalQueryIndex for a query vector already in native memory
+jobjectArray InternalSearch(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                            const float* queryVector, jint kJ, const knn_jni::live_docs::LiveDocs * liveDocs);
 
 void knn_jni::faiss_wrapper::CreateIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ,
                                          jobjectArray vectorsJ, jstring indexPathJ, jobject parametersJ) {
@@ -54,59 +147,82 @@ void knn_jni::faiss_wrapper::CreateIndex(knn_jni::JNIUtilInterface * jniUtil, JN
         throw std::runtime_error("Parameters cannot be null");
     }
 
-    // parametersJ is a Java Map<String, Object>. ConvertJavaMapToCppMap converts it to a c++ map<string, jobject>
-    // so that it is easier to access.
-    auto parametersCpp = jniUtil->ConvertJavaMapToCppMap(env, parametersJ);
+    // Read data set
+    int numVectors = jniUtil->GetJavaObjectArrayLength(env, vectorsJ);
+    int dim = jniUtil->GetInnerDimensionOf2dJavaFloatArray(env, vectorsJ);
+    auto dataset = jniUtil->Convert2dJavaObjectArrayToCppFloatVector(env, vectorsJ, dim);
 
-    // Get space type for this index
-    jobject spaceTypeJ = knn_jni::GetJObjectFromMapOrThrow(parametersCpp, knn_jni::SPACE_TYPE);
-    std::string spaceTypeCpp(jniUtil->ConvertJavaObjectToCppString(env, spaceTypeJ));
-    faiss::MetricType metric = TranslateSpaceToMetric(spaceTypeCpp);
+    InternalCreateIndex(jniUtil, env, idsJ, dataset, numVectors, dim, indexPathJ, parametersJ);
+}
+
+void knn_jni::faiss_wrapper::CreateIndexFromFlatVectors(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                        jintArray idsJ, jobject vectorsJ, jint dimJ,
+                                                        jstring indexPathJ, jobject parametersJ) {
+
+    if (idsJ == nullptr) {
+        throw std::runtime_error("IDs cannot be null");
+    }
+
+    if (indexPathJ == nullptr) {
+        throw std::runtime_error("Index path cannot be null");
+    }
+
+    if (parametersJ == nullptr) {
+        throw std::runtime_error("Parameters cannot be null");
+    }
 
     // Read data set
-    int numVectors = jniUtil->GetJavaObjectArrayLength(env, vectorsJ);
-    int numIds = jniUtil->GetJavaIntArrayLength(env, idsJ);
-    if (numIds != numVectors) {
-        throw std::runtime_error("Number of IDs does not match number of vectors");
+    auto dataset = jniUtil->ConvertFlatJavaVectorsToCppFloatVector(env, vectorsJ, dimJ);
+    int numVectors = (int) (dataset.size() / dimJ);
+
+    InternalCreateIndex(jniUtil, env, idsJ, dataset, numVectors, dimJ, indexPathJ, parametersJ);
+}
+
+void knn_jni::faiss_wrapper::CreateIndexFromHalfVectors(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                        jintArray idsJ, jobject vectorsJ, jint dimJ,
+                                                        jstring encodingJ, jstring indexPathJ, jobject parametersJ) {
+
+    if (idsJ == nullptr) {
+        throw std::runtime_error("IDs cannot be null");
     }
 
-    int dim = jniUtil->GetInnerDimensionOf2dJavaFloatArray(env, vectorsJ);
-    auto dataset = jniUtil->Convert2dJavaObjectArrayToCppFloatVector(env, vectorsJ, dim);
+    if (indexPathJ == nullptr) {
+        throw std::runtime_error("Index path cannot be null");
+    }
 
-    // Create faiss index
-    jobject indexDescriptionJ = knn_jni::GetJObjectFromMapOrThrow(parametersCpp, knn_jni::INDEX_DESCRIPTION);
-    std::string indexDescriptionCpp(jniUtil->ConvertJavaObjectToCppString(env, indexDescriptionJ));
+    if (parametersJ == nullptr) {
+        throw std::runtime_error("Parameters cannot be null");
+    }
 
-    std::unique_ptr<faiss::Index> indexWriter;
-    indexWriter.reset(faiss::index_factory(dim, indexDescriptionCpp.c_str(), metric));
+    // Read data set
+    auto encoding = knn_jni::GetHalfPrecisionEncoding(jniUtil, env, encodingJ);
+    auto dataset = jniUtil->ConvertHalfJavaVectorsToCppFloatVector(env, vectorsJ, dimJ, encoding);
+    int numVectors = (int) (dataset.size() / dimJ);
+
+    InternalCreateIndex(jniUtil, env, idsJ, dataset, numVectors, dimJ, indexPathJ, parametersJ);
+}
 
-    // Set thread count if it is passed in as a parameter. Setting this variable will only impact the current thread
-    if(parametersCpp.find(knn_jni::INDEX_THREAD_QUANTITY) != parametersCpp.end()) {
-        auto threadCount = jniUtil->ConvertJavaObjectToCppInteger(env, parametersCpp[knn_jni::INDEX_THREAD_QUANTITY]);
-        omp_set_num_threads(threadCount);
+void knn_jni::faiss_wrapper::CreateIndexFromByteVectors(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                        jintArray idsJ, jobject vectorsJ, jint dimJ,
+                                                        jstring indexPathJ, jobject parametersJ) {
+
+    if (idsJ == nullptr) {
+        throw std::runtime_error("IDs cannot be null");
     }
 
-    // Add extra parameters that cant be configured with the index factory
-    if(parametersCpp.find(knn_jni::PARAMETERS) != parametersCpp.end()) {
-        jobject subParametersJ = parametersCpp[knn_jni::PARAMETERS];
-        auto subParametersCpp = jniUtil->ConvertJavaMapToCppMap(env, subParametersJ);
-        SetExtraParameters(jniUtil, env, subParametersCpp, indexWriter.get());
-        jniUtil->DeleteLocalRef(env, subParametersJ);
+    if (indexPathJ == nullptr) {
+        throw std::runtime_error("Index path cannot be null");
     }
-    jniUtil->DeleteLocalRef(env, parametersJ);
 
-    // Check that the index does not need to be trained
-    if(!indexWriter->is_trained) {
-        throw std::runtime_error("Index is not trained");
+    if (parametersJ == nullptr) {
+        throw std::runtime_error("Parameters cannot be null");
     }
 
-    auto idVector = jniUtil->ConvertJavaIntArrayToCppIntVector(env, idsJ);
-    faiss::IndexIDMap idMap = faiss::IndexIDMap(indexWriter.get());
-    idMap.add_with_ids(numVectors, dataset.data(), idVector.data());
+    // Read data set
+    auto dataset = jniUtil->ConvertByteJavaVectorsToCppFloatVector(env, vectorsJ, dimJ);
+    int numVectors = (int) (dataset.size() / dimJ);
 
-    // Write the index to disk
-    std::string indexPathCpp(jniUtil->ConvertJavaStringToCppString(env, indexPathJ));
-    faiss::write_index(&idMap, indexPathCpp.c_str());
+    InternalCreateIndex(jniUtil, env, idsJ, dataset, numVectors, dimJ, indexPathJ, parametersJ, true);
 }
 
 void knn_jni::faiss_wrapper::CreateIndexFromTemplate(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ,
@@ -128,107 +244,279 @@ void knn_jni::faiss_wrapper::CreateIndexFromTemplate(knn_jni::JNIUtilInterface *
         throw std::runtime_error("Template index cannot be null");
     }
 
-    // Set thread count if it is passed in as a parameter. Setting this variable will only impact the current thread
-    auto parametersCpp = jniUtil->ConvertJavaMapToCppMap(env, parametersJ);
-    if(parametersCpp.find(knn_jni::INDEX_THREAD_QUANTITY) != parametersCpp.end()) {
-        auto threadCount = jniUtil->ConvertJavaObjectToCppInteger(env, parametersCpp[knn_jni::INDEX_THREAD_QUANTITY]);
-        omp_set_num_threads(threadCount);
-    }
-    jniUtil->DeleteLocalRef(env, parametersJ);
-
     // Read data set
     int numVectors = jniUtil->GetJavaObjectArrayLength(env, vectorsJ);
-    int numIds = jniUtil->GetJavaIntArrayLength(env, idsJ);
-    if (numIds != numVectors) {
-        throw std::runtime_error("Number of IDs does not match number of vectors");
-    }
-
     int dim = jniUtil->GetInnerDimensionOf2dJavaFloatArray(env, vectorsJ);
     auto dataset = jniUtil->Convert2dJavaObjectArrayToCppFloatVector(env, vectorsJ, dim);
 
-    // Get vector of bytes from jbytearray
-    int indexBytesCount = jniUtil->GetJavaBytesArrayLength(env, templateIndexJ);
-    jbyte * indexBytesJ = jniUtil->GetByteArrayElements(env, templateIndexJ, nullptr);
+    InternalCreateIndexFromTemplate(jniUtil, env, idsJ, dataset, numVectors, dim, indexPathJ, templateIndexJ,
+                                    parametersJ);
+}
 
-    faiss::VectorIOReader vectorIoReader;
-    for (int i = 0; i < indexBytesCount; i++) {
-        vectorIoReader.data.push_back((uint8_t) indexBytesJ[i]);
+void knn_jni::faiss_wrapper::CreateIndexFromTemplateWithFlatVectors(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                                    jintArray idsJ, jobject vectorsJ, jint dimJ,
+                                                                    jstring indexPathJ, jbyteArray templateIndexJ,
+                                                                    jobject parametersJ) {
+    if (idsJ == nullptr) {
+        throw std::runtime_error("IDs cannot be null");
     }
-    jniUtil->ReleaseByteArrayElements(env, templateIndexJ, indexBytesJ, JNI_ABORT);
 
-    // Create faiss index
-    std::unique_ptr<faiss::Index> indexWriter;
-    indexWriter.reset(faiss::read_index(&vectorIoReader, 0));
+    if (indexPathJ == nullptr) {
+        throw std::runtime_error("Index path cannot be null");
+    }
 
-    auto idVector = jniUtil->ConvertJavaIntArrayToCppIntVector(env, idsJ);
-    faiss::IndexIDMap idMap =  faiss::IndexIDMap(indexWriter.get());
-    idMap.add_with_ids(numVectors, dataset.data(), idVector.data());
+    if (templateIndexJ == nullptr) {
+        throw std::runtime_error("Template index cannot be null");
+    }
 
-    // Write the index to disk
-    std::string indexPathCpp(jniUtil->ConvertJavaStringToCppString(env, indexPathJ));
-    faiss::write_index(&idMap, indexPathCpp.c_str());
+    // Read data set
+    auto dataset = jniUtil->ConvertFlatJavaVectorsToCppFloatVector(env, vectorsJ, dimJ);
+    int numVectors = (int) (dataset.size() / dimJ);
+
+    InternalCreateIndexFromTemplate(jniUtil, env, idsJ, dataset, numVectors, dimJ, indexPathJ, templateIndexJ,
+                                    parametersJ);
 }
 
-jlong knn_jni::faiss_wrapper::LoadIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jstring indexPathJ) {
+jlong knn_jni::faiss_wrapper::LoadIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jstring indexPathJ,
+                                        jobject parametersJ) {
     if (indexPathJ == nullptr) {
         throw std::runtime_error("Index path cannot be null");
     }
 
     std::string indexPathCpp(jniUtil->ConvertJavaStringToCppString(env, indexPathJ));
-    faiss::Index* indexReader = faiss::read_index(indexPathCpp.c_str(), faiss::IO_FLAG_READ_ONLY);
+    KNN_USDT(opensearch_knn_faiss, load_start, indexPathCpp.c_str());
+    knn_jni::usdt::Stopwatch stopwatch(KNN_USDT_ENABLED(opensearch_knn_faiss, load_done));
+    auto earlyTermination = knn_jni::faiss_wrapper::EarlyTermination::NONE;
+    knn_jni::query_capture::IndexIdentity identity = {knn_jni::query_capture::Engine::FAISS, indexPathCpp, {}};
+    if (parametersJ != nullptr) {
+        auto parametersCpp = jniUtil->ConvertJavaMapToCppMap(env, parametersJ);
+        auto value = parametersCpp.find(knn_jni::EARLY_TERMINATION);
+        if (value != parametersCpp.end()) {
+            std::string earlyTerminationCpp = jniUtil->ConvertJavaObjectToCppString(env, value->second);
+            earlyTermination = knn_jni::faiss_wrapper::ParseEarlyTermination(earlyTerminationCpp);
+            identity.parameters.emplace_back(knn_jni::EARLY_TERMINATION, earlyTerminationCpp);
+        }
+    }
+
+    // Graphs written with the delta encoding load as a CompressedHnswIndex, and every other index as a CompactIdMapIndex
+    faiss::Index* indexReader = knn_jni::faiss_wrapper::ReadIndex(indexPathCpp, faiss::IO_FLAG_READ_ONLY);
+    if (auto * compressedIndex = dynamic_cast<knn_jni::faiss_wrapper::CompressedHnswIndex*>(indexReader)) {
+        compressedIndex->SetEarlyTermination(earlyTermination);
+    } else if (auto * compactIndex = dynamic_cast<knn_jni::faiss_wrapper::CompactIdMapIndex*>(indexReader)) {
+        compactIndex->SetEarlyTermination(earlyTermination);
+    } else if (earlyTermination != knn_jni::faiss_wrapper::EarlyTermination::NONE) {
+        delete indexReader;
+        throw std::runtime_error("Early termination is not supported for this index");
+    }
+    knn_jni::query_capture::RegisterIndex(indexReader, std::move(identity));
+    KNN_USDT(opensearch_knn_faiss, load_done, indexReader, indexPathCpp.c_str(), (int64_t) indexReader->ntotal,
+             stopwatch.Elapsed());
     return (jlong) indexReader;
 }
 
 jobjectArray knn_jni::faiss_wrapper::QueryIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
                                                 jfloatArray queryVectorJ, jint kJ) {
+    return InternalQueryIndex(jniUtil, env, indexPointerJ, queryVectorJ, kJ, nullptr);
+}
+
+jobjectArray knn_jni::faiss_wrapper::QueryIndexWithLiveDocs(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                            jlong indexPointerJ, jfloatArray queryVectorJ, jint kJ,
+                                                            jlongArray liveDocsJ) {
+    if (liveDocsJ == nullptr) {
+        return InternalQueryIndex(jniUtil, env, indexPointerJ, queryVectorJ, kJ, nullptr);
+    }
+
+    int numWords = jniUtil->GetJavaLongArrayLength(env, liveDocsJ);
+    jlong * liveDocsWords = jniUtil->GetLongArrayElements(env, liveDocsJ, nullptr);
+    knn_jni::live_docs::LiveDocs liveDocs(reinterpret_cast<const uint64_t *>(liveDocsWords), numWords);
+    jobjectArray results;
+    try {
+        results = InternalQueryIndex(jniUtil, env, indexPointerJ, queryVectorJ, kJ, &liveDocs);
+    } catch (...) {
+        jniUtil->ReleaseLongArrayElements(env, liveDocsJ, liveDocsWords, JNI_ABORT);
+        throw;
+    }
+    jniUtil->ReleaseLongArrayElements(env, liveDocsJ, liveDocsWords, JNI_ABORT);
+    return results;
+}
 
+jobjectArray knn_jni::faiss_wrapper::QueryIndexWithHalfVector(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                              jlong indexPointerJ, jshortArray queryVectorJ,
+                                                              jstring encodingJ, jint kJ) {
     if (queryVectorJ == nullptr) {
         throw std::runtime_error("Query Vector cannot be null");
     }
 
     auto *indexReader = reinterpret_cast<faiss::Index*>(indexPointerJ);
+    if (indexReader == nullptr) {
+        throw std::runtime_error("Invalid pointer to index");
+    }
+
+    // Every length is a multiple of 1, so the whole array is read as one vector and its length checked here
+    auto encoding = knn_jni::GetHalfPrecisionEncoding(jniUtil, env, encodingJ);
+    auto queryVector = jniUtil->ConvertHalfJavaVectorsToCppFloatVector(env, queryVectorJ, 1, encoding);
+    if (queryVector.size() != (size_t) indexReader->d) {
+        throw std::runtime_error("Query vector does not match the dimension of the index");
+    }
+    return InternalSearch(jniUtil, env, indexPointerJ, queryVector.data(), kJ, nullptr);
+}
+
+jobjectArray knn_jni::faiss_wrapper::QueryIndexWithByteVector(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                              jlong indexPointerJ, jbyteArray queryVectorJ,
+                                                              jint kJ) {
+    if (queryVectorJ == nullptr) {
+        throw std::runtime_error("Query Vector cannot be null");
+    }
 
+    auto *indexReader = reinterpret_cast<faiss::Index*>(indexPointerJ);
     if (indexReader == nullptr) {
         throw std::runtime_error("Invalid pointer to index");
     }
 
-    int dim	= jniUtil->GetJavaFloatArrayLength(env, queryVectorJ);
-    std::vector<float> dis(kJ * dim);
-    std::vector<faiss::Index::idx_t> ids(kJ * dim);
-    float* rawQueryvector = jniUtil->GetFloatArrayElements(env, queryVectorJ, nullptr);
+    // Every length is a multiple of 1, so the whole array is read as one vector and its length checked here
+    auto queryVector = jniUtil->ConvertByteJavaVectorsToCppFloatVector(env, queryVectorJ, 1);
+    if (queryVector.size() != (size_t) indexReader->d) {
+        throw std::runtime_error("Query vector does not match the dimension of the index");
+    }
+    return InternalSearch(jniUtil, env, indexPointerJ, queryVector.data(), kJ, nullptr);
+}
 
-    try {
-        indexReader->search(1, rawQueryvector, kJ, dis.data(), ids.data());
-    } catch (...) {
-        jniUtil->ReleaseFloatArrayElements(env, queryVectorJ, rawQueryvector, JNI_ABORT);
-        throw;
+void knn_jni::faiss_wrapper::SelfJoin(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ, jint kJ,
+                                      jboolean exactJ, jstring outputPathJ, jobject parametersJ) {
+    if (outputPathJ == nullptr) {
+        throw std::runtime_error("Output path cannot be null");
     }
-    jniUtil->ReleaseFloatArrayElements(env, queryVectorJ, rawQueryvector, JNI_ABORT);
 
-    // If there are not k results, the results will be padded with -1. Find the first -1, and set result size to that
-    // index
-    int resultSize = kJ;
-    auto it = std::find(ids.begin(), ids.end(), -1);
-    if (it != ids.end()) {
-        resultSize = it - ids.begin();
+    if (parametersJ == nullptr) {
+        throw std::runtime_error("Parameters cannot be null");
     }
 
-    jclass resultClass = jniUtil->FindClass(env,"org/opensearch/knn/index/KNNQueryResult");
-    jmethodID allArgs = jniUtil->FindMethod(env, "org/opensearch/knn/index/KNNQueryResult", "<init>");
+    auto *indexReader = reinterpret_cast<faiss::Index*>(indexPointerJ);
+    if (indexReader == nullptr) {
+        throw std::runtime_error("Invalid pointer to index");
+    }
 
-    jobjectArray results = jniUtil->NewObjectArray(env, resultSize, resultClass, nullptr);
+    // Joins are batch work, so they borrow threads and are scheduled like builds
+    auto parametersCpp = jniUtil->ConvertJavaMapToCppMap(env, parametersJ);
+    knn_jni::thread_pool::ThreadBudget threadBudget(knn_jni::GetRequestedThreadCount(jniUtil, env, parametersCpp));
+    int threadCount = threadBudget.Count();
+    auto schedulingPolicy = knn_jni::GetBuildSchedulingPolicy(jniUtil, env, parametersCpp);
+    jniUtil->DeleteLocalRef(env, parametersJ);
 
-    jobject result;
-    for(int i = 0; i < resultSize; ++i) {
-        result = jniUtil->NewObject(env, resultClass, allArgs, ids[i], dis[i]);
-        jniUtil->SetObjectArrayElement(env, results, i, result);
+    std::string outputPathCpp(jniUtil->ConvertJavaStringToCppString(env, outputPathJ));
+    knn_jni::qos::RunWithPolicy(schedulingPolicy, [&]() {
+        knn_jni::faiss_wrapper::SelfJoinIndex(indexReader, kJ, exactJ, threadCount, schedulingPolicy, outputPathCpp);
+    });
+}
+
+void knn_jni::faiss_wrapper::KnnJoin(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                     jlong queryVectorsPointerJ, jint kJ, jboolean exactJ, jstring outputPathJ,
+                                     jobject parametersJ) {
+    if (outputPathJ == nullptr) {
+        throw std::runtime_error("Output path cannot be null");
     }
-    return results;
+
+    if (parametersJ == nullptr) {
+        throw std::runtime_error("Parameters cannot be null");
+    }
+
+    auto *indexReader = reinterpret_cast<faiss::Index*>(indexPointerJ);
+    if (indexReader == nullptr) {
+        throw std::runtime_error("Invalid pointer to index");
+    }
+
+    auto *queryVectorsCpp = reinterpret_cast<std::vector<float>*>(queryVectorsPointerJ);
+    if (queryVectorsCpp == nullptr) {
+        throw std::runtime_error("Invalid pointer to query vectors");
+    }
+
+    if (queryVectorsCpp->size() % indexReader->d != 0) {
+        throw std::runtime_error("Query vectors do not match the dimension of the index");
+    }
+
+    // Joins are batch work, so they borrow threads and are scheduled like builds
+    auto parametersCpp = jniUtil->ConvertJavaMapToCppMap(env, parametersJ);
+    knn_jni::thread_pool::ThreadBudget threadBudget(knn_jni::GetRequestedThreadCount(jniUtil, env, parametersCpp));
+    int threadCount = threadBudget.Count();
+    auto schedulingPolicy = knn_jni::GetBuildSchedulingPolicy(jniUtil, env, parametersCpp);
+    jniUtil->DeleteLocalRef(env, parametersJ);
+
+    std::string outputPathCpp(jniUtil->ConvertJavaStringToCppString(env, outputPathJ));
+    knn_jni::qos::RunWithPolicy(schedulingPolicy, [&]() {
+        knn_jni::faiss_wrapper::KnnJoinIndex(indexReader, queryVectorsCpp->data(),
+                                             queryVectorsCpp->size() / indexReader->d, kJ, exactJ, threadCount,
+                                             schedulingPolicy, outputPathCpp);
+    });
 }
 
 void knn_jni::faiss_wrapper::Free(jlong indexPointer) {
     auto *indexWrapper = reinterpret_cast<faiss::Index*>(indexPointer);
+    KNN_USDT(opensearch_knn_faiss, free_start, indexWrapper);
+    knn_jni::usdt::Stopwatch stopwatch(KNN_USDT_ENABLED(opensearch_knn_faiss, free_done));
+    knn_jni::faiss_wrapper::RemoveRecallSampler(indexWrapper);
+    knn_jni::query_capture::UnregisterIndex(indexWrapper);
     delete indexWrapper;
+    KNN_USDT(opensearch_knn_faiss, free_done, indexWrapper, stopwatch.Elapsed());
+}
+
+void knn_jni::faiss_wrapper::SetRecallSampling(jlong indexPointerJ, jfloat rateJ) {
+    auto *indexReader = reinterpret_cast<faiss::Index*>(indexPointerJ);
+    if (indexReader == nullptr) {
+        throw std::runtime_error("Invalid pointer to index");
+    }
+    knn_jni::faiss_wrapper::SetRecallSampling(indexReader, rateJ);
+}
+
+jfloatArray knn_jni::faiss_wrapper::GetRecallStats(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                   jlong indexPointerJ) {
+    auto *indexReader = reinterpret_cast<faiss::Index*>(indexPointerJ);
+    if (indexReader == nullptr) {
+        throw std::runtime_error("Invalid pointer to index");
+    }
+
+    RecallStats stats = {0, 0, 0, 0};
+    auto sampler = knn_jni::faiss_wrapper::GetRecallSampler(indexReader);
+    if (sampler != nullptr) {
+        stats = sampler->GetStats();
+    }
+
+    jfloat valuesJ[] = {(jfloat) stats.windowSamples, (jfloat) stats.recall, (jfloat) stats.totalSamples,
+                        (jfloat) stats.droppedSamples};
+    jfloatArray ret = jniUtil->NewFloatArray(env, 4);
+    jniUtil->SetFloatArrayRegion(env, ret, 0, 4, valuesJ);
+    return ret;
+}
+
+jbyteArray knn_jni::faiss_wrapper::DescribeIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                 jlong indexPointerJ) {
+    auto *indexReader = reinterpret_cast<faiss::Index*>(indexPointerJ);
+    if (indexReader == nullptr) {
+        throw std::runtime_error("Invalid pointer to index");
+    }
+
+    std::string description = knn_jni::faiss_wrapper::Describe(indexReader);
+    jbyteArray ret = jniUtil->NewByteArray(env, (jsize) description.size());
+    jniUtil->SetByteArrayRegion(env, ret, 0, (jsize) description.size(),
+                                reinterpret_cast<const jbyte*>(description.data()));
+    return ret;
+}
+
+void knn_jni::faiss_wrapper::StartQueryCapture(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jstring pathJ,
+                                               jlong capacityJ, jfloat rateJ) {
+    if (pathJ == nullptr) {
+        throw std::runtime_error("Query capture path cannot be null");
+    }
+
+    std::string pathCpp(jniUtil->ConvertJavaStringToCppString(env, pathJ));
+    knn_jni::query_capture::Start(pathCpp, capacityJ, rateJ);
+}
+
+void knn_jni::faiss_wrapper::StopQueryCapture() {
+    knn_jni::query_capture::Stop();
+}
+
+void knn_jni::faiss_wrapper::SetThreadPoolSize(jint numThreadsJ) {
+    knn_jni::thread_pool::CpuBudget::Instance().Resize(numThreadsJ);
 }
 
 void knn_jni::faiss_wrapper::InitLibrary() {
@@ -244,6 +532,15 @@ jbyteArray knn_jni::faiss_wrapper::TrainIndex(knn_jni::JNIUtilInterface * jniUti
         throw std::runtime_error("Parameters cannot be null");
     }
 
+    auto *trainingVectorsPointerCpp = reinterpret_cast<std::vector<float>*>(trainVectorsPointerJ);
+    if (trainingVectorsPointerCpp == nullptr) {
+        throw std::runtime_error("Invalid pointer to training vectors");
+    }
+
+    if (dimensionJ <= 0) {
+        throw std::runtime_error("Dimension must be positive");
+    }
+
     auto parametersCpp = jniUtil->ConvertJavaMapToCppMap(env, parametersJ);
 
     jobject spaceTypeJ = knn_jni::GetJObjectFromMapOrThrow(parametersCpp, knn_jni::SPACE_TYPE);
@@ -254,6 +551,11 @@ jbyteArray knn_jni::faiss_wrapper::TrainIndex(knn_jni::JNIUtilInterface * jniUti
     jobject indexDescriptionJ = knn_jni::GetJObjectFromMapOrThrow(parametersCpp, knn_jni::INDEX_DESCRIPTION);
     std::string indexDescriptionCpp(jniUtil->ConvertJavaObjectToCppString(env, indexDescriptionJ));
 
+    // The arguments are valid, so every train_start is matched by a train_done unless the training itself fails
+    int numVectors = trainingVectorsPointerCpp->size()/(int) dimensionJ;
+    KNN_USDT(opensearch_knn_faiss, train_start, numVectors, (int) dimensionJ);
+    knn_jni::usdt::Stopwatch stopwatch(KNN_USDT_ENABLED(opensearch_knn_faiss, train_done));
+
     std::unique_ptr<faiss::Index> indexWriter;
     indexWriter.reset(faiss::index_factory((int) dimensionJ, indexDescriptionCpp.c_str(), metric));
 
@@ -264,25 +566,30 @@ jbyteArray knn_jni::faiss_wrapper::TrainIndex(knn_jni::JNIUtilInterface * jniUti
         indexHnswPq->storage->metric_type = metric;
     }
 
-    // Set thread count if it is passed in as a parameter. Setting this variable will only impact the current thread
-    if(parametersCpp.find(knn_jni::INDEX_THREAD_QUANTITY) != parametersCpp.end()) {
-        auto threadCount = jniUtil->ConvertJavaObjectToCppInteger(env, parametersCpp[knn_jni::INDEX_THREAD_QUANTITY]);
-        omp_set_num_threads(threadCount);
-    }
+    // Borrow the requested number of threads from the native CPU budget. Fewer are granted, or the training waits, when
+    // other builds and trainings hold the budget
+    knn_jni::thread_pool::ThreadBudget threadBudget(knn_jni::GetRequestedThreadCount(jniUtil, env, parametersCpp));
+    int threadCount = threadBudget.Count();
+    auto schedulingPolicy = knn_jni::GetBuildSchedulingPolicy(jniUtil, env, parametersCpp);
 
     // Add extra parameters that cant be configured with the index factory
+    bool balanced = false;
     if(parametersCpp.find(knn_jni::PARAMETERS) != parametersCpp.end()) {
         jobject subParametersJ = parametersCpp[knn_jni::PARAMETERS];
         auto subParametersCpp = jniUtil->ConvertJavaMapToCppMap(env, subParametersJ);
         SetExtraParameters(jniUtil, env, subParametersCpp, indexWriter.get());
+        balanced = knn_jni::IsBalancedClustering(jniUtil, env, subParametersCpp);
         jniUtil->DeleteLocalRef(env, subParametersJ);
     }
 
     // Train index if needed
-    auto *trainingVectorsPointerCpp = reinterpret_cast<std::vector<float>*>(trainVectorsPointerJ);
-    int numVectors = trainingVectorsPointerCpp->size()/(int) dimensionJ;
     if(!indexWriter->is_trained) {
-        InternalTrainIndex(indexWriter.get(), numVectors, trainingVectorsPointerCpp->data());
+        knn_jni::qos::RunWithPolicy(schedulingPolicy, [&]() {
+            if (threadCount > 0) {
+                omp_set_num_threads(threadCount);
+            }
+            InternalTrainIndex(indexWriter.get(), numVectors, trainingVectorsPointerCpp->data(), balanced);
+        });
     }
     jniUtil->DeleteLocalRef(env, parametersJ);
 
@@ -300,9 +607,74 @@ jbyteArray knn_jni::faiss_wrapper::TrainIndex(knn_jni::JNIUtilInterface * jniUti
 
     jbyteArray ret = jniUtil->NewByteArray(env, vectorIoWriter.data.size());
     jniUtil->SetByteArrayRegion(env, ret, 0, vectorIoWriter.data.size(), jbytesBuffer.get());
+    KNN_USDT(opensearch_knn_faiss, train_done, numVectors, (int) dimensionJ, (int64_t) vectorIoWriter.data.size(),
+             stopwatch.Elapsed());
     return ret;
 }
 
+jintArray knn_jni::faiss_wrapper::ListSizes(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                           jbyteArray templateIndexJ, jlong trainVectorsPointerJ) {
+    if (templateIndexJ == nullptr) {
+        throw std::runtime_error("Template index cannot be null");
+    }
+
+    auto *trainingVectorsPointerCpp = reinterpret_cast<std::vector<float>*>(trainVectorsPointerJ);
+    if (trainingVectorsPointerCpp == nullptr) {
+        throw std::runtime_error("Invalid pointer to training vectors");
+    }
+
+    std::unique_ptr<faiss::Index> templateIndex(ReadTemplateIndex(jniUtil, env, templateIndexJ));
+    faiss::Index::idx_t numVectors = trainingVectorsPointerCpp->size() / templateIndex->d;
+    auto sizes = AssignedListSizes(templateIndex.get(), numVectors, trainingVectorsPointerCpp->data());
+
+    std::vector<jint> sizesJ(sizes.begin(), sizes.end());
+    jintArray ret = jniUtil->NewIntArray(env, (jsize) sizesJ.size());
+    jniUtil->SetIntArrayRegion(env, ret, 0, (jsize) sizesJ.size(), sizesJ.data());
+    return ret;
+}
+
+jfloatArray knn_jni::faiss_wrapper::Calibrate(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                              jlong queryVectorsPointerJ, jint kJ, jfloat targetRecallJ) {
+    auto *indexReader = reinterpret_cast<faiss::Index*>(indexPointerJ);
+    if (indexReader == nullptr) {
+        throw std::runtime_error("Invalid pointer to index");
+    }
+
+    const std::vector<float>& queries = CalibrationQueries(queryVectorsPointerJ, indexReader);
+    int64_t numQueries = queries.size() / indexReader->d;
+    auto groundTruth = ExhaustiveNeighbors(indexReader, queries.data(), numQueries, kJ);
+    auto calibration = knn_jni::faiss_wrapper::Calibrate(indexReader, queries.data(), numQueries, kJ, targetRecallJ,
+                                                         groundTruth);
+    return CalibrationToJava(jniUtil, env, calibration);
+}
+
+jfloatArray knn_jni::faiss_wrapper::CalibrateTemplate(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                      jbyteArray templateIndexJ, jlong trainVectorsPointerJ,
+                                                      jlong queryVectorsPointerJ, jint kJ, jfloat targetRecallJ) {
+    std::unique_ptr<faiss::Index> index(ReadTemplateIndex(jniUtil, env, templateIndexJ));
+    auto *trainingVectorsPointerCpp = reinterpret_cast<std::vector<float>*>(trainVectorsPointerJ);
+    if (trainingVectorsPointerCpp == nullptr) {
+        throw std::runtime_error("Invalid pointer to training vectors");
+    }
+
+    const std::vector<float>& queries = CalibrationQueries(queryVectorsPointerJ, index.get());
+    int64_t numQueries = queries.size() / index->d;
+    faiss::Index::idx_t numVectors = trainingVectorsPointerCpp->size() / index->d;
+    index->add(numVectors, trainingVectorsPointerCpp->data());
+
+    // The training vectors are at hand, so the ground truth compares them exactly rather than their codes
+    knn_jni::vecs_io::Matrix<int32_t> groundTruth;
+    knn_jni::vecs_io::Matrix<float> groundTruthDistances;
+    const std::string& spaceType = index->metric_type == faiss::METRIC_L2 ? knn_jni::L2 : knn_jni::INNER_PRODUCT;
+    knn_jni::ground_truth::ComputeGroundTruth(trainingVectorsPointerCpp->data(), numVectors, queries.data(),
+                                              numQueries, (int) index->d, kJ, spaceType, omp_get_max_threads(),
+                                              groundTruth, groundTruthDistances);
+
+    auto calibration = knn_jni::faiss_wrapper::Calibrate(index.get(), queries.data(), numQueries, kJ, targetRecallJ,
+                                                         groundTruth);
+    return CalibrationToJava(jniUtil, env, calibration);
+}
+
 faiss::MetricType TranslateSpaceToMetric(const std::string& spaceType) {
     if (spaceType == knn_jni::L2) {
         return faiss::METRIC_L2;
@@ -318,6 +690,11 @@ faiss::MetricType TranslateSpaceToMetric(const std::string& spaceType) {
 void SetExtraParameters(knn_jni::JNIUtilInterface * jniUtil, JNIEnv *env,
                         const std::unordered_map<std::string, jobject>& parametersCpp, faiss::Index * index) {
 
+    if (auto * indexPreTransform = dynamic_cast<faiss::IndexPreTransform*>(index)) {
+        SetExtraParameters(jniUtil, env, parametersCpp, indexPreTransform->index);
+        return;
+    }
+
     std::unordered_map<std::string,jobject>::const_iterator value;
     if (auto * indexIvf = dynamic_cast<faiss::IndexIVF*>(index)) {
         if ((value = parametersCpp.find(knn_jni::NPROBES)) != parametersCpp.end()) {
@@ -343,11 +720,218 @@ void SetExtraParameters(knn_jni::JNIUtilInterface * jniUtil, JNIEnv *env,
     }
 }
 
-void InternalTrainIndex(faiss::Index * index, faiss::Index::idx_t n, const float* x) {
+void InternalCreateIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ,
+                         const std::vector<float>& dataset, int numVectors, int dim, jstring indexPathJ,
+                         jobject parametersJ, bool int8Vectors) {
+    KNN_USDT(opensearch_knn_faiss, build_start, numVectors, dim);
+    knn_jni::usdt::Stopwatch stopwatch(KNN_USDT_ENABLED(opensearch_knn_faiss, build_done));
+
+    // parametersJ is a Java Map<String, Object>. ConvertJavaMapToCppMap converts it to a c++ map<string, jobject>
+    // so that it is easier to access.
+    auto parametersCpp = jniUtil->ConvertJavaMapToCppMap(env, parametersJ);
+
+    // Get space type for this index
+    jobject spaceTypeJ = knn_jni::GetJObjectFromMapOrThrow(parametersCpp, knn_jni::SPACE_TYPE);
+    std::string spaceTypeCpp(jniUtil->ConvertJavaObjectToCppString(env, spaceTypeJ));
+    faiss::MetricType metric = TranslateSpaceToMetric(spaceTypeCpp);
+
+    int numIds = jniUtil->GetJavaIntArrayLength(env, idsJ);
+    if (numIds != numVectors) {
+        throw std::runtime_error("Number of IDs does not match number of vectors");
+    }
+
+    // Create faiss index
+    jobject indexDescriptionJ = knn_jni::GetJObjectFromMapOrThrow(parametersCpp, knn_jni::INDEX_DESCRIPTION);
+    std::string indexDescriptionCpp(jniUtil->ConvertJavaObjectToCppString(env, indexDescriptionJ));
+
+    std::unique_ptr<faiss::Index> indexWriter;
+    indexWriter.reset(faiss::index_factory(dim, indexDescriptionCpp.c_str(), metric));
+
+    // Borrow the requested number of threads from the native CPU budget. Fewer are granted, or the build waits, when
+    // other builds hold the budget
+    knn_jni::thread_pool::ThreadBudget threadBudget(knn_jni::GetRequestedThreadCount(jniUtil, env, parametersCpp));
+    int threadCount = threadBudget.Count();
+    auto schedulingPolicy = knn_jni::GetBuildSchedulingPolicy(jniUtil, env, parametersCpp);
+
+    // Add extra parameters that cant be configured with the index factory
+    auto reorderStrategy = knn_jni::graph_reorder::ReorderStrategy::NONE;
+    auto graphEncoding = knn_jni::adjacency_codec::GraphEncoding::FIXED;
+    if(parametersCpp.find(knn_jni::PARAMETERS) != parametersCpp.end()) {
+        jobject subParametersJ = parametersCpp[knn_jni::PARAMETERS];
+        auto subParametersCpp = jniUtil->ConvertJavaMapToCppMap(env, subParametersJ);
+        SetExtraParameters(jniUtil, env, subParametersCpp, indexWriter.get());
+        reorderStrategy = knn_jni::GetGraphReorderStrategy(jniUtil, env, subParametersCpp);
+        graphEncoding = knn_jni::GetGraphEncoding(jniUtil, env, subParametersCpp);
+        jniUtil->DeleteLocalRef(env, subParametersJ);
+    }
+    CheckGraphReorder(indexWriter.get(), reorderStrategy);
+    jniUtil->DeleteLocalRef(env, parametersJ);
+
+    // The range of int8 vectors is known up front, so an 8 bit scalar quantizer needs no training data
+    if (int8Vectors) {
+        SetInt8ScalarQuantizerRange(indexWriter.get());
+    }
+
+    // Check that the index does not need to be trained
+    if(!indexWriter->is_trained) {
+        throw std::runtime_error("Index is not trained");
+    }
+
+    auto idVector = jniUtil->ConvertJavaIntArrayToCppIntVector(env, idsJ);
+    faiss::IndexIDMap idMap = faiss::IndexIDMap(indexWriter.get());
+    knn_jni::qos::RunWithPolicy(schedulingPolicy, [&]() {
+        // The OpenMP thread count is per thread, so it has to be set on the thread running the build
+        if (threadCount > 0) {
+            omp_set_num_threads(threadCount);
+        }
+        InternalAddWithIds(&idMap, numVectors, dim, dataset.data(), idVector.data(), schedulingPolicy);
+        ReorderHnswGraph(&idMap, reorderStrategy);
+    });
+
+    // Write the index to disk
+    std::string indexPathCpp(jniUtil->ConvertJavaStringToCppString(env, indexPathJ));
+    InternalWriteIndex(&idMap, graphEncoding, indexPathCpp);
+    KNN_USDT(opensearch_knn_faiss, build_done, numVectors, dim, indexPathCpp.c_str(), stopwatch.Elapsed());
+}
+
+void SetInt8ScalarQuantizerRange(faiss::Index * index) {
+    auto * indexSq = dynamic_cast<faiss::IndexScalarQuantizer*>(index);
+    if (auto * indexHnsw = dynamic_cast<faiss::IndexHNSW*>(index)) {
+        indexSq = dynamic_cast<faiss::IndexScalarQuantizer*>(indexHnsw->storage);
+    }
+
+    if (indexSq == nullptr || indexSq->is_trained) {
+        return;
+    }
+
+    // A code decodes to vmin + (code + 0.5) * vdiff / 255. With vdiff = 255, the value v gets code v + 128 and
+    // decodes back to v. The half step of slack keeps float rounding in the encoder from landing on the wrong code
+    const float vmin = -128.5f;
+    const float vdiff = 255.0f;
+    auto & sq = indexSq->sq;
+    switch (sq.qtype) {
+        case faiss::ScalarQuantizer::QT_8bit_uniform:
+            sq.trained = {vmin, vdiff};
+            break;
+        case faiss::ScalarQuantizer::QT_8bit:
+            // One range per component: all the minimums, then all the spans
+            sq.trained.assign(2 * sq.d, vmin);
+            std::fill(sq.trained.begin() + sq.d, sq.trained.end(), vdiff);
+            break;
+        default:
+            return;
+    }
+    indexSq->is_trained = true;
+    index->is_trained = true;
+}
+
+void InternalCreateIndexFromTemplate(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ,
+                                     const std::vector<float>& dataset, int numVectors, int dim, jstring indexPathJ,
+                                     jbyteArray templateIndexJ, jobject parametersJ) {
+    KNN_USDT(opensearch_knn_faiss, build_start, numVectors, dim);
+    knn_jni::usdt::Stopwatch stopwatch(KNN_USDT_ENABLED(opensearch_knn_faiss, build_done));
+
+    // Borrow the requested number of threads from the native CPU budget. Fewer are granted, or the build waits, when
+    // other builds hold the budget
+    auto parametersCpp = jniUtil->ConvertJavaMapToCppMap(env, parametersJ);
+    knn_jni::thread_pool::ThreadBudget threadBudget(knn_jni::GetRequestedThreadCount(jniUtil, env, parametersCpp));
+    int threadCount = threadBudget.Count();
+    auto schedulingPolicy = knn_jni::GetBuildSchedulingPolicy(jniUtil, env, parametersCpp);
+    jniUtil->DeleteLocalRef(env, parametersJ);
+
+    int numIds = jniUtil->GetJavaIntArrayLength(env, idsJ);
+    if (numIds != numVectors) {
+        throw std::runtime_error("Number of IDs does not match number of vectors");
+    }
+
+    // Create faiss index
+    std::unique_ptr<faiss::Index> indexWriter(ReadTemplateIndex(jniUtil, env, templateIndexJ));
+
+    auto idVector = jniUtil->ConvertJavaIntArrayToCppIntVector(env, idsJ);
+    faiss::IndexIDMap idMap =  faiss::IndexIDMap(indexWriter.get());
+    knn_jni::qos::RunWithPolicy(schedulingPolicy, [&]() {
+        // The OpenMP thread count is per thread, so it has to be set on the thread running the build
+        if (threadCount > 0) {
+            omp_set_num_threads(threadCount);
+        }
+        InternalAddWithIds(&idMap, numVectors, dim, dataset.data(), idVector.data(), schedulingPolicy);
+    });
+
+    // Write the index to disk
+    std::string indexPathCpp(jniUtil->ConvertJavaStringToCppString(env, indexPathJ));
+    InternalWriteIndex(&idMap, knn_jni::adjacency_codec::GraphEncoding::FIXED, indexPathCpp);
+    KNN_USDT(opensearch_knn_faiss, build_done, numVectors, dim, indexPathCpp.c_str(), stopwatch.Elapsed());
+}
+
+const std::vector<float>& CalibrationQueries(jlong queryVectorsPointerJ, const faiss::Index * index) {
+    auto *queryVectorsCpp = reinterpret_cast<std::vector<float>*>(queryVectorsPointerJ);
+    if (queryVectorsCpp == nullptr) {
+        throw std::runtime_error("Invalid pointer to query vectors");
+    }
+
+    if (queryVectorsCpp->size() % index->d != 0) {
+        throw std::runtime_error("Query vectors do not match the dimension of the index");
+    }
+    return *queryVectorsCpp;
+}
+
+jfloatArray CalibrationToJava(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                              const knn_jni::faiss_wrapper::Calibration& calibration) {
+    std::vector<jfloat> valuesJ;
+    auto append = [&valuesJ](const knn_jni::faiss_wrapper::CalibrationPoint& point) {
+        valuesJ.push_back((jfloat) point.value);
+        valuesJ.push_back((jfloat) point.recall);
+        valuesJ.push_back((jfloat) point.latencyMicros);
+    };
+    append(calibration.frontier[calibration.recommended]);
+    for (const auto& point : calibration.frontier) {
+        append(point);
+    }
+
+    jfloatArray ret = jniUtil->NewFloatArray(env, (jsize) valuesJ.size());
+    jniUtil->SetFloatArrayRegion(env, ret, 0, (jsize) valuesJ.size(), valuesJ.data());
+    return ret;
+}
+
+faiss::Index * ReadTemplateIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jbyteArray templateIndexJ) {
+    // Get vector of bytes from jbytearray
+    int indexBytesCount = jniUtil->GetJavaBytesArrayLength(env, templateIndexJ);
+    jbyte * indexBytesJ = jniUtil->GetByteArrayElements(env, templateIndexJ, nullptr);
+
+    faiss::VectorIOReader vectorIoReader;
+    for (int i = 0; i < indexBytesCount; i++) {
+        vectorIoReader.data.push_back((uint8_t) indexBytesJ[i]);
+    }
+    jniUtil->ReleaseByteArrayElements(env, templateIndexJ, indexBytesJ, JNI_ABORT);
+
+    return faiss::read_index(&vectorIoReader, 0);
+}
+
+void InternalTrainIndex(faiss::Index * index, faiss::Index::idx_t n, const float* x, bool balanced) {
+    if (auto * indexPreTransform = dynamic_cast<faiss::IndexPreTransform*>(index)) {
+        // Each transform allocates its output; the previous one is freed once the next has been computed
+        std::unique_ptr<float[]> transformed;
+        const float* xt = x;
+        for (auto * transform : indexPreTransform->chain) {
+            if (!transform->is_trained) {
+                transform->train(n, xt);
+            }
+            transformed.reset(transform->apply(n, xt));
+            xt = transformed.get();
+        }
+
+        InternalTrainIndex(indexPreTransform->index, n, xt, balanced);
+        indexPreTransform->is_trained = indexPreTransform->index->is_trained;
+        return;
+    }
+
     if (auto * indexIvf = dynamic_cast<faiss::IndexIVF*>(index)) {
         if (indexIvf->quantizer_trains_alone == 2) {
             InternalTrainIndex(indexIvf->quantizer, n, x);
         }
+        if (balanced) {
+            TrainBalancedQuantizer(indexIvf, n, x);
+        }
         indexIvf->make_direct_map();
     }
 
@@ -355,3 +939,218 @@ void InternalTrainIndex(faiss::Index * index, faiss::Index::idx_t n, const float
         index->train(n, x);
     }
 }
+
+void TrainBalancedQuantizer(faiss::IndexIVF * indexIvf, faiss::Index::idx_t n, const float* x) {
+    if (indexIvf->quantizer_trains_alone != 0 || dynamic_cast<faiss::IndexFlat*>(indexIvf->quantizer) == nullptr) {
+        throw std::runtime_error("Balanced clustering needs a flat coarse quantizer");
+    }
+
+    std::vector<float> centroids(indexIvf->nlist * indexIvf->d);
+    knn_jni::faiss_wrapper::TrainBalancedCentroids(n, (int) indexIvf->d, x, (int) indexIvf->nlist,
+                                                   indexIvf->metric_type, indexIvf->cp, BALANCED_MAX_IMBALANCE,
+                                                   BALANCED_ITERATIONS, centroids.data());
+
+    // Faiss skips training a quantizer that already holds nlist centroids
+    indexIvf->quantizer->reset();
+    indexIvf->quantizer->add(indexIvf->nlist, centroids.data());
+    indexIvf->quantizer->is_trained = true;
+}
+
+void InternalAddWithIds(faiss::Index * index, faiss::Index::idx_t n, int dim, const float* x,
+                        const faiss::Index::idx_t* ids, knn_jni::qos::SchedulingPolicy schedulingPolicy) {
+    // Vectors added per call to add_with_ids. Small enough that a build notices queries quickly, large enough that
+    // OpenMP still parallelizes each batch well
+    const faiss::Index::idx_t batchSize = 16384;
+
+    for (faiss::Index::idx_t i = 0; i < n; i += batchSize) {
+        knn_jni::qos::YieldToQueries(schedulingPolicy);
+        faiss::Index::idx_t count = std::min(batchSize, n - i);
+        index->add_with_ids(count, x + i * dim, ids + i);
+    }
+}
+
+void CheckGraphReorder(const faiss::Index * index, knn_jni::graph_reorder::ReorderStrategy strategy) {
+    if (strategy == knn_jni::graph_reorder::ReorderStrategy::NONE) {
+        return;
+    }
+
+    if (strategy == knn_jni::graph_reorder::ReorderStrategy::LOCALITY) {
+        throw std::runtime_error("faiss only supports the \"none\", \"bfs\" and \"rcm\" graph reorder strategies");
+    }
+
+    auto * indexHnsw = dynamic_cast<const faiss::IndexHNSW*>(index);
+    if (indexHnsw == nullptr) {
+        throw std::runtime_error("Graph reordering needs an HNSW index");
+    }
+
+    // Vectors are moved by reconstructing and re-adding them, which is only lossless for flat storage
+    if (dynamic_cast<const faiss::IndexFlat*>(indexHnsw->storage) == nullptr) {
+        throw std::runtime_error("Graph reordering needs an HNSW index with flat storage");
+    }
+}
+
+void ReorderHnswGraph(faiss::IndexIDMap * idMap, knn_jni::graph_reorder::ReorderStrategy strategy) {
+    auto * indexHnsw = dynamic_cast<faiss::IndexHNSW*>(idMap->index);
+    if (strategy == knn_jni::graph_reorder::ReorderStrategy::NONE || indexHnsw->ntotal == 0) {
+        return;
+    }
+    auto * storage = dynamic_cast<faiss::IndexFlat*>(indexHnsw->storage);
+
+    faiss::HNSW& hnsw = indexHnsw->hnsw;
+    faiss::Index::idx_t numNodes = indexHnsw->ntotal;
+
+    // Every node is present in layer 0, so the order is computed on the base layer
+    std::vector<int64_t> baseOffsets;
+    std::vector<int32_t> baseAdjacency;
+    baseOffsets.reserve(numNodes + 1);
+    for (faiss::Index::idx_t i = 0; i < numNodes; ++i) {
+        size_t begin, end;
+        hnsw.neighbor_range(i, 0, &begin, &end);
+        baseOffsets.push_back(baseAdjacency.size());
+        baseAdjacency.insert(baseAdjacency.end(), hnsw.neighbors.begin() + begin, hnsw.neighbors.begin() + end);
+    }
+    baseOffsets.push_back(baseAdjacency.size());
+
+    auto order = knn_jni::graph_reorder::ComputeOrder(strategy, baseOffsets, baseAdjacency, hnsw.entry_point);
+    auto newIds = knn_jni::graph_reorder::InvertOrder(order);
+
+    // Rewrite the links of all layers in the new order
+    std::vector<int> levels(numNodes);
+    std::vector<size_t> offsets(numNodes + 1, 0);
+    for (faiss::Index::idx_t i = 0; i < numNodes; ++i) {
+        int32_t oldId = order[i];
+        levels[i] = hnsw.levels[oldId];
+        offsets[i + 1] = offsets[i] + (hnsw.offsets[oldId + 1] - hnsw.offsets[oldId]);
+    }
+
+    std::vector<faiss::HNSW::storage_idx_t> neighbors(offsets[numNodes]);
+    for (faiss::Index::idx_t i = 0; i < numNodes; ++i) {
+        size_t source = hnsw.offsets[order[i]];
+        for (size_t j = offsets[i]; j < offsets[i + 1]; ++j, ++source) {
+            faiss::HNSW::storage_idx_t neighbor = hnsw.neighbors[source];
+            neighbors[j] = neighbor < 0 ? neighbor : newIds[neighbor];
+        }
+    }
+
+    hnsw.levels.swap(levels);
+    hnsw.offsets.swap(offsets);
+    hnsw.neighbors.swap(neighbors);
+    hnsw.entry_point = newIds[hnsw.entry_point];
+
+    // Move the vectors and the ids
+    std::vector<float> vectors((size_t) numNodes * storage->d);
+    for (faiss::Index::idx_t i = 0; i < numNodes; ++i) {
+        storage->reconstruct(order[i], vectors.data() + (size_t) i * storage->d);
+    }
+    storage->reset();
+    storage->add(numNodes, vectors.data());
+
+    std::vector<faiss::Index::idx_t> ids(numNodes);
+    for (faiss::Index::idx_t i = 0; i < numNodes; ++i) {
+        ids[i] = idMap->id_map[order[i]];
+    }
+    idMap->id_map.swap(ids);
+}
+
+void InternalWriteIndex(faiss::IndexIDMap * idMap, knn_jni::adjacency_codec::GraphEncoding graphEncoding,
+                        const std::string& indexPath) {
+    auto * indexHnsw = dynamic_cast<faiss::IndexHNSW*>(idMap->index);
+    if (graphEncoding == knn_jni::adjacency_codec::GraphEncoding::DELTA && indexHnsw != nullptr) {
+        knn_jni::compact_id_map::CompactIdMap ids(idMap->id_map);
+        knn_jni::faiss_wrapper::CompressedHnswIndex compressedIndex(indexHnsw, std::move(ids), false);
+        knn_jni::faiss_wrapper::WriteCompressedHnswIndex(compressedIndex, indexPath);
+        return;
+    }
+
+    faiss::write_index(idMap, indexPath.c_str());
+}
+
+jobjectArray InternalQueryIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                jfloatArray queryVectorJ, jint kJ, const knn_jni::live_docs::LiveDocs * liveDocs) {
+
+    if (queryVectorJ == nullptr) {
+        throw std::runtime_error("Query Vector cannot be null");
+    }
+
+    float* rawQueryvector = jniUtil->GetFloatArrayElements(env, queryVectorJ, nullptr);
+    jobjectArray results;
+    try {
+        results = InternalSearch(jniUtil, env, indexPointerJ, rawQueryvector, kJ, liveDocs);
+    } catch (...) {
+        jniUtil->ReleaseFloatArrayElements(env, queryVectorJ, rawQueryvector, JNI_ABORT);
+        throw;
+    }
+    jniUtil->ReleaseFloatArrayElements(env, queryVectorJ, rawQueryvector, JNI_ABORT);
+    return results;
+}
+
+jobjectArray InternalSearch(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                            const float* queryVector, jint kJ, const knn_jni::live_docs::LiveDocs * liveDocs) {
+
+    auto *indexReader = reinterpret_cast<faiss::Index*>(indexPointerJ);
+
+    if (indexReader == nullptr) {
+        throw std::runtime_error("Invalid pointer to index");
+    }
+    KNN_USDT(opensearch_knn_faiss, query_start, indexReader, (int) kJ, liveDocs != nullptr);
+    knn_jni::usdt::Stopwatch stopwatch(KNN_USDT_ENABLED(opensearch_knn_faiss, query_done));
+
+    std::vector<float> dis(kJ);
+    std::vector<faiss::Index::idx_t> ids(kJ);
+
+    bool capture = knn_jni::query_capture::ShouldCapture();
+    std::chrono::steady_clock::time_point start;
+    if (capture) {
+        start = std::chrono::steady_clock::now();
+    }
+    {
+        // Builds running on this node back off while the query is in flight
+        knn_jni::qos::ScopedQuery scopedQuery;
+        if (liveDocs == nullptr) {
+            indexReader->search(1, queryVector, kJ, dis.data(), ids.data());
+        } else {
+            knn_jni::faiss_wrapper::SearchLiveDocs(indexReader, *liveDocs, 1, queryVector, kJ, dis.data(),
+                                                   ids.data());
+        }
+    }
+    std::chrono::nanoseconds latency(0);
+    if (capture) {
+        latency = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    }
+
+    // A fraction of the queries is checked against an exhaustive search in the background. Queries with deleted docs
+    // are left out, since the docs they skip would count as misses
+    if (liveDocs == nullptr) {
+        auto sampler = knn_jni::faiss_wrapper::GetRecallSampler(indexReader);
+        if (sampler != nullptr && sampler->ShouldSample()) {
+            sampler->Sample(queryVector, kJ, ids.data());
+        }
+    }
+
+    // If there are not k results, the results will be padded with -1. Find the first -1, and set result size to that
+    // index
+    int resultSize = kJ;
+    auto it = std::find(ids.begin(), ids.end(), -1);
+    if (it != ids.end()) {
+        resultSize = it - ids.begin();
+    }
+
+    // Sampled queries are written to the capture log for offline replay
+    if (capture) {
+        knn_jni::query_capture::Capture(indexReader, queryVector, (int) indexReader->d, kJ, liveDocs != nullptr,
+                                        (uint64_t) latency.count(), ids.data(), resultSize);
+    }
+
+    jclass resultClass = jniUtil->FindClass(env,"org/opensearch/knn/index/KNNQueryResult");
+    jmethodID allArgs = jniUtil->FindMethod(env, "org/opensearch/knn/index/KNNQueryResult", "<init>");
+
+    jobjectArray results = jniUtil->NewObjectArray(env, resultSize, resultClass, nullptr);
+
+    jobject result;
+    for(int i = 0; i < resultSize; ++i) {
+        result = jniUtil->NewObject(env, resultClass, allArgs, ids[i], dis[i]);
+        jniUtil->SetObjectArrayElement(env, results, i, result);
+    }
+    KNN_USDT(opensearch_knn_faiss, query_done, indexReader, (int) kJ, resultSize, stopwatch.Elapsed());
+    return results;
+}
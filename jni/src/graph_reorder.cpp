@@ -0,0 +1,196 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "graph_reorder.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+
+namespace {
+    // Number of random hyperplanes used by ComputeLocalityOrder
+    const int LOCALITY_HASH_BITS = 16;
+
+    uint32_t GrayToBinary(uint32_t gray) {
+        for (uint32_t shift = 1; shift < 32; shift <<= 1) {
+            gray ^= gray >> shift;
+        }
+        return gray;
+    }
+
+    int64_t Degree(const std::vector<int64_t>& offsets, const std::vector<int32_t>& adjacency, int32_t node) {
+        int64_t degree = 0;
+        for (int64_t j = offsets[node]; j < offsets[node + 1] && adjacency[j] >= 0; ++j) {
+            degree++;
+        }
+        return degree;
+    }
+}
+
+knn_jni::graph_reorder::ReorderStrategy knn_jni::graph_reorder::ParseReorderStrategy(const std::string& strategy) {
+    if (strategy == "none") {
+        return ReorderStrategy::NONE;
+    }
+
+    if (strategy == "bfs") {
+        return ReorderStrategy::BFS;
+    }
+
+    if (strategy == "rcm") {
+        return ReorderStrategy::RCM;
+    }
+
+    if (strategy == "locality") {
+        return ReorderStrategy::LOCALITY;
+    }
+
+    throw std::runtime_error("Invalid graph reorder strategy \"" + strategy + "\"");
+}
+
+std::vector<int32_t> knn_jni::graph_reorder::ComputeOrder(ReorderStrategy strategy,
+                                                          const std::vector<int64_t>& offsets,
+                                                          const std::vector<int32_t>& adjacency, int32_t start) {
+    if (strategy == ReorderStrategy::LOCALITY) {
+        throw std::runtime_error("Graph reorder strategy \"locality\" does not apply to a built graph");
+    }
+
+    if (offsets.empty()) {
+        return std::vector<int32_t>();
+    }
+
+    auto numNodes = (int32_t) (offsets.size() - 1);
+    std::vector<int32_t> order;
+    order.reserve(numNodes);
+
+    if (strategy == ReorderStrategy::NONE || numNodes == 0) {
+        order.resize(numNodes);
+        std::iota(order.begin(), order.end(), 0);
+        return order;
+    }
+
+    std::vector<int64_t> degrees;
+    std::vector<int32_t> roots(numNodes);
+    std::iota(roots.begin(), roots.end(), 0);
+    if (strategy == ReorderStrategy::RCM) {
+        degrees.resize(numNodes);
+        for (int32_t i = 0; i < numNodes; ++i) {
+            degrees[i] = Degree(offsets, adjacency, i);
+        }
+
+        // Disconnected components are started from their lowest degree node, as Cuthill-McKee prescribes
+        std::stable_sort(roots.begin(), roots.end(), [&degrees](int32_t a, int32_t b) {
+            return degrees[a] < degrees[b];
+        });
+    }
+
+    if (start < 0 || start >= numNodes) {
+        start = roots[0];
+    }
+
+    std::vector<bool> visited(numNodes, false);
+    std::vector<int32_t> neighbors;
+    size_t nextRoot = 0;
+    int32_t root = start;
+    while (true) {
+        visited[root] = true;
+        order.push_back(root);
+
+        // The order vector doubles as the BFS queue
+        for (size_t head = order.size() - 1; head < order.size(); ++head) {
+            int32_t node = order[head];
+            neighbors.clear();
+            for (int64_t j = offsets[node]; j < offsets[node + 1] && adjacency[j] >= 0; ++j) {
+                int32_t neighbor = adjacency[j];
+                if (neighbor < numNodes && !visited[neighbor]) {
+                    visited[neighbor] = true;
+                    neighbors.push_back(neighbor);
+                }
+            }
+
+            if (strategy == ReorderStrategy::RCM) {
+                std::stable_sort(neighbors.begin(), neighbors.end(), [&degrees](int32_t a, int32_t b) {
+                    return degrees[a] < degrees[b];
+                });
+            }
+            order.insert(order.end(), neighbors.begin(), neighbors.end());
+        }
+
+        while (nextRoot < roots.size() && visited[roots[nextRoot]]) {
+            nextRoot++;
+        }
+        if (nextRoot == roots.size()) {
+            break;
+        }
+        root = roots[nextRoot];
+    }
+
+    if (strategy == ReorderStrategy::RCM) {
+        std::reverse(order.begin(), order.end());
+    }
+    return order;
+}
+
+std::vector<int32_t> knn_jni::graph_reorder::ComputeLocalityOrder(const std::vector<const float*>& vectors, int dim) {
+    auto numVectors = (int32_t) vectors.size();
+    std::vector<int32_t> order(numVectors);
+    std::iota(order.begin(), order.end(), 0);
+    if (numVectors <= 1 || dim <= 0) {
+        return order;
+    }
+
+    // Hyperplanes go through the mean so that uncentered data still splits
+    std::vector<double> mean(dim, 0.0);
+    for (const float* vector : vectors) {
+        for (int j = 0; j < dim; ++j) {
+            mean[j] += vector[j];
+        }
+    }
+    for (int j = 0; j < dim; ++j) {
+        mean[j] /= numVectors;
+    }
+
+    // Fixed seed: the same input always produces the same layout
+    std::mt19937 generator(1234);
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<float> hyperplanes((size_t) LOCALITY_HASH_BITS * dim);
+    for (auto& value : hyperplanes) {
+        value = distribution(generator);
+    }
+
+    std::vector<uint32_t> ranks(numVectors);
+    for (int32_t i = 0; i < numVectors; ++i) {
+        uint32_t key = 0;
+        for (int bit = 0; bit < LOCALITY_HASH_BITS; ++bit) {
+            const float* hyperplane = hyperplanes.data() + (size_t) bit * dim;
+            double projection = 0.0;
+            for (int j = 0; j < dim; ++j) {
+                projection += hyperplane[j] * (vectors[i][j] - mean[j]);
+            }
+            key = (key << 1) | (projection > 0 ? 1u : 0u);
+        }
+        ranks[i] = GrayToBinary(key);
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&ranks](int32_t a, int32_t b) {
+        return ranks[a] < ranks[b];
+    });
+    return order;
+}
+
+std::vector<int32_t> knn_jni::graph_reorder::InvertOrder(const std::vector<int32_t>& order) {
+    std::vector<int32_t> inverse(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        inverse[order[i]] = (int32_t) i;
+    }
+    return inverse;
+}
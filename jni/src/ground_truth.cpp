@@ -0,0 +1,128 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "ground_truth.h"
+#include "jni_util.h"
+
+#include "faiss/IndexFlat.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <omp.h>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+
+namespace {
+    void Normalize(float* vectors, int64_t rows, int dim) {
+        for (int64_t i = 0; i < rows; ++i) {
+            float* row = vectors + i * dim;
+            float norm = 0;
+            for (int j = 0; j < dim; ++j) {
+                norm += row[j] * row[j];
+            }
+            norm = std::sqrt(norm);
+            if (norm > 0) {
+                for (int j = 0; j < dim; ++j) {
+                    row[j] /= norm;
+                }
+            }
+        }
+    }
+}
+
+void knn_jni::ground_truth::ComputeGroundTruth(const knn_jni::vecs_io::Matrix<float>& base,
+                                               const knn_jni::vecs_io::Matrix<float>& queries, int k,
+                                               const std::string& spaceType, int numThreads,
+                                               knn_jni::vecs_io::Matrix<int32_t>& neighbors,
+                                               knn_jni::vecs_io::Matrix<float>& distances) {
+    if (base.cols != queries.cols) {
+        throw std::runtime_error("Base and query vectors have different dimensions");
+    }
+
+    ComputeGroundTruth(base.data.data(), base.rows, queries.data.data(), queries.rows, (int) base.cols, k, spaceType,
+                       numThreads, neighbors, distances);
+}
+
+void knn_jni::ground_truth::ComputeGroundTruth(const float* base, int64_t numBase, const float* queries,
+                                               int64_t numQueries, int dim, int k, const std::string& spaceType,
+                                               int numThreads, knn_jni::vecs_io::Matrix<int32_t>& neighbors,
+                                               knn_jni::vecs_io::Matrix<float>& distances) {
+    if (k <= 0) {
+        throw std::runtime_error("k must be positive");
+    }
+
+    bool cosine = spaceType == knn_jni::COSINESIMIL;
+    std::unique_ptr<faiss::IndexFlat> index;
+    if (spaceType == knn_jni::L2) {
+        index.reset(new faiss::IndexFlatL2(dim));
+    } else if (spaceType == knn_jni::INNER_PRODUCT || cosine) {
+        index.reset(new faiss::IndexFlatIP(dim));
+    } else {
+        throw std::runtime_error("Invalid spaceType");
+    }
+
+    // Cosine similarity is the inner product of the normalized vectors
+    std::vector<float> normalizedQueries;
+    const float* searchQueries = queries;
+    if (cosine) {
+        std::vector<float> normalizedBase(base, base + numBase * dim);
+        Normalize(normalizedBase.data(), numBase, dim);
+        index->add(numBase, normalizedBase.data());
+        normalizedQueries.assign(queries, queries + numQueries * dim);
+        Normalize(normalizedQueries.data(), numQueries, dim);
+        searchQueries = normalizedQueries.data();
+    } else {
+        index->add(numBase, base);
+    }
+
+    std::vector<float> rawDistances(numQueries * k);
+    std::vector<faiss::Index::idx_t> labels(numQueries * k);
+    omp_set_num_threads(numThreads);
+    index->search(numQueries, searchQueries, k, rawDistances.data(), labels.data());
+
+    neighbors = knn_jni::vecs_io::Matrix<int32_t>(numQueries, k);
+    distances = knn_jni::vecs_io::Matrix<float>(numQueries, k);
+    for (size_t i = 0; i < labels.size(); ++i) {
+        neighbors.data[i] = (int32_t) labels[i];
+        if (spaceType == knn_jni::L2) {
+            distances.data[i] = std::sqrt(std::max(0.0f, rawDistances[i]));
+        } else if (cosine) {
+            distances.data[i] = 1 - rawDistances[i];
+        } else {
+            distances.data[i] = rawDistances[i];
+        }
+    }
+}
+
+double knn_jni::ground_truth::RecallAtR(const knn_jni::vecs_io::Matrix<int32_t>& results,
+                                        const knn_jni::vecs_io::Matrix<int32_t>& groundTruth, int r, int k) {
+    if (results.rows != groundTruth.rows) {
+        throw std::runtime_error("Results and ground truth have a different number of queries");
+    }
+
+    if (r <= 0 || r > results.cols || k > groundTruth.cols) {
+        throw std::runtime_error("Invalid values for r and k");
+    }
+
+    int64_t correct = 0;
+    for (int64_t i = 0; i < groundTruth.rows; ++i) {
+        std::unordered_set<int32_t> trueNeighbors(groundTruth.Row(i), groundTruth.Row(i) + k);
+        for (int j = 0; j < r; ++j) {
+            if (trueNeighbors.count(results.Row(i)[j]) > 0) {
+                ++correct;
+            }
+        }
+    }
+    return (double) correct / ((double) r * groundTruth.rows);
+}
@@ -0,0 +1,194 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+
+#include "half_precision.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <cpuid.h>
+#include <immintrin.h>
+#define KNN_HALF_PRECISION_F16C
+#endif
+
+
+namespace {
+    uint32_t FloatBits(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    float BitsToFloat(uint32_t bits) {
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+#ifdef KNN_HALF_PRECISION_F16C
+    // F16C is VEX encoded, so the OS also has to save the AVX registers
+    bool HasF16c() {
+        unsigned int eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+            return false;
+        }
+        const unsigned int osxsave = 1u << 27, avx = 1u << 28, f16c = 1u << 29;
+        if ((ecx & (osxsave | avx | f16c)) != (osxsave | avx | f16c)) {
+            return false;
+        }
+        unsigned int xcr0Low, xcr0High;
+        __asm__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+        return (xcr0Low & 6u) == 6u;
+    }
+
+    const bool HAS_F16C = HasF16c();
+
+    __attribute__((target("avx,f16c")))
+    void DecodeFp16F16c(const uint16_t* src, size_t n, float* dst) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(half));
+        }
+        for (; i < n; ++i) {
+            dst[i] = knn_jni::half_precision::Fp16ToFloat(src[i]);
+        }
+    }
+
+    __attribute__((target("avx,f16c")))
+    void EncodeFp16F16c(const float* src, size_t n, uint16_t* dst) {
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), half);
+        }
+        for (; i < n; ++i) {
+            dst[i] = knn_jni::half_precision::FloatToFp16(src[i]);
+        }
+    }
+#endif
+}
+
+knn_jni::half_precision::Encoding knn_jni::half_precision::ParseEncoding(const std::string& encoding) {
+    if (encoding == "fp16") {
+        return Encoding::FP16;
+    }
+
+    if (encoding == "bf16") {
+        return Encoding::BF16;
+    }
+
+    throw std::runtime_error("Invalid vector encoding \"" + encoding + "\"");
+}
+
+void knn_jni::half_precision::Decode(Encoding encoding, const uint16_t* src, size_t n, float* dst) {
+    if (encoding == Encoding::BF16) {
+        for (size_t i = 0; i < n; ++i) {
+            dst[i] = Bf16ToFloat(src[i]);
+        }
+        return;
+    }
+
+#ifdef KNN_HALF_PRECISION_F16C
+    if (HAS_F16C) {
+        DecodeFp16F16c(src, n, dst);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = Fp16ToFloat(src[i]);
+    }
+}
+
+void knn_jni::half_precision::Encode(Encoding encoding, const float* src, size_t n, uint16_t* dst) {
+    if (encoding == Encoding::BF16) {
+        for (size_t i = 0; i < n; ++i) {
+            dst[i] = FloatToBf16(src[i]);
+        }
+        return;
+    }
+
+#ifdef KNN_HALF_PRECISION_F16C
+    if (HAS_F16C) {
+        EncodeFp16F16c(src, n, dst);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = FloatToFp16(src[i]);
+    }
+}
+
+float knn_jni::half_precision::Fp16ToFloat(uint16_t value) {
+    uint32_t sign = (uint32_t) (value & 0x8000u) << 16;
+    uint32_t exponent = (value >> 10) & 0x1fu;
+    uint32_t mantissa = value & 0x3ffu;
+
+    if (exponent == 0x1fu) {
+        // Infinity or NaN
+        return BitsToFloat(sign | 0x7f800000u | (mantissa << 13));
+    }
+
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            return BitsToFloat(sign);
+        }
+        // Subnormal: mantissa * 2^-24, exact in float
+        float magnitude = (float) mantissa * BitsToFloat(0x33800000u);
+        return sign != 0 ? -magnitude : magnitude;
+    }
+
+    return BitsToFloat(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+uint16_t knn_jni::half_precision::FloatToFp16(float value) {
+    uint32_t bits = FloatBits(value);
+    auto sign = (uint16_t) ((bits >> 16) & 0x8000u);
+    uint32_t magnitude = bits & 0x7fffffffu;
+
+    if (magnitude >= 0x7f800000u) {
+        // Infinity stays infinity, NaN stays a quiet NaN
+        return sign | (magnitude > 0x7f800000u ? 0x7e00u : 0x7c00u);
+    }
+
+    if (magnitude >= 0x477ff000u) {
+        // Rounds to a value past the largest half, 65504
+        return sign | 0x7c00u;
+    }
+
+    if (magnitude < 0x38800000u) {
+        // Result is subnormal or zero. Adding 0.5 moves the value so that the float adder rounds the bits to drop
+        // to nearest even, and the half bits end up in the low mantissa bits
+        float shifted = BitsToFloat(magnitude) + 0.5f;
+        return sign | (uint16_t) (FloatBits(shifted) - 0x3f000000u);
+    }
+
+    // Normal: rebias the exponent and round the 13 dropped mantissa bits to nearest even
+    uint32_t mantissaOdd = (magnitude >> 13) & 1u;
+    magnitude += 0xc8000fffu + mantissaOdd;
+    return sign | (uint16_t) (magnitude >> 13);
+}
+
+float knn_jni::half_precision::Bf16ToFloat(uint16_t value) {
+    return BitsToFloat((uint32_t) value << 16);
+}
+
+uint16_t knn_jni::half_precision::FloatToBf16(float value) {
+    uint32_t bits = FloatBits(value);
+    if ((bits & 0x7fffffffu) > 0x7f800000u) {
+        // Keep NaN a NaN even when its payload sits in the dropped bits
+        return (uint16_t) ((bits >> 16) | 0x40u);
+    }
+    uint32_t lsb = (bits >> 16) & 1u;
+    return (uint16_t) ((bits + 0x7fffu + lsb) >> 16);
+}
@@ -0,0 +1,99 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "hdf5_io.h"
+
+#include "hdf5.h"
+
+#include <stdexcept>
+
+
+namespace {
+    // Closes an HDF5 handle when it goes out of scope
+    class Handle {
+    public:
+        Handle(hid_t id, herr_t (*close)(hid_t), const std::string& error) : id(id), close(close) {
+            if (id < 0) {
+                throw std::runtime_error(error);
+            }
+        }
+
+        ~Handle() {
+            close(id);
+        }
+
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+
+        hid_t Get() const {
+            return id;
+        }
+
+    private:
+        hid_t id;
+        herr_t (*close)(hid_t);
+    };
+
+    template <typename T>
+    knn_jni::vecs_io::Matrix<T> ReadDataset(const std::string& path, const std::string& name, hid_t memoryType) {
+        Handle file(H5Fopen(path.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT), H5Fclose, "Unable to open " + path);
+        Handle dataset(H5Dopen2(file.Get(), name.c_str(), H5P_DEFAULT), H5Dclose,
+                       "Unable to open dataset " + name + " in " + path);
+        Handle space(H5Dget_space(dataset.Get()), H5Sclose, "Unable to read dataset " + name);
+
+        hsize_t dims[2];
+        if (H5Sget_simple_extent_ndims(space.Get()) != 2 || H5Sget_simple_extent_dims(space.Get(), dims, nullptr) < 0) {
+            throw std::runtime_error("Dataset " + name + " is not two dimensional");
+        }
+
+        knn_jni::vecs_io::Matrix<T> matrix((int64_t) dims[0], (int64_t) dims[1]);
+        if (H5Dread(dataset.Get(), memoryType, H5S_ALL, H5S_ALL, H5P_DEFAULT, matrix.data.data()) < 0) {
+            throw std::runtime_error("Unable to read dataset " + name);
+        }
+        return matrix;
+    }
+
+    template <typename T>
+    void WriteDataset(const std::string& path, const std::string& name, const knn_jni::vecs_io::Matrix<T>& matrix,
+                      hid_t fileType, hid_t memoryType) {
+        Handle file(H5Fopen(path.c_str(), H5F_ACC_RDWR, H5P_DEFAULT), H5Fclose, "Unable to open " + path);
+        hsize_t dims[2] = {(hsize_t) matrix.rows, (hsize_t) matrix.cols};
+        Handle space(H5Screate_simple(2, dims, nullptr), H5Sclose, "Unable to create dataset " + name);
+        Handle dataset(H5Dcreate2(file.Get(), name.c_str(), fileType, space.Get(), H5P_DEFAULT, H5P_DEFAULT,
+                                  H5P_DEFAULT), H5Dclose, "Unable to create dataset " + name + " in " + path);
+        if (H5Dwrite(dataset.Get(), memoryType, H5S_ALL, H5S_ALL, H5P_DEFAULT, matrix.data.data()) < 0) {
+            throw std::runtime_error("Unable to write dataset " + name);
+        }
+    }
+}
+
+knn_jni::vecs_io::Matrix<float> knn_jni::hdf5_io::ReadFloatDataset(const std::string& path, const std::string& name) {
+    return ReadDataset<float>(path, name, H5T_NATIVE_FLOAT);
+}
+
+knn_jni::vecs_io::Matrix<int32_t> knn_jni::hdf5_io::ReadIntDataset(const std::string& path, const std::string& name) {
+    return ReadDataset<int32_t>(path, name, H5T_NATIVE_INT32);
+}
+
+void knn_jni::hdf5_io::CreateFile(const std::string& path) {
+    Handle file(H5Fcreate(path.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT), H5Fclose,
+                "Unable to create " + path);
+}
+
+void knn_jni::hdf5_io::WriteDataset(const std::string& path, const std::string& name,
+                                    const knn_jni::vecs_io::Matrix<float>& matrix) {
+    ::WriteDataset(path, name, matrix, H5T_IEEE_F32LE, H5T_NATIVE_FLOAT);
+}
+
+void knn_jni::hdf5_io::WriteDataset(const std::string& path, const std::string& name,
+                                    const knn_jni::vecs_io::Matrix<int32_t>& matrix) {
+    ::WriteDataset(path, name, matrix, H5T_STD_I32LE, H5T_NATIVE_INT32);
+}
@@ -0,0 +1,200 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "index_description.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+
+knn_jni::index_description::GraphSummary knn_jni::index_description::SummarizeGraph(
+        int32_t numNodes, const std::vector<int>& topLayers, int32_t entryPoint, const NeighborFetcher& neighbors) {
+    if ((int32_t) topLayers.size() != numNodes) {
+        throw std::runtime_error("Number of top layers does not match the number of nodes");
+    }
+
+    GraphSummary summary = {{}, {}, 0, numNodes};
+    std::vector<int32_t> out;
+    int64_t totalDegree = 0;
+    for (int32_t node = 0; node < numNodes; ++node) {
+        int topLayer = std::max(topLayers[node], 0);
+        if ((size_t) topLayer >= summary.levelCounts.size()) {
+            summary.levelCounts.resize(topLayer + 1, 0);
+        }
+        summary.levelCounts[topLayer]++;
+
+        neighbors(node, 0, out);
+        if (out.size() >= summary.degreeHistogram.size()) {
+            summary.degreeHistogram.resize(out.size() + 1, 0);
+        }
+        summary.degreeHistogram[out.size()]++;
+        totalDegree += (int64_t) out.size();
+    }
+    summary.meanDegree = numNodes == 0 ? 0 : (double) totalDegree / numNodes;
+
+    if (entryPoint < 0 || entryPoint >= numNodes) {
+        return summary;
+    }
+
+    // Upper layers only hold nodes that are also on the base layer, but a node only linked to from above is still
+    // reached by the greedy descent, so links of every layer count
+    std::vector<bool> visited(numNodes, false);
+    std::vector<int32_t> pending = {entryPoint};
+    visited[entryPoint] = true;
+    int64_t reached = 1;
+    while (!pending.empty()) {
+        int32_t node = pending.back();
+        pending.pop_back();
+        for (int layer = 0; layer <= topLayers[node]; ++layer) {
+            neighbors(node, layer, out);
+            for (int32_t neighbor : out) {
+                if (neighbor >= 0 && neighbor < numNodes && !visited[neighbor]) {
+                    visited[neighbor] = true;
+                    pending.push_back(neighbor);
+                    reached++;
+                }
+            }
+        }
+    }
+    summary.unreachable = numNodes - reached;
+    return summary;
+}
+
+knn_jni::index_description::ListSummary knn_jni::index_description::SummarizeLists(std::vector<int64_t> sizes) {
+    ListSummary summary = {(int64_t) sizes.size(), 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    if (sizes.empty()) {
+        return summary;
+    }
+
+    std::sort(sizes.begin(), sizes.end());
+    double sumOfSquares = 0;
+    for (int64_t size : sizes) {
+        summary.total += size;
+        sumOfSquares += (double) size * size;
+        if (size == 0) {
+            summary.empty++;
+        }
+    }
+
+    auto percentile = [&sizes](double p) {
+        return sizes[std::min(sizes.size() - 1, (size_t) (p * sizes.size()))];
+    };
+    summary.min = sizes.front();
+    summary.max = sizes.back();
+    summary.mean = (double) summary.total / sizes.size();
+    summary.p50 = percentile(0.5);
+    summary.p90 = percentile(0.9);
+    summary.p99 = percentile(0.99);
+    summary.imbalance = summary.total == 0 ? 0 :
+            sizes.size() * sumOfSquares / ((double) summary.total * summary.total);
+    return summary;
+}
+
+knn_jni::index_description::JsonWriter::JsonWriter() : out("{"), firstMember{true} {}
+
+void knn_jni::index_description::JsonWriter::Key(const std::string& name) {
+    if (!firstMember.back()) {
+        out += ',';
+    }
+    firstMember.back() = false;
+    out += '"';
+    out += name;
+    out += "\":";
+}
+
+void knn_jni::index_description::JsonWriter::BeginObject(const std::string& name) {
+    Key(name);
+    out += '{';
+    firstMember.push_back(true);
+}
+
+void knn_jni::index_description::JsonWriter::EndObject() {
+    if (firstMember.size() <= 1) {
+        throw std::runtime_error("No object to end");
+    }
+    out += '}';
+    firstMember.pop_back();
+}
+
+void knn_jni::index_description::JsonWriter::Number(const std::string& name, int64_t value) {
+    Key(name);
+    out += std::to_string(value);
+}
+
+void knn_jni::index_description::JsonWriter::Number(const std::string& name, double value) {
+    Key(name);
+    if (!std::isfinite(value)) {
+        out += "null";
+        return;
+    }
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.6g", value);
+    out += buffer;
+}
+
+void knn_jni::index_description::JsonWriter::String(const std::string& name, const std::string& value) {
+    Key(name);
+    out += '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    out += '"';
+}
+
+void knn_jni::index_description::JsonWriter::Boolean(const std::string& name, bool value) {
+    Key(name);
+    out += value ? "true" : "false";
+}
+
+void knn_jni::index_description::JsonWriter::Numbers(const std::string& name, const std::vector<int64_t>& values) {
+    Key(name);
+    out += '[';
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i > 0) {
+            out += ',';
+        }
+        out += std::to_string(values[i]);
+    }
+    out += ']';
+}
+
+void knn_jni::index_description::JsonWriter::Graph(const GraphSummary& graph) {
+    Numbers("level_counts", graph.levelCounts);
+    Numbers("degree_histogram", graph.degreeHistogram);
+    Number("mean_degree", graph.meanDegree);
+    Number("unreachable", graph.unreachable);
+}
+
+void knn_jni::index_description::JsonWriter::Lists(const ListSummary& lists) {
+    Number("count", lists.numLists);
+    Number("total", lists.total);
+    Number("min", lists.min);
+    Number("max", lists.max);
+    Number("mean", lists.mean);
+    Number("p50", lists.p50);
+    Number("p90", lists.p90);
+    Number("p99", lists.p99);
+    Number("empty", lists.empty);
+    Number("imbalance", lists.imbalance);
+}
+
+std::string knn_jni::index_description::JsonWriter::Finish() {
+    if (firstMember.size() != 1) {
+        throw std::runtime_error("Objects left open");
+    }
+    return out + "}";
+}
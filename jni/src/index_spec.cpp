@@ -0,0 +1,247 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+
+#include "index_spec.h"
+
+#include "jni_util.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using knn_jni::json::Value;
+
+namespace {
+    // Defaults of KNNSettings and KNNConstants
+    const int DEFAULT_M = 16;
+    const int DEFAULT_EF_CONSTRUCTION = 512;
+    const int DEFAULT_EF_SEARCH = 512;
+    const int DEFAULT_NLIST = 4;
+    const int DEFAULT_NPROBES = 1;
+    const int DEFAULT_PQ_M = 1;
+    const int DEFAULT_PQ_CODE_SIZE = 8;
+
+    const std::string KNN_VECTOR = "knn_vector";
+    const std::string METHOD_HNSW = "hnsw";
+    const std::string METHOD_IVF = "ivf";
+    const std::string ENCODER = "encoder";
+    const std::string ENCODER_FLAT = "flat";
+    const std::string ENCODER_PQ = "pq";
+    const std::string NLIST = "nlist";
+    const std::string CODE_SIZE = "code_size";
+
+    // Index setting called name, given either nested under "index" or flattened as "index.<name>"
+    const Value* Setting(const Value& indexSpec, const std::string& name) {
+        const Value* settings = indexSpec.Find("settings");
+        if (settings == nullptr) {
+            return nullptr;
+        }
+        const Value* index = settings->Find("index");
+        if (index != nullptr && index->Find(name) != nullptr) {
+            return index->Find(name);
+        }
+        return settings->Find("index." + name);
+    }
+
+    // OpenSearch accepts numeric settings given as strings
+    int IntSetting(const Value& indexSpec, const std::string& name, int defaultValue) {
+        const Value* value = Setting(indexSpec, name);
+        if (value == nullptr) {
+            return defaultValue;
+        }
+        return value->IsString() ? std::stoi(value->AsString()) : value->AsInt();
+    }
+
+    std::string StringSetting(const Value& indexSpec, const std::string& name, const std::string& defaultValue) {
+        const Value* value = Setting(indexSpec, name);
+        return value == nullptr ? defaultValue : value->AsString();
+    }
+
+    void ParseMethod(const Value& method, knn_jni::index_spec::IndexSpec& spec) {
+        const Value* name = method.Find("name");
+        if (name == nullptr) {
+            throw std::runtime_error("Method has no name");
+        }
+        spec.method = name->AsString();
+
+        if (const Value* engine = method.Find("engine")) {
+            spec.engine = engine->AsString();
+        }
+        if (const Value* spaceType = method.Find("space_type")) {
+            spec.spaceType = spaceType->AsString();
+        }
+
+        const Value* parameters = method.Find("parameters");
+        if (parameters == nullptr) {
+            return;
+        }
+        for (const auto& parameter : parameters->Members()) {
+            if (parameter.first == ENCODER) {
+                const Value* encoderName = parameter.second->Find("name");
+                if (encoderName == nullptr) {
+                    throw std::runtime_error("Encoder has no name");
+                }
+                spec.encoder = encoderName->AsString();
+                if (const Value* encoderParameters = parameter.second->Find("parameters")) {
+                    for (const auto& encoderParameter : encoderParameters->Members()) {
+                        spec.encoderParameters[encoderParameter.first] = encoderParameter.second->AsInt();
+                    }
+                }
+            } else if (parameter.second->IsString()) {
+                spec.stringParameters[parameter.first] = parameter.second->AsString();
+            } else {
+                spec.intParameters[parameter.first] = parameter.second->AsInt();
+            }
+        }
+    }
+
+    bool IsFaiss(const knn_jni::index_spec::IndexSpec& spec) {
+        return spec.engine == knn_jni::FAISS_NAME;
+    }
+
+    template <typename T>
+    void Put(knn_jni::replay::Map& map, const std::string& name, T* value) {
+        map.entries[name].reset(value);
+    }
+}
+
+knn_jni::index_spec::IndexSpec knn_jni::index_spec::ParseIndexSpec(const knn_jni::json::Value& indexSpec,
+                                                                   const knn_jni::json::Value* methodSpec,
+                                                                   const std::string& field) {
+    const Value* mappings = indexSpec.Find("mappings");
+    const Value* properties = mappings == nullptr ? nullptr : mappings->Find("properties");
+    if (properties == nullptr) {
+        throw std::runtime_error("Index spec has no mapping properties");
+    }
+
+    const Value* mapping = nullptr;
+    if (!field.empty()) {
+        mapping = properties->Find(field);
+    } else {
+        for (const auto& property : properties->Members()) {
+            const Value* type = property.second->Find("type");
+            if (type != nullptr && type->IsString() && type->AsString() == KNN_VECTOR) {
+                mapping = property.second.get();
+                break;
+            }
+        }
+    }
+    if (mapping == nullptr) {
+        throw std::runtime_error("Index spec has no knn_vector field " + field);
+    }
+
+    // Fields without a method fall back on the index settings, as the plugin did before methods existed
+    IndexSpec spec;
+    spec.engine = knn_jni::NMSLIB_NAME;
+    spec.method = METHOD_HNSW;
+    spec.spaceType = StringSetting(indexSpec, "knn.space_type", knn_jni::L2);
+    spec.encoder = ENCODER_FLAT;
+    spec.efSearch = IntSetting(indexSpec, "knn.algo_param.ef_search", DEFAULT_EF_SEARCH);
+    spec.earlyTermination = StringSetting(indexSpec, "knn.early_termination", knn_jni::EARLY_TERMINATION_NONE);
+
+    if (const Value* method = mapping->Find(knn_jni::METHOD)) {
+        ParseMethod(*method, spec);
+    } else if (mapping->Find("model_id") != nullptr) {
+        if (methodSpec == nullptr) {
+            throw std::runtime_error("Field refers to a model, so a method spec is needed");
+        }
+        ParseMethod(*methodSpec, spec);
+    } else {
+        spec.intParameters[knn_jni::M] = IntSetting(indexSpec, "knn.algo_param.m", DEFAULT_M);
+        spec.intParameters[knn_jni::EF_CONSTRUCTION] = IntSetting(indexSpec, "knn.algo_param.ef_construction",
+                                                                  DEFAULT_EF_CONSTRUCTION);
+    }
+
+    if (spec.engine != knn_jni::FAISS_NAME && spec.engine != knn_jni::NMSLIB_NAME) {
+        throw std::runtime_error("Unsupported engine " + spec.engine);
+    }
+    if (spec.method == METHOD_HNSW) {
+        spec.intParameters.insert({knn_jni::M, DEFAULT_M});
+        spec.intParameters.insert({knn_jni::EF_CONSTRUCTION, DEFAULT_EF_CONSTRUCTION});
+        if (IsFaiss(spec)) {
+            spec.intParameters.insert({knn_jni::EF_SEARCH, DEFAULT_EF_SEARCH});
+        }
+    } else if (spec.method == METHOD_IVF && IsFaiss(spec)) {
+        spec.intParameters.insert({NLIST, DEFAULT_NLIST});
+        spec.intParameters.insert({knn_jni::NPROBES, DEFAULT_NPROBES});
+    } else {
+        throw std::runtime_error("Unsupported method " + spec.method + " for " + spec.engine);
+    }
+
+    if (spec.encoder == ENCODER_PQ) {
+        spec.encoderParameters.insert({knn_jni::M, DEFAULT_PQ_M});
+        spec.encoderParameters.insert({CODE_SIZE, DEFAULT_PQ_CODE_SIZE});
+    } else if (spec.encoder != ENCODER_FLAT) {
+        throw std::runtime_error("Unsupported encoder " + spec.encoder);
+    }
+    return spec;
+}
+
+bool knn_jni::index_spec::RequiresTraining(const IndexSpec& spec) {
+    return IsFaiss(spec) && (spec.method == METHOD_IVF || spec.encoder == ENCODER_PQ);
+}
+
+std::string knn_jni::index_spec::FaissIndexDescription(const IndexSpec& spec) {
+    std::string description;
+    if (spec.method == METHOD_HNSW) {
+        description = "HNSW" + std::to_string(spec.intParameters.at(knn_jni::M));
+    } else {
+        description = "IVF" + std::to_string(spec.intParameters.at(NLIST));
+    }
+
+    if (spec.encoder == ENCODER_PQ) {
+        return description + ",PQ" + std::to_string(spec.encoderParameters.at(knn_jni::M)) + "x" +
+               std::to_string(spec.encoderParameters.at(CODE_SIZE));
+    }
+    return description + ",Flat";
+}
+
+std::unique_ptr<knn_jni::replay::Map> knn_jni::index_spec::BuildParameters(const IndexSpec& spec, int threadCount) {
+    std::unique_ptr<knn_jni::replay::Map> parameters(new knn_jni::replay::Map());
+    Put(*parameters, knn_jni::SPACE_TYPE, new knn_jni::replay::String(spec.spaceType));
+    Put(*parameters, knn_jni::INDEX_THREAD_QUANTITY, new knn_jni::replay::Integer(threadCount));
+
+    // For faiss, parameters that are part of the index description are not passed on again
+    auto * subParameters = new knn_jni::replay::Map();
+    Put(*parameters, knn_jni::PARAMETERS, subParameters);
+    for (const auto& parameter : spec.intParameters) {
+        if (IsFaiss(spec) && (parameter.first == knn_jni::M || parameter.first == NLIST)) {
+            continue;
+        }
+        Put(*subParameters, parameter.first, new knn_jni::replay::Integer(parameter.second));
+    }
+    for (const auto& parameter : spec.stringParameters) {
+        Put(*subParameters, parameter.first, new knn_jni::replay::String(parameter.second));
+    }
+
+    if (IsFaiss(spec)) {
+        Put(*parameters, knn_jni::INDEX_DESCRIPTION, new knn_jni::replay::String(FaissIndexDescription(spec)));
+    }
+    return parameters;
+}
+
+std::unique_ptr<knn_jni::replay::Map> knn_jni::index_spec::LoadParameters(const IndexSpec& spec) {
+    std::unique_ptr<knn_jni::replay::Map> parameters(new knn_jni::replay::Map());
+    Put(*parameters, knn_jni::SPACE_TYPE, new knn_jni::replay::String(spec.spaceType));
+    Put(*parameters, "efSearch", new knn_jni::replay::Integer(spec.efSearch));
+
+    // The plugin passes the cosine mode of a field on at load time, since nmslib files do not record it
+    auto cosineMode = spec.stringParameters.find(knn_jni::COSINE_MODE);
+    if (cosineMode != spec.stringParameters.end()) {
+        Put(*parameters, knn_jni::COSINE_MODE, new knn_jni::replay::String(cosineMode->second));
+    }
+
+    if (spec.engine == knn_jni::FAISS_NAME) {
+        Put(*parameters, knn_jni::EARLY_TERMINATION, new knn_jni::replay::String(spec.earlyTermination));
+    }
+    return parameters;
+}
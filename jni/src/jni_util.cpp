@@ -11,6 +11,7 @@
 
 #include "jni_util.h"
 
+#include <algorithm>
 #include <jni.h>
 #include <new>
 #include <stdexcept>
@@ -61,6 +62,18 @@ void knn_jni::JNIUtil::Initialize(JNIEnv *env) {
     this->cachedMethods["java/lang/Integer:intValue"] = env->GetMethodID(tempLocalClassRef, "intValue", "()I");
     env->DeleteLocalRef(tempLocalClassRef);
 
+    tempLocalClassRef = env->FindClass("[F");
+    this->cachedClasses["[F"] = (jclass) env->NewGlobalRef(tempLocalClassRef);
+    env->DeleteLocalRef(tempLocalClassRef);
+
+    tempLocalClassRef = env->FindClass("[S");
+    this->cachedClasses["[S"] = (jclass) env->NewGlobalRef(tempLocalClassRef);
+    env->DeleteLocalRef(tempLocalClassRef);
+
+    tempLocalClassRef = env->FindClass("[B");
+    this->cachedClasses["[B"] = (jclass) env->NewGlobalRef(tempLocalClassRef);
+    env->DeleteLocalRef(tempLocalClassRef);
+
     tempLocalClassRef = env->FindClass("org/opensearch/knn/index/KNNQueryResult");
     this->cachedClasses["org/opensearch/knn/index/KNNQueryResult"] = (jclass) env->NewGlobalRef(tempLocalClassRef);
     this->cachedMethods["org/opensearch/knn/index/KNNQueryResult:<init>"] = env->GetMethodID(tempLocalClassRef, "<init>", "(IF)V");
@@ -231,25 +244,21 @@ std::vector<float> knn_jni::JNIUtil::Convert2dJavaObjectArrayToCppFloatVector(JN
     int numVectors = env->GetArrayLength(array2dJ);
     this->HasExceptionInStack(env);
 
-    std::vector<float> floatVectorCpp;
+    // Size the output once and copy each row straight into place. Row references are released as we go so that
+    // large batches do not exhaust the local reference table
+    std::vector<float> floatVectorCpp((size_t) numVectors * dim);
     for (int i = 0; i < numVectors; ++i) {
         auto vectorArray = (jfloatArray)env->GetObjectArrayElement(array2dJ, i);
         this->HasExceptionInStack(env, "Unable to get object array element");
 
         if (dim != env->GetArrayLength(vectorArray)) {
+            env->DeleteLocalRef(vectorArray);
             throw std::runtime_error("Dimension of vectors is inconsistent");
         }
 
-        float* vector = env->GetFloatArrayElements(vectorArray, nullptr);
-        if (vector == nullptr) {
-            this->HasExceptionInStack(env);
-            throw std::runtime_error("Unable to get float array elements");
-        }
-
-        for(int j = 0; j < dim; ++j) {
-            floatVectorCpp.push_back(vector[j]);
-        }
-        env->ReleaseFloatArrayElements(vectorArray, vector, JNI_ABORT);
+        env->GetFloatArrayRegion(vectorArray, 0, dim, floatVectorCpp.data() + (size_t) i * dim);
+        env->DeleteLocalRef(vectorArray);
+        this->HasExceptionInStack(env, "Unable to get float array region");
     }
     this->HasExceptionInStack(env);
     env->DeleteLocalRef(array2dJ);
@@ -280,6 +289,132 @@ std::vector<int64_t> knn_jni::JNIUtil::ConvertJavaIntArrayToCppIntVector(JNIEnv
     return vectorCpp;
 }
 
+std::vector<float> knn_jni::JNIUtil::ConvertFlatJavaVectorsToCppFloatVector(JNIEnv *env, jobject vectorsJ, int dim) {
+
+    if (vectorsJ == nullptr) {
+        throw std::runtime_error("Vectors cannot be null");
+    }
+
+    if (dim <= 0) {
+        throw std::runtime_error("Dimension must be positive");
+    }
+
+    if (env->IsInstanceOf(vectorsJ, this->FindClass(env, "[F"))) {
+        auto vectorsArrayJ = (jfloatArray) vectorsJ;
+        jsize numFloats = env->GetArrayLength(vectorsArrayJ);
+        this->HasExceptionInStack(env, "Unable to get array length");
+        if (numFloats % dim != 0) {
+            throw std::runtime_error("Number of floats is not a multiple of the dimension");
+        }
+
+        std::vector<float> floatVectorCpp(numFloats);
+        env->GetFloatArrayRegion(vectorsArrayJ, 0, numFloats, floatVectorCpp.data());
+        this->HasExceptionInStack(env, "Unable to get float array region");
+        return floatVectorCpp;
+    }
+
+    auto * address = reinterpret_cast<const float *>(env->GetDirectBufferAddress(vectorsJ));
+    jlong capacity = env->GetDirectBufferCapacity(vectorsJ);
+    if (address == nullptr || capacity < 0) {
+        throw std::runtime_error("Vectors must be a float array or a direct buffer");
+    }
+
+    if (capacity % (jlong) (sizeof(float) * dim) != 0) {
+        throw std::runtime_error("Number of floats is not a multiple of the dimension");
+    }
+
+    return std::vector<float>(address, address + capacity / sizeof(float));
+}
+
+std::vector<float> knn_jni::JNIUtil::ConvertHalfJavaVectorsToCppFloatVector(JNIEnv *env, jobject vectorsJ, int dim,
+                                                                            knn_jni::half_precision::Encoding encoding) {
+
+    if (vectorsJ == nullptr) {
+        throw std::runtime_error("Vectors cannot be null");
+    }
+
+    if (dim <= 0) {
+        throw std::runtime_error("Dimension must be positive");
+    }
+
+    if (env->IsInstanceOf(vectorsJ, this->FindClass(env, "[S"))) {
+        auto vectorsArrayJ = (jshortArray) vectorsJ;
+        jsize numValues = env->GetArrayLength(vectorsArrayJ);
+        this->HasExceptionInStack(env, "Unable to get array length");
+        if (numValues % dim != 0) {
+            throw std::runtime_error("Number of values is not a multiple of the dimension");
+        }
+
+        // Widen straight out of the Java array. Nothing in the critical region calls back into the JVM
+        std::vector<float> floatVectorCpp(numValues);
+        auto * values = reinterpret_cast<const uint16_t *>(env->GetPrimitiveArrayCritical(vectorsArrayJ, nullptr));
+        if (values == nullptr) {
+            this->HasExceptionInStack(env, "Unable to get short array elements");
+            throw std::runtime_error("Unable to get short array elements");
+        }
+        knn_jni::half_precision::Decode(encoding, values, numValues, floatVectorCpp.data());
+        env->ReleasePrimitiveArrayCritical(vectorsArrayJ, (void *) values, JNI_ABORT);
+        return floatVectorCpp;
+    }
+
+    auto * address = reinterpret_cast<const uint16_t *>(env->GetDirectBufferAddress(vectorsJ));
+    jlong capacity = env->GetDirectBufferCapacity(vectorsJ);
+    if (address == nullptr || capacity < 0) {
+        throw std::runtime_error("Vectors must be a short array or a direct buffer");
+    }
+
+    if (capacity % (jlong) (sizeof(uint16_t) * dim) != 0) {
+        throw std::runtime_error("Number of values is not a multiple of the dimension");
+    }
+
+    std::vector<float> floatVectorCpp(capacity / sizeof(uint16_t));
+    knn_jni::half_precision::Decode(encoding, address, floatVectorCpp.size(), floatVectorCpp.data());
+    return floatVectorCpp;
+}
+
+std::vector<float> knn_jni::JNIUtil::ConvertByteJavaVectorsToCppFloatVector(JNIEnv *env, jobject vectorsJ, int dim) {
+
+    if (vectorsJ == nullptr) {
+        throw std::runtime_error("Vectors cannot be null");
+    }
+
+    if (dim <= 0) {
+        throw std::runtime_error("Dimension must be positive");
+    }
+
+    if (env->IsInstanceOf(vectorsJ, this->FindClass(env, "[B"))) {
+        auto vectorsArrayJ = (jbyteArray) vectorsJ;
+        jsize numValues = env->GetArrayLength(vectorsArrayJ);
+        this->HasExceptionInStack(env, "Unable to get array length");
+        if (numValues % dim != 0) {
+            throw std::runtime_error("Number of values is not a multiple of the dimension");
+        }
+
+        // Widen straight out of the Java array. Nothing in the critical region calls back into the JVM
+        std::vector<float> floatVectorCpp(numValues);
+        auto * values = reinterpret_cast<const int8_t *>(env->GetPrimitiveArrayCritical(vectorsArrayJ, nullptr));
+        if (values == nullptr) {
+            this->HasExceptionInStack(env, "Unable to get byte array elements");
+            throw std::runtime_error("Unable to get byte array elements");
+        }
+        std::copy(values, values + numValues, floatVectorCpp.begin());
+        env->ReleasePrimitiveArrayCritical(vectorsArrayJ, (void *) values, JNI_ABORT);
+        return floatVectorCpp;
+    }
+
+    auto * address = reinterpret_cast<const int8_t *>(env->GetDirectBufferAddress(vectorsJ));
+    jlong capacity = env->GetDirectBufferCapacity(vectorsJ);
+    if (address == nullptr || capacity < 0) {
+        throw std::runtime_error("Vectors must be a byte array or a direct buffer");
+    }
+
+    if (capacity % dim != 0) {
+        throw std::runtime_error("Number of values is not a multiple of the dimension");
+    }
+
+    return std::vector<float>(address, address + capacity);
+}
+
 int knn_jni::JNIUtil::GetInnerDimensionOf2dJavaFloatArray(JNIEnv *env, jobjectArray array2dJ) {
 
     if (array2dJ == nullptr) {
@@ -293,6 +428,7 @@ int knn_jni::JNIUtil::GetInnerDimensionOf2dJavaFloatArray(JNIEnv *env, jobjectAr
     auto vectorArray = (jfloatArray)env->GetObjectArrayElement(array2dJ, 0);
     this->HasExceptionInStack(env);
     int dim = env->GetArrayLength(vectorArray);
+    env->DeleteLocalRef(vectorArray);
     this->HasExceptionInStack(env);
     return dim;
 }
@@ -341,6 +477,17 @@ int knn_jni::JNIUtil::GetJavaFloatArrayLength(JNIEnv *env, jfloatArray arrayJ) {
     return length;
 }
 
+int knn_jni::JNIUtil::GetJavaLongArrayLength(JNIEnv *env, jlongArray arrayJ) {
+
+    if (arrayJ == nullptr) {
+        throw std::runtime_error("Array cannot be null");
+    }
+
+    int length = env->GetArrayLength(arrayJ);
+    this->HasExceptionInStack(env, "Unable to get array length");
+    return length;
+}
+
 void knn_jni::JNIUtil::DeleteLocalRef(JNIEnv *env, jobject obj) {
     env->DeleteLocalRef(obj);
 }
@@ -376,6 +523,16 @@ jint * knn_jni::JNIUtil::GetIntArrayElements(JNIEnv *env, jintArray array, jbool
     return intArray;
 }
 
+jlong * knn_jni::JNIUtil::GetLongArrayElements(JNIEnv *env, jlongArray array, jboolean * isCopy) {
+    jlong * longArray = env->GetLongArrayElements(array, isCopy);
+    if (longArray == nullptr) {
+        this->HasExceptionInStack(env, "Unable to get long array");
+        throw std::runtime_error("Unable to get long array");
+    }
+
+    return longArray;
+}
+
 jobject knn_jni::JNIUtil::GetObjectArrayElement(JNIEnv *env, jobjectArray array, jsize index) {
     jobject object = env->GetObjectArrayElement(array, index);
     this->HasExceptionInStack(env, "Unable to get object");
@@ -412,6 +569,26 @@ jbyteArray knn_jni::JNIUtil::NewByteArray(JNIEnv *env, jsize len) {
     return byteArray;
 }
 
+jintArray knn_jni::JNIUtil::NewIntArray(JNIEnv *env, jsize len) {
+    jintArray intArray = env->NewIntArray(len);
+    if (intArray == nullptr) {
+        this->HasExceptionInStack(env, "Unable to allocate int array");
+        throw std::runtime_error("Unable to allocate int array");
+    }
+
+    return intArray;
+}
+
+jfloatArray knn_jni::JNIUtil::NewFloatArray(JNIEnv *env, jsize len) {
+    jfloatArray floatArray = env->NewFloatArray(len);
+    if (floatArray == nullptr) {
+        this->HasExceptionInStack(env, "Unable to allocate float array");
+        throw std::runtime_error("Unable to allocate float array");
+    }
+
+    return floatArray;
+}
+
 void knn_jni::JNIUtil::ReleaseByteArrayElements(JNIEnv *env, jbyteArray array, jbyte *elems, int mode) {
     env->ReleaseByteArrayElements(array, elems, mode);
 }
@@ -424,6 +601,10 @@ void knn_jni::JNIUtil::ReleaseIntArrayElements(JNIEnv *env, jintArray array, jin
     env->ReleaseIntArrayElements(array, elems, mode);
 }
 
+void knn_jni::JNIUtil::ReleaseLongArrayElements(JNIEnv *env, jlongArray array, jlong *elems, jint mode) {
+    env->ReleaseLongArrayElements(array, elems, mode);
+}
+
 void knn_jni::JNIUtil::SetObjectArrayElement(JNIEnv *env, jobjectArray array, jsize index, jobject val) {
     env->SetObjectArrayElement(array, index, val);
     this->HasExceptionInStack(env, "Unable to set object array element");
@@ -434,6 +615,17 @@ void knn_jni::JNIUtil::SetByteArrayRegion(JNIEnv *env, jbyteArray array, jsize s
     this->HasExceptionInStack(env, "Unable to set byte array region");
 }
 
+void knn_jni::JNIUtil::SetIntArrayRegion(JNIEnv *env, jintArray array, jsize start, jsize len, const jint * buf) {
+    env->SetIntArrayRegion(array, start, len, buf);
+    this->HasExceptionInStack(env, "Unable to set int array region");
+}
+
+void knn_jni::JNIUtil::SetFloatArrayRegion(JNIEnv *env, jfloatArray array, jsize start, jsize len,
+                                           const jfloat * buf) {
+    env->SetFloatArrayRegion(array, start, len, buf);
+    this->HasExceptionInStack(env, "Unable to set float array region");
+}
+
 jobject knn_jni::GetJObjectFromMapOrThrow(std::unordered_map<std::string, jobject> map, std::string key) {
     if(map.find(key) == map.end()) {
         throw std::runtime_error(key + " not found");
@@ -441,6 +633,66 @@ jobject knn_jni::GetJObjectFromMapOrThrow(std::unordered_map<std::string, jobjec
     return map[key];
 }
 
+int knn_jni::GetRequestedThreadCount(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                     std::unordered_map<std::string, jobject>& parametersCpp) {
+    if (parametersCpp.find(knn_jni::INDEX_THREAD_QUANTITY) != parametersCpp.end()) {
+        return jniUtil->ConvertJavaObjectToCppInteger(env, parametersCpp[knn_jni::INDEX_THREAD_QUANTITY]);
+    }
+    return 0;
+}
+
+knn_jni::qos::SchedulingPolicy knn_jni::GetBuildSchedulingPolicy(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                                 std::unordered_map<std::string, jobject>& parametersCpp) {
+    if (parametersCpp.find(knn_jni::BUILD_SCHEDULING_POLICY) == parametersCpp.end()) {
+        return knn_jni::qos::SchedulingPolicy::NORMAL;
+    }
+
+    auto policy = jniUtil->ConvertJavaObjectToCppString(env, parametersCpp[knn_jni::BUILD_SCHEDULING_POLICY]);
+    return knn_jni::qos::ParseSchedulingPolicy(policy);
+}
+
+knn_jni::graph_reorder::ReorderStrategy knn_jni::GetGraphReorderStrategy(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                                         std::unordered_map<std::string, jobject>& parametersCpp) {
+    if (parametersCpp.find(knn_jni::GRAPH_REORDER) == parametersCpp.end()) {
+        return knn_jni::graph_reorder::ReorderStrategy::NONE;
+    }
+
+    auto strategy = jniUtil->ConvertJavaObjectToCppString(env, parametersCpp[knn_jni::GRAPH_REORDER]);
+    return knn_jni::graph_reorder::ParseReorderStrategy(strategy);
+}
+
+knn_jni::adjacency_codec::GraphEncoding knn_jni::GetGraphEncoding(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                                  std::unordered_map<std::string, jobject>& parametersCpp) {
+    if (parametersCpp.find(knn_jni::GRAPH_ENCODING) == parametersCpp.end()) {
+        return knn_jni::adjacency_codec::GraphEncoding::FIXED;
+    }
+
+    auto encoding = jniUtil->ConvertJavaObjectToCppString(env, parametersCpp[knn_jni::GRAPH_ENCODING]);
+    return knn_jni::adjacency_codec::ParseGraphEncoding(encoding);
+}
+
+bool knn_jni::IsBalancedClustering(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                   std::unordered_map<std::string, jobject>& parametersCpp) {
+    if (parametersCpp.find(knn_jni::CLUSTERING) == parametersCpp.end()) {
+        return false;
+    }
+
+    auto clustering = jniUtil->ConvertJavaObjectToCppString(env, parametersCpp[knn_jni::CLUSTERING]);
+    if (clustering != knn_jni::CLUSTERING_KMEANS && clustering != knn_jni::CLUSTERING_BALANCED) {
+        throw std::runtime_error("Invalid clustering " + clustering);
+    }
+    return clustering == knn_jni::CLUSTERING_BALANCED;
+}
+
+knn_jni::half_precision::Encoding knn_jni::GetHalfPrecisionEncoding(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                                    jstring encodingJ) {
+    if (encodingJ == nullptr) {
+        throw std::runtime_error("Encoding cannot be null");
+    }
+
+    return knn_jni::half_precision::ParseEncoding(jniUtil->ConvertJavaStringToCppString(env, encodingJ));
+}
+
 //TODO: This potentially should use const char *
 const std::string knn_jni::FAISS_NAME = "faiss";
 const std::string knn_jni::NMSLIB_NAME = "nmslib";
@@ -452,6 +704,7 @@ const std::string knn_jni::INDEX_DESCRIPTION = "index_description";
 const std::string knn_jni::PARAMETERS = "parameters";
 const std::string knn_jni::TRAINING_DATASET_SIZE_LIMIT = "training_dataset_size_limit";
 const std::string knn_jni::INDEX_THREAD_QUANTITY = "indexThreadQty";
+const std::string knn_jni::BUILD_SCHEDULING_POLICY = "buildSchedulingPolicy";
 
 const std::string knn_jni::L2 = "l2";
 const std::string knn_jni::L1 = "l1";
@@ -462,8 +715,23 @@ const std::string knn_jni::NEG_DOT_PRODUCT = "negdotprod";
 
 const std::string knn_jni::NPROBES = "nprobes";
 const std::string knn_jni::COARSE_QUANTIZER = "coarse_quantizer";
+const std::string knn_jni::CLUSTERING = "clustering";
+const std::string knn_jni::CLUSTERING_KMEANS = "kmeans";
+const std::string knn_jni::CLUSTERING_BALANCED = "balanced";
 const std::string knn_jni::M = "m";
 const std::string knn_jni::M_NMSLIB = "M";
 const std::string knn_jni::EF_CONSTRUCTION = "ef_construction";
 const std::string knn_jni::EF_CONSTRUCTION_NMSLIB = "efConstruction";
 const std::string knn_jni::EF_SEARCH = "ef_search";
+const std::string knn_jni::GRAPH_REORDER = "graph_reorder";
+const std::string knn_jni::GRAPH_ENCODING = "graph_encoding";
+const std::string knn_jni::COSINE_MODE = "cosine_mode";
+const std::string knn_jni::COSINE_MODE_RAW = "raw";
+const std::string knn_jni::COSINE_MODE_NORMALIZED = "normalized";
+const std::string knn_jni::INDEX_LAYOUT = "index_layout";
+const std::string knn_jni::INDEX_LAYOUT_OPTIMIZED = "optimized";
+const std::string knn_jni::INDEX_LAYOUT_REGULAR = "regular";
+const std::string knn_jni::EARLY_TERMINATION = "early_termination";
+const std::string knn_jni::EARLY_TERMINATION_NONE = "none";
+const std::string knn_jni::EARLY_TERMINATION_ADAPTIVE = "adaptive";
+const std::string knn_jni::SKIP_OPTIMIZED_INDEX_NMSLIB = "skip_optimized_index";
@@ -0,0 +1,304 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+
+#include "json_value.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace knn_jni {
+    namespace json {
+
+        // Recursive descent parser over the whole text
+        class Parser {
+        public:
+            explicit Parser(const std::string& text) : text(text), position(0) {}
+
+            Value ParseDocument() {
+                Value value = ParseValue();
+                SkipWhitespace();
+                if (position != text.size()) {
+                    Fail("Unexpected trailing characters");
+                }
+                return value;
+            }
+
+        private:
+            const std::string& text;
+            size_t position;
+
+            [[noreturn]] void Fail(const std::string& message) const {
+                throw std::runtime_error("Invalid JSON at offset " + std::to_string(position) + ": " + message);
+            }
+
+            void SkipWhitespace() {
+                while (position < text.size() && (text[position] == ' ' || text[position] == '\t' ||
+                                                  text[position] == '\n' || text[position] == '\r')) {
+                    position++;
+                }
+            }
+
+            char Peek() {
+                SkipWhitespace();
+                if (position == text.size()) {
+                    Fail("Unexpected end of input");
+                }
+                return text[position];
+            }
+
+            void Expect(char c) {
+                if (Peek() != c) {
+                    Fail(std::string("Expected '") + c + "'");
+                }
+                position++;
+            }
+
+            void ExpectLiteral(const std::string& literal) {
+                if (text.compare(position, literal.size(), literal) != 0) {
+                    Fail("Expected " + literal);
+                }
+                position += literal.size();
+            }
+
+            Value ParseValue() {
+                Value value;
+                char c = Peek();
+                if (c == '{') {
+                    value.type = Value::Type::OBJECT;
+                    ParseObject(value);
+                } else if (c == '[') {
+                    value.type = Value::Type::ARRAY;
+                    ParseArray(value);
+                } else if (c == '"') {
+                    value.type = Value::Type::STRING;
+                    value.string = ParseString();
+                } else if (c == 't' || c == 'f') {
+                    value.type = Value::Type::BOOLEAN;
+                    value.boolean = c == 't';
+                    ExpectLiteral(value.boolean ? "true" : "false");
+                } else if (c == 'n') {
+                    ExpectLiteral("null");
+                } else {
+                    value.type = Value::Type::NUMBER;
+                    value.number = ParseNumber();
+                }
+                return value;
+            }
+
+            void ParseObject(Value& value) {
+                Expect('{');
+                if (Peek() == '}') {
+                    position++;
+                    return;
+                }
+                while (true) {
+                    if (Peek() != '"') {
+                        Fail("Expected member name");
+                    }
+                    std::string name = ParseString();
+                    Expect(':');
+                    value.members[name] = std::make_shared<const Value>(ParseValue());
+                    if (Peek() == ',') {
+                        position++;
+                        continue;
+                    }
+                    Expect('}');
+                    return;
+                }
+            }
+
+            void ParseArray(Value& value) {
+                Expect('[');
+                if (Peek() == ']') {
+                    position++;
+                    return;
+                }
+                while (true) {
+                    value.elements.push_back(std::make_shared<const Value>(ParseValue()));
+                    if (Peek() == ',') {
+                        position++;
+                        continue;
+                    }
+                    Expect(']');
+                    return;
+                }
+            }
+
+            std::string ParseString() {
+                Expect('"');
+                std::string result;
+                while (true) {
+                    if (position >= text.size()) {
+                        Fail("Unterminated string");
+                    }
+                    char c = text[position++];
+                    if (c == '"') {
+                        return result;
+                    }
+                    if (c != '\\') {
+                        result += c;
+                        continue;
+                    }
+                    if (position >= text.size()) {
+                        Fail("Unterminated string");
+                    }
+                    char escaped = text[position++];
+                    switch (escaped) {
+                        case '"': result += '"'; break;
+                        case '\\': result += '\\'; break;
+                        case '/': result += '/'; break;
+                        case 'b': result += '\b'; break;
+                        case 'f': result += '\f'; break;
+                        case 'n': result += '\n'; break;
+                        case 'r': result += '\r'; break;
+                        case 't': result += '\t'; break;
+                        case 'u': AppendCodePoint(ParseHex(), result); break;
+                        default: Fail("Invalid escape");
+                    }
+                }
+            }
+
+            unsigned ParseHex() {
+                if (position + 4 > text.size()) {
+                    Fail("Invalid unicode escape");
+                }
+                unsigned codePoint = 0;
+                for (int i = 0; i < 4; i++) {
+                    char c = text[position++];
+                    codePoint <<= 4;
+                    if (c >= '0' && c <= '9') {
+                        codePoint |= c - '0';
+                    } else if (c >= 'a' && c <= 'f') {
+                        codePoint |= c - 'a' + 10;
+                    } else if (c >= 'A' && c <= 'F') {
+                        codePoint |= c - 'A' + 10;
+                    } else {
+                        Fail("Invalid unicode escape");
+                    }
+                }
+                return codePoint;
+            }
+
+            // Encode a code point of the basic multilingual plane as UTF-8. Surrogate pairs are not combined, which
+            // the specs never need
+            static void AppendCodePoint(unsigned codePoint, std::string& out) {
+                if (codePoint < 0x80) {
+                    out += (char) codePoint;
+                } else if (codePoint < 0x800) {
+                    out += (char) (0xC0 | (codePoint >> 6));
+                    out += (char) (0x80 | (codePoint & 0x3F));
+                } else {
+                    out += (char) (0xE0 | (codePoint >> 12));
+                    out += (char) (0x80 | ((codePoint >> 6) & 0x3F));
+                    out += (char) (0x80 | (codePoint & 0x3F));
+                }
+            }
+
+            double ParseNumber() {
+                const char* begin = text.c_str() + position;
+                if (*begin != '-' && (*begin < '0' || *begin > '9')) {
+                    Fail("Unexpected character");
+                }
+                char* end;
+                double number = strtod(begin, &end);
+                position += end - begin;
+                return number;
+            }
+        };
+    }
+}
+
+knn_jni::json::Value knn_jni::json::Value::Parse(const std::string& text) {
+    return Parser(text).ParseDocument();
+}
+
+knn_jni::json::Value knn_jni::json::Value::ParseFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Unable to open " + path);
+    }
+    std::stringstream text;
+    text << file.rdbuf();
+    return Parse(text.str());
+}
+
+knn_jni::json::Value::Value() : type(Type::NUL), boolean(false), number(0) {}
+
+knn_jni::json::Value::Type knn_jni::json::Value::GetType() const {
+    return type;
+}
+
+bool knn_jni::json::Value::IsNumber() const {
+    return type == Type::NUMBER;
+}
+
+bool knn_jni::json::Value::IsString() const {
+    return type == Type::STRING;
+}
+
+bool knn_jni::json::Value::IsObject() const {
+    return type == Type::OBJECT;
+}
+
+bool knn_jni::json::Value::AsBool() const {
+    if (type != Type::BOOLEAN) {
+        throw std::runtime_error("JSON value is not a boolean");
+    }
+    return boolean;
+}
+
+double knn_jni::json::Value::AsNumber() const {
+    if (type != Type::NUMBER) {
+        throw std::runtime_error("JSON value is not a number");
+    }
+    return number;
+}
+
+int knn_jni::json::Value::AsInt() const {
+    double value = AsNumber();
+    if (value != std::floor(value)) {
+        throw std::runtime_error("JSON value is not an integer");
+    }
+    return (int) value;
+}
+
+const std::string& knn_jni::json::Value::AsString() const {
+    if (type != Type::STRING) {
+        throw std::runtime_error("JSON value is not a string");
+    }
+    return string;
+}
+
+const std::vector<std::shared_ptr<const knn_jni::json::Value>>& knn_jni::json::Value::Elements() const {
+    if (type != Type::ARRAY) {
+        throw std::runtime_error("JSON value is not an array");
+    }
+    return elements;
+}
+
+const std::map<std::string, std::shared_ptr<const knn_jni::json::Value>>& knn_jni::json::Value::Members() const {
+    if (type != Type::OBJECT) {
+        throw std::runtime_error("JSON value is not an object");
+    }
+    return members;
+}
+
+const knn_jni::json::Value* knn_jni::json::Value::Find(const std::string& name) const {
+    if (type != Type::OBJECT) {
+        return nullptr;
+    }
+    auto member = members.find(name);
+    return member == members.end() ? nullptr : member->second.get();
+}
@@ -0,0 +1,29 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "live_docs.h"
+
+#include <algorithm>
+
+
+knn_jni::live_docs::LiveDocs::LiveDocs(const uint64_t* words, size_t numWords) : words(words), numWords(numWords) {}
+
+int64_t knn_jni::live_docs::LiveDocs::NumDeleted() const {
+    int64_t numLive = 0;
+    for (size_t i = 0; i < numWords; ++i) {
+        numLive += __builtin_popcountll(words[i]);
+    }
+    return (int64_t) numWords * 64 - numLive;
+}
+
+int64_t knn_jni::live_docs::OverFetchSize(const LiveDocs& liveDocs, int64_t k) {
+    return std::max<int64_t>(k, std::min<int64_t>(k + liveDocs.NumDeleted(), k * MAX_OVER_FETCH_FACTOR));
+}
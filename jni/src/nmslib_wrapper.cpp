@@ -11,6 +11,14 @@
 
 #include "jni_util.h"
 #include "nmslib_wrapper.h"
+#include "adjacency_codec.h"
+#include "graph_reorder.h"
+#include "index_description.h"
+#include "live_docs.h"
+#include "qos.h"
+#include "query_capture.h"
+#include "thread_pool.h"
+#include "usdt.h"
 
 #include "init.h"
 #include "index.h"
@@ -21,12 +29,68 @@
 #include "spacefactory.h"
 #include "space.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <jni.h>
+#include <limits>
 #include <string>
-
+#include <utility>
+#include <vector>
+
+KNN_USDT_SEMAPHORE(opensearch_knn_nmslib, load_start)
+KNN_USDT_SEMAPHORE(opensearch_knn_nmslib, load_done)
+KNN_USDT_SEMAPHORE(opensearch_knn_nmslib, query_start)
+KNN_USDT_SEMAPHORE(opensearch_knn_nmslib, query_done)
+KNN_USDT_SEMAPHORE(opensearch_knn_nmslib, build_start)
+KNN_USDT_SEMAPHORE(opensearch_knn_nmslib, build_done)
+KNN_USDT_SEMAPHORE(opensearch_knn_nmslib, free_start)
+KNN_USDT_SEMAPHORE(opensearch_knn_nmslib, free_done)
 
 std::string TranslateSpaceType(const std::string& spaceType);
 
+// Whether parametersCpp asks for cosine indices to hold normalized vectors and be searched by inner product. Throws if
+// the mode is unknown
+bool IsCosineNormalized(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                        std::unordered_map<std::string, jobject>& parametersCpp);
+
+// Whether parametersCpp asks for the regular layout instead of the optimized one. Throws if the layout is unknown
+bool IsRegularLayout(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                     std::unordered_map<std::string, jobject>& parametersCpp);
+
+// Whether the hnsw index file at indexPath holds the optimized layout, from the flag nmslib writes at its start
+bool ReadOptimizedLayoutFlag(const std::string& indexPath);
+
+// Write the count, dimension, memory and graph summary of the hnsw index file at indexPath, which must be in the
+// optimized layout, to writer. Throws if the file does not have the structure nmslib writes
+void DescribeOptimizedHnswFile(const std::string& indexPath, knn_jni::index_description::JsonWriter& writer);
+
+// Scale vector to unit length. Zero vectors are left as they are
+void NormalizeVector(float * vector, int dim);
+
+// Build an hnsw index over dataset, whose objects hold dim floats each, and write it to indexPathJ. Shared by the
+// float[][] and flat entry points. The objects stay owned by the caller
+void InternalCreateIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, similarity::ObjectVector& dataset, int dim,
+                         jstring indexPathJ, jobject parametersJ);
+
+// Build an index over vectors laid out back to back, dim floats each. vectors is released once copied into the
+// dataset objects
+void InternalCreateIndexFromFlatVectors(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ,
+                                        std::vector<float>& vectors, int dim, jstring indexPathJ,
+                                        jobject parametersJ);
+
+// Query an index, returning only docs live in liveDocs when it is not null
+jobjectArray InternalQueryIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                jfloatArray queryVectorJ, jint kJ, const knn_jni::live_docs::LiveDocs * liveDocs);
+
+// Same as InternalQueryIndex for a query vector of dim floats already in native memory
+jobjectArray InternalSearch(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                            const float* queryVector, int dim, jint kJ,
+                            const knn_jni::live_docs::LiveDocs * liveDocs);
+
 void knn_jni::nmslib_wrapper::CreateIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ,
                                           jobjectArray vectorsJ, jstring indexPathJ, jobject parametersJ) {
 
@@ -46,46 +110,6 @@ void knn_jni::nmslib_wrapper::CreateIndex(knn_jni::JNIUtilInterface * jniUtil, J
         throw std::runtime_error("Parameters cannot be null");
     }
 
-    // Handle parameters
-    auto parametersCpp = jniUtil->ConvertJavaMapToCppMap(env, parametersJ);
-    std::vector<std::string> indexParameters;
-
-    // Algorithm parameters will be in a sub map
-    if(parametersCpp.find(knn_jni::PARAMETERS) != parametersCpp.end()) {
-        jobject subParametersJ = parametersCpp[knn_jni::PARAMETERS];
-        auto subParametersCpp = jniUtil->ConvertJavaMapToCppMap(env, subParametersJ);
-
-        if(subParametersCpp.find(knn_jni::EF_CONSTRUCTION) != subParametersCpp.end()) {
-            auto efConstruction = jniUtil->ConvertJavaObjectToCppInteger(env, subParametersCpp[knn_jni::EF_CONSTRUCTION]);
-            indexParameters.push_back(knn_jni::EF_CONSTRUCTION_NMSLIB + "=" + std::to_string(efConstruction));
-        }
-
-        if(subParametersCpp.find(knn_jni::M) != subParametersCpp.end()) {
-            auto m = jniUtil->ConvertJavaObjectToCppInteger(env, subParametersCpp[knn_jni::M]);
-            indexParameters.push_back(knn_jni::M_NMSLIB + "=" + std::to_string(m));
-        }
-
-        jniUtil->DeleteLocalRef(env, subParametersJ);
-    }
-
-    if(parametersCpp.find(knn_jni::INDEX_THREAD_QUANTITY) != parametersCpp.end()) {
-        auto indexThreadQty = jniUtil->ConvertJavaObjectToCppInteger(env, parametersCpp[knn_jni::INDEX_THREAD_QUANTITY]);
-        indexParameters.push_back(knn_jni::INDEX_THREAD_QUANTITY + "=" + std::to_string(indexThreadQty));
-    }
-
-    jniUtil->DeleteLocalRef(env, parametersJ);
-
-    // Get the path to save the index
-    std::string indexPathCpp(jniUtil->ConvertJavaStringToCppString(env, indexPathJ));
-
-    // Get space type for this index
-    jobject spaceTypeJ = knn_jni::GetJObjectFromMapOrThrow(parametersCpp, knn_jni::SPACE_TYPE);
-    std::string spaceTypeCpp(jniUtil->ConvertJavaObjectToCppString(env, spaceTypeJ));
-    spaceTypeCpp = TranslateSpaceType(spaceTypeCpp);
-
-    std::unique_ptr<similarity::Space<float>> space;
-    space.reset(similarity::SpaceFactoryRegistry<float>::Instance().CreateSpace(spaceTypeCpp,similarity::AnyParams()));
-
     // Get number of ids and vectors and dimension
     int numVectors = jniUtil->GetJavaObjectArrayLength(env, vectorsJ);
     int numIds = jniUtil->GetJavaIntArrayLength(env, idsJ);
@@ -96,7 +120,7 @@ void knn_jni::nmslib_wrapper::CreateIndex(knn_jni::JNIUtilInterface * jniUtil, J
 
     // Read dataset
     similarity::ObjectVector dataset;
-    int* idsCpp;
+    int* idsCpp = nullptr;
     try {
         // Read in data set
         idsCpp = jniUtil->GetIntArrayElements(env, idsJ, nullptr);
@@ -114,13 +138,12 @@ void knn_jni::nmslib_wrapper::CreateIndex(knn_jni::JNIUtilInterface * jniUtil, J
 
             dataset.push_back(new similarity::Object(idsCpp[i], -1, dim*sizeof(float), floatArrayCpp));
             jniUtil->ReleaseFloatArrayElements(env, floatArrayJ, floatArrayCpp, JNI_ABORT);
+            jniUtil->DeleteLocalRef(env, floatArrayJ);
         }
         jniUtil->ReleaseIntArrayElements(env, idsJ, idsCpp, JNI_ABORT);
+        idsCpp = nullptr;
 
-        std::unique_ptr<similarity::Index<float>> index;
-        index.reset(similarity::MethodFactoryRegistry<float>::Instance().CreateMethod(false, "hnsw", spaceTypeCpp, *(space), dataset));
-        index->CreateIndex(similarity::AnyParams(indexParameters));
-        index->SaveIndex(indexPathCpp);
+        InternalCreateIndex(jniUtil, env, dataset, dim, indexPathJ, parametersJ);
 
         for (auto & it : dataset) {
             delete it;
@@ -130,7 +153,92 @@ void knn_jni::nmslib_wrapper::CreateIndex(knn_jni::JNIUtilInterface * jniUtil, J
             delete it;
         }
 
+        if (idsCpp != nullptr) {
+            jniUtil->ReleaseIntArrayElements(env, idsJ, idsCpp, JNI_ABORT);
+        }
+        throw;
+    }
+}
+
+void knn_jni::nmslib_wrapper::CreateIndexFromFlatVectors(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                         jintArray idsJ, jobject vectorsJ, jint dimJ,
+                                                         jstring indexPathJ, jobject parametersJ) {
+
+    if (idsJ == nullptr) {
+        throw std::runtime_error("IDs cannot be null");
+    }
+
+    if (indexPathJ == nullptr) {
+        throw std::runtime_error("Index path cannot be null");
+    }
+
+    if (parametersJ == nullptr) {
+        throw std::runtime_error("Parameters cannot be null");
+    }
+
+    auto vectors = jniUtil->ConvertFlatJavaVectorsToCppFloatVector(env, vectorsJ, dimJ);
+    InternalCreateIndexFromFlatVectors(jniUtil, env, idsJ, vectors, dimJ, indexPathJ, parametersJ);
+}
+
+void knn_jni::nmslib_wrapper::CreateIndexFromHalfVectors(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                         jintArray idsJ, jobject vectorsJ, jint dimJ,
+                                                         jstring encodingJ, jstring indexPathJ, jobject parametersJ) {
+
+    if (idsJ == nullptr) {
+        throw std::runtime_error("IDs cannot be null");
+    }
+
+    if (indexPathJ == nullptr) {
+        throw std::runtime_error("Index path cannot be null");
+    }
+
+    if (parametersJ == nullptr) {
+        throw std::runtime_error("Parameters cannot be null");
+    }
+
+    auto encoding = knn_jni::GetHalfPrecisionEncoding(jniUtil, env, encodingJ);
+    auto vectors = jniUtil->ConvertHalfJavaVectorsToCppFloatVector(env, vectorsJ, dimJ, encoding);
+    InternalCreateIndexFromFlatVectors(jniUtil, env, idsJ, vectors, dimJ, indexPathJ, parametersJ);
+}
+
+void InternalCreateIndexFromFlatVectors(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ,
+                                        std::vector<float>& vectors, int dimJ, jstring indexPathJ,
+                                        jobject parametersJ) {
+    int numVectors = (int) (vectors.size() / dimJ);
+    int numIds = jniUtil->GetJavaIntArrayLength(env, idsJ);
+    if (numIds != numVectors) {
+        throw std::runtime_error("Number of IDs does not match number of vectors");
+    }
+
+    // Read dataset
+    similarity::ObjectVector dataset;
+    int* idsCpp = nullptr;
+    try {
+        idsCpp = jniUtil->GetIntArrayElements(env, idsJ, nullptr);
+        dataset.reserve(numVectors);
+        for (int i = 0; i < numVectors; i++) {
+            dataset.push_back(new similarity::Object(idsCpp[i], -1, dimJ*sizeof(float),
+                                                     vectors.data() + (size_t) i * dimJ));
+        }
         jniUtil->ReleaseIntArrayElements(env, idsJ, idsCpp, JNI_ABORT);
+        idsCpp = nullptr;
+
+        // The objects hold their own copies, so the flat vectors can go before the build allocates the graph
+        std::vector<float>().swap(vectors);
+
+        InternalCreateIndex(jniUtil, env, dataset, dimJ, indexPathJ, parametersJ);
+
+        for (auto & it : dataset) {
+            delete it;
+        }
+    } catch (...) {
+        for (auto & it : dataset) {
+            delete it;
+        }
+
+        if (idsCpp != nullptr) {
+            jniUtil->ReleaseIntArrayElements(env, idsJ, idsCpp, JNI_ABORT);
+        }
         throw;
     }
 }
@@ -147,88 +255,154 @@ jlong knn_jni::nmslib_wrapper::LoadIndex(knn_jni::JNIUtilInterface * jniUtil, JN
     }
 
     std::string indexPathCpp(jniUtil->ConvertJavaStringToCppString(env, indexPathJ));
+    KNN_USDT(opensearch_knn_nmslib, load_start, indexPathCpp.c_str());
+    knn_jni::usdt::Stopwatch stopwatch(KNN_USDT_ENABLED(opensearch_knn_nmslib, load_done));
 
     auto parametersCpp = jniUtil->ConvertJavaMapToCppMap(env, parametersJ);
 
     // Get space type for this index
     jobject spaceTypeJ = knn_jni::GetJObjectFromMapOrThrow(parametersCpp, knn_jni::SPACE_TYPE);
     std::string spaceTypeCpp(jniUtil->ConvertJavaObjectToCppString(env, spaceTypeJ));
+    knn_jni::query_capture::IndexIdentity identity = {knn_jni::query_capture::Engine::NMSLIB, indexPathCpp,
+                                                      {{knn_jni::SPACE_TYPE, spaceTypeCpp}}};
     spaceTypeCpp = TranslateSpaceType(spaceTypeCpp);
 
+    // A cosine index built from normalized vectors is an inner product index underneath
+    bool cosineNormalized = spaceTypeCpp == knn_jni::COSINESIMIL && IsCosineNormalized(jniUtil, env, parametersCpp);
+    if (cosineNormalized) {
+        spaceTypeCpp = knn_jni::NEG_DOT_PRODUCT;
+    }
+    if (parametersCpp.find(knn_jni::COSINE_MODE) != parametersCpp.end()) {
+        identity.parameters.emplace_back(knn_jni::COSINE_MODE, jniUtil->ConvertJavaObjectToCppString(
+                env, parametersCpp[knn_jni::COSINE_MODE]));
+    }
+
     // Parse query params
     std::vector<std::string> queryParams;
 
     if(parametersCpp.find("efSearch") != parametersCpp.end()) {
         auto efSearch = std::to_string(jniUtil->ConvertJavaObjectToCppInteger(env, parametersCpp["efSearch"]));
         queryParams.push_back("efSearch=" + efSearch);
+        identity.parameters.emplace_back("efSearch", efSearch);
     }
 
     // Load index
     knn_jni::nmslib_wrapper::IndexWrapper * indexWrapper;
     try {
         indexWrapper = new knn_jni::nmslib_wrapper::IndexWrapper(spaceTypeCpp);
+        indexWrapper->cosineNormalized = cosineNormalized;
         indexWrapper->index->LoadIndex(indexPathCpp);
         indexWrapper->index->SetQueryTimeParams(similarity::AnyParams(queryParams));
+        indexWrapper->optimizedLayout = ReadOptimizedLayoutFlag(indexPathCpp);
+        indexWrapper->indexPath = indexPathCpp;
     } catch (...) {
         delete indexWrapper;
         throw;
     }
 
+    knn_jni::query_capture::RegisterIndex(indexWrapper, std::move(identity));
+    // nmslib does not expose how many vectors an index holds
+    KNN_USDT(opensearch_knn_nmslib, load_done, indexWrapper, indexPathCpp.c_str(), (int64_t) -1, stopwatch.Elapsed());
     return (jlong) indexWrapper;
 }
 
 jobjectArray knn_jni::nmslib_wrapper::QueryIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
                                                  jfloatArray queryVectorJ, jint kJ) {
+    return InternalQueryIndex(jniUtil, env, indexPointerJ, queryVectorJ, kJ, nullptr);
+}
+
+jobjectArray knn_jni::nmslib_wrapper::QueryIndexWithLiveDocs(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                             jlong indexPointerJ, jfloatArray queryVectorJ, jint kJ,
+                                                             jlongArray liveDocsJ) {
+    if (liveDocsJ == nullptr) {
+        return InternalQueryIndex(jniUtil, env, indexPointerJ, queryVectorJ, kJ, nullptr);
+    }
+
+    int numWords = jniUtil->GetJavaLongArrayLength(env, liveDocsJ);
+    jlong * liveDocsWords = jniUtil->GetLongArrayElements(env, liveDocsJ, nullptr);
+    knn_jni::live_docs::LiveDocs liveDocs(reinterpret_cast<const uint64_t *>(liveDocsWords), numWords);
+    jobjectArray results;
+    try {
+        results = InternalQueryIndex(jniUtil, env, indexPointerJ, queryVectorJ, kJ, &liveDocs);
+    } catch (...) {
+        jniUtil->ReleaseLongArrayElements(env, liveDocsJ, liveDocsWords, JNI_ABORT);
+        throw;
+    }
+    jniUtil->ReleaseLongArrayElements(env, liveDocsJ, liveDocsWords, JNI_ABORT);
+    return results;
+}
 
+jobjectArray knn_jni::nmslib_wrapper::QueryIndexWithHalfVector(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                               jlong indexPointerJ, jshortArray queryVectorJ,
+                                                               jstring encodingJ, jint kJ) {
     if (queryVectorJ == nullptr) {
         throw std::runtime_error("Query Vector cannot be null");
     }
 
+    // Every length is a multiple of 1, so the whole array is read as one vector
+    auto encoding = knn_jni::GetHalfPrecisionEncoding(jniUtil, env, encodingJ);
+    auto queryVector = jniUtil->ConvertHalfJavaVectorsToCppFloatVector(env, queryVectorJ, 1, encoding);
+    return InternalSearch(jniUtil, env, indexPointerJ, queryVector.data(), (int) queryVector.size(), kJ, nullptr);
+}
+
+bool knn_jni::nmslib_wrapper::IsOptimizedLayout(jlong indexPointerJ) {
     if (indexPointerJ == 0) {
         throw std::runtime_error("Invalid pointer to index");
     }
 
-    auto *indexWrapper = reinterpret_cast<knn_jni::nmslib_wrapper::IndexWrapper*>(indexPointerJ);
-
-    int dim	= jniUtil->GetJavaFloatArrayLength(env, queryVectorJ);
-
-    float* rawQueryvector = jniUtil->GetFloatArrayElements(env, queryVectorJ, nullptr); // Have to call release on this
+    return reinterpret_cast<knn_jni::nmslib_wrapper::IndexWrapper*>(indexPointerJ)->optimizedLayout;
+}
 
-    std::unique_ptr<const similarity::Object> queryObject;
-    try {
-        queryObject.reset(new similarity::Object(-1, -1, dim*sizeof(float), rawQueryvector));
-    } catch (...) {
-        jniUtil->ReleaseFloatArrayElements(env, queryVectorJ, rawQueryvector, JNI_ABORT);
-        throw;
+jbyteArray knn_jni::nmslib_wrapper::DescribeIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                  jlong indexPointerJ) {
+    if (indexPointerJ == 0) {
+        throw std::runtime_error("Invalid pointer to index");
     }
-    jniUtil->ReleaseFloatArrayElements(env, queryVectorJ, rawQueryvector, JNI_ABORT);
-
-    similarity::KNNQuery<float> knnQuery(*(indexWrapper->space), queryObject.get(), kJ);
-    indexWrapper->index->Search(&knnQuery);
-
-    std::unique_ptr<similarity::KNNQueue<float>> neighbors(knnQuery.Result()->Clone());
-    int resultSize = neighbors->Size();
 
-    jclass resultClass = jniUtil->FindClass(env,"org/opensearch/knn/index/KNNQueryResult");
-    jmethodID allArgs = jniUtil->FindMethod(env, "org/opensearch/knn/index/KNNQueryResult", "<init>");
+    auto *indexWrapper = reinterpret_cast<knn_jni::nmslib_wrapper::IndexWrapper*>(indexPointerJ);
+    if (indexWrapper->indexPath.empty()) {
+        throw std::runtime_error("Index was not loaded from a file");
+    }
 
-    jobjectArray results = jniUtil->NewObjectArray(env, resultSize, resultClass, nullptr);
+    // Report the space the plugin asked for rather than the one nmslib searches in
+    std::string metric = indexWrapper->spaceType;
+    if (indexWrapper->cosineNormalized) {
+        metric = knn_jni::COSINESIMIL;
+    } else if (metric == knn_jni::NEG_DOT_PRODUCT) {
+        metric = knn_jni::INNER_PRODUCT;
+    }
 
-    jobject result;
-    float distance;
-    long id;
-    for(int i = 0; i < resultSize; ++i) {
-        distance = neighbors->TopDistance();
-        id = neighbors->Pop()->id();
-        result = jniUtil->NewObject(env, resultClass, allArgs, id, distance);
-        jniUtil->SetObjectArrayElement(env, results, i, result);
+    knn_jni::index_description::JsonWriter writer;
+    writer.String("engine", knn_jni::NMSLIB_NAME);
+    writer.String("metric", metric);
+    writer.String("layout", indexWrapper->optimizedLayout ? knn_jni::INDEX_LAYOUT_OPTIMIZED
+                                                          : knn_jni::INDEX_LAYOUT_REGULAR);
+    if (indexWrapper->optimizedLayout) {
+        DescribeOptimizedHnswFile(indexWrapper->indexPath, writer);
+    } else {
+        std::ifstream input(indexWrapper->indexPath, std::ios::binary | std::ios::ate);
+        if (!input) {
+            throw std::runtime_error("Unable to open index file " + indexWrapper->indexPath);
+        }
+        writer.BeginObject("memory");
+        writer.Number("total", (int64_t) input.tellg());
+        writer.EndObject();
     }
-    return results;
+
+    std::string description = writer.Finish();
+    jbyteArray ret = jniUtil->NewByteArray(env, (jsize) description.size());
+    jniUtil->SetByteArrayRegion(env, ret, 0, (jsize) description.size(),
+                                reinterpret_cast<const jbyte*>(description.data()));
+    return ret;
 }
 
 void knn_jni::nmslib_wrapper::Free(jlong indexPointerJ) {
     auto *indexWrapper = reinterpret_cast<knn_jni::nmslib_wrapper::IndexWrapper*>(indexPointerJ);
+    KNN_USDT(opensearch_knn_nmslib, free_start, indexWrapper);
+    knn_jni::usdt::Stopwatch stopwatch(KNN_USDT_ENABLED(opensearch_knn_nmslib, free_done));
+    knn_jni::query_capture::UnregisterIndex(indexWrapper);
     delete indexWrapper;
+    KNN_USDT(opensearch_knn_nmslib, free_done, indexWrapper, stopwatch.Elapsed());
 }
 
 void knn_jni::nmslib_wrapper::InitLibrary() {
@@ -258,3 +432,397 @@ std::string TranslateSpaceType(const std::string& spaceType) {
 
     throw std::runtime_error("Invalid spaceType");
 }
+
+bool IsCosineNormalized(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                        std::unordered_map<std::string, jobject>& parametersCpp) {
+    if (parametersCpp.find(knn_jni::COSINE_MODE) == parametersCpp.end()) {
+        return false;
+    }
+
+    auto mode = jniUtil->ConvertJavaObjectToCppString(env, parametersCpp[knn_jni::COSINE_MODE]);
+    if (mode == knn_jni::COSINE_MODE_NORMALIZED) {
+        return true;
+    }
+
+    if (mode == knn_jni::COSINE_MODE_RAW) {
+        return false;
+    }
+
+    throw std::runtime_error("Invalid cosine mode \"" + mode + "\"");
+}
+
+bool IsRegularLayout(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                     std::unordered_map<std::string, jobject>& parametersCpp) {
+    if (parametersCpp.find(knn_jni::INDEX_LAYOUT) == parametersCpp.end()) {
+        return false;
+    }
+
+    auto layout = jniUtil->ConvertJavaObjectToCppString(env, parametersCpp[knn_jni::INDEX_LAYOUT]);
+    if (layout == knn_jni::INDEX_LAYOUT_REGULAR) {
+        return true;
+    }
+
+    if (layout == knn_jni::INDEX_LAYOUT_OPTIMIZED) {
+        return false;
+    }
+
+    throw std::runtime_error("Invalid index layout \"" + layout + "\"");
+}
+
+bool ReadOptimizedLayoutFlag(const std::string& indexPath) {
+    // nmslib only builds the optimized layout for the spaces it has flat kernels for, and falls back to the regular
+    // one otherwise, so the file is the only reliable record of which layout is in use
+    std::ifstream input(indexPath, std::ios::binary);
+    uint32_t optimizedFlag = 0;
+    if (!input.read(reinterpret_cast<char*>(&optimizedFlag), sizeof(optimizedFlag))) {
+        throw std::runtime_error("Unable to read index layout of " + indexPath);
+    }
+    return optimizedFlag != 0;
+}
+
+namespace {
+    // Bytes before the vector in an nmslib object: 32 bit id and label, then the data length as a size_t
+    const size_t NMSLIB_OBJECT_HEADER_SIZE = 2 * sizeof(int32_t) + sizeof(size_t);
+    const size_t NMSLIB_DATA_LENGTH_OFFSET = 2 * sizeof(int32_t);
+
+    template <typename T>
+    T ReadHnswField(std::istream& input, const std::string& indexPath) {
+        T value;
+        if (!input.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+            throw std::runtime_error("Unexpected end of index file " + indexPath);
+        }
+        return value;
+    }
+
+    // Append the count and ids of a link list, as nmslib stores them, to layers
+    void AppendLinks(const char * links, size_t maxLinks, std::vector<std::vector<int32_t>>& layers,
+                     const std::string& indexPath) {
+        int32_t count;
+        memcpy(&count, links, sizeof(count));
+        if (count < 0 || (size_t) count > maxLinks) {
+            throw std::runtime_error("Unrecognized link list in index file " + indexPath);
+        }
+        layers.emplace_back(count);
+        memcpy(layers.back().data(), links + sizeof(int32_t), count * sizeof(int32_t));
+    }
+}
+
+void DescribeOptimizedHnswFile(const std::string& indexPath, knn_jni::index_description::JsonWriter& writer) {
+    std::ifstream input(indexPath, std::ios::binary);
+    if (!input) {
+        throw std::runtime_error("Unable to open index file " + indexPath);
+    }
+
+    // The header Hnsw::SaveOptimizedIndex writes after the layout flag
+    auto optimizedFlag = ReadHnswField<uint32_t>(input, indexPath);
+    auto totalElements = ReadHnswField<uint32_t>(input, indexPath);
+    auto memoryPerObject = ReadHnswField<size_t>(input, indexPath);
+    auto offsetLevel0 = ReadHnswField<size_t>(input, indexPath);
+    auto offsetData = ReadHnswField<size_t>(input, indexPath);
+    auto maxLevel = ReadHnswField<int32_t>(input, indexPath);
+    auto entryPoint = ReadHnswField<uint32_t>(input, indexPath);
+    auto maxM = ReadHnswField<size_t>(input, indexPath);
+    auto maxM0 = ReadHnswField<size_t>(input, indexPath);
+    ReadHnswField<int32_t>(input, indexPath);  // Distance function
+    ReadHnswField<size_t>(input, indexPath);   // Search method
+
+    size_t level0Size = (maxM0 + 1) * sizeof(int32_t);
+    if (optimizedFlag == 0 || maxM == 0 || offsetLevel0 + level0Size > memoryPerObject ||
+        offsetData + NMSLIB_OBJECT_HEADER_SIZE > memoryPerObject || totalElements > (uint32_t) INT32_MAX) {
+        throw std::runtime_error("Unrecognized header in index file " + indexPath);
+    }
+
+    // Base layer links are stored with the vectors, one block per node, and the upper layers of every node follow
+    // all blocks, so the base lists are held until the upper ones are read
+    auto numNodes = (int32_t) totalElements;
+    std::vector<std::vector<int32_t>> baseLayers;
+    baseLayers.reserve(numNodes);
+    std::vector<char> block(memoryPerObject);
+    int64_t dimension = 0;
+    for (int32_t node = 0; node < numNodes; ++node) {
+        if (!input.read(block.data(), memoryPerObject)) {
+            throw std::runtime_error("Unexpected end of index file " + indexPath);
+        }
+        if (node == 0) {
+            size_t dataLength;
+            memcpy(&dataLength, block.data() + offsetData + NMSLIB_DATA_LENGTH_OFFSET, sizeof(dataLength));
+            dimension = (int64_t) (dataLength / sizeof(float));
+        }
+        AppendLinks(block.data() + offsetLevel0, maxM0, baseLayers, indexPath);
+    }
+
+    knn_jni::adjacency_codec::CompressedGraph graph;
+    std::vector<int> topLayers(numNodes);
+    int64_t upperLinkBytes = 0;
+    size_t upperListSize = (maxM + 1) * sizeof(int32_t);
+    std::vector<char> upperLinks;
+    std::vector<std::vector<int32_t>> layers;
+    for (int32_t node = 0; node < numNodes; ++node) {
+        auto linkBytes = ReadHnswField<uint32_t>(input, indexPath);
+        if (linkBytes % upperListSize != 0) {
+            throw std::runtime_error("Unrecognized link list in index file " + indexPath);
+        }
+        upperLinks.resize(linkBytes);
+        if (linkBytes > 0 && !input.read(upperLinks.data(), linkBytes)) {
+            throw std::runtime_error("Unexpected end of index file " + indexPath);
+        }
+        upperLinkBytes += linkBytes;
+
+        layers.clear();
+        layers.push_back(std::move(baseLayers[node]));
+        topLayers[node] = (int) (linkBytes / upperListSize);
+        for (int layer = 1; layer <= topLayers[node]; ++layer) {
+            AppendLinks(upperLinks.data() + (layer - 1) * upperListSize, maxM, layers, indexPath);
+        }
+        graph.AppendNode(layers);
+    }
+    if (input.peek() != std::ifstream::traits_type::eof()) {
+        throw std::runtime_error("Unrecognized trailing data in index file " + indexPath);
+    }
+
+    int64_t vectorBytes = (int64_t) numNodes * (int64_t) (memoryPerObject - level0Size);
+    int64_t graphBytes = (int64_t) numNodes * (int64_t) level0Size + upperLinkBytes;
+    writer.Number("count", (int64_t) numNodes);
+    writer.Number("dimension", dimension);
+    writer.BeginObject("memory");
+    writer.Number("ids", (int64_t) 0);
+    writer.Number("vectors", vectorBytes);
+    writer.Number("graph", graphBytes);
+    writer.Number("total", vectorBytes + graphBytes);
+    writer.EndObject();
+
+    writer.BeginObject("hnsw");
+    writer.Number("entry_point", (int64_t) entryPoint);
+    writer.Number("max_level", (int64_t) maxLevel);
+    writer.String("graph_encoding", "fixed");
+    writer.Graph(knn_jni::index_description::SummarizeGraph(
+            numNodes, topLayers, (int32_t) entryPoint,
+            [&graph](int32_t node, int layer, std::vector<int32_t>& out) { graph.Neighbors(node, layer, out); }));
+    writer.EndObject();
+}
+
+void NormalizeVector(float * vector, int dim) {
+    double norm = 0;
+    for (int i = 0; i < dim; i++) {
+        norm += (double) vector[i] * vector[i];
+    }
+
+    if (norm == 0) {
+        return;
+    }
+
+    auto scale = (float) (1 / std::sqrt(norm));
+    for (int i = 0; i < dim; i++) {
+        vector[i] *= scale;
+    }
+}
+
+void InternalCreateIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, similarity::ObjectVector& dataset, int dim,
+                         jstring indexPathJ, jobject parametersJ) {
+    int numVectors = (int) dataset.size();
+    KNN_USDT(opensearch_knn_nmslib, build_start, numVectors, dim);
+    knn_jni::usdt::Stopwatch stopwatch(KNN_USDT_ENABLED(opensearch_knn_nmslib, build_done));
+
+    // Handle parameters
+    auto parametersCpp = jniUtil->ConvertJavaMapToCppMap(env, parametersJ);
+    std::vector<std::string> indexParameters;
+
+    auto reorderStrategy = knn_jni::graph_reorder::ReorderStrategy::NONE;
+    bool cosineNormalized = false;
+
+    // Algorithm parameters will be in a sub map
+    if(parametersCpp.find(knn_jni::PARAMETERS) != parametersCpp.end()) {
+        jobject subParametersJ = parametersCpp[knn_jni::PARAMETERS];
+        auto subParametersCpp = jniUtil->ConvertJavaMapToCppMap(env, subParametersJ);
+
+        if(subParametersCpp.find(knn_jni::EF_CONSTRUCTION) != subParametersCpp.end()) {
+            auto efConstruction = jniUtil->ConvertJavaObjectToCppInteger(env, subParametersCpp[knn_jni::EF_CONSTRUCTION]);
+            indexParameters.push_back(knn_jni::EF_CONSTRUCTION_NMSLIB + "=" + std::to_string(efConstruction));
+        }
+
+        if(subParametersCpp.find(knn_jni::M) != subParametersCpp.end()) {
+            auto m = jniUtil->ConvertJavaObjectToCppInteger(env, subParametersCpp[knn_jni::M]);
+            indexParameters.push_back(knn_jni::M_NMSLIB + "=" + std::to_string(m));
+        }
+
+        // nmslib keeps its graph private, so only the insertion order can be changed
+        reorderStrategy = knn_jni::GetGraphReorderStrategy(jniUtil, env, subParametersCpp);
+        if (reorderStrategy != knn_jni::graph_reorder::ReorderStrategy::NONE
+            && reorderStrategy != knn_jni::graph_reorder::ReorderStrategy::LOCALITY) {
+            throw std::runtime_error("nmslib only supports the \"none\" and \"locality\" graph reorder strategies");
+        }
+        cosineNormalized = IsCosineNormalized(jniUtil, env, subParametersCpp);
+
+        if (IsRegularLayout(jniUtil, env, subParametersCpp)) {
+            indexParameters.push_back(knn_jni::SKIP_OPTIMIZED_INDEX_NMSLIB + "=1");
+        }
+
+        jniUtil->DeleteLocalRef(env, subParametersJ);
+    }
+
+    // nmslib spawns its own threads for the build. Borrow them from the native CPU budget so that concurrent builds
+    // cannot oversubscribe the node
+    knn_jni::thread_pool::ThreadBudget threadBudget(knn_jni::GetRequestedThreadCount(jniUtil, env, parametersCpp));
+    if (threadBudget.Count() > 0) {
+        indexParameters.push_back(knn_jni::INDEX_THREAD_QUANTITY + "=" + std::to_string(threadBudget.Count()));
+    }
+    auto schedulingPolicy = knn_jni::GetBuildSchedulingPolicy(jniUtil, env, parametersCpp);
+
+    jniUtil->DeleteLocalRef(env, parametersJ);
+
+    // Get the path to save the index
+    std::string indexPathCpp(jniUtil->ConvertJavaStringToCppString(env, indexPathJ));
+
+    // Get space type for this index
+    jobject spaceTypeJ = knn_jni::GetJObjectFromMapOrThrow(parametersCpp, knn_jni::SPACE_TYPE);
+    std::string spaceTypeCpp(jniUtil->ConvertJavaObjectToCppString(env, spaceTypeJ));
+    spaceTypeCpp = TranslateSpaceType(spaceTypeCpp);
+
+    // The cosine space works out both norms in every distance call. Normalizing once up front lets the graph be built
+    // by inner product instead, which ranks neighbors the same way. The objects are owned by the caller's data set
+    if (cosineNormalized && spaceTypeCpp == knn_jni::COSINESIMIL) {
+        for (auto & it : dataset) {
+            NormalizeVector(reinterpret_cast<float*>(const_cast<char*>(it->data())), dim);
+        }
+        spaceTypeCpp = knn_jni::NEG_DOT_PRODUCT;
+    }
+
+    std::unique_ptr<similarity::Space<float>> space;
+    space.reset(similarity::SpaceFactoryRegistry<float>::Instance().CreateSpace(spaceTypeCpp,similarity::AnyParams()));
+
+    // nmslib keeps its graph private and lays nodes out in insertion order, so locality is improved by inserting
+    // similar vectors next to each other instead of renumbering the graph afterwards. Ids travel with the objects.
+    if (reorderStrategy == knn_jni::graph_reorder::ReorderStrategy::LOCALITY) {
+        std::vector<const float*> vectors;
+        vectors.reserve(dataset.size());
+        for (auto & it : dataset) {
+            vectors.push_back(reinterpret_cast<const float*>(it->data()));
+        }
+
+        auto order = knn_jni::graph_reorder::ComputeLocalityOrder(vectors, dim);
+        similarity::ObjectVector reordered;
+        reordered.reserve(dataset.size());
+        for (auto position : order) {
+            reordered.push_back(dataset[position]);
+        }
+        dataset.swap(reordered);
+    }
+
+    std::unique_ptr<similarity::Index<float>> index;
+    index.reset(similarity::MethodFactoryRegistry<float>::Instance().CreateMethod(false, "hnsw", spaceTypeCpp, *(space), dataset));
+
+    // nmslib has no hook to yield between insertions, so the build relies on the lower thread priority alone
+    knn_jni::qos::RunWithPolicy(schedulingPolicy, [&]() {
+        index->CreateIndex(similarity::AnyParams(indexParameters));
+    });
+    index->SaveIndex(indexPathCpp);
+    KNN_USDT(opensearch_knn_nmslib, build_done, numVectors, dim, indexPathCpp.c_str(), stopwatch.Elapsed());
+}
+
+jobjectArray InternalQueryIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                jfloatArray queryVectorJ, jint kJ, const knn_jni::live_docs::LiveDocs * liveDocs) {
+
+    if (queryVectorJ == nullptr) {
+        throw std::runtime_error("Query Vector cannot be null");
+    }
+
+    int dim	= jniUtil->GetJavaFloatArrayLength(env, queryVectorJ);
+
+    float* rawQueryvector = jniUtil->GetFloatArrayElements(env, queryVectorJ, nullptr); // Have to call release on this
+
+    jobjectArray results;
+    try {
+        results = InternalSearch(jniUtil, env, indexPointerJ, rawQueryvector, dim, kJ, liveDocs);
+    } catch (...) {
+        jniUtil->ReleaseFloatArrayElements(env, queryVectorJ, rawQueryvector, JNI_ABORT);
+        throw;
+    }
+    jniUtil->ReleaseFloatArrayElements(env, queryVectorJ, rawQueryvector, JNI_ABORT);
+    return results;
+}
+
+jobjectArray InternalSearch(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                            const float* queryVector, int dim, jint kJ,
+                            const knn_jni::live_docs::LiveDocs * liveDocs) {
+
+    if (indexPointerJ == 0) {
+        throw std::runtime_error("Invalid pointer to index");
+    }
+
+    auto *indexWrapper = reinterpret_cast<knn_jni::nmslib_wrapper::IndexWrapper*>(indexPointerJ);
+    KNN_USDT(opensearch_knn_nmslib, query_start, indexWrapper, (int) kJ, liveDocs != nullptr);
+    knn_jni::usdt::Stopwatch stopwatch(KNN_USDT_ENABLED(opensearch_knn_nmslib, query_done));
+
+    std::unique_ptr<similarity::Object> queryObject(new similarity::Object(-1, -1, dim*sizeof(float), queryVector));
+    if (indexWrapper->cosineNormalized) {
+        NormalizeVector(reinterpret_cast<float*>(queryObject->data()), dim);
+    }
+
+    // nmslib has no hook into the graph traversal, so deleted docs are made up for by fetching one extra result for
+    // each of them, up to a bounded multiple of k
+    int fetchK = kJ;
+    if (liveDocs != nullptr) {
+        fetchK = (int) std::min<int64_t>(std::numeric_limits<int>::max(),
+                                         knn_jni::live_docs::OverFetchSize(*liveDocs, kJ));
+    }
+
+    similarity::KNNQuery<float> knnQuery(*(indexWrapper->space), queryObject.get(), fetchK);
+    bool capture = knn_jni::query_capture::ShouldCapture();
+    std::chrono::steady_clock::time_point start;
+    if (capture) {
+        start = std::chrono::steady_clock::now();
+    }
+    {
+        // Builds running on this node back off while the query is in flight
+        knn_jni::qos::ScopedQuery scopedQuery;
+        indexWrapper->index->Search(&knnQuery);
+    }
+    std::chrono::nanoseconds latency(0);
+    if (capture) {
+        latency = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    }
+
+    // The queue pops the farthest neighbor first
+    std::unique_ptr<similarity::KNNQueue<float>> neighbors(knnQuery.Result()->Clone());
+    std::vector<std::pair<long, float>> neighborsCpp;
+    while (!neighbors->Empty()) {
+        float distance = neighbors->TopDistance();
+        if (indexWrapper->cosineNormalized) {
+            // Between unit vectors, the cosine distance 1 - cos is one more than the negative dot product
+            distance += 1;
+        }
+        neighborsCpp.emplace_back(neighbors->Pop()->id(), distance);
+    }
+
+    std::vector<std::pair<long, float>> liveNeighbors;
+    for (auto it = neighborsCpp.rbegin(); it != neighborsCpp.rend() && liveNeighbors.size() < (size_t) kJ; ++it) {
+        if (liveDocs == nullptr || liveDocs->IsLive(it->first)) {
+            liveNeighbors.push_back(*it);
+        }
+    }
+    // Sampled queries are written to the capture log for offline replay, nearest first like faiss results
+    if (capture) {
+        std::vector<int64_t> ids;
+        for (const auto& neighbor : liveNeighbors) {
+            ids.push_back(neighbor.first);
+        }
+        knn_jni::query_capture::Capture(indexWrapper, queryVector, dim, kJ, liveDocs != nullptr,
+                                        (uint64_t) latency.count(), ids.data(), (int) ids.size());
+    }
+
+    std::reverse(liveNeighbors.begin(), liveNeighbors.end());
+    int resultSize = liveNeighbors.size();
+
+    jclass resultClass = jniUtil->FindClass(env,"org/opensearch/knn/index/KNNQueryResult");
+    jmethodID allArgs = jniUtil->FindMethod(env, "org/opensearch/knn/index/KNNQueryResult", "<init>");
+
+    jobjectArray results = jniUtil->NewObjectArray(env, resultSize, resultClass, nullptr);
+
+    jobject result;
+    for(int i = 0; i < resultSize; ++i) {
+        result = jniUtil->NewObject(env, resultClass, allArgs, liveNeighbors[i].first, liveNeighbors[i].second);
+        jniUtil->SetObjectArrayElement(env, results, i, result);
+    }
+    KNN_USDT(opensearch_knn_nmslib, query_done, indexWrapper, (int) kJ, resultSize, stopwatch.Elapsed());
+    return results;
+}
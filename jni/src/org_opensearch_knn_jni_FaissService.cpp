@@ -51,6 +51,48 @@ JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_createIndex(JNIE
     }
 }
 
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_createIndexFromFlatVectors(JNIEnv * env, jclass cls,
+                                                                                           jintArray idsJ,
+                                                                                           jobject vectorsJ,
+                                                                                           jint dimJ,
+                                                                                           jstring indexPathJ,
+                                                                                           jobject parametersJ)
+{
+    try {
+        knn_jni::faiss_wrapper::CreateIndexFromFlatVectors(&jniUtil, env, idsJ, vectorsJ, dimJ, indexPathJ,
+                                                           parametersJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+}
+
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_createIndexFromHalfVectors(
+        JNIEnv * env, jclass cls, jintArray idsJ, jobject vectorsJ, jint dimJ, jstring encodingJ, jstring indexPathJ,
+        jobject parametersJ)
+{
+    try {
+        knn_jni::faiss_wrapper::CreateIndexFromHalfVectors(&jniUtil, env, idsJ, vectorsJ, dimJ, encodingJ, indexPathJ,
+                                                           parametersJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+}
+
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_createIndexFromByteVectors(JNIEnv * env, jclass cls,
+                                                                                           jintArray idsJ,
+                                                                                           jobject vectorsJ,
+                                                                                           jint dimJ,
+                                                                                           jstring indexPathJ,
+                                                                                           jobject parametersJ)
+{
+    try {
+        knn_jni::faiss_wrapper::CreateIndexFromByteVectors(&jniUtil, env, idsJ, vectorsJ, dimJ, indexPathJ,
+                                                           parametersJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+}
+
 JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_createIndexFromTemplate(JNIEnv * env, jclass cls,
                                                                                         jintArray idsJ,
                                                                                         jobjectArray vectorsJ,
@@ -65,10 +107,23 @@ JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_createIndexFromT
     }
 }
 
-JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_loadIndex(JNIEnv * env, jclass cls, jstring indexPathJ)
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_createIndexFromTemplateWithFlatVectors(
+        JNIEnv * env, jclass cls, jintArray idsJ, jobject vectorsJ, jint dimJ, jstring indexPathJ,
+        jbyteArray templateIndexJ, jobject parametersJ)
+{
+    try {
+        knn_jni::faiss_wrapper::CreateIndexFromTemplateWithFlatVectors(&jniUtil, env, idsJ, vectorsJ, dimJ, indexPathJ,
+                                                                       templateIndexJ, parametersJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+}
+
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_loadIndex(JNIEnv * env, jclass cls, jstring indexPathJ,
+                                                                           jobject parametersJ)
 {
     try {
-        return knn_jni::faiss_wrapper::LoadIndex(&jniUtil, env, indexPathJ);
+        return knn_jni::faiss_wrapper::LoadIndex(&jniUtil, env, indexPathJ, parametersJ);
     } catch (...) {
         jniUtil.CatchCppExceptionAndThrowJava(env);
     }
@@ -88,6 +143,68 @@ JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_FaissService_queryInd
     return nullptr;
 }
 
+JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_FaissService_queryIndexWithHalfVector(
+        JNIEnv * env, jclass cls, jlong indexPointerJ, jshortArray queryVectorJ, jstring encodingJ, jint kJ)
+{
+    try {
+        return knn_jni::faiss_wrapper::QueryIndexWithHalfVector(&jniUtil, env, indexPointerJ, queryVectorJ, encodingJ, kJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return nullptr;
+}
+
+JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_FaissService_queryIndexWithByteVector(JNIEnv * env,
+                                                                                                 jclass cls,
+                                                                                                 jlong indexPointerJ,
+                                                                                                 jbyteArray queryVectorJ,
+                                                                                                 jint kJ)
+{
+    try {
+        return knn_jni::faiss_wrapper::QueryIndexWithByteVector(&jniUtil, env, indexPointerJ, queryVectorJ, kJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return nullptr;
+}
+
+JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_FaissService_queryIndexWithLiveDocs(JNIEnv * env, jclass cls,
+                                                                                               jlong indexPointerJ,
+                                                                                               jfloatArray queryVectorJ, jint kJ,
+                                                                                               jlongArray liveDocsJ)
+{
+    try {
+        return knn_jni::faiss_wrapper::QueryIndexWithLiveDocs(&jniUtil, env, indexPointerJ, queryVectorJ, kJ, liveDocsJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return nullptr;
+}
+
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_selfJoin(JNIEnv * env, jclass cls, jlong indexPointerJ,
+                                                                      jint kJ, jboolean exactJ, jstring outputPathJ,
+                                                                      jobject parametersJ)
+{
+    try {
+        knn_jni::faiss_wrapper::SelfJoin(&jniUtil, env, indexPointerJ, kJ, exactJ, outputPathJ, parametersJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+}
+
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_knnJoin(JNIEnv * env, jclass cls, jlong indexPointerJ,
+                                                                     jlong queryVectorsPointerJ, jint kJ,
+                                                                     jboolean exactJ, jstring outputPathJ,
+                                                                     jobject parametersJ)
+{
+    try {
+        knn_jni::faiss_wrapper::KnnJoin(&jniUtil, env, indexPointerJ, queryVectorsPointerJ, kJ, exactJ, outputPathJ,
+                                        parametersJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+}
+
 JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_free(JNIEnv * env, jclass cls, jlong indexPointerJ)
 {
     try {
@@ -97,6 +214,68 @@ JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_free(JNIEnv * en
     }
 }
 
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_setRecallSampling(JNIEnv * env, jclass cls,
+                                                                                jlong indexPointerJ, jfloat rateJ)
+{
+    try {
+        knn_jni::faiss_wrapper::SetRecallSampling(indexPointerJ, rateJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+}
+
+JNIEXPORT jfloatArray JNICALL Java_org_opensearch_knn_jni_FaissService_getRecallStats(JNIEnv * env, jclass cls,
+                                                                                      jlong indexPointerJ)
+{
+    try {
+        return knn_jni::faiss_wrapper::GetRecallStats(&jniUtil, env, indexPointerJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return nullptr;
+}
+
+JNIEXPORT jbyteArray JNICALL Java_org_opensearch_knn_jni_FaissService_describeIndex(JNIEnv * env, jclass cls,
+                                                                                    jlong indexPointerJ)
+{
+    try {
+        return knn_jni::faiss_wrapper::DescribeIndex(&jniUtil, env, indexPointerJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return nullptr;
+}
+
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_startQueryCapture(JNIEnv * env, jclass cls,
+                                                                                jstring pathJ, jlong capacityJ,
+                                                                                jfloat rateJ)
+{
+    try {
+        knn_jni::faiss_wrapper::StartQueryCapture(&jniUtil, env, pathJ, capacityJ, rateJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+}
+
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_stopQueryCapture(JNIEnv * env, jclass cls)
+{
+    try {
+        knn_jni::faiss_wrapper::StopQueryCapture();
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+}
+
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_setThreadPoolSize(JNIEnv * env, jclass cls,
+                                                                                jint numThreadsJ)
+{
+    try {
+        knn_jni::faiss_wrapper::SetThreadPoolSize(numThreadsJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+}
+
 JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_initLibrary(JNIEnv * env, jclass cls)
 {
     try {
@@ -119,6 +298,46 @@ JNIEXPORT jbyteArray JNICALL Java_org_opensearch_knn_jni_FaissService_trainIndex
     return nullptr;
 }
 
+JNIEXPORT jintArray JNICALL Java_org_opensearch_knn_jni_FaissService_listSizes(JNIEnv * env, jclass cls,
+                                                                               jbyteArray templateIndexJ,
+                                                                               jlong trainVectorsPointerJ)
+{
+    try {
+        return knn_jni::faiss_wrapper::ListSizes(&jniUtil, env, templateIndexJ, trainVectorsPointerJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return nullptr;
+}
+
+JNIEXPORT jfloatArray JNICALL Java_org_opensearch_knn_jni_FaissService_calibrate(JNIEnv * env, jclass cls,
+                                                                                 jlong indexPointerJ,
+                                                                                 jlong queryVectorsPointerJ, jint kJ,
+                                                                                 jfloat targetRecallJ)
+{
+    try {
+        return knn_jni::faiss_wrapper::Calibrate(&jniUtil, env, indexPointerJ, queryVectorsPointerJ, kJ, targetRecallJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return nullptr;
+}
+
+JNIEXPORT jfloatArray JNICALL Java_org_opensearch_knn_jni_FaissService_calibrateTemplate(JNIEnv * env, jclass cls,
+                                                                                         jbyteArray templateIndexJ,
+                                                                                         jlong trainVectorsPointerJ,
+                                                                                         jlong queryVectorsPointerJ,
+                                                                                         jint kJ, jfloat targetRecallJ)
+{
+    try {
+        return knn_jni::faiss_wrapper::CalibrateTemplate(&jniUtil, env, templateIndexJ, trainVectorsPointerJ,
+                                                         queryVectorsPointerJ, kJ, targetRecallJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return nullptr;
+}
+
 JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_transferVectors(JNIEnv * env, jclass cls,
                                                                                  jlong vectorsPointerJ,
                                                                                  jobjectArray vectorsJ)
@@ -137,6 +356,52 @@ JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_transferVectors
     return (jlong) vect;
 }
 
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_transferFlatVectors(JNIEnv * env, jclass cls,
+                                                                                     jlong vectorsPointerJ,
+                                                                                     jobject vectorsJ, jint dimJ)
+{
+    try {
+        auto dataset = jniUtil.ConvertFlatJavaVectorsToCppFloatVector(env, vectorsJ, dimJ);
+
+        std::vector<float> *vect;
+        if ((long) vectorsPointerJ == 0) {
+            vect = new std::vector<float>;
+        } else {
+            vect = reinterpret_cast<std::vector<float>*>(vectorsPointerJ);
+        }
+        vect->insert(vect->begin(), dataset.begin(), dataset.end());
+
+        return (jlong) vect;
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return 0;
+}
+
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_transferHalfVectors(JNIEnv * env, jclass cls,
+                                                                                     jlong vectorsPointerJ,
+                                                                                     jobject vectorsJ, jint dimJ,
+                                                                                     jstring encodingJ)
+{
+    try {
+        auto encoding = knn_jni::GetHalfPrecisionEncoding(&jniUtil, env, encodingJ);
+        auto dataset = jniUtil.ConvertHalfJavaVectorsToCppFloatVector(env, vectorsJ, dimJ, encoding);
+
+        std::vector<float> *vect;
+        if ((long) vectorsPointerJ == 0) {
+            vect = new std::vector<float>;
+        } else {
+            vect = reinterpret_cast<std::vector<float>*>(vectorsPointerJ);
+        }
+        vect->insert(vect->begin(), dataset.begin(), dataset.end());
+
+        return (jlong) vect;
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return 0;
+}
+
 JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_freeVectors(JNIEnv * env, jclass cls,
                                                                             jlong vectorsPointerJ)
 {
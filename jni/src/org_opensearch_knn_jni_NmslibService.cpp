@@ -48,6 +48,33 @@ JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_NmslibService_createIndex(JNI
     }
 }
 
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_NmslibService_createIndexFromFlatVectors(JNIEnv * env, jclass cls,
+                                                                                            jintArray idsJ,
+                                                                                            jobject vectorsJ,
+                                                                                            jint dimJ,
+                                                                                            jstring indexPathJ,
+                                                                                            jobject parametersJ)
+{
+    try {
+        knn_jni::nmslib_wrapper::CreateIndexFromFlatVectors(&jniUtil, env, idsJ, vectorsJ, dimJ, indexPathJ,
+                                                            parametersJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+}
+
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_NmslibService_createIndexFromHalfVectors(
+        JNIEnv * env, jclass cls, jintArray idsJ, jobject vectorsJ, jint dimJ, jstring encodingJ, jstring indexPathJ,
+        jobject parametersJ)
+{
+    try {
+        knn_jni::nmslib_wrapper::CreateIndexFromHalfVectors(&jniUtil, env, idsJ, vectorsJ, dimJ, encodingJ,
+                                                            indexPathJ, parametersJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+}
+
 JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_NmslibService_loadIndex(JNIEnv * env, jclass cls,
                                                                             jstring indexPathJ, jobject parametersJ)
 {
@@ -71,6 +98,53 @@ JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_NmslibService_queryIn
     return nullptr;
 }
 
+JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_NmslibService_queryIndexWithHalfVector(
+        JNIEnv * env, jclass cls, jlong indexPointerJ, jshortArray queryVectorJ, jstring encodingJ, jint kJ)
+{
+    try {
+        return knn_jni::nmslib_wrapper::QueryIndexWithHalfVector(&jniUtil, env, indexPointerJ, queryVectorJ,
+                                                                 encodingJ, kJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return nullptr;
+}
+
+JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_NmslibService_queryIndexWithLiveDocs(JNIEnv * env, jclass cls,
+                                                                                                jlong indexPointerJ,
+                                                                                                jfloatArray queryVectorJ, jint kJ,
+                                                                                                jlongArray liveDocsJ)
+{
+    try {
+        return knn_jni::nmslib_wrapper::QueryIndexWithLiveDocs(&jniUtil, env, indexPointerJ, queryVectorJ, kJ, liveDocsJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return nullptr;
+}
+
+JNIEXPORT jboolean JNICALL Java_org_opensearch_knn_jni_NmslibService_isOptimizedLayout(JNIEnv * env, jclass cls,
+                                                                                      jlong indexPointerJ)
+{
+    try {
+        return knn_jni::nmslib_wrapper::IsOptimizedLayout(indexPointerJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return JNI_FALSE;
+}
+
+JNIEXPORT jbyteArray JNICALL Java_org_opensearch_knn_jni_NmslibService_describeIndex(JNIEnv * env, jclass cls,
+                                                                                     jlong indexPointerJ)
+{
+    try {
+        return knn_jni::nmslib_wrapper::DescribeIndex(&jniUtil, env, indexPointerJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return nullptr;
+}
+
 JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_NmslibService_free(JNIEnv * env, jclass cls, jlong indexPointerJ)
 {
     try {
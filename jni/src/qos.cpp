@@ -0,0 +1,122 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "qos.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+namespace {
+    std::atomic<int> activeQueries(0);
+
+    // Nice value used for the NICE policy. Build threads only get what is left after normal priority threads run.
+    const int BUILD_NICENESS = 10;
+
+    const std::chrono::microseconds INITIAL_BACKOFF(100);
+    const std::chrono::microseconds MAX_BACKOFF(5000);
+    const std::chrono::microseconds MAX_TOTAL_BACKOFF(50000);
+
+    // Lower the priority of the calling thread. Failures are ignored: the task still runs, just at normal priority.
+    void LowerCurrentThreadPriority(knn_jni::qos::SchedulingPolicy policy) {
+#ifdef __linux__
+        if (policy == knn_jni::qos::SchedulingPolicy::IDLE) {
+            sched_param param{};
+            param.sched_priority = 0;
+            pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+        }
+
+        // On Linux the nice value belongs to the thread, so this does not touch the rest of the JVM
+        auto tid = (id_t) syscall(SYS_gettid);
+        setpriority(PRIO_PROCESS, tid, BUILD_NICENESS);
+#endif
+    }
+}
+
+knn_jni::qos::SchedulingPolicy knn_jni::qos::ParseSchedulingPolicy(const std::string& policy) {
+    if (policy == "normal") {
+        return SchedulingPolicy::NORMAL;
+    }
+
+    if (policy == "nice") {
+        return SchedulingPolicy::NICE;
+    }
+
+    if (policy == "idle") {
+        return SchedulingPolicy::IDLE;
+    }
+
+    throw std::runtime_error("Invalid scheduling policy \"" + policy + "\"");
+}
+
+knn_jni::qos::ScopedQuery::ScopedQuery() {
+    activeQueries.fetch_add(1);
+}
+
+knn_jni::qos::ScopedQuery::~ScopedQuery() {
+    activeQueries.fetch_sub(1);
+}
+
+int knn_jni::qos::ActiveQueries() {
+    return activeQueries.load();
+}
+
+void knn_jni::qos::YieldToQueries(SchedulingPolicy policy) {
+    if (policy == SchedulingPolicy::NORMAL) {
+        return;
+    }
+
+    std::chrono::microseconds backoff = INITIAL_BACKOFF;
+    std::chrono::microseconds waited(0);
+    while (activeQueries.load() > 0 && waited < MAX_TOTAL_BACKOFF) {
+        std::this_thread::sleep_for(backoff);
+        waited += backoff;
+        backoff = std::min(backoff * 2, MAX_BACKOFF);
+    }
+}
+
+void knn_jni::qos::RunWithPolicy(SchedulingPolicy policy, const std::function<void()>& task) {
+#ifdef __linux__
+    if (policy == SchedulingPolicy::NORMAL) {
+        task();
+        return;
+    }
+
+    std::exception_ptr error;
+    std::thread worker([policy, &task, &error]() {
+        LowerCurrentThreadPriority(policy);
+        try {
+            task();
+        } catch (...) {
+            error = std::current_exception();
+        }
+    });
+    worker.join();
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+#else
+    task();
+#endif
+}
@@ -0,0 +1,470 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "query_capture.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+
+
+namespace {
+    // Log header: magic, version, header size, ring capacity and write cursor. The rest is reserved
+    const char LOG_MAGIC[8] = {'K', 'N', 'N', 'Q', 'C', 'A', 'P', '1'};
+    constexpr uint32_t LOG_VERSION = 1;
+    constexpr size_t HEADER_SIZE = 64;
+    constexpr size_t VERSION_OFFSET = 8;
+    constexpr size_t CAPACITY_OFFSET = 16;
+    constexpr size_t CURSOR_OFFSET = 24;
+
+    // Each record is framed by its length, its absolute position in the stream of records written to the ring, and a
+    // checksum of its body. Frames start on 8 byte boundaries
+    constexpr uint32_t FRAME_MAGIC = 0x5243514b;
+    constexpr uint64_t FRAME_ALIGNMENT = 8;
+
+    struct FrameHeader {
+        uint32_t magic;
+        uint32_t length;
+        uint64_t position;
+        uint32_t checksum;
+        uint32_t bodyLength;
+    };
+    static_assert(sizeof(FrameHeader) == 24, "Frame header must be packed");
+    static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t) && ATOMIC_LLONG_LOCK_FREE == 2,
+                  "The write cursor is an atomic in the mapped header");
+
+    // 32 bit FNV-1a
+    uint32_t Checksum(const uint8_t * data, size_t size) {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ data[i]) * 16777619u;
+        }
+        return hash;
+    }
+
+    std::string ErrorMessage(const std::string& what, const std::string& path) {
+        return what + " " + path + ": " + strerror(errno);
+    }
+
+    // Blocks of the ring are allocated up front, since running out of disk under a mapping would raise SIGBUS in the
+    // middle of a query
+    void Allocate(int fd, const std::string& path, off_t size) {
+#ifdef __linux__
+        int error = posix_fallocate(fd, 0, size);
+        if (error != 0) {
+            errno = error;
+            throw std::runtime_error(ErrorMessage("Unable to allocate query capture log", path));
+        }
+#else
+        std::vector<char> zeros(1 << 20, 0);
+        for (off_t offset = 0; offset < size;) {
+            auto chunk = (size_t) std::min<off_t>(zeros.size(), size - offset);
+            ssize_t written = pwrite(fd, zeros.data(), chunk, offset);
+            if (written <= 0) {
+                throw std::runtime_error(ErrorMessage("Unable to allocate query capture log", path));
+            }
+            offset += written;
+        }
+#endif
+    }
+
+    class RingLog {
+    public:
+        RingLog(const std::string& path, int64_t capacityBytes)
+                : path(path), capacity((uint64_t) capacityBytes / FRAME_ALIGNMENT * FRAME_ALIGNMENT) {
+            fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            if (fd < 0) {
+                throw std::runtime_error(ErrorMessage("Unable to open query capture log", path));
+            }
+            mappedSize = HEADER_SIZE + capacity;
+
+            try {
+                bool reuse = IsCompatible();
+                if (!reuse) {
+                    // Truncating first zeroes the ring, so frames of an older log cannot pass for records of this one
+                    if (ftruncate(fd, 0) != 0 || ftruncate(fd, (off_t) mappedSize) != 0) {
+                        throw std::runtime_error(ErrorMessage("Unable to size query capture log", path));
+                    }
+                    Allocate(fd, path, (off_t) mappedSize);
+                }
+
+                void * mapping = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if (mapping == MAP_FAILED) {
+                    throw std::runtime_error(ErrorMessage("Unable to map query capture log", path));
+                }
+                base = static_cast<uint8_t *>(mapping);
+            } catch (...) {
+                close(fd);
+                throw;
+            }
+
+            if (!IsCompatible()) {
+                memcpy(base, LOG_MAGIC, sizeof(LOG_MAGIC));
+                uint32_t versionAndSize[2] = {LOG_VERSION, (uint32_t) HEADER_SIZE};
+                memcpy(base + VERSION_OFFSET, versionAndSize, sizeof(versionAndSize));
+                memcpy(base + CAPACITY_OFFSET, &capacity, sizeof(capacity));
+                new (base + CURSOR_OFFSET) std::atomic<uint64_t>(0);
+            }
+        }
+
+        ~RingLog() {
+            munmap(base, mappedSize);
+            close(fd);
+        }
+
+        RingLog(const RingLog&) = delete;
+        RingLog& operator=(const RingLog&) = delete;
+
+        const std::string& Path() const {
+            return path;
+        }
+
+        uint64_t Capacity() const {
+            return capacity;
+        }
+
+        // Reserve a frame for body and copy it in. Returns false if the body does not fit the ring
+        bool Append(const std::vector<uint8_t>& body) {
+            uint64_t length = (sizeof(FrameHeader) + body.size() + FRAME_ALIGNMENT - 1) / FRAME_ALIGNMENT *
+                              FRAME_ALIGNMENT;
+            if (length > capacity || length > std::numeric_limits<uint32_t>::max()) {
+                return false;
+            }
+
+            // Frames never wrap around the end of the ring. When the rest of the lap is too short, it is skipped
+            auto * cursor = reinterpret_cast<std::atomic<uint64_t> *>(base + CURSOR_OFFSET);
+            uint64_t current = cursor->load(std::memory_order_relaxed);
+            uint64_t position;
+            do {
+                uint64_t offset = current % capacity;
+                position = offset + length > capacity ? current + (capacity - offset) : current;
+            } while (!cursor->compare_exchange_weak(current, position + length, std::memory_order_relaxed));
+
+            FrameHeader header = {FRAME_MAGIC, (uint32_t) length, position, Checksum(body.data(), body.size()),
+                                  (uint32_t) body.size()};
+            uint8_t * frame = base + HEADER_SIZE + position % capacity;
+            memcpy(frame + sizeof(FrameHeader), body.data(), body.size());
+            memcpy(frame, &header, sizeof(header));
+            return true;
+        }
+
+    private:
+        // Whether the file already holds a log with a ring of this capacity
+        bool IsCompatible() const {
+            uint8_t header[HEADER_SIZE];
+            if (base != nullptr) {
+                memcpy(header, base, HEADER_SIZE);
+            } else {
+                struct stat status;
+                if (fstat(fd, &status) != 0 || (uint64_t) status.st_size != mappedSize ||
+                    pread(fd, header, HEADER_SIZE, 0) != (ssize_t) HEADER_SIZE) {
+                    return false;
+                }
+            }
+            uint32_t version;
+            uint64_t storedCapacity;
+            memcpy(&version, header + VERSION_OFFSET, sizeof(version));
+            memcpy(&storedCapacity, header + CAPACITY_OFFSET, sizeof(storedCapacity));
+            return memcmp(header, LOG_MAGIC, sizeof(LOG_MAGIC)) == 0 && version == LOG_VERSION &&
+                   storedCapacity == capacity;
+        }
+
+        std::string path;
+        uint64_t capacity;
+        int fd = -1;
+        size_t mappedSize = 0;
+        uint8_t * base = nullptr;
+    };
+
+    class BodyWriter {
+    public:
+        explicit BodyWriter(std::vector<uint8_t>& out) : out(out) {}
+
+        template <typename T>
+        void Put(T value) {
+            Bytes(&value, sizeof(value));
+        }
+
+        void Bytes(const void * data, size_t size) {
+            auto * bytes = static_cast<const uint8_t *>(data);
+            out.insert(out.end(), bytes, bytes + size);
+        }
+
+        void String(const std::string& value) {
+            if (value.size() > std::numeric_limits<uint16_t>::max()) {
+                throw std::runtime_error("String too long for a query capture record");
+            }
+            Put<uint16_t>((uint16_t) value.size());
+            Bytes(value.data(), value.size());
+        }
+
+    private:
+        std::vector<uint8_t>& out;
+    };
+
+    class BodyReader {
+    public:
+        BodyReader(const uint8_t * data, size_t size) : data(data), size(size) {}
+
+        template <typename T>
+        T Get() {
+            T value;
+            Bytes(&value, sizeof(value));
+            return value;
+        }
+
+        void Bytes(void * target, size_t count) {
+            if (count > size - offset) {
+                throw std::runtime_error("Malformed query capture record");
+            }
+            memcpy(target, data + offset, count);
+            offset += count;
+        }
+
+        std::string String() {
+            std::string value(Get<uint16_t>(), '\0');
+            Bytes(&value[0], value.size());
+            return value;
+        }
+
+    private:
+        const uint8_t * data;
+        size_t size;
+        size_t offset = 0;
+    };
+
+    // Body: timestamp, latency, k, dimension, number of results, engine, filtered flag, path, load parameters as
+    // key value pairs, query and result ids
+    void EncodeRecord(const knn_jni::query_capture::Record& record, std::vector<uint8_t>& out) {
+        BodyWriter writer(out);
+        writer.Put<uint64_t>(record.timestampMicros);
+        writer.Put<uint64_t>(record.latencyNanos);
+        writer.Put<int32_t>(record.k);
+        writer.Put<uint32_t>((uint32_t) record.query.size());
+        writer.Put<uint32_t>((uint32_t) record.resultIds.size());
+        writer.Put<uint8_t>((uint8_t) record.index.engine);
+        writer.Put<uint8_t>(record.filtered ? 1 : 0);
+        writer.String(record.index.path);
+        writer.Put<uint16_t>((uint16_t) record.index.parameters.size());
+        for (const auto& parameter : record.index.parameters) {
+            writer.String(parameter.first);
+            writer.String(parameter.second);
+        }
+        writer.Bytes(record.query.data(), record.query.size() * sizeof(float));
+        writer.Bytes(record.resultIds.data(), record.resultIds.size() * sizeof(int32_t));
+    }
+
+    knn_jni::query_capture::Record DecodeRecord(const uint8_t * data, size_t size) {
+        BodyReader reader(data, size);
+        knn_jni::query_capture::Record record;
+        record.timestampMicros = reader.Get<uint64_t>();
+        record.latencyNanos = reader.Get<uint64_t>();
+        record.k = reader.Get<int32_t>();
+        auto dim = reader.Get<uint32_t>();
+        auto numIds = reader.Get<uint32_t>();
+        record.index.engine = (knn_jni::query_capture::Engine) reader.Get<uint8_t>();
+        record.filtered = reader.Get<uint8_t>() != 0;
+        record.index.path = reader.String();
+        auto numParameters = reader.Get<uint16_t>();
+        for (uint16_t i = 0; i < numParameters; ++i) {
+            std::string key = reader.String();
+            record.index.parameters.emplace_back(key, reader.String());
+        }
+        if (dim > size || numIds > size) {
+            throw std::runtime_error("Malformed query capture record");
+        }
+        record.query.resize(dim);
+        reader.Bytes(record.query.data(), dim * sizeof(float));
+        record.resultIds.resize(numIds);
+        reader.Bytes(record.resultIds.data(), numIds * sizeof(int32_t));
+        return record;
+    }
+
+    double UniformDraw() {
+        thread_local std::minstd_rand generator(
+                (unsigned) std::random_device{}() ^ (unsigned) std::hash<std::thread::id>()(std::this_thread::get_id()));
+        thread_local std::uniform_real_distribution<double> distribution(0.0, 1.0);
+        return distribution(generator);
+    }
+
+    // The running log is swapped with atomic shared_ptr operations, so a query that picked it up keeps it mapped until
+    // its record is written even if the capture is stopped meanwhile
+    std::shared_ptr<RingLog> runningLog;
+    std::atomic<double> sampleRate(0);
+    std::mutex startMutex;
+
+    std::mutex indicesMutex;
+    std::unordered_map<const void *, std::shared_ptr<const knn_jni::query_capture::IndexIdentity>> indices;
+
+    std::atomic<int64_t> capturedRecords(0);
+    std::atomic<int64_t> droppedRecords(0);
+}
+
+void knn_jni::query_capture::RegisterIndex(const void * index, IndexIdentity identity) {
+    std::shared_ptr<const IndexIdentity> shared = std::make_shared<IndexIdentity>(std::move(identity));
+    std::lock_guard<std::mutex> lock(indicesMutex);
+    indices[index] = shared;
+}
+
+void knn_jni::query_capture::UnregisterIndex(const void * index) {
+    std::lock_guard<std::mutex> lock(indicesMutex);
+    indices.erase(index);
+}
+
+void knn_jni::query_capture::Start(const std::string& path, int64_t capacityBytes, double rate) {
+    if (path.empty()) {
+        throw std::runtime_error("Query capture path cannot be empty");
+    }
+    if (capacityBytes < MIN_CAPACITY) {
+        throw std::runtime_error("Query capture log must hold at least " + std::to_string(MIN_CAPACITY) + " bytes");
+    }
+    if (!(rate >= 0 && rate <= 1)) {
+        throw std::runtime_error("Query capture sample rate must be between 0 and 1");
+    }
+
+    std::lock_guard<std::mutex> lock(startMutex);
+    auto current = std::atomic_load(&runningLog);
+    uint64_t capacity = (uint64_t) capacityBytes / FRAME_ALIGNMENT * FRAME_ALIGNMENT;
+    if (current == nullptr || current->Path() != path || current->Capacity() != capacity) {
+        std::atomic_store(&runningLog, std::make_shared<RingLog>(path, capacityBytes));
+    }
+    sampleRate.store(rate);
+}
+
+void knn_jni::query_capture::Stop() {
+    std::lock_guard<std::mutex> lock(startMutex);
+    sampleRate.store(0);
+    std::atomic_store(&runningLog, std::shared_ptr<RingLog>());
+}
+
+bool knn_jni::query_capture::ShouldCapture() {
+    double rate = sampleRate.load(std::memory_order_relaxed);
+    return rate > 0 && UniformDraw() < rate;
+}
+
+void knn_jni::query_capture::Capture(const void * index, const float * query, int dim, int k, bool filtered,
+                                     uint64_t latencyNanos, const int64_t * ids, int numIds) {
+    try {
+        auto log = std::atomic_load(&runningLog);
+        if (log == nullptr) {
+            return;
+        }
+
+        std::shared_ptr<const IndexIdentity> identity;
+        {
+            std::lock_guard<std::mutex> lock(indicesMutex);
+            auto entry = indices.find(index);
+            if (entry == indices.end()) {
+                return;
+            }
+            identity = entry->second;
+        }
+
+        Record record;
+        record.timestampMicros = (uint64_t) std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+        record.latencyNanos = latencyNanos;
+        record.k = k;
+        record.filtered = filtered;
+        record.index = *identity;
+        record.query.assign(query, query + dim);
+        record.resultIds.assign(ids, ids + numIds);
+
+        thread_local std::vector<uint8_t> body;
+        body.clear();
+        EncodeRecord(record, body);
+        if (log->Append(body)) {
+            capturedRecords++;
+        } else {
+            droppedRecords++;
+        }
+    } catch (...) {
+        droppedRecords++;
+    }
+}
+
+int64_t knn_jni::query_capture::CapturedRecords() {
+    return capturedRecords;
+}
+
+int64_t knn_jni::query_capture::DroppedRecords() {
+    return droppedRecords;
+}
+
+std::vector<knn_jni::query_capture::Record> knn_jni::query_capture::ReadLog(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Unable to open query capture log " + path);
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    uint32_t version = 0;
+    uint64_t capacity = 0;
+    uint64_t cursor = 0;
+    if (bytes.size() >= HEADER_SIZE) {
+        memcpy(&version, bytes.data() + VERSION_OFFSET, sizeof(version));
+        memcpy(&capacity, bytes.data() + CAPACITY_OFFSET, sizeof(capacity));
+        memcpy(&cursor, bytes.data() + CURSOR_OFFSET, sizeof(cursor));
+    }
+    if (bytes.size() < HEADER_SIZE || memcmp(bytes.data(), LOG_MAGIC, sizeof(LOG_MAGIC)) != 0 ||
+        version != LOG_VERSION || capacity == 0 || bytes.size() != HEADER_SIZE + capacity) {
+        throw std::runtime_error("Not a query capture log: " + path);
+    }
+
+    // Only frames inside the last lap before the cursor are current. Anything else is left over from an earlier lap,
+    // or was torn by a crash or by a writer that lapped another
+    const uint8_t * ring = bytes.data() + HEADER_SIZE;
+    uint64_t oldest = cursor > capacity ? cursor - capacity : 0;
+    std::vector<std::pair<uint64_t, Record>> frames;
+    for (uint64_t offset = 0; offset + sizeof(FrameHeader) <= capacity;) {
+        FrameHeader header;
+        memcpy(&header, ring + offset, sizeof(header));
+        bool valid = header.magic == FRAME_MAGIC && header.length % FRAME_ALIGNMENT == 0 &&
+                     header.length >= sizeof(FrameHeader) + (uint64_t) header.bodyLength &&
+                     offset + header.length <= capacity && header.position % capacity == offset &&
+                     header.position >= oldest && header.position + header.length <= cursor &&
+                     Checksum(ring + offset + sizeof(FrameHeader), header.bodyLength) == header.checksum;
+        if (!valid) {
+            offset += FRAME_ALIGNMENT;
+            continue;
+        }
+        frames.emplace_back(header.position, DecodeRecord(ring + offset + sizeof(FrameHeader), header.bodyLength));
+        offset += header.length;
+    }
+
+    std::sort(frames.begin(), frames.end(),
+              [](const std::pair<uint64_t, Record>& a, const std::pair<uint64_t, Record>& b) {
+                  return a.first < b.first;
+              });
+    std::vector<Record> records;
+    records.reserve(frames.size());
+    for (auto& frame : frames) {
+        records.push_back(std::move(frame.second));
+    }
+    return records;
+}
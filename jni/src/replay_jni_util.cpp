@@ -0,0 +1,245 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+
+#include "replay_jni_util.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+void knn_jni::replay::ReplayJNIUtil::ThrowJavaException(JNIEnv* env, const char* type, const char* message) {
+    throw std::runtime_error(std::string(type) + ": " + message);
+}
+
+void knn_jni::replay::ReplayJNIUtil::HasExceptionInStack(JNIEnv* env) {}
+
+void knn_jni::replay::ReplayJNIUtil::HasExceptionInStack(JNIEnv* env, const std::string& message) {}
+
+void knn_jni::replay::ReplayJNIUtil::CatchCppExceptionAndThrowJava(JNIEnv* env) {
+    throw;
+}
+
+jclass knn_jni::replay::ReplayJNIUtil::FindClass(JNIEnv * env, const std::string& className) {
+    // The wrappers only check for null and hand the class back to NewObject
+    return (jclass) 1;
+}
+
+jmethodID knn_jni::replay::ReplayJNIUtil::FindMethod(JNIEnv * env, const std::string& className,
+                                                     const std::string& methodName) {
+    return (jmethodID) 1;
+}
+
+std::string knn_jni::replay::ReplayJNIUtil::ConvertJavaStringToCppString(JNIEnv * env, jstring javaString) {
+    return FromJava<String>(javaString).value;
+}
+
+std::unordered_map<std::string, jobject> knn_jni::replay::ReplayJNIUtil::ConvertJavaMapToCppMap(JNIEnv *env,
+                                                                                               jobject parametersJ) {
+    std::unordered_map<std::string, jobject> parametersCpp;
+    for (auto & entry : FromJava<Map>(parametersJ).entries) {
+        parametersCpp[entry.first] = ToJava<jobject>(entry.second.get());
+    }
+    return parametersCpp;
+}
+
+std::string knn_jni::replay::ReplayJNIUtil::ConvertJavaObjectToCppString(JNIEnv *env, jobject objectJ) {
+    return FromJava<String>(objectJ).value;
+}
+
+int knn_jni::replay::ReplayJNIUtil::ConvertJavaObjectToCppInteger(JNIEnv *env, jobject objectJ) {
+    return FromJava<Integer>(objectJ).value;
+}
+
+std::vector<float> knn_jni::replay::ReplayJNIUtil::Convert2dJavaObjectArrayToCppFloatVector(JNIEnv *env,
+                                                                                           jobjectArray array2dJ,
+                                                                                           int dim) {
+    auto & vectors = FromJava<ObjectArray>(array2dJ);
+    std::vector<float> dataset;
+    dataset.reserve(vectors.elements.size() * dim);
+    for (auto & element : vectors.elements) {
+        auto & vector = FromJava<FloatArray>(element.get());
+        if (vector.values.size() != (size_t) dim) {
+            throw std::runtime_error("Dimension of vectors is inconsistent");
+        }
+        dataset.insert(dataset.end(), vector.values.begin(), vector.values.end());
+    }
+    return dataset;
+}
+
+std::vector<int64_t> knn_jni::replay::ReplayJNIUtil::ConvertJavaIntArrayToCppIntVector(JNIEnv *env, jintArray arrayJ) {
+    auto & values = FromJava<IntArray>(arrayJ).values;
+    return std::vector<int64_t>(values.begin(), values.end());
+}
+
+std::vector<float> knn_jni::replay::ReplayJNIUtil::ConvertFlatJavaVectorsToCppFloatVector(JNIEnv *env,
+                                                                                          jobject vectorsJ, int dim) {
+    auto & values = FromJava<FloatArray>(vectorsJ).values;
+    if (dim <= 0 || values.size() % dim != 0) {
+        throw std::runtime_error("Number of floats is not a multiple of the dimension");
+    }
+    return values;
+}
+
+std::vector<float> knn_jni::replay::ReplayJNIUtil::ConvertHalfJavaVectorsToCppFloatVector(
+        JNIEnv *env, jobject vectorsJ, int dim, half_precision::Encoding encoding) {
+    auto & values = FromJava<ShortArray>(vectorsJ).values;
+    if (dim <= 0 || values.size() % dim != 0) {
+        throw std::runtime_error("Number of values is not a multiple of the dimension");
+    }
+    std::vector<float> vectors(values.size());
+    half_precision::Decode(encoding, values.data(), values.size(), vectors.data());
+    return vectors;
+}
+
+std::vector<float> knn_jni::replay::ReplayJNIUtil::ConvertByteJavaVectorsToCppFloatVector(JNIEnv *env,
+                                                                                          jobject vectorsJ, int dim) {
+    auto & values = FromJava<ByteArray>(vectorsJ).values;
+    if (dim <= 0 || values.size() % dim != 0) {
+        throw std::runtime_error("Number of values is not a multiple of the dimension");
+    }
+    return std::vector<float>(values.begin(), values.end());
+}
+
+int knn_jni::replay::ReplayJNIUtil::GetInnerDimensionOf2dJavaFloatArray(JNIEnv *env, jobjectArray array2dJ) {
+    auto & vectors = FromJava<ObjectArray>(array2dJ);
+    if (vectors.elements.empty()) {
+        return 0;
+    }
+    return (int) FromJava<FloatArray>(vectors.elements[0].get()).values.size();
+}
+
+int knn_jni::replay::ReplayJNIUtil::GetJavaObjectArrayLength(JNIEnv *env, jobjectArray arrayJ) {
+    return (int) FromJava<ObjectArray>(arrayJ).elements.size();
+}
+
+int knn_jni::replay::ReplayJNIUtil::GetJavaIntArrayLength(JNIEnv *env, jintArray arrayJ) {
+    return (int) FromJava<IntArray>(arrayJ).values.size();
+}
+
+int knn_jni::replay::ReplayJNIUtil::GetJavaBytesArrayLength(JNIEnv *env, jbyteArray arrayJ) {
+    return (int) FromJava<ByteArray>(arrayJ).values.size();
+}
+
+int knn_jni::replay::ReplayJNIUtil::GetJavaFloatArrayLength(JNIEnv *env, jfloatArray arrayJ) {
+    return (int) FromJava<FloatArray>(arrayJ).values.size();
+}
+
+int knn_jni::replay::ReplayJNIUtil::GetJavaLongArrayLength(JNIEnv *env, jlongArray arrayJ) {
+    return (int) FromJava<LongArray>(arrayJ).values.size();
+}
+
+void knn_jni::replay::ReplayJNIUtil::DeleteLocalRef(JNIEnv *env, jobject obj) {}
+
+jbyte * knn_jni::replay::ReplayJNIUtil::GetByteArrayElements(JNIEnv *env, jbyteArray array, jboolean * isCopy) {
+    if (isCopy != nullptr) {
+        *isCopy = JNI_FALSE;
+    }
+    return FromJava<ByteArray>(array).values.data();
+}
+
+jfloat * knn_jni::replay::ReplayJNIUtil::GetFloatArrayElements(JNIEnv *env, jfloatArray array, jboolean * isCopy) {
+    if (isCopy != nullptr) {
+        *isCopy = JNI_FALSE;
+    }
+    return FromJava<FloatArray>(array).values.data();
+}
+
+jint * knn_jni::replay::ReplayJNIUtil::GetIntArrayElements(JNIEnv *env, jintArray array, jboolean * isCopy) {
+    if (isCopy != nullptr) {
+        *isCopy = JNI_FALSE;
+    }
+    return reinterpret_cast<jint *>(FromJava<IntArray>(array).values.data());
+}
+
+jlong * knn_jni::replay::ReplayJNIUtil::GetLongArrayElements(JNIEnv *env, jlongArray array, jboolean * isCopy) {
+    if (isCopy != nullptr) {
+        *isCopy = JNI_FALSE;
+    }
+    return reinterpret_cast<jlong *>(FromJava<LongArray>(array).values.data());
+}
+
+jobject knn_jni::replay::ReplayJNIUtil::GetObjectArrayElement(JNIEnv *env, jobjectArray array, jsize index) {
+    return ToJava<jobject>(FromJava<ObjectArray>(array).elements.at(index).get());
+}
+
+jobject knn_jni::replay::ReplayJNIUtil::NewObject(JNIEnv *env, jclass clazz, jmethodID methodId, int id,
+                                                  float distance) {
+    return ToJava<jobject>(new QueryResult(id, distance));
+}
+
+jobjectArray knn_jni::replay::ReplayJNIUtil::NewObjectArray(JNIEnv *env, jsize len, jclass clazz, jobject init) {
+    auto * array = new ObjectArray();
+    array->elements.resize(len);
+    return ToJava<jobjectArray>(array);
+}
+
+jbyteArray knn_jni::replay::ReplayJNIUtil::NewByteArray(JNIEnv *env, jsize len) {
+    auto * array = new ByteArray();
+    array->values.resize(len);
+    return ToJava<jbyteArray>(array);
+}
+
+jintArray knn_jni::replay::ReplayJNIUtil::NewIntArray(JNIEnv *env, jsize len) {
+    auto * array = new IntArray();
+    array->values.resize(len);
+    return ToJava<jintArray>(array);
+}
+
+jfloatArray knn_jni::replay::ReplayJNIUtil::NewFloatArray(JNIEnv *env, jsize len) {
+    auto * array = new FloatArray();
+    array->values.resize(len);
+    return ToJava<jfloatArray>(array);
+}
+
+void knn_jni::replay::ReplayJNIUtil::ReleaseByteArrayElements(JNIEnv *env, jbyteArray array, jbyte *elems, int mode) {}
+
+void knn_jni::replay::ReplayJNIUtil::ReleaseFloatArrayElements(JNIEnv *env, jfloatArray array, jfloat *elems,
+                                                               int mode) {}
+
+void knn_jni::replay::ReplayJNIUtil::ReleaseIntArrayElements(JNIEnv *env, jintArray array, jint *elems, jint mode) {}
+
+void knn_jni::replay::ReplayJNIUtil::ReleaseLongArrayElements(JNIEnv *env, jlongArray array, jlong *elems,
+                                                              jint mode) {}
+
+void knn_jni::replay::ReplayJNIUtil::SetObjectArrayElement(JNIEnv *env, jobjectArray array, jsize index,
+                                                           jobject val) {
+    // The array takes ownership, like a Java array keeps its element reachable
+    FromJava<ObjectArray>(array).elements.at(index).reset(reinterpret_cast<Object *>(val));
+}
+
+void knn_jni::replay::ReplayJNIUtil::SetByteArrayRegion(JNIEnv *env, jbyteArray array, jsize start, jsize len,
+                                                        const jbyte * buf) {
+    auto & values = FromJava<ByteArray>(array).values;
+    if (start < 0 || len < 0 || (size_t) start + len > values.size()) {
+        throw std::runtime_error("Byte array region out of bounds");
+    }
+    std::copy(buf, buf + len, values.begin() + start);
+}
+
+void knn_jni::replay::ReplayJNIUtil::SetIntArrayRegion(JNIEnv *env, jintArray array, jsize start, jsize len,
+                                                       const jint * buf) {
+    auto & values = FromJava<IntArray>(array).values;
+    if (start < 0 || len < 0 || (size_t) start + len > values.size()) {
+        throw std::runtime_error("Int array region out of bounds");
+    }
+    std::copy(buf, buf + len, values.begin() + start);
+}
+
+void knn_jni::replay::ReplayJNIUtil::SetFloatArrayRegion(JNIEnv *env, jfloatArray array, jsize start, jsize len,
+                                                         const jfloat * buf) {
+    auto & values = FromJava<FloatArray>(array).values;
+    if (start < 0 || len < 0 || (size_t) start + len > values.size()) {
+        throw std::runtime_error("Float array region out of bounds");
+    }
+    std::copy(buf, buf + len, values.begin() + start);
+}
@@ -0,0 +1,130 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "thread_pool.h"
+
+#include <algorithm>
+
+
+namespace {
+    int ClampPoolSize(int numThreads) {
+        if (numThreads <= 0) {
+            numThreads = (int) std::thread::hardware_concurrency();
+        }
+        return std::max(1, std::min(numThreads, knn_jni::thread_pool::MAX_POOL_SIZE));
+    }
+}
+
+knn_jni::thread_pool::CpuBudget& knn_jni::thread_pool::CpuBudget::Instance() {
+    static knn_jni::thread_pool::CpuBudget budget(0);
+    return budget;
+}
+
+knn_jni::thread_pool::CpuBudget::CpuBudget(int numThreads): size(ClampPoolSize(numThreads)), borrowedThreads(0) {}
+
+void knn_jni::thread_pool::CpuBudget::Resize(int numThreads) {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->size = ClampPoolSize(numThreads);
+    }
+    this->released.notify_all();
+}
+
+int knn_jni::thread_pool::CpuBudget::Size() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->size;
+}
+
+int knn_jni::thread_pool::CpuBudget::AcquireThreads(int requested) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->released.wait(lock, [this]() { return this->borrowedThreads < this->size; });
+
+    int granted = std::max(1, std::min(requested, this->size - this->borrowedThreads));
+    this->borrowedThreads += granted;
+    return granted;
+}
+
+void knn_jni::thread_pool::CpuBudget::ReleaseThreads(int count) {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->borrowedThreads -= count;
+    }
+    this->released.notify_all();
+}
+
+int knn_jni::thread_pool::CpuBudget::BorrowedThreads() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->borrowedThreads;
+}
+
+knn_jni::thread_pool::ThreadBudget::ThreadBudget(int requested): count(0) {
+    if (requested > 0) {
+        this->count = knn_jni::thread_pool::CpuBudget::Instance().AcquireThreads(requested);
+    }
+}
+
+knn_jni::thread_pool::ThreadBudget::~ThreadBudget() {
+    if (this->count > 0) {
+        knn_jni::thread_pool::CpuBudget::Instance().ReleaseThreads(this->count);
+    }
+}
+
+knn_jni::thread_pool::BackgroundWorker& knn_jni::thread_pool::BackgroundWorker::Instance() {
+    // Intentionally leaked so that the thread is never joined during static destruction at process exit
+    static auto * worker = new knn_jni::thread_pool::BackgroundWorker();
+    return *worker;
+}
+
+knn_jni::thread_pool::BackgroundWorker::BackgroundWorker(): stop(false) {}
+
+knn_jni::thread_pool::BackgroundWorker::~BackgroundWorker() {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stop = true;
+    }
+    this->wake.notify_all();
+    if (this->thread.joinable()) {
+        this->thread.join();
+    }
+}
+
+void knn_jni::thread_pool::BackgroundWorker::Submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->tasks.push_back(std::move(task));
+        if (!this->thread.joinable()) {
+            this->thread = std::thread(&BackgroundWorker::Run, this);
+        }
+    }
+    this->wake.notify_one();
+}
+
+void knn_jni::thread_pool::BackgroundWorker::Run() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (true) {
+        this->wake.wait(lock, [this]() { return this->stop || !this->tasks.empty(); });
+        // Tasks queued before the worker is destroyed still run, so that their owners are not left waiting on them
+        if (this->tasks.empty()) {
+            return;
+        }
+
+        std::function<void()> task = std::move(this->tasks.front());
+        this->tasks.pop_front();
+        lock.unlock();
+        try {
+            task();
+        } catch (...) {
+            // Tasks report their own errors. Never let one take the worker down.
+        }
+        task = nullptr;
+        lock.lock();
+    }
+}
@@ -0,0 +1,105 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "vecs_io.h"
+
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+
+
+namespace {
+    using FilePointer = std::unique_ptr<FILE, int(*)(FILE*)>;
+
+    FilePointer OpenOrThrow(const std::string& path, const char* mode) {
+        FilePointer file(fopen(path.c_str(), mode), &fclose);
+        if (file == nullptr) {
+            throw std::runtime_error("Unable to open " + path);
+        }
+        return file;
+    }
+
+    bool EndsWith(const std::string& value, const std::string& suffix) {
+        return value.size() >= suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    // Read vectors whose components are stored as Stored and returned as T
+    template <typename Stored, typename T>
+    knn_jni::vecs_io::Matrix<T> ReadVecs(const std::string& path) {
+        FilePointer file = OpenOrThrow(path, "rb");
+        knn_jni::vecs_io::Matrix<T> matrix;
+        std::vector<Stored> row;
+        int32_t dim;
+        while (fread(&dim, sizeof(dim), 1, file.get()) == 1) {
+            if (dim <= 0 || (matrix.rows > 0 && dim != matrix.cols)) {
+                throw std::runtime_error("Invalid vector dimension in " + path);
+            }
+            matrix.cols = dim;
+            row.resize(dim);
+            if (fread(row.data(), sizeof(Stored), dim, file.get()) != (size_t) dim) {
+                throw std::runtime_error("Truncated vector in " + path);
+            }
+            matrix.data.insert(matrix.data.end(), row.begin(), row.end());
+            ++matrix.rows;
+        }
+        if (ferror(file.get())) {
+            throw std::runtime_error("Unable to read " + path);
+        }
+        return matrix;
+    }
+
+    template <typename T>
+    void WriteVecs(const std::string& path, const knn_jni::vecs_io::Matrix<T>& matrix) {
+        FilePointer file = OpenOrThrow(path, "wb");
+        auto dim = (int32_t) matrix.cols;
+        for (int64_t i = 0; i < matrix.rows; ++i) {
+            if (fwrite(&dim, sizeof(dim), 1, file.get()) != 1 ||
+                fwrite(matrix.Row(i), sizeof(T), matrix.cols, file.get()) != (size_t) matrix.cols) {
+                throw std::runtime_error("Unable to write " + path);
+            }
+        }
+        if (fflush(file.get()) != 0) {
+            throw std::runtime_error("Unable to write " + path);
+        }
+    }
+}
+
+knn_jni::vecs_io::Matrix<float> knn_jni::vecs_io::ReadFvecs(const std::string& path) {
+    return ReadVecs<float, float>(path);
+}
+
+knn_jni::vecs_io::Matrix<float> knn_jni::vecs_io::ReadBvecs(const std::string& path) {
+    return ReadVecs<uint8_t, float>(path);
+}
+
+knn_jni::vecs_io::Matrix<int32_t> knn_jni::vecs_io::ReadIvecs(const std::string& path) {
+    return ReadVecs<int32_t, int32_t>(path);
+}
+
+knn_jni::vecs_io::Matrix<float> knn_jni::vecs_io::ReadVectors(const std::string& path) {
+    if (EndsWith(path, ".fvecs")) {
+        return ReadFvecs(path);
+    }
+
+    if (EndsWith(path, ".bvecs")) {
+        return ReadBvecs(path);
+    }
+
+    throw std::runtime_error("Unsupported vector file " + path + ", expected .fvecs or .bvecs");
+}
+
+void knn_jni::vecs_io::WriteFvecs(const std::string& path, const Matrix<float>& matrix) {
+    WriteVecs(path, matrix);
+}
+
+void knn_jni::vecs_io::WriteIvecs(const std::string& path, const Matrix<int32_t>& matrix) {
+    WriteVecs(path, matrix);
+}
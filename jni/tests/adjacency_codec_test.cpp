@@ -0,0 +1,93 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "adjacency_codec.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using knn_jni::adjacency_codec::GraphEncoding;
+
+TEST(AdjacencyCodecParseGraphEncodingTest, BasicAssertions) {
+    ASSERT_EQ(GraphEncoding::FIXED, knn_jni::adjacency_codec::ParseGraphEncoding("fixed"));
+    ASSERT_EQ(GraphEncoding::DELTA, knn_jni::adjacency_codec::ParseGraphEncoding("delta"));
+    ASSERT_THROW(knn_jni::adjacency_codec::ParseGraphEncoding("zstd"), std::runtime_error);
+}
+
+TEST(AdjacencyCodecListTest, BasicAssertions) {
+    // Unsorted, with duplicates, padding and deltas of every byte length
+    std::vector<int32_t> ids = {70000, 3, -1, 1 << 30, 1000, 3, 0, 200, 20000000, -1, -1};
+    std::vector<int32_t> expected = {0, 3, 200, 1000, 70000, 20000000, 1 << 30};
+
+    std::vector<uint8_t> encoded;
+    knn_jni::adjacency_codec::EncodeList(ids.data(), ids.size(), encoded);
+    knn_jni::adjacency_codec::EncodeList(ids.data(), 0, encoded);
+    size_t length = encoded.size();
+    encoded.resize(length + knn_jni::adjacency_codec::DECODE_PADDING, 0);
+
+    std::vector<int32_t> decoded;
+    const uint8_t* next = knn_jni::adjacency_codec::DecodeList(encoded.data(), decoded);
+    ASSERT_EQ(expected, decoded);
+    ASSERT_EQ(next, knn_jni::adjacency_codec::SkipList(encoded.data()));
+
+    // The empty list follows
+    next = knn_jni::adjacency_codec::DecodeList(next, decoded);
+    ASSERT_TRUE(decoded.empty());
+    ASSERT_EQ(encoded.data() + length, next);
+}
+
+TEST(AdjacencyCodecCompressedGraphTest, BasicAssertions) {
+    // Node i links to the 16 nodes after it on the base layer. Every fourth node also has a second layer
+    int numNodes = 1000;
+    knn_jni::adjacency_codec::CompressedGraph graph;
+    std::vector<std::vector<std::vector<int32_t>>> expected(numNodes);
+    for (int i = 0; i < numNodes; ++i) {
+        std::vector<int32_t> base;
+        for (int j = 1; j <= 16; ++j) {
+            base.push_back((i + j) % numNodes);
+        }
+        expected[i].push_back(base);
+        if (i % 4 == 0) {
+            expected[i].push_back({(i + 4) % numNodes, (i + 8) % numNodes, -1, -1});
+        }
+        graph.AppendNode(expected[i]);
+    }
+    ASSERT_EQ(numNodes, graph.NumNodes());
+
+    // Fixed width storage would take 16 ids of 4 bytes per node on the base layer alone
+    ASSERT_LT(graph.Data().size(), (size_t) numNodes * 16 * 4 / 2);
+
+    // Rebuilding from the serialized form keeps the graph
+    knn_jni::adjacency_codec::CompressedGraph copy(graph.Offsets(), graph.Data());
+    std::vector<int32_t> neighbors;
+    for (int i = 0; i < numNodes; ++i) {
+        for (size_t layer = 0; layer < 3; ++layer) {
+            std::vector<int32_t> layerExpected;
+            if (layer < expected[i].size()) {
+                for (int32_t id : expected[i][layer]) {
+                    if (id >= 0) {
+                        layerExpected.push_back(id);
+                    }
+                }
+                std::sort(layerExpected.begin(), layerExpected.end());
+            }
+
+            copy.Neighbors(i, layer, neighbors);
+            ASSERT_EQ(layerExpected, neighbors);
+        }
+    }
+
+    std::vector<uint64_t> truncatedOffsets(graph.Offsets().begin(), graph.Offsets().end() - 1);
+    ASSERT_THROW(knn_jni::adjacency_codec::CompressedGraph(truncatedOffsets, graph.Data()), std::runtime_error);
+}
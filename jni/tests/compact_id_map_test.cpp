@@ -0,0 +1,73 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "compact_id_map.h"
+
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(CompactIdMapIdentityTest, BasicAssertions) {
+    // Ids equal to positions take no memory
+    std::vector<int64_t> ids = {0, 1, 2, 3, 4};
+    knn_jni::compact_id_map::CompactIdMap idMap(ids);
+    ASSERT_TRUE(idMap.IsIdentity());
+    ASSERT_EQ(5, idMap.Size());
+    ASSERT_EQ(0, idMap.MemoryUsage());
+    ASSERT_EQ(3, idMap.Map(3));
+    ASSERT_EQ(-1, idMap.Map(-1));
+    ASSERT_EQ(ids, idMap.ToVector());
+}
+
+TEST(CompactIdMapSparseTest, BasicAssertions) {
+    std::vector<int64_t> ids = {4, 10, 2147483647, 0};
+    knn_jni::compact_id_map::CompactIdMap idMap(ids);
+    ASSERT_FALSE(idMap.IsIdentity());
+    ASSERT_EQ(4, idMap.Size());
+    ASSERT_EQ(ids, idMap.ToVector());
+
+    // Padding of missing results is kept
+    std::vector<int64_t> labels = {2, 0, -1};
+    idMap.MapLabels(labels.data(), labels.size());
+    ASSERT_EQ(std::vector<int64_t>({2147483647, 4, -1}), labels);
+
+    // Same mapping from 32 bit ids
+    knn_jni::compact_id_map::CompactIdMap fromIds(idMap.Ids());
+    ASSERT_EQ(ids, fromIds.ToVector());
+
+    ASSERT_THROW(knn_jni::compact_id_map::CompactIdMap(std::vector<int64_t>({1, 2147483648})), std::runtime_error);
+    ASSERT_THROW(knn_jni::compact_id_map::CompactIdMap(std::vector<int32_t>({1, -2})), std::runtime_error);
+}
+
+TEST(CompactIdMapIoTest, BasicAssertions) {
+    // Identity maps are written without ids, other maps with their 32 bit ids
+    knn_jni::compact_id_map::CompactIdMap identity(std::vector<int64_t>({0, 1, 2}));
+    knn_jni::compact_id_map::CompactIdMap sparse(std::vector<int64_t>({7, 3, 2147483647}));
+
+    FILE* file = tmpfile();
+    ASSERT_NE(nullptr, file);
+    knn_jni::compact_id_map::WriteCompactIdMap(identity, file);
+    ASSERT_EQ(sizeof(uint8_t) + sizeof(int64_t), ftell(file));
+    knn_jni::compact_id_map::WriteCompactIdMap(sparse, file);
+
+    rewind(file);
+    auto readIdentity = knn_jni::compact_id_map::ReadCompactIdMap(file);
+    ASSERT_TRUE(readIdentity.IsIdentity());
+    ASSERT_EQ(3, readIdentity.Size());
+    auto readSparse = knn_jni::compact_id_map::ReadCompactIdMap(file);
+    ASSERT_EQ(sparse.ToVector(), readSparse.ToVector());
+
+    // The file ends here
+    ASSERT_THROW(knn_jni::compact_id_map::ReadCompactIdMap(file), std::runtime_error);
+    fclose(file);
+}
@@ -0,0 +1,89 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+
+#include "distance_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+    double Reference(knn_jni::distance_kernels::Metric metric, const std::vector<float>& x,
+                     const std::vector<float>& y) {
+        double l2 = 0, dot = 0, xNorm = 0, yNorm = 0;
+        for (size_t i = 0; i < x.size(); ++i) {
+            l2 += ((double) x[i] - y[i]) * ((double) x[i] - y[i]);
+            dot += (double) x[i] * y[i];
+            xNorm += (double) x[i] * x[i];
+            yNorm += (double) y[i] * y[i];
+        }
+
+        switch (metric) {
+            case knn_jni::distance_kernels::Metric::L2:
+                return l2;
+            case knn_jni::distance_kernels::Metric::INNER_PRODUCT:
+                return dot;
+            default:
+                return dot / std::sqrt(xNorm * yNorm);
+        }
+    }
+}
+
+TEST(DistanceKernelsSelectTest, BasicAssertions) {
+    for (size_t dim : {128, 384, 768, 1024, 1536}) {
+        ASSERT_TRUE(knn_jni::distance_kernels::IsSpecializedDimension(dim));
+        auto kernel = knn_jni::distance_kernels::SelectKernel(knn_jni::distance_kernels::Metric::L2, dim);
+        ASSERT_NE(nullptr, kernel.distance);
+        ASSERT_TRUE(kernel.specialized);
+        ASSERT_EQ(dim, kernel.dim);
+    }
+
+    for (size_t dim : {1, 100, 127, 1537}) {
+        ASSERT_FALSE(knn_jni::distance_kernels::IsSpecializedDimension(dim));
+        auto kernel = knn_jni::distance_kernels::SelectKernel(knn_jni::distance_kernels::Metric::COSINE, dim);
+        ASSERT_NE(nullptr, kernel.distance);
+        ASSERT_FALSE(kernel.specialized);
+    }
+}
+
+TEST(DistanceKernelsValueTest, BasicAssertions) {
+    using knn_jni::distance_kernels::Metric;
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> values(-1.0f, 1.0f);
+    for (size_t dim : {1, 7, 100, 128, 384, 768, 1024, 1536, 1537}) {
+        std::vector<float> x(dim), y(dim);
+        for (size_t i = 0; i < dim; ++i) {
+            x[i] = values(rng);
+            y[i] = values(rng);
+        }
+
+        for (auto metric : {Metric::L2, Metric::INNER_PRODUCT, Metric::COSINE}) {
+            auto kernel = knn_jni::distance_kernels::SelectKernel(metric, dim);
+            double expected = Reference(metric, x, y);
+            ASSERT_NEAR(expected, kernel(x.data(), y.data()), 1e-4 * std::max(1.0, std::fabs(expected)));
+        }
+    }
+}
+
+TEST(DistanceKernelsCosineZeroTest, BasicAssertions) {
+    for (size_t dim : {3, 128}) {
+        std::vector<float> zero(dim, 0.0f), ones(dim, 1.0f);
+        auto kernel = knn_jni::distance_kernels::SelectKernel(knn_jni::distance_kernels::Metric::COSINE, dim);
+        ASSERT_EQ(0.0f, kernel(zero.data(), ones.data()));
+        ASSERT_EQ(0.0f, kernel(ones.data(), zero.data()));
+        ASSERT_NEAR(1.0f, kernel(ones.data(), ones.data()), 1e-6);
+    }
+}
@@ -0,0 +1,124 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "faiss_balanced_kmeans.h"
+
+#include "faiss/Clustering.h"
+#include "faiss/IndexFlat.h"
+#include "faiss/IndexIVFFlat.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_util.h"
+
+namespace {
+    // Most vectors sit in one tight cluster near the origin and the rest are spread out, so that plain k-means
+    // leaves a few very long lists
+    std::vector<float> SkewedVectors(int n, int dim) {
+        std::vector<float> vectors(n * dim);
+        for (int i = 0; i < n; i++) {
+            float spread = i % 5 == 0 ? 100.0f : 1.0f;
+            for (int j = 0; j < dim; j++) {
+                vectors[i * dim + j] = test_util::RandomFloat(-spread, spread);
+            }
+        }
+        return vectors;
+    }
+
+    int64_t MaxListSize(int n, int dim, int nlist, const std::vector<float>& centroids, const std::vector<float>& x) {
+        faiss::IndexFlatL2 quantizer(dim);
+        quantizer.add(nlist, centroids.data());
+        quantizer.is_trained = true;
+        faiss::IndexIVFFlat ivf(&quantizer, dim, nlist);
+        ivf.is_trained = true;
+
+        std::vector<int64_t> sizes = knn_jni::faiss_wrapper::AssignedListSizes(&ivf, n, x.data());
+        EXPECT_EQ(n, std::accumulate(sizes.begin(), sizes.end(), (int64_t) 0));
+        return *std::max_element(sizes.begin(), sizes.end());
+    }
+}
+
+TEST(FaissBalancedKMeansTest, EvensOutListSizes) {
+    int n = 2000;
+    int dim = 8;
+    int nlist = 16;
+    std::vector<float> x = SkewedVectors(n, dim);
+
+    faiss::ClusteringParameters parameters;
+    parameters.seed = 7;
+
+    faiss::Clustering clustering(dim, nlist, parameters);
+    faiss::IndexFlatL2 assignIndex(dim);
+    clustering.train(n, x.data(), assignIndex);
+    int64_t kmeansMax = MaxListSize(n, dim, nlist, clustering.centroids, x);
+
+    std::vector<float> balanced(nlist * dim);
+    knn_jni::faiss_wrapper::TrainBalancedCentroids(n, dim, x.data(), nlist, faiss::METRIC_L2, parameters, 1.2f, 10,
+                                                   balanced.data());
+    int64_t balancedMax = MaxListSize(n, dim, nlist, balanced, x);
+
+    ASSERT_LT(balancedMax, kmeansMax);
+}
+
+TEST(FaissBalancedKMeansTest, RequiresEnoughVectors) {
+    int dim = 4;
+    std::vector<float> x(8 * dim, 1.0f);
+    std::vector<float> centroids(16 * dim);
+    faiss::ClusteringParameters parameters;
+
+    ASSERT_THROW(knn_jni::faiss_wrapper::TrainBalancedCentroids(8, dim, x.data(), 16, faiss::METRIC_L2, parameters,
+                                                                1.2f, 10, centroids.data()),
+                 std::runtime_error);
+}
+
+TEST(FaissBalancedKMeansTest, InnerProduct) {
+    int n = 2000;
+    int dim = 8;
+    int nlist = 16;
+    std::vector<float> x = SkewedVectors(n, dim);
+
+    // Spherical clustering keeps the centroids on the unit sphere through the balancing iterations too
+    faiss::ClusteringParameters parameters;
+    parameters.seed = 7;
+    parameters.spherical = true;
+
+    std::vector<float> centroids(nlist * dim);
+    knn_jni::faiss_wrapper::TrainBalancedCentroids(n, dim, x.data(), nlist, faiss::METRIC_INNER_PRODUCT, parameters,
+                                                   1.2f, 10, centroids.data());
+    for (int c = 0; c < nlist; c++) {
+        float norm = 0;
+        for (int j = 0; j < dim; j++) {
+            norm += centroids[c * dim + j] * centroids[c * dim + j];
+        }
+        ASSERT_NEAR(1.0f, norm, 1e-4);
+    }
+}
+
+TEST(FaissBalancedKMeansTest, RejectsUnsupportedMetric) {
+    int dim = 4;
+    std::vector<float> x(32 * dim, 1.0f);
+    std::vector<float> centroids(4 * dim);
+    faiss::ClusteringParameters parameters;
+
+    ASSERT_THROW(knn_jni::faiss_wrapper::TrainBalancedCentroids(32, dim, x.data(), 4, faiss::METRIC_L1, parameters,
+                                                                1.2f, 10, centroids.data()),
+                 std::runtime_error);
+}
+
+TEST(FaissBalancedKMeansTest, RejectsNonIvfIndex) {
+    faiss::IndexFlatL2 index(4);
+    std::vector<float> x(4, 1.0f);
+
+    ASSERT_THROW(knn_jni::faiss_wrapper::AssignedListSizes(&index, 1, x.data()), std::runtime_error);
+}
@@ -0,0 +1,174 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "faiss_calibration.h"
+#include "faiss_compact_id_map_index.h"
+#include "faiss_compressed_hnsw.h"
+
+#include "faiss/IndexFlat.h"
+#include "faiss/IndexHNSW.h"
+#include "faiss/IndexIVFFlat.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_util.h"
+
+namespace {
+    std::vector<float> RandomVectors(int n, int dim) {
+        std::vector<float> vectors(n * dim);
+        for (auto& value : vectors) {
+            value = test_util::RandomFloat(-10, 10);
+        }
+        return vectors;
+    }
+}
+
+TEST(FaissCalibrationTest, SweepsTheSearchParameter) {
+    int dim = 4;
+    faiss::IndexHNSWFlat hnsw(dim, 8);
+    ASSERT_EQ((std::vector<int64_t>{100, 200, 400, 800}), knn_jni::faiss_wrapper::SweepValues(&hnsw, 100));
+    ASSERT_EQ((std::vector<int64_t>{2000}), knn_jni::faiss_wrapper::SweepValues(&hnsw, 2000));
+
+    faiss::IndexFlatL2 quantizer(dim);
+    faiss::IndexIVFFlat ivf(&quantizer, dim, 12);
+    ASSERT_EQ((std::vector<int64_t>{1, 2, 4, 8, 12}), knn_jni::faiss_wrapper::SweepValues(&ivf, 10));
+
+    faiss::IndexFlatL2 flat(dim);
+    ASSERT_THROW(knn_jni::faiss_wrapper::SweepValues(&flat, 10), std::runtime_error);
+}
+
+TEST(FaissCalibrationTest, KeepsTheFrontier) {
+    std::vector<knn_jni::faiss_wrapper::CalibrationPoint> points = {
+            {1, 0.50, 10}, {2, 0.70, 20}, {4, 0.65, 30}, {8, 0.95, 40}, {16, 0.95, 80}, {32, 0.99, 35}};
+    auto frontier = knn_jni::faiss_wrapper::ParetoFrontier(points);
+    ASSERT_EQ(3, frontier.size());
+    ASSERT_EQ(1, frontier[0].value);
+    ASSERT_EQ(2, frontier[1].value);
+    ASSERT_EQ(32, frontier[2].value);
+
+    ASSERT_EQ(1, knn_jni::faiss_wrapper::RecommendedPoint(frontier, 0.6));
+    ASSERT_EQ(2, knn_jni::faiss_wrapper::RecommendedPoint(frontier, 0.9));
+    // Out of reach, so the most accurate point is recommended
+    ASSERT_EQ(2, knn_jni::faiss_wrapper::RecommendedPoint(frontier, 1.0));
+    ASSERT_THROW(knn_jni::faiss_wrapper::RecommendedPoint({}, 0.9), std::runtime_error);
+}
+
+TEST(FaissCalibrationTest, CalibratesIvf) {
+    int n = 2000;
+    int dim = 8;
+    int k = 10;
+    int numQueries = 20;
+    std::vector<float> vectors = RandomVectors(n, dim);
+    std::vector<float> queries = RandomVectors(numQueries, dim);
+
+    faiss::IndexFlatL2 quantizer(dim);
+    faiss::IndexIVFFlat ivf(&quantizer, dim, 16);
+    ivf.train(n, vectors.data());
+    ivf.add(n, vectors.data());
+    ivf.nprobe = 3;
+
+    // Ground truth is in the id space of the loaded index
+    std::vector<int32_t> ids(n);
+    for (int i = 0; i < n; ++i) {
+        ids[i] = 5 * i;
+    }
+    knn_jni::faiss_wrapper::CompactIdMapIndex compactIndex(&ivf, knn_jni::compact_id_map::CompactIdMap(ids), false);
+    auto groundTruth = knn_jni::faiss_wrapper::ExhaustiveNeighbors(&compactIndex, queries.data(), numQueries, k);
+    faiss::IndexFlatL2 flat(dim);
+    flat.add(n, vectors.data());
+    std::vector<float> distances(numQueries * k);
+    std::vector<faiss::Index::idx_t> labels(numQueries * k);
+    flat.search(numQueries, queries.data(), k, distances.data(), labels.data());
+    for (int i = 0; i < numQueries * k; ++i) {
+        ASSERT_EQ(5 * labels[i], groundTruth.data[i]);
+    }
+
+    // Probing every list of a flat IVF index is exact, so the frontier reaches full recall
+    auto calibration = knn_jni::faiss_wrapper::Calibrate(&compactIndex, queries.data(), numQueries, k, 0.9,
+                                                         groundTruth);
+    double bestRecall = 0;
+    for (size_t i = 0; i < calibration.frontier.size(); ++i) {
+        bestRecall = std::max(bestRecall, calibration.frontier[i].recall);
+        if (i > 0) {
+            ASSERT_LT(calibration.frontier[i - 1].value, calibration.frontier[i].value);
+        }
+    }
+    ASSERT_DOUBLE_EQ(1.0, bestRecall);
+    ASSERT_GE(calibration.frontier[calibration.recommended].recall, 0.9);
+    ASSERT_EQ(3, ivf.nprobe);
+
+    knn_jni::vecs_io::Matrix<int32_t> badGroundTruth(1, k);
+    ASSERT_THROW(knn_jni::faiss_wrapper::Calibrate(&ivf, queries.data(), numQueries, k, 0.9, badGroundTruth),
+                 std::runtime_error);
+}
+
+TEST(FaissCalibrationTest, CalibratesHnsw) {
+    int n = 2000;
+    int dim = 8;
+    int k = 10;
+    int numQueries = 20;
+    std::vector<float> vectors = RandomVectors(n, dim);
+    std::vector<float> queries = RandomVectors(numQueries, dim);
+
+    faiss::IndexHNSWFlat hnsw(dim, 16);
+    hnsw.hnsw.efSearch = 24;
+    hnsw.add(n, vectors.data());
+
+    auto groundTruth = knn_jni::faiss_wrapper::ExhaustiveNeighbors(&hnsw, queries.data(), numQueries, k);
+    auto calibration = knn_jni::faiss_wrapper::Calibrate(&hnsw, queries.data(), numQueries, k, 0.95, groundTruth);
+    ASSERT_FALSE(calibration.frontier.empty());
+    ASSERT_GE(calibration.frontier[calibration.recommended].recall, 0.95);
+    ASSERT_EQ(24, hnsw.hnsw.efSearch);
+}
+
+TEST(FaissCalibrationTest, LeavesServedIndicesUntouched) {
+    int n = 2000;
+    int dim = 8;
+    int k = 10;
+    int numQueries = 20;
+    std::vector<float> vectors = RandomVectors(n, dim);
+    std::vector<float> queries = RandomVectors(numQueries, dim);
+
+    faiss::IndexHNSWFlat hnsw(dim, 16);
+    hnsw.hnsw.efSearch = 24;
+    hnsw.add(n, vectors.data());
+    knn_jni::faiss_wrapper::CompactIdMapIndex compactIndex(&hnsw, knn_jni::compact_id_map::CompactIdMap(n), false);
+    auto groundTruth = knn_jni::faiss_wrapper::ExhaustiveNeighbors(&compactIndex, queries.data(), numQueries, k);
+
+    // Queries served from the index while it is calibrated keep its efSearch
+    std::atomic<bool> done(false);
+    std::atomic<int> changes(0);
+    std::thread reader([&]() {
+        while (!done) {
+            if (hnsw.hnsw.efSearch != 24) {
+                changes++;
+            }
+        }
+    });
+    auto calibration = knn_jni::faiss_wrapper::Calibrate(&compactIndex, queries.data(), numQueries, k, 0.95,
+                                                         groundTruth);
+    done = true;
+    reader.join();
+    ASSERT_EQ(0, changes);
+    ASSERT_GE(calibration.frontier[calibration.recommended].recall, 0.95);
+
+    // Compressed graphs are swept through their own graph
+    knn_jni::faiss_wrapper::CompressedHnswIndex compressedIndex(&hnsw, knn_jni::compact_id_map::CompactIdMap(n), false);
+    calibration = knn_jni::faiss_wrapper::Calibrate(&compressedIndex, queries.data(), numQueries, k, 0.95,
+                                                    groundTruth);
+    ASSERT_GE(calibration.frontier[calibration.recommended].recall, 0.95);
+    ASSERT_EQ(24, hnsw.hnsw.efSearch);
+}
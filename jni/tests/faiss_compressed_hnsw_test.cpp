@@ -0,0 +1,123 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "faiss_compressed_hnsw.h"
+#include "faiss_compact_id_map_index.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_util.h"
+
+TEST(FaissCompressedHnswIndexTest, BasicAssertions) {
+    // Define the data
+    faiss::Index::idx_t numIds = 500;
+    std::vector<faiss::Index::idx_t> ids;
+    std::vector<float> vectors;
+    int dim = 16;
+    for (int64_t i = 0; i < numIds; i++) {
+        ids.push_back(i * 3);
+        for (int j = 0; j < dim; j++) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    std::unique_ptr<faiss::Index> createdIndex(test_util::FaissCreateIndex(dim, "HNSW16,Flat", faiss::METRIC_L2));
+    auto createdIndexWithData = test_util::FaissAddData(createdIndex.get(), ids, vectors);
+
+    // Reference results, taken before compression frees the fixed width links
+    int k = 10;
+    std::vector<float> expectedDistances(numIds * k);
+    std::vector<faiss::Index::idx_t> expectedLabels(numIds * k);
+    createdIndexWithData.search(numIds, vectors.data(), k, expectedDistances.data(), expectedLabels.data());
+
+    auto *indexHnsw = dynamic_cast<faiss::IndexHNSW *>(createdIndex.get());
+    knn_jni::faiss_wrapper::CompressedHnswIndex compressedIndex(
+            indexHnsw, knn_jni::compact_id_map::CompactIdMap(createdIndexWithData.id_map), false);
+    ASSERT_TRUE(indexHnsw->hnsw.neighbors.empty());
+    ASSERT_FALSE(compressedIndex.GetIds().IsIdentity());
+    ASSERT_THROW(compressedIndex.add(1, vectors.data()), std::runtime_error);
+
+    std::vector<float> distances(numIds * k);
+    std::vector<faiss::Index::idx_t> labels(numIds * k);
+    compressedIndex.search(numIds, vectors.data(), k, distances.data(), labels.data());
+
+    // Every vector finds itself, and results mostly agree with faiss: both walk the same graph, only the order in
+    // which neighbors are visited differs
+    int matches = 0;
+    for (int64_t i = 0; i < numIds; i++) {
+        ASSERT_EQ(ids[i], labels[i * k]);
+        ASSERT_FLOAT_EQ(0.0, distances[i * k]);
+        ASSERT_TRUE(std::is_sorted(distances.begin() + i * k, distances.begin() + (i + 1) * k));
+        for (int j = 0; j < k; j++) {
+            auto begin = expectedLabels.begin() + i * k;
+            if (std::find(begin, begin + k, labels[i * k + j]) != begin + k) {
+                matches++;
+            }
+        }
+    }
+    ASSERT_GE(matches, numIds * k * 9 / 10);
+
+    // Round trip through a file gives the same results
+    std::string indexPath = test_util::RandomString(10, "tmp/", ".faiss");
+    knn_jni::faiss_wrapper::WriteCompressedHnswIndex(compressedIndex, indexPath);
+    std::unique_ptr<faiss::Index> loadedIndex(knn_jni::faiss_wrapper::ReadIndex(indexPath, faiss::IO_FLAG_READ_ONLY));
+    ASSERT_NE(nullptr, dynamic_cast<knn_jni::faiss_wrapper::CompressedHnswIndex *>(loadedIndex.get()));
+
+    std::vector<float> loadedDistances(numIds * k);
+    std::vector<faiss::Index::idx_t> loadedLabels(numIds * k);
+    loadedIndex->search(numIds, vectors.data(), k, loadedDistances.data(), loadedLabels.data());
+    ASSERT_EQ(labels, loadedLabels);
+    ASSERT_EQ(distances, loadedDistances);
+
+    // Clean up
+    std::remove(indexPath.c_str());
+}
+
+TEST(FaissReadIndexTest, BasicAssertions) {
+    // Files written by faiss load as they are, except that id maps are compacted
+    faiss::Index::idx_t numIds = 100;
+    std::vector<faiss::Index::idx_t> ids;
+    std::vector<float> vectors;
+    int dim = 2;
+    for (int64_t i = 0; i < numIds; i++) {
+        ids.push_back(i);
+        for (int j = 0; j < dim; j++) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    std::string indexPath = test_util::RandomString(10, "tmp/", ".faiss");
+    std::unique_ptr<faiss::Index> createdIndex(test_util::FaissCreateIndex(dim, "HNSW16,Flat", faiss::METRIC_L2));
+    auto createdIndexWithData = test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    test_util::FaissWriteIndex(&createdIndexWithData, indexPath);
+
+    std::unique_ptr<faiss::Index> loadedIndex(knn_jni::faiss_wrapper::ReadIndex(indexPath, faiss::IO_FLAG_READ_ONLY));
+    auto *compactIndex = dynamic_cast<knn_jni::faiss_wrapper::CompactIdMapIndex *>(loadedIndex.get());
+    ASSERT_NE(nullptr, compactIndex);
+    ASSERT_TRUE(compactIndex->GetIds().IsIdentity());
+    ASSERT_EQ(numIds, loadedIndex->ntotal);
+
+    // Files without an id map get the identity
+    test_util::FaissWriteIndex(createdIndex.get(), indexPath);
+    loadedIndex.reset(knn_jni::faiss_wrapper::ReadIndex(indexPath, faiss::IO_FLAG_READ_ONLY));
+    compactIndex = dynamic_cast<knn_jni::faiss_wrapper::CompactIdMapIndex *>(loadedIndex.get());
+    ASSERT_NE(nullptr, compactIndex);
+    ASSERT_TRUE(compactIndex->GetIds().IsIdentity());
+    ASSERT_NE(nullptr, dynamic_cast<faiss::IndexHNSW *>(compactIndex->GetIndex()));
+
+    // Clean up
+    std::remove(indexPath.c_str());
+}
@@ -0,0 +1,143 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "faiss_description.h"
+#include "faiss_compressed_hnsw.h"
+#include "faiss_wrapper.h"
+#include "json_value.h"
+
+#include "faiss/IndexHNSW.h"
+#include "faiss/IndexIVF.h"
+
+#include <memory>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "test_util.h"
+
+using ::testing::NiceMock;
+
+namespace {
+    // Sum of the numbers of an array member of document
+    int64_t Sum(const knn_jni::json::Value& document, const std::string& name) {
+        int64_t sum = 0;
+        for (const auto& element : document.Find(name)->Elements()) {
+            sum += element->AsInt();
+        }
+        return sum;
+    }
+}
+
+TEST(FaissDescriptionTest, DescribesHnsw) {
+    faiss::Index::idx_t numIds = 500;
+    int dim = 16;
+    std::vector<faiss::Index::idx_t> ids;
+    std::vector<float> vectors;
+    for (int64_t i = 0; i < numIds; i++) {
+        ids.push_back(i * 3);
+        for (int j = 0; j < dim; j++) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    std::unique_ptr<faiss::Index> createdIndex(test_util::FaissCreateIndex(dim, "HNSW16,Flat", faiss::METRIC_L2));
+    auto createdIndexWithData = test_util::FaissAddData(createdIndex.get(), ids, vectors);
+
+    auto fixed = knn_jni::json::Value::Parse(knn_jni::faiss_wrapper::Describe(&createdIndexWithData));
+    ASSERT_EQ("faiss", fixed.Find("engine")->AsString());
+    ASSERT_EQ(numIds, fixed.Find("count")->AsInt());
+    ASSERT_EQ(dim, fixed.Find("dimension")->AsInt());
+    ASSERT_EQ(knn_jni::L2, fixed.Find("metric")->AsString());
+
+    const auto *memory = fixed.Find("memory");
+    ASSERT_EQ((int) (numIds * sizeof(faiss::Index::idx_t)), memory->Find("ids")->AsInt());
+    ASSERT_EQ((int) (numIds * dim * sizeof(float)), memory->Find("vectors")->AsInt());
+    ASSERT_GT(memory->Find("graph")->AsInt(), 0);
+    ASSERT_EQ(memory->Find("ids")->AsInt() + memory->Find("vectors")->AsInt() + memory->Find("graph")->AsInt(),
+              memory->Find("total")->AsInt());
+
+    const auto *hnsw = fixed.Find("hnsw");
+    ASSERT_EQ("fixed", hnsw->Find("graph_encoding")->AsString());
+    ASSERT_EQ(numIds, Sum(*hnsw, "level_counts"));
+    ASSERT_EQ(numIds, Sum(*hnsw, "degree_histogram"));
+    ASSERT_EQ((size_t) hnsw->Find("max_level")->AsInt() + 1, hnsw->Find("level_counts")->Elements().size());
+    ASSERT_LE(hnsw->Find("mean_degree")->AsNumber(), 32);
+    ASSERT_LT(hnsw->Find("unreachable")->AsInt(), 5);
+
+    // Compression keeps the structure and shrinks the graph
+    auto *indexHnsw = dynamic_cast<faiss::IndexHNSW *>(createdIndex.get());
+    knn_jni::faiss_wrapper::CompressedHnswIndex compressedIndex(
+            indexHnsw, knn_jni::compact_id_map::CompactIdMap(createdIndexWithData.id_map), false);
+    auto compressed = knn_jni::json::Value::Parse(knn_jni::faiss_wrapper::Describe(&compressedIndex));
+    const auto *compressedHnsw = compressed.Find("hnsw");
+    ASSERT_EQ("delta", compressedHnsw->Find("graph_encoding")->AsString());
+    ASSERT_EQ(hnsw->Find("unreachable")->AsInt(), compressedHnsw->Find("unreachable")->AsInt());
+    ASSERT_EQ(hnsw->Find("level_counts")->Elements().size(),
+              compressedHnsw->Find("level_counts")->Elements().size());
+    ASSERT_DOUBLE_EQ(hnsw->Find("mean_degree")->AsNumber(), compressedHnsw->Find("mean_degree")->AsNumber());
+    ASSERT_LT(compressed.Find("memory")->Find("graph")->AsInt(), memory->Find("graph")->AsInt());
+    ASSERT_EQ(nullptr, compressed.Find("ivf"));
+}
+
+TEST(FaissDescriptionTest, DescribesIvf) {
+    faiss::Index::idx_t numIds = 500;
+    int dim = 8;
+    int nlist = 8;
+    std::vector<faiss::Index::idx_t> ids;
+    std::vector<float> vectors;
+    for (int64_t i = 0; i < numIds; i++) {
+        ids.push_back(i);
+        for (int j = 0; j < dim; j++) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    std::unique_ptr<faiss::Index> createdIndex(test_util::FaissCreateIndex(dim, "IVF8,Flat",
+                                                                           faiss::METRIC_INNER_PRODUCT));
+    createdIndex->train(numIds, vectors.data());
+    auto createdIndexWithData = test_util::FaissAddData(createdIndex.get(), ids, vectors);
+
+    auto description = knn_jni::json::Value::Parse(knn_jni::faiss_wrapper::Describe(&createdIndexWithData));
+    ASSERT_EQ(knn_jni::INNER_PRODUCT, description.Find("metric")->AsString());
+    ASSERT_EQ(nullptr, description.Find("hnsw"));
+
+    // Listed codes and their ids, the ids of the id map, and the centroids of the flat quantizer
+    const auto *memory = description.Find("memory");
+    ASSERT_EQ((int) (numIds * dim * sizeof(float)), memory->Find("vectors")->AsInt());
+    ASSERT_EQ((int) (2 * numIds * sizeof(faiss::Index::idx_t)), memory->Find("ids")->AsInt());
+    ASSERT_EQ((int) (nlist * dim * sizeof(float)), memory->Find("quantizer")->AsInt());
+
+    const auto *ivf = description.Find("ivf");
+    const auto *listSizes = ivf->Find("list_sizes");
+    ASSERT_EQ(nlist, listSizes->Find("count")->AsInt());
+    ASSERT_EQ(numIds, listSizes->Find("total")->AsInt());
+    ASSERT_LE(listSizes->Find("min")->AsInt(), listSizes->Find("p50")->AsInt());
+    ASSERT_LE(listSizes->Find("p50")->AsInt(), listSizes->Find("max")->AsInt());
+    ASSERT_GE(listSizes->Find("imbalance")->AsNumber(), 1.0);
+    ASSERT_LE(listSizes->Find("imbalance")->AsNumber(), (double) nlist);
+}
+
+TEST(FaissDescriptionTest, ReturnsDescriptionToJava) {
+    int dim = 4;
+    std::unique_ptr<faiss::Index> createdIndex(test_util::FaissCreateIndex(dim, "HNSW8,Flat", faiss::METRIC_L2));
+    std::vector<float> vectors(10 * dim, 1.0f);
+    createdIndex->add(10, vectors.data());
+
+    JNIEnv *jniEnv = nullptr;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+    std::unique_ptr<std::vector<uint8_t>> bytes(reinterpret_cast<std::vector<uint8_t> *>(
+            knn_jni::faiss_wrapper::DescribeIndex(&mockJNIUtil, jniEnv, reinterpret_cast<jlong>(createdIndex.get()))));
+    auto description = knn_jni::json::Value::Parse(std::string(bytes->begin(), bytes->end()));
+    ASSERT_EQ(10, description.Find("count")->AsInt());
+
+    ASSERT_THROW(knn_jni::faiss_wrapper::DescribeIndex(&mockJNIUtil, jniEnv, 0), std::runtime_error);
+}
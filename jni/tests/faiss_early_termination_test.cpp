@@ -0,0 +1,148 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "faiss_early_termination.h"
+#include "faiss_compact_id_map_index.h"
+#include "faiss_filtered_search.h"
+
+#include "faiss/IndexFlat.h"
+#include "faiss/IndexHNSW.h"
+#include "faiss/IndexIVFFlat.h"
+#include "faiss/IndexPreTransform.h"
+#include "faiss/VectorTransform.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_util.h"
+
+namespace {
+    std::vector<float> RandomVectors(int n, int dim) {
+        std::vector<float> vectors(n * dim);
+        for (auto& value : vectors) {
+            value = test_util::RandomFloat(-10, 10);
+        }
+        return vectors;
+    }
+
+    // Number of labels of actual that are among the first k of expected, over all queries
+    int Overlap(const std::vector<faiss::Index::idx_t>& expected, const std::vector<faiss::Index::idx_t>& actual,
+                int numQueries, int k) {
+        int matches = 0;
+        for (int q = 0; q < numQueries; ++q) {
+            auto begin = expected.begin() + q * k;
+            for (int i = 0; i < k; ++i) {
+                if (actual[q * k + i] >= 0 && std::find(begin, begin + k, actual[q * k + i]) != begin + k) {
+                    matches++;
+                }
+            }
+        }
+        return matches;
+    }
+}
+
+TEST(FaissEarlyTerminationTest, ParsesNames) {
+    ASSERT_EQ(knn_jni::faiss_wrapper::EarlyTermination::NONE, knn_jni::faiss_wrapper::ParseEarlyTermination("none"));
+    ASSERT_EQ(knn_jni::faiss_wrapper::EarlyTermination::ADAPTIVE,
+              knn_jni::faiss_wrapper::ParseEarlyTermination("adaptive"));
+    ASSERT_THROW(knn_jni::faiss_wrapper::ParseEarlyTermination("always"), std::runtime_error);
+
+    ASSERT_EQ(128, knn_jni::faiss_wrapper::AdaptivePatience(512, 10));
+    ASSERT_EQ(10, knn_jni::faiss_wrapper::AdaptivePatience(16, 10));
+}
+
+TEST(FaissEarlyTerminationTest, IvfSkipsOnlyListsThatCannotMatter) {
+    int n = 3000;
+    int dim = 8;
+    int nlist = 32;
+    int k = 10;
+    int numQueries = 50;
+    std::vector<float> vectors = RandomVectors(n, dim);
+    std::vector<float> queries = RandomVectors(numQueries, dim);
+
+    faiss::IndexFlatL2 quantizer(dim);
+    faiss::IndexIVFFlat ivf(&quantizer, dim, nlist);
+    ivf.train(n, vectors.data());
+    ivf.add(n, vectors.data());
+    ivf.nprobe = 8;
+
+    // Vectors of a flat IVF are compared exactly, so the bisector bound never drops a true result
+    std::vector<float> expectedDistances(numQueries * k);
+    std::vector<faiss::Index::idx_t> expectedLabels(numQueries * k);
+    ivf.search(numQueries, queries.data(), k, expectedDistances.data(), expectedLabels.data());
+
+    std::vector<float> distances(numQueries * k);
+    std::vector<faiss::Index::idx_t> labels(numQueries * k);
+    knn_jni::faiss_wrapper::SearchIvfAdaptive(&ivf, numQueries, queries.data(), k, distances.data(), labels.data());
+    for (int i = 0; i < numQueries * k; ++i) {
+        ASSERT_FLOAT_EQ(expectedDistances[i], distances[i]);
+    }
+    ASSERT_EQ(numQueries * k, Overlap(expectedLabels, labels, numQueries, k));
+
+    // Behind a pre-transform, the query is transformed before the lists are probed
+    faiss::RandomRotationMatrix rotation(dim, dim);
+    rotation.init(3);
+    faiss::IndexFlatL2 rotatedQuantizer(dim);
+    faiss::IndexIVFFlat rotatedIvf(&rotatedQuantizer, dim, nlist);
+    faiss::IndexPreTransform preTransform(&rotation, &rotatedIvf);
+    preTransform.train(n, vectors.data());
+    preTransform.add(n, vectors.data());
+    rotatedIvf.nprobe = 8;
+
+    preTransform.search(numQueries, queries.data(), k, expectedDistances.data(), expectedLabels.data());
+    knn_jni::faiss_wrapper::SearchIvfAdaptive(&preTransform, numQueries, queries.data(), k, distances.data(),
+                                              labels.data());
+    ASSERT_EQ(numQueries * k, Overlap(expectedLabels, labels, numQueries, k));
+}
+
+TEST(FaissEarlyTerminationTest, HnswPatienceKeepsRecall) {
+    int n = 2000;
+    int dim = 8;
+    int k = 10;
+    int numQueries = 50;
+    std::vector<float> vectors = RandomVectors(n, dim);
+    std::vector<float> queries = RandomVectors(numQueries, dim);
+
+    faiss::IndexHNSWFlat hnsw(dim, 16);
+    hnsw.hnsw.efSearch = 256;
+    hnsw.add(n, vectors.data());
+    auto kernel = knn_jni::faiss_wrapper::SelectFlatKernel(hnsw.storage);
+
+    std::vector<float> distances(numQueries * k);
+    std::vector<faiss::Index::idx_t> exhaustiveLabels(numQueries * k);
+    knn_jni::faiss_wrapper::SearchHnsw(hnsw, knn_jni::faiss_wrapper::FixedNeighbors(hnsw.hnsw), nullptr, kernel,
+                                       numQueries, queries.data(), k, distances.data(), exhaustiveLabels.data());
+
+    std::vector<faiss::Index::idx_t> adaptiveLabels(numQueries * k);
+    knn_jni::faiss_wrapper::SearchHnsw(hnsw, knn_jni::faiss_wrapper::FixedNeighbors(hnsw.hnsw), nullptr, kernel,
+                                       numQueries, queries.data(), k, distances.data(), adaptiveLabels.data(),
+                                       knn_jni::faiss_wrapper::AdaptivePatience(hnsw.hnsw.efSearch, k));
+    for (int i = 0; i < numQueries * k; ++i) {
+        ASSERT_GE(adaptiveLabels[i], 0);
+    }
+    ASSERT_GE(Overlap(exhaustiveLabels, adaptiveLabels, numQueries, k), numQueries * k * 9 / 10);
+
+    // A loaded index searches adaptively once it is told to, and maps positions to ids either way
+    std::vector<int32_t> ids(n);
+    for (int i = 0; i < n; ++i) {
+        ids[i] = 3 * i;
+    }
+    knn_jni::faiss_wrapper::CompactIdMapIndex compactIndex(&hnsw, knn_jni::compact_id_map::CompactIdMap(ids), false);
+    compactIndex.SetEarlyTermination(knn_jni::faiss_wrapper::EarlyTermination::ADAPTIVE);
+    std::vector<faiss::Index::idx_t> compactLabels(numQueries * k);
+    compactIndex.search(numQueries, queries.data(), k, distances.data(), compactLabels.data());
+    for (int i = 0; i < numQueries * k; ++i) {
+        ASSERT_EQ(3 * adaptiveLabels[i], compactLabels[i]);
+    }
+}
@@ -0,0 +1,244 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "faiss_filtered_search.h"
+#include "faiss_compact_id_map_index.h"
+#include "faiss_compressed_hnsw.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_util.h"
+
+namespace {
+    // Ids of the k nearest live docs to query, found by brute force
+    std::vector<faiss::Index::idx_t> ExactLiveNeighbors(const std::vector<float>& vectors,
+                                                        const std::vector<faiss::Index::idx_t>& ids, int dim,
+                                                        const float* query, int k,
+                                                        const knn_jni::live_docs::LiveDocs& liveDocs) {
+        std::vector<std::pair<float, faiss::Index::idx_t>> scored;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (!liveDocs.IsLive(ids[i])) {
+                continue;
+            }
+            float distance = 0;
+            for (int j = 0; j < dim; ++j) {
+                float diff = vectors[i * dim + j] - query[j];
+                distance += diff * diff;
+            }
+            scored.emplace_back(distance, ids[i]);
+        }
+        std::sort(scored.begin(), scored.end());
+
+        std::vector<faiss::Index::idx_t> neighbors;
+        for (int i = 0; i < k && i < (int) scored.size(); ++i) {
+            neighbors.push_back(scored[i].second);
+        }
+        return neighbors;
+    }
+
+    // Check that index only returns live docs, k per query, and mostly the exact ones
+    void AssertSearchesLiveDocs(const faiss::Index* index, const std::vector<float>& vectors,
+                                const std::vector<faiss::Index::idx_t>& ids, int dim,
+                                const knn_jni::live_docs::LiveDocs& liveDocs) {
+        int k = 10;
+        auto numQueries = (faiss::Index::idx_t) ids.size();
+        std::vector<float> distances(numQueries * k);
+        std::vector<faiss::Index::idx_t> labels(numQueries * k);
+        knn_jni::faiss_wrapper::SearchLiveDocs(index, liveDocs, numQueries, vectors.data(), k, distances.data(),
+                                               labels.data());
+
+        int matches = 0;
+        for (faiss::Index::idx_t q = 0; q < numQueries; ++q) {
+            auto expected = ExactLiveNeighbors(vectors, ids, dim, vectors.data() + q * dim, k, liveDocs);
+            for (int i = 0; i < k; ++i) {
+                ASSERT_TRUE(labels[q * k + i] >= 0);
+                ASSERT_TRUE(liveDocs.IsLive(labels[q * k + i]));
+                if (std::find(expected.begin(), expected.end(), labels[q * k + i]) != expected.end()) {
+                    matches++;
+                }
+            }
+        }
+        ASSERT_GE(matches, numQueries * k * 9 / 10);
+    }
+}
+
+TEST(FaissSearchLiveDocsTest, BasicAssertions) {
+    // Define the data. Two out of three docs are deleted
+    faiss::Index::idx_t numIds = 600;
+    std::vector<faiss::Index::idx_t> ids;
+    std::vector<float> vectors;
+    int dim = 8;
+    for (int64_t i = 0; i < numIds; i++) {
+        ids.push_back(i * 2);
+        for (int j = 0; j < dim; j++) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    std::vector<uint64_t> words((numIds * 2 + 63) / 64, 0);
+    for (auto id : ids) {
+        if (id % 3 == 0) {
+            words[id / 64] |= 1ull << (id % 64);
+        }
+    }
+    knn_jni::live_docs::LiveDocs liveDocs(words.data(), words.size());
+
+    // Id map over HNSW, as loaded from disk
+    std::unique_ptr<faiss::Index> hnswIndex(test_util::FaissCreateIndex(dim, "HNSW16,Flat", faiss::METRIC_L2));
+    auto hnswIndexWithData = test_util::FaissAddData(hnswIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::CompactIdMapIndex compactIndex(
+            hnswIndex.get(), knn_jni::compact_id_map::CompactIdMap(hnswIndexWithData.id_map), false);
+    AssertSearchesLiveDocs(&compactIndex, vectors, ids, dim, liveDocs);
+
+    // Same graph, compressed
+    knn_jni::faiss_wrapper::CompressedHnswIndex compressedIndex(
+            dynamic_cast<faiss::IndexHNSW *>(hnswIndex.get()),
+            knn_jni::compact_id_map::CompactIdMap(hnswIndexWithData.id_map), false);
+    AssertSearchesLiveDocs(&compressedIndex, vectors, ids, dim, liveDocs);
+
+    // Id map over a flat index skips deleted docs while scanning
+    std::unique_ptr<faiss::Index> flatIndex(test_util::FaissCreateIndex(dim, "Flat", faiss::METRIC_L2));
+    auto flatIndexWithData = test_util::FaissAddData(flatIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::CompactIdMapIndex compactFlatIndex(
+            flatIndex.get(), knn_jni::compact_id_map::CompactIdMap(flatIndexWithData.id_map), false);
+    AssertSearchesLiveDocs(&compactFlatIndex, vectors, ids, dim, liveDocs);
+
+    // Other indices drop deleted docs from a larger result set
+    AssertSearchesLiveDocs(&flatIndexWithData, vectors, ids, dim, liveDocs);
+}
+
+TEST(FaissSpecializedKernelSearchTest, BasicAssertions) {
+    // 128 has a specialized kernel, so the compact index searches without faiss
+    faiss::Index::idx_t numIds = 200;
+    std::vector<faiss::Index::idx_t> ids;
+    std::vector<float> vectors;
+    int dim = 128;
+    for (int64_t i = 0; i < numIds; i++) {
+        ids.push_back(i);
+        for (int j = 0; j < dim; j++) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    int k = 5;
+    for (auto metric : {faiss::METRIC_L2, faiss::METRIC_INNER_PRODUCT}) {
+        std::unique_ptr<faiss::Index> flatIndex(test_util::FaissCreateIndex(dim, "Flat", metric));
+        auto flatIndexWithData = test_util::FaissAddData(flatIndex.get(), ids, vectors);
+        knn_jni::faiss_wrapper::CompactIdMapIndex compactIndex(
+                flatIndex.get(), knn_jni::compact_id_map::CompactIdMap(flatIndexWithData.id_map), false);
+        ASSERT_TRUE(compactIndex.GetKernel().specialized);
+
+        // Fewer queries than faiss hands to BLAS
+        faiss::Index::idx_t numQueries = 10;
+        std::vector<float> expectedDistances(numQueries * k), distances(numQueries * k);
+        std::vector<faiss::Index::idx_t> expectedLabels(numQueries * k), labels(numQueries * k);
+        flatIndexWithData.search(numQueries, vectors.data(), k, expectedDistances.data(), expectedLabels.data());
+        compactIndex.search(numQueries, vectors.data(), k, distances.data(), labels.data());
+
+        for (size_t i = 0; i < labels.size(); ++i) {
+            ASSERT_EQ(expectedLabels[i], labels[i]);
+            ASSERT_NEAR(expectedDistances[i], distances[i], 1e-3 * std::max(1.0f, std::abs(expectedDistances[i])));
+        }
+    }
+}
+
+TEST(FaissLoadedIndexSpecializedKernelTest, BasicAssertions) {
+    // Indices written by faiss without an id map, as for doc ids 0 to n - 1, load behind an identity map and so get
+    // the kernel of their dimension too
+    faiss::Index::idx_t numIds = 100;
+    std::string indexPath = test_util::RandomString(10, "tmp/", ".faiss");
+    for (int dim : {128, 768}) {
+        std::vector<float> vectors;
+        for (int64_t i = 0; i < numIds * dim; i++) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+
+        for (auto description : {"Flat", "HNSW16,Flat"}) {
+            std::unique_ptr<faiss::Index> createdIndex(test_util::FaissCreateIndex(dim, description, faiss::METRIC_L2));
+            createdIndex->add(numIds, vectors.data());
+            test_util::FaissWriteIndex(createdIndex.get(), indexPath);
+
+            std::unique_ptr<faiss::Index> loadedIndex(
+                    knn_jni::faiss_wrapper::ReadIndex(indexPath, faiss::IO_FLAG_READ_ONLY));
+            auto *compactIndex = dynamic_cast<knn_jni::faiss_wrapper::CompactIdMapIndex *>(loadedIndex.get());
+            ASSERT_NE(nullptr, compactIndex);
+            ASSERT_TRUE(compactIndex->GetIds().IsIdentity());
+            ASSERT_TRUE(compactIndex->GetKernel().specialized);
+            ASSERT_EQ(dim, compactIndex->GetKernel().dim);
+
+            int k = 1;
+            faiss::Index::idx_t numQueries = 10;
+            std::vector<float> distances(numQueries * k);
+            std::vector<faiss::Index::idx_t> labels(numQueries * k);
+            loadedIndex->search(numQueries, vectors.data(), k, distances.data(), labels.data());
+            for (faiss::Index::idx_t i = 0; i < numQueries; i++) {
+                ASSERT_EQ(i, labels[i]);
+            }
+        }
+    }
+
+    // Clean up
+    std::remove(indexPath.c_str());
+}
+
+TEST(FaissSearchLiveDocsHeavilyDeletedTest, BasicAssertions) {
+    // Define the data. Nineteen out of twenty docs are deleted
+    faiss::Index::idx_t numIds = 1000;
+    std::vector<faiss::Index::idx_t> ids;
+    std::vector<float> vectors;
+    int dim = 8;
+    for (int64_t i = 0; i < numIds; i++) {
+        ids.push_back(i);
+        for (int j = 0; j < dim; j++) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    std::vector<uint64_t> words((numIds + 63) / 64, 0);
+    for (auto id : ids) {
+        if (id % 20 == 0) {
+            words[id / 64] |= 1ull << (id % 64);
+        }
+    }
+    knn_jni::live_docs::LiveDocs liveDocs(words.data(), words.size());
+
+    // An index that cannot skip deleted docs fetches a bounded number of results, so it may return fewer than k.
+    // Those it returns are live and, as the flat search is exact, the nearest live docs in order
+    std::unique_ptr<faiss::Index> flatIndex(test_util::FaissCreateIndex(dim, "Flat", faiss::METRIC_L2));
+    auto flatIndexWithData = test_util::FaissAddData(flatIndex.get(), ids, vectors);
+
+    int k = 10;
+    faiss::Index::idx_t numQueries = 100;
+    std::vector<float> distances(numQueries * k);
+    std::vector<faiss::Index::idx_t> labels(numQueries * k);
+    knn_jni::faiss_wrapper::SearchLiveDocs(&flatIndexWithData, liveDocs, numQueries, vectors.data(), k,
+                                           distances.data(), labels.data());
+
+    int numFound = 0;
+    for (faiss::Index::idx_t q = 0; q < numQueries; ++q) {
+        auto expected = ExactLiveNeighbors(vectors, ids, dim, vectors.data() + q * dim, k, liveDocs);
+        int found = 0;
+        while (found < k && labels[q * k + found] >= 0) {
+            ASSERT_EQ(expected[found], labels[q * k + found]);
+            found++;
+        }
+        for (int i = found; i < k; ++i) {
+            ASSERT_EQ(-1, labels[q * k + i]);
+        }
+        numFound += found;
+    }
+    ASSERT_GT(numFound, 0);
+}
@@ -0,0 +1,219 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "faiss_join.h"
+#include "faiss_compact_id_map_index.h"
+#include "faiss_compressed_hnsw.h"
+
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_util.h"
+
+namespace {
+    struct JoinRow {
+        int32_t queryId;
+        std::vector<int32_t> ids;
+        std::vector<float> distances;
+    };
+
+    std::vector<JoinRow> ReadJoinResults(const std::string& path) {
+        std::unique_ptr<FILE, int(*)(FILE*)> file(fopen(path.c_str(), "rb"), &fclose);
+        uint32_t k;
+        EXPECT_EQ(1, fread(&k, sizeof(k), 1, file.get()));
+
+        std::vector<JoinRow> rows;
+        JoinRow row;
+        row.ids.resize(k);
+        row.distances.resize(k);
+        while (fread(&row.queryId, sizeof(row.queryId), 1, file.get()) == 1) {
+            EXPECT_EQ(k, fread(row.ids.data(), sizeof(int32_t), k, file.get()));
+            EXPECT_EQ(k, fread(row.distances.data(), sizeof(float), k, file.get()));
+            rows.push_back(row);
+        }
+        return rows;
+    }
+}
+
+TEST(FaissKnnJoinIndexTest, BasicAssertions) {
+    // Define the data
+    faiss::Index::idx_t numIds = 300;
+    std::vector<faiss::Index::idx_t> ids;
+    std::vector<float> vectors;
+    int dim = 8;
+    for (int64_t i = 0; i < numIds; i++) {
+        ids.push_back(i * 5);
+        for (int j = 0; j < dim; j++) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    int numQueries = 50;
+    std::vector<float> queries;
+    for (int i = 0; i < numQueries * dim; i++) {
+        queries.push_back(test_util::RandomFloat(-500.0, 500.0));
+    }
+
+    std::unique_ptr<faiss::Index> createdIndex(test_util::FaissCreateIndex(dim, "Flat", faiss::METRIC_L2));
+    auto createdIndexWithData = test_util::FaissAddData(createdIndex.get(), ids, vectors);
+
+    int k = 5;
+    std::vector<float> expectedDistances(numQueries * k);
+    std::vector<faiss::Index::idx_t> expectedLabels(numQueries * k);
+    createdIndexWithData.search(numQueries, queries.data(), k, expectedDistances.data(), expectedLabels.data());
+
+    std::string outputPath = test_util::RandomString(10, "tmp/", ".join");
+    knn_jni::faiss_wrapper::KnnJoinIndex(&createdIndexWithData, queries.data(), numQueries, k, true, 2,
+                                         knn_jni::qos::SchedulingPolicy::NORMAL, outputPath);
+
+    auto rows = ReadJoinResults(outputPath);
+    ASSERT_EQ(numQueries, rows.size());
+    for (int i = 0; i < numQueries; i++) {
+        ASSERT_EQ(i, rows[i].queryId);
+        for (int j = 0; j < k; j++) {
+            ASSERT_EQ(expectedLabels[i * k + j], rows[i].ids[j]);
+            ASSERT_FLOAT_EQ(expectedDistances[i * k + j], rows[i].distances[j]);
+        }
+    }
+
+    ASSERT_THROW(knn_jni::faiss_wrapper::KnnJoinIndex(&createdIndexWithData, queries.data(), numQueries, 0, false, 1,
+                                                      knn_jni::qos::SchedulingPolicy::NORMAL, outputPath),
+                 std::runtime_error);
+
+    // Clean up
+    std::remove(outputPath.c_str());
+}
+
+TEST(FaissSelfJoinIndexTest, BasicAssertions) {
+    // Define the data
+    faiss::Index::idx_t numIds = 300;
+    std::vector<faiss::Index::idx_t> ids;
+    std::vector<float> vectors;
+    int dim = 8;
+    for (int64_t i = 0; i < numIds; i++) {
+        ids.push_back(i * 5);
+        for (int j = 0; j < dim; j++) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    std::unique_ptr<faiss::Index> createdIndex(test_util::FaissCreateIndex(dim, "HNSW16,Flat", faiss::METRIC_L2));
+    auto createdIndexWithData = test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::CompactIdMapIndex compactIndex(
+            createdIndex.get(), knn_jni::compact_id_map::CompactIdMap(createdIndexWithData.id_map), false);
+
+    // Exact join: the first neighbor is the nearest other vector
+    int k = 5;
+    std::string outputPath = test_util::RandomString(10, "tmp/", ".join");
+    knn_jni::faiss_wrapper::SelfJoinIndex(&compactIndex, k, true, 2, knn_jni::qos::SchedulingPolicy::NORMAL, outputPath);
+    auto rows = ReadJoinResults(outputPath);
+    ASSERT_EQ(numIds, rows.size());
+    for (int i = 0; i < numIds; i++) {
+        ASSERT_EQ(ids[i], rows[i].queryId);
+        for (int j = 0; j < k; j++) {
+            ASSERT_NE(ids[i], rows[i].ids[j]);
+            ASSERT_GE(rows[i].ids[j], 0);
+        }
+
+        float nearestDistance = std::numeric_limits<float>::max();
+        int64_t nearest = -1;
+        for (int j = 0; j < numIds; j++) {
+            float distance = 0;
+            for (int l = 0; j != i && l < dim; l++) {
+                float diff = vectors[i * dim + l] - vectors[j * dim + l];
+                distance += diff * diff;
+            }
+            if (j != i && distance < nearestDistance) {
+                nearestDistance = distance;
+                nearest = ids[j];
+            }
+        }
+        ASSERT_EQ(nearest, rows[i].ids[0]);
+    }
+
+    // Graph join leaves each vector out of its own neighbors too
+    knn_jni::faiss_wrapper::SelfJoinIndex(&compactIndex, k, false, 2, knn_jni::qos::SchedulingPolicy::NICE, outputPath);
+    rows = ReadJoinResults(outputPath);
+    ASSERT_EQ(numIds, rows.size());
+    for (int i = 0; i < numIds; i++) {
+        ASSERT_EQ(ids[i], rows[i].queryId);
+        for (int j = 0; j < k; j++) {
+            ASSERT_NE(ids[i], rows[i].ids[j]);
+        }
+    }
+
+    // Clean up
+    std::remove(outputPath.c_str());
+}
+
+TEST(FaissJoinCompressedIndexTest, BasicAssertions) {
+    // Define the data
+    faiss::Index::idx_t numIds = 300;
+    std::vector<faiss::Index::idx_t> ids;
+    std::vector<float> vectors;
+    int dim = 8;
+    for (int64_t i = 0; i < numIds; i++) {
+        ids.push_back(i * 5);
+        for (int j = 0; j < dim; j++) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    // The delta encoding frees the links of the HNSW index, so graph joins have to walk the compressed graph
+    std::unique_ptr<faiss::Index> createdIndex(test_util::FaissCreateIndex(dim, "HNSW16,Flat", faiss::METRIC_L2));
+    auto createdIndexWithData = test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::CompressedHnswIndex compressedIndex(
+            dynamic_cast<faiss::IndexHNSW *>(createdIndex.get()),
+            knn_jni::compact_id_map::CompactIdMap(createdIndexWithData.id_map), false);
+
+    // Indexed vectors find themselves first
+    int k = 5;
+    std::string outputPath = test_util::RandomString(10, "tmp/", ".join");
+    knn_jni::faiss_wrapper::KnnJoinIndex(&compressedIndex, vectors.data(), numIds, k, false, 2,
+                                         knn_jni::qos::SchedulingPolicy::NORMAL, outputPath);
+    auto rows = ReadJoinResults(outputPath);
+    ASSERT_EQ(numIds, rows.size());
+    for (int i = 0; i < numIds; i++) {
+        ASSERT_EQ(i, rows[i].queryId);
+        ASSERT_EQ(ids[i], rows[i].ids[0]);
+        ASSERT_FLOAT_EQ(0, rows[i].distances[0]);
+    }
+
+    // Self joins leave each vector out of its own neighbors, and agree with the exact join on the nearest one
+    knn_jni::faiss_wrapper::SelfJoinIndex(&compressedIndex, k, true, 2, knn_jni::qos::SchedulingPolicy::NORMAL,
+                                          outputPath);
+    auto exactRows = ReadJoinResults(outputPath);
+    knn_jni::faiss_wrapper::SelfJoinIndex(&compressedIndex, k, false, 2, knn_jni::qos::SchedulingPolicy::NORMAL,
+                                          outputPath);
+    rows = ReadJoinResults(outputPath);
+    ASSERT_EQ(numIds, rows.size());
+    ASSERT_EQ(numIds, exactRows.size());
+    int matches = 0;
+    for (int i = 0; i < numIds; i++) {
+        ASSERT_EQ(ids[i], rows[i].queryId);
+        for (int j = 0; j < k; j++) {
+            ASSERT_NE(ids[i], rows[i].ids[j]);
+            ASSERT_GE(rows[i].ids[j], 0);
+            ASSERT_EQ(0, rows[i].ids[j] % 5);
+        }
+        if (rows[i].ids[0] == exactRows[i].ids[0]) {
+            matches++;
+        }
+    }
+    ASSERT_GE(matches, numIds * 9 / 10);
+
+    // Clean up
+    std::remove(outputPath.c_str());
+}
@@ -0,0 +1,143 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "faiss_recall_sampling.h"
+#include "faiss_wrapper.h"
+
+#include "faiss/IndexFlat.h"
+#include "faiss/IndexIVFFlat.h"
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "test_util.h"
+
+using ::testing::NiceMock;
+
+namespace {
+    std::vector<float> RandomVectors(int n, int dim) {
+        std::vector<float> vectors(n * dim);
+        for (auto& value : vectors) {
+            value = test_util::RandomFloat(-10, 10);
+        }
+        return vectors;
+    }
+
+    // Search every query through index and hand it to the sampler of index, as QueryIndex does
+    void SearchAndSample(const faiss::Index& index, const std::vector<float>& queries, int k) {
+        auto sampler = knn_jni::faiss_wrapper::GetRecallSampler(&index);
+        ASSERT_NE(nullptr, sampler);
+        int numQueries = (int) queries.size() / index.d;
+        std::vector<float> distances(k);
+        std::vector<faiss::Index::idx_t> labels(k);
+        for (int q = 0; q < numQueries; ++q) {
+            index.search(1, queries.data() + q * index.d, k, distances.data(), labels.data());
+            if (sampler->ShouldSample()) {
+                sampler->Sample(queries.data() + q * index.d, k, labels.data());
+                // One check at a time, so that none is dropped
+                sampler->WaitForChecks();
+            }
+        }
+    }
+}
+
+TEST(FaissRecallSamplingTest, KeepsARollingWindow) {
+    faiss::IndexFlatL2 index(4);
+    auto sampler = std::make_shared<knn_jni::faiss_wrapper::RecallSampler>(&index, 0.5);
+    ASSERT_EQ(0, sampler->GetStats().windowSamples);
+    ASSERT_DOUBLE_EQ(0, sampler->GetStats().recall);
+
+    for (size_t i = 0; i < knn_jni::faiss_wrapper::RECALL_WINDOW_SIZE; ++i) {
+        sampler->Record(1.0);
+    }
+    for (size_t i = 0; i < knn_jni::faiss_wrapper::RECALL_WINDOW_SIZE / 2; ++i) {
+        sampler->Record(0.0);
+    }
+    auto stats = sampler->GetStats();
+    ASSERT_EQ(knn_jni::faiss_wrapper::RECALL_WINDOW_SIZE, stats.windowSamples);
+    ASSERT_NEAR(0.5, stats.recall, 1e-9);
+    ASSERT_EQ(knn_jni::faiss_wrapper::RECALL_WINDOW_SIZE * 3 / 2, stats.totalSamples);
+    ASSERT_EQ(0, stats.droppedSamples);
+
+    ASSERT_THROW(sampler->SetRate(1.5), std::runtime_error);
+    ASSERT_THROW(std::make_shared<knn_jni::faiss_wrapper::RecallSampler>(&index, -0.1), std::runtime_error);
+}
+
+TEST(FaissRecallSamplingTest, MeasuresRecallOfSampledQueries) {
+    int n = 2000;
+    int dim = 8;
+    int k = 10;
+    int numQueries = 50;
+    std::vector<float> vectors = RandomVectors(n, dim);
+    std::vector<float> queries = RandomVectors(numQueries, dim);
+
+    // A flat index is exact
+    faiss::IndexFlatL2 flat(dim);
+    flat.add(n, vectors.data());
+    knn_jni::faiss_wrapper::SetRecallSampling(&flat, 1.0);
+    SearchAndSample(flat, queries, k);
+    auto stats = knn_jni::faiss_wrapper::GetRecallSampler(&flat)->GetStats();
+    ASSERT_EQ(numQueries, stats.totalSamples);
+    ASSERT_DOUBLE_EQ(1.0, stats.recall);
+
+    // Probing one list of many misses neighbors
+    faiss::IndexFlatL2 quantizer(dim);
+    faiss::IndexIVFFlat ivf(&quantizer, dim, 32);
+    ivf.train(n, vectors.data());
+    ivf.add(n, vectors.data());
+    ivf.nprobe = 1;
+    knn_jni::faiss_wrapper::SetRecallSampling(&ivf, 1.0);
+    SearchAndSample(ivf, queries, k);
+    stats = knn_jni::faiss_wrapper::GetRecallSampler(&ivf)->GetStats();
+    ASSERT_EQ(numQueries, stats.windowSamples);
+    ASSERT_GT(stats.recall, 0.0);
+    ASSERT_LT(stats.recall, 1.0);
+
+    // Once removed, a sampler ignores new samples and the index has none
+    auto sampler = knn_jni::faiss_wrapper::GetRecallSampler(&ivf);
+    knn_jni::faiss_wrapper::RemoveRecallSampler(&ivf);
+    ASSERT_EQ(nullptr, knn_jni::faiss_wrapper::GetRecallSampler(&ivf));
+    std::vector<faiss::Index::idx_t> labels(k, 0);
+    sampler->Sample(queries.data(), k, labels.data());
+    sampler->WaitForChecks();
+    ASSERT_EQ(numQueries, sampler->GetStats().totalSamples);
+
+    // A rate of 0 stops sampling
+    knn_jni::faiss_wrapper::SetRecallSampling(&flat, 0);
+    ASSERT_EQ(nullptr, knn_jni::faiss_wrapper::GetRecallSampler(&flat));
+}
+
+TEST(FaissRecallSamplingTest, ReturnsStatsToJava) {
+    int dim = 4;
+    faiss::IndexFlatL2 flat(dim);
+    std::vector<float> vectors = RandomVectors(100, dim);
+    flat.add(100, vectors.data());
+
+    JNIEnv *jniEnv = nullptr;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+    auto indexPointer = reinterpret_cast<jlong>(&flat);
+
+    std::unique_ptr<std::vector<float>> stats(reinterpret_cast<std::vector<float> *>(
+            knn_jni::faiss_wrapper::GetRecallStats(&mockJNIUtil, jniEnv, indexPointer)));
+    ASSERT_EQ((std::vector<float>{0, 0, 0, 0}), *stats);
+
+    knn_jni::faiss_wrapper::SetRecallSampling(indexPointer, 1.0f);
+    knn_jni::faiss_wrapper::GetRecallSampler(&flat)->Record(0.75);
+    stats.reset(reinterpret_cast<std::vector<float> *>(
+            knn_jni::faiss_wrapper::GetRecallStats(&mockJNIUtil, jniEnv, indexPointer)));
+    ASSERT_EQ((std::vector<float>{1, 0.75f, 1, 0}), *stats);
+
+    EXPECT_THROW(knn_jni::faiss_wrapper::SetRecallSampling(indexPointer, 2.0f), std::runtime_error);
+    knn_jni::faiss_wrapper::RemoveRecallSampler(&flat);
+}
@@ -10,7 +10,14 @@
  */
 
 #include "faiss_wrapper.h"
+#include "faiss_compact_id_map_index.h"
 
+#include "faiss/IndexHNSW.h"
+#include "faiss/IndexIVF.h"
+#include "faiss/IndexPreTransform.h"
+
+#include <algorithm>
+#include <numeric>
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -68,6 +75,259 @@ TEST(FaissCreateIndexTest, BasicAssertions) {
     std::remove(indexPath.c_str());
 }
 
+TEST(FaissCreateIndexFromFlatVectorsTest, BasicAssertions) {
+    // Define the data
+    faiss::Index::idx_t numIds = 200;
+    std::vector<faiss::Index::idx_t> ids;
+    std::vector<float> vectors;
+    int dim = 2;
+    for (int64_t i = 0; i < numIds; ++i) {
+        ids.push_back(i);
+        for (int j = 0; j < dim; ++j) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    std::string indexPath = test_util::RandomString(10, "tmp/", ".faiss");
+    std::string spaceType = knn_jni::L2;
+    std::string index_description = "Flat";
+
+    std::unordered_map<std::string, jobject> parametersMap;
+    parametersMap[knn_jni::SPACE_TYPE] = (jobject)&spaceType;
+    parametersMap[knn_jni::INDEX_DESCRIPTION] = (jobject)&index_description;
+
+    // Set up jni
+    JNIEnv *jniEnv = nullptr;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    EXPECT_CALL(mockJNIUtil,
+                GetJavaIntArrayLength(jniEnv, reinterpret_cast<jintArray>(&ids)))
+            .WillRepeatedly(Return(ids.size()));
+
+    // Create the index
+    knn_jni::faiss_wrapper::CreateIndexFromFlatVectors(
+            &mockJNIUtil, jniEnv, reinterpret_cast<jintArray>(&ids),
+            (jobject)&vectors, dim, (jstring)&indexPath,
+            (jobject)&parametersMap);
+
+    // Make sure index can be loaded and holds every vector
+    std::unique_ptr<faiss::Index> index(test_util::FaissLoadIndex(indexPath));
+    ASSERT_EQ(numIds, index->ntotal);
+    ASSERT_EQ(dim, index->d);
+
+    // A mismatch between ids and vectors is rejected
+    std::vector<float> shortVectors(vectors.begin(), vectors.end() - dim);
+    ASSERT_THROW(knn_jni::faiss_wrapper::CreateIndexFromFlatVectors(
+            &mockJNIUtil, jniEnv, reinterpret_cast<jintArray>(&ids),
+            (jobject)&shortVectors, dim, (jstring)&indexPath,
+            (jobject)&parametersMap), std::runtime_error);
+
+    // Clean up
+    std::remove(indexPath.c_str());
+}
+
+TEST(FaissCreateIndexWithGraphReorderTest, BasicAssertions) {
+    // Define the data
+    faiss::Index::idx_t numIds = 200;
+    std::vector<faiss::Index::idx_t> ids;
+    std::vector<float> vectors;
+    int dim = 8;
+    for (int64_t i = 0; i < numIds; ++i) {
+        ids.push_back(i);
+        for (int j = 0; j < dim; ++j) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    std::string indexPath = test_util::RandomString(10, "tmp/", ".faiss");
+    std::string spaceType = knn_jni::L2;
+
+    // Set up jni
+    JNIEnv *jniEnv = nullptr;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    EXPECT_CALL(mockJNIUtil,
+                GetJavaIntArrayLength(jniEnv, reinterpret_cast<jintArray>(&ids)))
+            .WillRepeatedly(Return(ids.size()));
+
+    auto build = [&](std::string description, std::string strategy) {
+        std::unordered_map<std::string, jobject> subParametersMap;
+        subParametersMap[knn_jni::GRAPH_REORDER] = (jobject)&strategy;
+        std::unordered_map<std::string, jobject> parametersMap;
+        parametersMap[knn_jni::SPACE_TYPE] = (jobject)&spaceType;
+        parametersMap[knn_jni::INDEX_DESCRIPTION] = (jobject)&description;
+        parametersMap[knn_jni::PARAMETERS] = (jobject)&subParametersMap;
+        knn_jni::faiss_wrapper::CreateIndexFromFlatVectors(
+                &mockJNIUtil, jniEnv, reinterpret_cast<jintArray>(&ids),
+                (jobject)&vectors, dim, (jstring)&indexPath,
+                (jobject)&parametersMap);
+    };
+
+    // Reordering an HNSW graph over flat storage keeps every vector
+    build("HNSW16,Flat", "rcm");
+    std::unique_ptr<faiss::Index> index(test_util::FaissLoadIndex(indexPath));
+    ASSERT_EQ(numIds, index->ntotal);
+
+    // Strategies faiss cannot apply are rejected instead of skipped
+    ASSERT_THROW(build("HNSW16,Flat", "locality"), std::runtime_error);
+    ASSERT_THROW(build("HNSW16,SQfp16", "bfs"), std::runtime_error);
+    ASSERT_THROW(build("Flat", "bfs"), std::runtime_error);
+
+    // Clean up
+    std::remove(indexPath.c_str());
+}
+
+TEST(FaissCreateIndexFromHalfVectorsTest, BasicAssertions) {
+    // Define the data, already rounded to fp16
+    faiss::Index::idx_t numIds = 200;
+    std::vector<faiss::Index::idx_t> ids;
+    std::vector<uint16_t> vectors;
+    int dim = 8;
+    for (int64_t i = 0; i < numIds; ++i) {
+        ids.push_back(i);
+        for (int j = 0; j < dim; ++j) {
+            vectors.push_back(knn_jni::half_precision::FloatToFp16(test_util::RandomFloat(-500.0, 500.0)));
+        }
+    }
+
+    std::string indexPath = test_util::RandomString(10, "tmp/", ".faiss");
+    std::string spaceType = knn_jni::L2;
+    std::string index_description = "HNSW32,SQfp16";
+    std::string encoding = "fp16";
+
+    std::unordered_map<std::string, jobject> parametersMap;
+    parametersMap[knn_jni::SPACE_TYPE] = (jobject)&spaceType;
+    parametersMap[knn_jni::INDEX_DESCRIPTION] = (jobject)&index_description;
+
+    // Set up jni
+    JNIEnv *jniEnv = nullptr;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    EXPECT_CALL(mockJNIUtil,
+                GetJavaIntArrayLength(jniEnv, reinterpret_cast<jintArray>(&ids)))
+            .WillRepeatedly(Return(ids.size()));
+
+    // Create the index
+    knn_jni::faiss_wrapper::CreateIndexFromHalfVectors(
+            &mockJNIUtil, jniEnv, reinterpret_cast<jintArray>(&ids),
+            (jobject)&vectors, dim, (jstring)&encoding, (jstring)&indexPath,
+            (jobject)&parametersMap);
+
+    // Make sure index can be loaded and holds every vector
+    std::unique_ptr<faiss::Index> index(test_util::FaissLoadIndex(indexPath));
+    ASSERT_EQ(numIds, index->ntotal);
+    ASSERT_EQ(dim, index->d);
+
+    // fp16 storage is exact for fp16 input, so a stored vector finds itself first
+    int k = 5;
+    std::vector<uint16_t> query(vectors.begin() + 7 * dim, vectors.begin() + 8 * dim);
+    std::unique_ptr<std::vector<std::pair<int, float> *>> results(
+            reinterpret_cast<std::vector<std::pair<int, float> *> *>(
+                    knn_jni::faiss_wrapper::QueryIndexWithHalfVector(
+                            &mockJNIUtil, jniEnv, reinterpret_cast<jlong>(index.get()),
+                            reinterpret_cast<jshortArray>(&query), (jstring)&encoding, k)));
+    ASSERT_EQ(k, results->size());
+    ASSERT_EQ(7, results->at(0)->first);
+    ASSERT_FLOAT_EQ(0, results->at(0)->second);
+    for (auto it : *results.get()) {
+        delete it;
+    }
+
+    // A query of another length is rejected instead of read past its end
+    std::vector<uint16_t> shortQuery(query.begin(), query.end() - 1);
+    ASSERT_THROW(knn_jni::faiss_wrapper::QueryIndexWithHalfVector(
+            &mockJNIUtil, jniEnv, reinterpret_cast<jlong>(index.get()),
+            reinterpret_cast<jshortArray>(&shortQuery), (jstring)&encoding, k), std::runtime_error);
+
+    // Unknown encodings are rejected
+    std::string badEncoding = "fp8";
+    ASSERT_THROW(knn_jni::faiss_wrapper::CreateIndexFromHalfVectors(
+            &mockJNIUtil, jniEnv, reinterpret_cast<jintArray>(&ids),
+            (jobject)&vectors, dim, (jstring)&badEncoding, (jstring)&indexPath,
+            (jobject)&parametersMap), std::runtime_error);
+
+    // Clean up
+    std::remove(indexPath.c_str());
+}
+
+TEST(FaissCreateIndexFromByteVectorsTest, BasicAssertions) {
+    // Define the data
+    faiss::Index::idx_t numIds = 200;
+    std::vector<faiss::Index::idx_t> ids;
+    std::vector<int8_t> vectors;
+    int dim = 8;
+    for (int64_t i = 0; i < numIds; ++i) {
+        ids.push_back(i);
+        for (int j = 0; j < dim; ++j) {
+            vectors.push_back((int8_t) test_util::RandomFloat(-128.0, 127.0));
+        }
+    }
+
+    std::string indexPath = test_util::RandomString(10, "tmp/", ".faiss");
+    std::string spaceType = knn_jni::L2;
+
+    // Set up jni
+    JNIEnv *jniEnv = nullptr;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    EXPECT_CALL(mockJNIUtil,
+                GetJavaIntArrayLength(jniEnv, reinterpret_cast<jintArray>(&ids)))
+            .WillRepeatedly(Return(ids.size()));
+
+    // 8 bit scalar quantizers need no training for int8 input, and keep every value exactly
+    for (std::string index_description : {"SQ8", "HNSW32,SQ8"}) {
+        std::unordered_map<std::string, jobject> parametersMap;
+        parametersMap[knn_jni::SPACE_TYPE] = (jobject)&spaceType;
+        parametersMap[knn_jni::INDEX_DESCRIPTION] = (jobject)&index_description;
+
+        knn_jni::faiss_wrapper::CreateIndexFromByteVectors(
+                &mockJNIUtil, jniEnv, reinterpret_cast<jintArray>(&ids),
+                (jobject)&vectors, dim, (jstring)&indexPath,
+                (jobject)&parametersMap);
+
+        std::unique_ptr<faiss::Index> index(test_util::FaissLoadIndex(indexPath));
+        ASSERT_EQ(numIds, index->ntotal);
+        ASSERT_EQ(dim, index->d);
+
+        int k = 5;
+        std::vector<int8_t> query(vectors.begin() + 11 * dim, vectors.begin() + 12 * dim);
+        std::unique_ptr<std::vector<std::pair<int, float> *>> results(
+                reinterpret_cast<std::vector<std::pair<int, float> *> *>(
+                        knn_jni::faiss_wrapper::QueryIndexWithByteVector(
+                                &mockJNIUtil, jniEnv, reinterpret_cast<jlong>(index.get()),
+                                reinterpret_cast<jbyteArray>(&query), k)));
+        ASSERT_EQ(k, results->size());
+        ASSERT_EQ(11, results->at(0)->first);
+        ASSERT_FLOAT_EQ(0, results->at(0)->second);
+        for (auto it : *results.get()) {
+            delete it;
+        }
+
+        // Queries of another length are rejected instead of read past their end or truncated
+        std::vector<int8_t> shortQuery(query.begin(), query.end() - 1);
+        ASSERT_THROW(knn_jni::faiss_wrapper::QueryIndexWithByteVector(
+                &mockJNIUtil, jniEnv, reinterpret_cast<jlong>(index.get()),
+                reinterpret_cast<jbyteArray>(&shortQuery), k), std::runtime_error);
+        std::vector<int8_t> longQuery(query);
+        longQuery.push_back(1);
+        ASSERT_THROW(knn_jni::faiss_wrapper::QueryIndexWithByteVector(
+                &mockJNIUtil, jniEnv, reinterpret_cast<jlong>(index.get()),
+                reinterpret_cast<jbyteArray>(&longQuery), k), std::runtime_error);
+
+        std::remove(indexPath.c_str());
+    }
+
+    // Quantizers that still need training are left alone
+    std::string index_description = "IVF4,SQ8";
+    std::unordered_map<std::string, jobject> parametersMap;
+    parametersMap[knn_jni::SPACE_TYPE] = (jobject)&spaceType;
+    parametersMap[knn_jni::INDEX_DESCRIPTION] = (jobject)&index_description;
+    ASSERT_THROW(knn_jni::faiss_wrapper::CreateIndexFromByteVectors(
+            &mockJNIUtil, jniEnv, reinterpret_cast<jintArray>(&ids),
+            (jobject)&vectors, dim, (jstring)&indexPath,
+            (jobject)&parametersMap), std::runtime_error);
+}
+
 TEST(FaissCreateIndexFromTemplateTest, BasicAssertions) {
     // Define the data
     faiss::Index::idx_t numIds = 100;
@@ -151,13 +411,17 @@ TEST(FaissLoadIndexTest, BasicAssertions) {
 
     std::unique_ptr<faiss::Index> loadedIndexPointer(
             reinterpret_cast<faiss::Index *>(knn_jni::faiss_wrapper::LoadIndex(
-                    &mockJNIUtil, jniEnv, (jstring)&indexPath)));
+                    &mockJNIUtil, jniEnv, (jstring)&indexPath, nullptr)));
+
+    // The id map is loaded in compact form. Compare it and the serialized versions of the index it wraps
+    auto *loadedCompactIndex = dynamic_cast<knn_jni::faiss_wrapper::CompactIdMapIndex *>(loadedIndexPointer.get());
+    ASSERT_NE(nullptr, loadedCompactIndex);
+    ASSERT_EQ(createdIndexWithData.id_map, loadedCompactIndex->GetIds().ToVector());
 
-    // Compare serialized versions
     auto createIndexSerialization =
-            test_util::FaissGetSerializedIndex(&createdIndexWithData);
+            test_util::FaissGetSerializedIndex(createdIndex.get());
     auto loadedIndexSerialization = test_util::FaissGetSerializedIndex(
-            reinterpret_cast<faiss::Index *>(loadedIndexPointer.get()));
+            loadedCompactIndex->GetIndex());
 
     ASSERT_NE(0, loadedIndexSerialization.data.size());
     ASSERT_EQ(createIndexSerialization.data.size(),
@@ -168,6 +432,129 @@ TEST(FaissLoadIndexTest, BasicAssertions) {
                   loadedIndexSerialization.data[i]);
     }
 
+    ASSERT_EQ(knn_jni::faiss_wrapper::EarlyTermination::NONE, loadedCompactIndex->GetEarlyTermination());
+
+    // Early termination is a load time setting
+    std::string adaptive = knn_jni::EARLY_TERMINATION_ADAPTIVE;
+    std::unordered_map<std::string, jobject> loadParameters = {{knn_jni::EARLY_TERMINATION, (jobject) &adaptive}};
+    std::unique_ptr<faiss::Index> adaptiveIndexPointer(
+            reinterpret_cast<faiss::Index *>(knn_jni::faiss_wrapper::LoadIndex(
+                    &mockJNIUtil, jniEnv, (jstring)&indexPath, (jobject) &loadParameters)));
+    auto *adaptiveIndex = dynamic_cast<knn_jni::faiss_wrapper::CompactIdMapIndex *>(adaptiveIndexPointer.get());
+    ASSERT_NE(nullptr, adaptiveIndex);
+    ASSERT_EQ(knn_jni::faiss_wrapper::EarlyTermination::ADAPTIVE, adaptiveIndex->GetEarlyTermination());
+
+    std::string invalid = "always";
+    loadParameters[knn_jni::EARLY_TERMINATION] = (jobject) &invalid;
+    ASSERT_THROW(knn_jni::faiss_wrapper::LoadIndex(&mockJNIUtil, jniEnv, (jstring)&indexPath,
+                                                   (jobject) &loadParameters), std::runtime_error);
+
+    // Clean up
+    std::remove(indexPath.c_str());
+}
+
+TEST(FaissLoadIndexWithIdentityIdsTest, BasicAssertions) {
+    // Define the data, with doc ids that match the positions
+    faiss::Index::idx_t numIds = 200;
+    std::vector<faiss::Index::idx_t> ids;
+    std::vector<float> vectors;
+    int dim = 2;
+    for (int64_t i = 0; i < numIds; ++i) {
+        ids.push_back(i);
+        for (int j = 0; j < dim; ++j) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    std::string indexPath = test_util::RandomString(10, "tmp/", ".faiss");
+    std::string spaceType = knn_jni::L2;
+    std::string index_description = "HNSW16,Flat";
+
+    std::unordered_map<std::string, jobject> parametersMap;
+    parametersMap[knn_jni::SPACE_TYPE] = (jobject)&spaceType;
+    parametersMap[knn_jni::INDEX_DESCRIPTION] = (jobject)&index_description;
+
+    // Set up jni
+    JNIEnv *jniEnv = nullptr;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    EXPECT_CALL(mockJNIUtil,
+                GetJavaIntArrayLength(jniEnv, reinterpret_cast<jintArray>(&ids)))
+            .WillRepeatedly(Return(ids.size()));
+
+    knn_jni::faiss_wrapper::CreateIndexFromFlatVectors(
+            &mockJNIUtil, jniEnv, reinterpret_cast<jintArray>(&ids),
+            (jobject)&vectors, dim, (jstring)&indexPath,
+            (jobject)&parametersMap);
+
+    // The index loads behind an identity id map, not as the bare HNSW index
+    std::unique_ptr<faiss::Index> loadedIndex(
+            reinterpret_cast<faiss::Index *>(knn_jni::faiss_wrapper::LoadIndex(
+                    &mockJNIUtil, jniEnv, (jstring)&indexPath, nullptr)));
+    auto *compactIndex = dynamic_cast<knn_jni::faiss_wrapper::CompactIdMapIndex *>(loadedIndex.get());
+    ASSERT_NE(nullptr, compactIndex);
+    ASSERT_TRUE(compactIndex->GetIds().IsIdentity());
+    ASSERT_EQ(0, compactIndex->GetIds().MemoryUsage());
+    ASSERT_NE(nullptr, dynamic_cast<faiss::IndexHNSW *>(compactIndex->GetIndex()));
+
+    int k = 5;
+    std::vector<float> query(vectors.begin() + 42 * dim, vectors.begin() + 43 * dim);
+    std::unique_ptr<std::vector<std::pair<int, float> *>> results(
+            reinterpret_cast<std::vector<std::pair<int, float> *> *>(
+                    knn_jni::faiss_wrapper::QueryIndex(
+                            &mockJNIUtil, jniEnv, reinterpret_cast<jlong>(loadedIndex.get()),
+                            reinterpret_cast<jfloatArray>(&query), k)));
+    ASSERT_EQ(k, results->size());
+    ASSERT_EQ(42, results->at(0)->first);
+    for (auto it : *results.get()) {
+        delete it;
+    }
+
+    // Adaptive early termination applies to it like to any other loaded index
+    std::string adaptive = knn_jni::EARLY_TERMINATION_ADAPTIVE;
+    std::unordered_map<std::string, jobject> loadParameters = {{knn_jni::EARLY_TERMINATION, (jobject) &adaptive}};
+    std::unique_ptr<faiss::Index> adaptiveIndex(
+            reinterpret_cast<faiss::Index *>(knn_jni::faiss_wrapper::LoadIndex(
+                    &mockJNIUtil, jniEnv, (jstring)&indexPath, (jobject) &loadParameters)));
+    auto *adaptiveCompactIndex = dynamic_cast<knn_jni::faiss_wrapper::CompactIdMapIndex *>(adaptiveIndex.get());
+    ASSERT_NE(nullptr, adaptiveCompactIndex);
+    ASSERT_TRUE(adaptiveCompactIndex->GetIds().IsIdentity());
+    ASSERT_EQ(knn_jni::faiss_wrapper::EarlyTermination::ADAPTIVE, adaptiveCompactIndex->GetEarlyTermination());
+    results.reset(reinterpret_cast<std::vector<std::pair<int, float> *> *>(
+            knn_jni::faiss_wrapper::QueryIndex(
+                    &mockJNIUtil, jniEnv, reinterpret_cast<jlong>(adaptiveIndex.get()),
+                    reinterpret_cast<jfloatArray>(&query), k)));
+    ASSERT_EQ(k, results->size());
+    ASSERT_EQ(42, results->at(0)->first);
+    for (auto it : *results.get()) {
+        delete it;
+    }
+
+    // Other doc ids load back as 32 bit ids
+    std::vector<faiss::Index::idx_t> sparseIds;
+    for (int64_t i = 0; i < numIds; ++i) {
+        sparseIds.push_back(i * 5 + 1);
+    }
+    EXPECT_CALL(mockJNIUtil,
+                GetJavaIntArrayLength(jniEnv, reinterpret_cast<jintArray>(&sparseIds)))
+            .WillRepeatedly(Return(sparseIds.size()));
+    knn_jni::faiss_wrapper::CreateIndexFromFlatVectors(
+            &mockJNIUtil, jniEnv, reinterpret_cast<jintArray>(&sparseIds),
+            (jobject)&vectors, dim, (jstring)&indexPath,
+            (jobject)&parametersMap);
+    loadedIndex.reset(reinterpret_cast<faiss::Index *>(knn_jni::faiss_wrapper::LoadIndex(
+            &mockJNIUtil, jniEnv, (jstring)&indexPath, nullptr)));
+    compactIndex = dynamic_cast<knn_jni::faiss_wrapper::CompactIdMapIndex *>(loadedIndex.get());
+    ASSERT_NE(nullptr, compactIndex);
+    ASSERT_EQ(sparseIds, compactIndex->GetIds().ToVector());
+    ASSERT_EQ(numIds * sizeof(int32_t), compactIndex->GetIds().MemoryUsage());
+
+    // Ids are only compacted on load: the file itself stays a faiss id map that faiss reads as it is
+    std::unique_ptr<faiss::Index> faissIndex(test_util::FaissLoadIndex(indexPath));
+    auto *idMap = dynamic_cast<faiss::IndexIDMap *>(faissIndex.get());
+    ASSERT_NE(nullptr, idMap);
+    ASSERT_EQ(sparseIds, idMap->id_map);
+
     // Clean up
     std::remove(indexPath.c_str());
 }
@@ -229,6 +616,45 @@ TEST(FaissQueryIndexTest, BasicAssertions) {
     }
 }
 
+TEST(FaissQueryIndexWithLiveDocsTest, BasicAssertions) {
+    // Define the index data
+    faiss::Index::idx_t numIds = 100;
+    std::vector<faiss::Index::idx_t> ids;
+    std::vector<float> vectors;
+    int dim = 16;
+    for (int64_t i = 0; i < numIds; i++) {
+        ids.push_back(i);
+        for (int j = 0; j < dim; j++) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    // Every other doc is deleted
+    std::vector<int64_t> liveDocs(2, 0x5555555555555555ll);
+
+    std::unique_ptr<faiss::Index> createdIndex(test_util::FaissCreateIndex(dim, "Flat", faiss::METRIC_L2));
+    auto createdIndexWithData = test_util::FaissAddData(createdIndex.get(), ids, vectors);
+
+    // Setup jni
+    JNIEnv *jniEnv = nullptr;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    int k = 10;
+    std::vector<float> query(vectors.begin() + dim, vectors.begin() + 2 * dim);
+    std::unique_ptr<std::vector<std::pair<int, float> *>> results(
+            reinterpret_cast<std::vector<std::pair<int, float> *> *>(
+                    knn_jni::faiss_wrapper::QueryIndexWithLiveDocs(
+                            &mockJNIUtil, jniEnv, reinterpret_cast<jlong>(&createdIndexWithData),
+                            reinterpret_cast<jfloatArray>(&query), k, reinterpret_cast<jlongArray>(&liveDocs))));
+
+    // The query is the vector of deleted doc 1, which is not returned, yet k live docs are
+    ASSERT_EQ(k, results->size());
+    for (auto it : *results.get()) {
+        ASSERT_EQ(0, it->first % 2);
+        delete it;
+    }
+}
+
 TEST(FaissFreeTest, BasicAssertions) {
     // Define the data
     int dim = 2;
@@ -284,3 +710,169 @@ TEST(FaissTrainIndexTest, BasicAssertions) {
     // Confirm that training succeeded
     ASSERT_TRUE(trainedIndex->is_trained);
 }
+
+TEST(FaissTrainIndexWithPreTransformTest, BasicAssertions) {
+    int dim = 16;
+    std::string spaceType = knn_jni::L2;
+    int nprobes = 3;
+    std::unordered_map<std::string, jobject> subParametersMap;
+    subParametersMap[knn_jni::NPROBES] = (jobject) &nprobes;
+
+    int numTrainingVectors = 1000;
+    std::vector<float> trainingVectors;
+    for (int i = 0; i < numTrainingVectors * dim; ++i) {
+        trainingVectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+    }
+
+    JNIEnv *jniEnv = nullptr;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    // Rotation into the same dimension and reduction to half of it, both ahead of an IVF index
+    for (std::string indexDescription : {"OPQ4_16,IVF4,PQ4", "PCA8,IVF4,Flat"}) {
+        std::unordered_map<std::string, jobject> parametersMap;
+        parametersMap[knn_jni::SPACE_TYPE] = (jobject) &spaceType;
+        parametersMap[knn_jni::INDEX_DESCRIPTION] = (jobject) &indexDescription;
+        parametersMap[knn_jni::PARAMETERS] = (jobject) &subParametersMap;
+
+        std::unique_ptr<std::vector<uint8_t>> trainedIndexSerialization(
+                reinterpret_cast<std::vector<uint8_t> *>(
+                        knn_jni::faiss_wrapper::TrainIndex(
+                                &mockJNIUtil, jniEnv, (jobject) &parametersMap, dim,
+                                reinterpret_cast<jlong>(&trainingVectors))));
+
+        std::unique_ptr<faiss::Index> trainedIndex(
+                test_util::FaissLoadFromSerializedIndex(trainedIndexSerialization.get()));
+        ASSERT_TRUE(trainedIndex->is_trained);
+
+        // The transforms and the index behind them are trained, and the parameters reached the IVF index
+        auto * indexPreTransform = dynamic_cast<faiss::IndexPreTransform *>(trainedIndex.get());
+        ASSERT_NE(nullptr, indexPreTransform);
+        for (auto * transform : indexPreTransform->chain) {
+            ASSERT_TRUE(transform->is_trained);
+        }
+        auto * indexIvf = dynamic_cast<faiss::IndexIVF *>(indexPreTransform->index);
+        ASSERT_NE(nullptr, indexIvf);
+        ASSERT_TRUE(indexIvf->is_trained);
+        ASSERT_EQ(nprobes, (int) indexIvf->nprobe);
+    }
+}
+
+TEST(FaissTrainIndexWithBalancedClusteringTest, BasicAssertions) {
+    int dim = 8;
+    int nlist = 8;
+    std::string spaceType = knn_jni::L2;
+    std::string indexDescription = "IVF8,Flat";
+    std::string clustering = knn_jni::CLUSTERING_BALANCED;
+    std::unordered_map<std::string, jobject> subParametersMap;
+    subParametersMap[knn_jni::CLUSTERING] = (jobject) &clustering;
+
+    std::unordered_map<std::string, jobject> parametersMap;
+    parametersMap[knn_jni::SPACE_TYPE] = (jobject) &spaceType;
+    parametersMap[knn_jni::INDEX_DESCRIPTION] = (jobject) &indexDescription;
+    parametersMap[knn_jni::PARAMETERS] = (jobject) &subParametersMap;
+
+    int numTrainingVectors = 1000;
+    std::vector<float> trainingVectors;
+    for (int i = 0; i < numTrainingVectors * dim; ++i) {
+        trainingVectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+    }
+
+    JNIEnv *jniEnv = nullptr;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    std::unique_ptr<std::vector<uint8_t>> trainedIndexSerialization(
+            reinterpret_cast<std::vector<uint8_t> *>(
+                    knn_jni::faiss_wrapper::TrainIndex(
+                            &mockJNIUtil, jniEnv, (jobject) &parametersMap, dim,
+                            reinterpret_cast<jlong>(&trainingVectors))));
+
+    std::unique_ptr<faiss::Index> trainedIndex(
+            test_util::FaissLoadFromSerializedIndex(trainedIndexSerialization.get()));
+    ASSERT_TRUE(trainedIndex->is_trained);
+
+    // Every training vector lands in exactly one list
+    std::unique_ptr<std::vector<int32_t>> listSizes(
+            reinterpret_cast<std::vector<int32_t> *>(
+                    knn_jni::faiss_wrapper::ListSizes(
+                            &mockJNIUtil, jniEnv, reinterpret_cast<jbyteArray>(trainedIndexSerialization.get()),
+                            reinterpret_cast<jlong>(&trainingVectors))));
+    ASSERT_EQ(nlist, (int) listSizes->size());
+    ASSERT_EQ(numTrainingVectors, std::accumulate(listSizes->begin(), listSizes->end(), 0));
+    EXPECT_THROW(knn_jni::faiss_wrapper::ListSizes(&mockJNIUtil, jniEnv, nullptr,
+                                                   reinterpret_cast<jlong>(&trainingVectors)),
+                 std::runtime_error);
+    EXPECT_THROW(knn_jni::faiss_wrapper::ListSizes(
+                         &mockJNIUtil, jniEnv, reinterpret_cast<jbyteArray>(trainedIndexSerialization.get()), 0),
+                 std::runtime_error);
+
+    // Unknown clustering methods are rejected
+    clustering = "spectral";
+    EXPECT_THROW(knn_jni::faiss_wrapper::TrainIndex(&mockJNIUtil, jniEnv, (jobject) &parametersMap, dim,
+                                                    reinterpret_cast<jlong>(&trainingVectors)),
+                 std::runtime_error);
+
+    // Missing arguments are rejected before the training vectors are read
+    EXPECT_THROW(knn_jni::faiss_wrapper::TrainIndex(&mockJNIUtil, jniEnv, nullptr, dim,
+                                                    reinterpret_cast<jlong>(&trainingVectors)),
+                 std::runtime_error);
+    EXPECT_THROW(knn_jni::faiss_wrapper::TrainIndex(&mockJNIUtil, jniEnv, (jobject) &parametersMap, dim, 0),
+                 std::runtime_error);
+    EXPECT_THROW(knn_jni::faiss_wrapper::TrainIndex(&mockJNIUtil, jniEnv, (jobject) &parametersMap, 0,
+                                                    reinterpret_cast<jlong>(&trainingVectors)),
+                 std::runtime_error);
+}
+
+TEST(FaissCalibrateTemplateTest, BasicAssertions) {
+    int dim = 8;
+    int k = 10;
+    std::string spaceType = knn_jni::L2;
+    std::string indexDescription = "IVF16,Flat";
+    std::unordered_map<std::string, jobject> parametersMap;
+    parametersMap[knn_jni::SPACE_TYPE] = (jobject) &spaceType;
+    parametersMap[knn_jni::INDEX_DESCRIPTION] = (jobject) &indexDescription;
+
+    int numTrainingVectors = 2000;
+    std::vector<float> trainingVectors;
+    for (int i = 0; i < numTrainingVectors * dim; ++i) {
+        trainingVectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+    }
+    std::vector<float> queryVectors(trainingVectors.begin(), trainingVectors.begin() + 20 * dim);
+
+    JNIEnv *jniEnv = nullptr;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    std::unique_ptr<std::vector<uint8_t>> trainedIndexSerialization(
+            reinterpret_cast<std::vector<uint8_t> *>(
+                    knn_jni::faiss_wrapper::TrainIndex(
+                            &mockJNIUtil, jniEnv, (jobject) &parametersMap, dim,
+                            reinterpret_cast<jlong>(&trainingVectors))));
+
+    // The recommended setting comes first, followed by the frontier, as (nprobe, recall, latency) triples
+    std::unique_ptr<std::vector<float>> calibration(
+            reinterpret_cast<std::vector<float> *>(
+                    knn_jni::faiss_wrapper::CalibrateTemplate(
+                            &mockJNIUtil, jniEnv, reinterpret_cast<jbyteArray>(trainedIndexSerialization.get()),
+                            reinterpret_cast<jlong>(&trainingVectors), reinterpret_cast<jlong>(&queryVectors), k,
+                            0.9f)));
+    ASSERT_EQ(0, calibration->size() % 3);
+    ASSERT_GE(calibration->size(), 6);
+    ASSERT_GE((*calibration)[1], 0.9f);
+
+    float bestRecall = 0;
+    bool recommendedOnFrontier = false;
+    for (size_t i = 3; i < calibration->size(); i += 3) {
+        ASSERT_GE((*calibration)[i], 1.0f);
+        ASSERT_LE((*calibration)[i], 16.0f);
+        bestRecall = std::max(bestRecall, (*calibration)[i + 1]);
+        recommendedOnFrontier |= (*calibration)[i] == (*calibration)[0];
+    }
+    ASSERT_FLOAT_EQ(1.0f, bestRecall);
+    ASSERT_TRUE(recommendedOnFrontier);
+
+    std::vector<float> misshapenQueries(dim + 1);
+    EXPECT_THROW(knn_jni::faiss_wrapper::CalibrateTemplate(
+                         &mockJNIUtil, jniEnv, reinterpret_cast<jbyteArray>(trainedIndexSerialization.get()),
+                         reinterpret_cast<jlong>(&trainingVectors), reinterpret_cast<jlong>(&misshapenQueries), k,
+                         0.9f),
+                 std::runtime_error);
+}
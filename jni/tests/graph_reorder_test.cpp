@@ -0,0 +1,128 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "graph_reorder.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_util.h"
+
+using knn_jni::graph_reorder::ReorderStrategy;
+
+namespace {
+    // Path graph 0 - 1 - ... - 9 whose node ids are shuffled, plus an isolated node 10. Each node has 3 slots, unused
+    // ones padded with -1 like faiss does.
+    void MakeShuffledPath(std::vector<int64_t>& offsets, std::vector<int32_t>& adjacency, std::vector<int32_t>& path) {
+        path = {7, 2, 9, 0, 5, 3, 8, 1, 6, 4};
+        int numNodes = 11;
+        std::vector<std::vector<int32_t>> neighbors(numNodes);
+        for (size_t i = 0; i + 1 < path.size(); ++i) {
+            neighbors[path[i]].push_back(path[i + 1]);
+            neighbors[path[i + 1]].push_back(path[i]);
+        }
+
+        offsets.clear();
+        adjacency.clear();
+        for (int i = 0; i < numNodes; ++i) {
+            offsets.push_back(adjacency.size());
+            for (int j = 0; j < 3; ++j) {
+                adjacency.push_back(j < (int) neighbors[i].size() ? neighbors[i][j] : -1);
+            }
+        }
+        offsets.push_back(adjacency.size());
+    }
+
+    void AssertIsPermutation(const std::vector<int32_t>& order, size_t size) {
+        ASSERT_EQ(size, order.size());
+        std::vector<int32_t> sorted(order);
+        std::sort(sorted.begin(), sorted.end());
+        for (size_t i = 0; i < size; ++i) {
+            ASSERT_EQ((int32_t) i, sorted[i]);
+        }
+    }
+}
+
+TEST(GraphReorderParseStrategyTest, BasicAssertions) {
+    ASSERT_EQ(ReorderStrategy::NONE, knn_jni::graph_reorder::ParseReorderStrategy("none"));
+    ASSERT_EQ(ReorderStrategy::BFS, knn_jni::graph_reorder::ParseReorderStrategy("bfs"));
+    ASSERT_EQ(ReorderStrategy::RCM, knn_jni::graph_reorder::ParseReorderStrategy("rcm"));
+    ASSERT_EQ(ReorderStrategy::LOCALITY, knn_jni::graph_reorder::ParseReorderStrategy("locality"));
+    ASSERT_THROW(knn_jni::graph_reorder::ParseReorderStrategy("gorder"), std::runtime_error);
+}
+
+TEST(GraphReorderComputeOrderTest, BasicAssertions) {
+    std::vector<int64_t> offsets;
+    std::vector<int32_t> adjacency;
+    std::vector<int32_t> path;
+    MakeShuffledPath(offsets, adjacency, path);
+
+    // No reordering keeps the identity
+    auto identity = knn_jni::graph_reorder::ComputeOrder(ReorderStrategy::NONE, offsets, adjacency, path[0]);
+    for (size_t i = 0; i < identity.size(); ++i) {
+        ASSERT_EQ((int32_t) i, identity[i]);
+    }
+
+    // BFS from one end of the path lays the path out contiguously, the isolated node comes last
+    auto bfs = knn_jni::graph_reorder::ComputeOrder(ReorderStrategy::BFS, offsets, adjacency, path[0]);
+    AssertIsPermutation(bfs, 11);
+    for (size_t i = 0; i < path.size(); ++i) {
+        ASSERT_EQ(path[i], bfs[i]);
+    }
+    ASSERT_EQ(10, bfs[10]);
+
+    // After RCM every edge of the path connects nodes with consecutive new ids
+    auto rcm = knn_jni::graph_reorder::ComputeOrder(ReorderStrategy::RCM, offsets, adjacency, path[0]);
+    AssertIsPermutation(rcm, 11);
+    auto newIds = knn_jni::graph_reorder::InvertOrder(rcm);
+    for (size_t i = 0; i + 1 < path.size(); ++i) {
+        ASSERT_EQ(1, std::abs(newIds[path[i]] - newIds[path[i + 1]]));
+    }
+
+    // Locality ordering works on vectors, not on a built graph
+    ASSERT_THROW(knn_jni::graph_reorder::ComputeOrder(ReorderStrategy::LOCALITY, offsets, adjacency, path[0]),
+                 std::runtime_error);
+}
+
+TEST(GraphReorderComputeLocalityOrderTest, BasicAssertions) {
+    // Two well separated clusters, interleaved in the input
+    int dim = 8;
+    int numVectors = 200;
+    std::vector<std::vector<float>> data;
+    for (int i = 0; i < numVectors; ++i) {
+        float center = (i % 2 == 0) ? -100.0f : 100.0f;
+        std::vector<float> vector;
+        for (int j = 0; j < dim; ++j) {
+            vector.push_back(center + test_util::RandomFloat(-1.0, 1.0));
+        }
+        data.push_back(vector);
+    }
+
+    std::vector<const float*> vectors;
+    for (auto& vector : data) {
+        vectors.push_back(vector.data());
+    }
+
+    auto order = knn_jni::graph_reorder::ComputeLocalityOrder(vectors, dim);
+    AssertIsPermutation(order, numVectors);
+
+    // Each cluster ends up in one contiguous run, so the cluster changes exactly once along the new order
+    int changes = 0;
+    for (int i = 1; i < numVectors; ++i) {
+        if (order[i] % 2 != order[i - 1] % 2) {
+            changes++;
+        }
+    }
+    ASSERT_EQ(1, changes);
+}
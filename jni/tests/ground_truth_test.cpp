@@ -0,0 +1,115 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "ground_truth.h"
+#include "jni_util.h"
+#include "vecs_io.h"
+
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "test_util.h"
+
+using knn_jni::vecs_io::Matrix;
+
+TEST(VecsIoTest, BasicAssertions) {
+    Matrix<float> vectors(3, 4);
+    Matrix<int32_t> ids(3, 2);
+    for (size_t i = 0; i < vectors.data.size(); ++i) {
+        vectors.data[i] = test_util::RandomFloat(-500.0, 500.0);
+    }
+    for (size_t i = 0; i < ids.data.size(); ++i) {
+        ids.data[i] = (int32_t) i;
+    }
+
+    std::string vectorsPath = test_util::RandomString(10, "tmp/", ".fvecs");
+    std::string idsPath = test_util::RandomString(10, "tmp/", ".ivecs");
+    knn_jni::vecs_io::WriteFvecs(vectorsPath, vectors);
+    knn_jni::vecs_io::WriteIvecs(idsPath, ids);
+
+    Matrix<float> readVectors = knn_jni::vecs_io::ReadVectors(vectorsPath);
+    ASSERT_EQ(3, readVectors.rows);
+    ASSERT_EQ(4, readVectors.cols);
+    ASSERT_EQ(vectors.data, readVectors.data);
+    ASSERT_EQ(ids.data, knn_jni::vecs_io::ReadIvecs(idsPath).data);
+
+    // An ivecs file is not read as vectors, and a truncated file is rejected
+    ASSERT_THROW(knn_jni::vecs_io::ReadVectors(idsPath), std::runtime_error);
+    FILE* file = fopen(vectorsPath.c_str(), "ab");
+    int32_t dim = 4;
+    fwrite(&dim, sizeof(dim), 1, file);
+    fclose(file);
+    ASSERT_THROW(knn_jni::vecs_io::ReadFvecs(vectorsPath), std::runtime_error);
+
+    // Clean up
+    std::remove(vectorsPath.c_str());
+    std::remove(idsPath.c_str());
+}
+
+TEST(ComputeGroundTruthTest, BasicAssertions) {
+    // Points on a line, so the nearest neighbors are known
+    Matrix<float> base(10, 2);
+    for (int i = 0; i < 10; ++i) {
+        base.Row(i)[0] = (float) i;
+        base.Row(i)[1] = 0;
+    }
+    Matrix<float> queries(2, 2);
+    queries.Row(0)[0] = 2.1f;
+    queries.Row(1)[0] = 8.9f;
+
+    Matrix<int32_t> neighbors;
+    Matrix<float> distances;
+    knn_jni::ground_truth::ComputeGroundTruth(base, queries, 3, knn_jni::L2, 2, neighbors, distances);
+    ASSERT_EQ(2, neighbors.rows);
+    ASSERT_EQ(3, neighbors.cols);
+    ASSERT_EQ(2, neighbors.Row(0)[0]);
+    ASSERT_EQ(3, neighbors.Row(0)[1]);
+    ASSERT_EQ(1, neighbors.Row(0)[2]);
+    ASSERT_EQ(9, neighbors.Row(1)[0]);
+    ASSERT_NEAR(0.1, distances.Row(0)[0], 1e-5);
+    ASSERT_NEAR(1.9, distances.Row(1)[2], 1e-5);
+
+    // The largest inner product wins
+    knn_jni::ground_truth::ComputeGroundTruth(base, queries, 1, knn_jni::INNER_PRODUCT, 1, neighbors, distances);
+    ASSERT_EQ(9, neighbors.Row(0)[0]);
+    ASSERT_NEAR(9 * 2.1, distances.Row(0)[0], 1e-4);
+
+    // Fewer base vectors than k pads with -1
+    knn_jni::ground_truth::ComputeGroundTruth(base, queries, 12, knn_jni::COSINESIMIL, 1, neighbors, distances);
+    ASSERT_EQ(-1, neighbors.Row(0)[11]);
+    ASSERT_NEAR(0, distances.Row(0)[0], 1e-5);
+
+    // Vectors in caller owned memory are searched in place, here only the first five base rows
+    knn_jni::ground_truth::ComputeGroundTruth(base.data.data(), 5, queries.data.data(), queries.rows, 2, 2,
+                                              knn_jni::L2, 1, neighbors, distances);
+    ASSERT_EQ(2, neighbors.rows);
+    ASSERT_EQ(4, neighbors.Row(1)[0]);
+    ASSERT_EQ(3, neighbors.Row(1)[1]);
+    ASSERT_NEAR(4.9, distances.Row(1)[0], 1e-5);
+
+    ASSERT_THROW(knn_jni::ground_truth::ComputeGroundTruth(base, queries, 3, "hamming", 1, neighbors, distances),
+                 std::runtime_error);
+}
+
+TEST(RecallAtRTest, BasicAssertions) {
+    Matrix<int32_t> groundTruth(2, 4);
+    groundTruth.data = {1, 2, 3, 4, 5, 6, 7, 8};
+    Matrix<int32_t> results(2, 2);
+    results.data = {1, 9, 4, 5};
+
+    // Query 0 finds 1 of its top 2, query 1 finds 5 among its top 2 but not 4
+    ASSERT_DOUBLE_EQ(0.5, knn_jni::ground_truth::RecallAtR(results, groundTruth, 2, 2));
+    ASSERT_DOUBLE_EQ(0.5, knn_jni::ground_truth::RecallAtR(results, groundTruth, 1, 2));
+    ASSERT_THROW(knn_jni::ground_truth::RecallAtR(results, groundTruth, 3, 2), std::runtime_error);
+}
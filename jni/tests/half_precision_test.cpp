@@ -0,0 +1,95 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+
+#include "half_precision.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(HalfPrecisionParseEncodingTest, BasicAssertions) {
+    ASSERT_EQ(knn_jni::half_precision::Encoding::FP16, knn_jni::half_precision::ParseEncoding("fp16"));
+    ASSERT_EQ(knn_jni::half_precision::Encoding::BF16, knn_jni::half_precision::ParseEncoding("bf16"));
+    ASSERT_THROW(knn_jni::half_precision::ParseEncoding("fp8"), std::runtime_error);
+}
+
+TEST(HalfPrecisionFp16Test, BasicAssertions) {
+    using knn_jni::half_precision::Fp16ToFloat;
+    using knn_jni::half_precision::FloatToFp16;
+
+    ASSERT_EQ(0x0000, FloatToFp16(0.0f));
+    ASSERT_EQ(0x8000, FloatToFp16(-0.0f));
+    ASSERT_EQ(0x3c00, FloatToFp16(1.0f));
+    ASSERT_EQ(0xc000, FloatToFp16(-2.0f));
+    ASSERT_EQ(0x7bff, FloatToFp16(65504.0f));
+    ASSERT_EQ(0x7c00, FloatToFp16(65520.0f));
+    ASSERT_EQ(0x7c00, FloatToFp16(std::numeric_limits<float>::infinity()));
+    ASSERT_EQ(0x0001, FloatToFp16(std::ldexp(1.0f, -24)));
+    ASSERT_EQ(0x0000, FloatToFp16(std::ldexp(1.0f, -26)));
+    ASSERT_TRUE(std::isnan(Fp16ToFloat(FloatToFp16(std::numeric_limits<float>::quiet_NaN()))));
+
+    // 1 + 2^-11 lies halfway between 1 and the next half, and rounds to the even one
+    ASSERT_EQ(0x3c00, FloatToFp16(1.0f + std::ldexp(1.0f, -11)));
+    ASSERT_EQ(0x3c02, FloatToFp16(1.0f + 3 * std::ldexp(1.0f, -11)));
+
+    // Every half survives a round trip through float
+    for (uint32_t bits = 0; bits < 0x10000u; ++bits) {
+        auto half = (uint16_t) bits;
+        float value = Fp16ToFloat(half);
+        if (std::isnan(value)) {
+            ASSERT_EQ(0x7c00, half & 0x7c00);
+            continue;
+        }
+        ASSERT_EQ(half, FloatToFp16(value));
+    }
+}
+
+TEST(HalfPrecisionBf16Test, BasicAssertions) {
+    using knn_jni::half_precision::Bf16ToFloat;
+    using knn_jni::half_precision::FloatToBf16;
+
+    ASSERT_EQ(0x3f80, FloatToBf16(1.0f));
+    ASSERT_FLOAT_EQ(1.0f, Bf16ToFloat(0x3f80));
+    ASSERT_FLOAT_EQ(-2.0f, Bf16ToFloat(FloatToBf16(-2.0f)));
+
+    // 1 + 2^-8 lies halfway between 1 and the next bfloat16, and rounds to the even one
+    ASSERT_EQ(0x3f80, FloatToBf16(1.0f + std::ldexp(1.0f, -8)));
+    ASSERT_EQ(0x3f82, FloatToBf16(1.0f + 3 * std::ldexp(1.0f, -8)));
+    ASSERT_TRUE(std::isnan(Bf16ToFloat(FloatToBf16(std::numeric_limits<float>::quiet_NaN()))));
+}
+
+TEST(HalfPrecisionDecodeTest, BasicAssertions) {
+    // Enough values to cover both the vectorized body and the scalar tail
+    std::vector<float> values;
+    for (int i = 0; i < 37; ++i) {
+        values.push_back((float) (i - 18) * 0.37f);
+    }
+
+    for (auto encoding : {knn_jni::half_precision::Encoding::FP16, knn_jni::half_precision::Encoding::BF16}) {
+        std::vector<uint16_t> encoded(values.size());
+        knn_jni::half_precision::Encode(encoding, values.data(), values.size(), encoded.data());
+        std::vector<float> decoded(values.size());
+        knn_jni::half_precision::Decode(encoding, encoded.data(), encoded.size(), decoded.data());
+
+        float tolerance = encoding == knn_jni::half_precision::Encoding::FP16 ? 1e-2f : 5e-2f;
+        for (size_t i = 0; i < values.size(); ++i) {
+            auto expected = encoding == knn_jni::half_precision::Encoding::FP16
+                    ? knn_jni::half_precision::FloatToFp16(values[i])
+                    : knn_jni::half_precision::FloatToBf16(values[i]);
+            ASSERT_EQ(expected, encoded[i]);
+            ASSERT_NEAR(values[i], decoded[i], tolerance);
+        }
+    }
+}
@@ -0,0 +1,90 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "index_description.h"
+#include "json_value.h"
+
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(IndexDescriptionTest, SummarizesGraphs) {
+    // Two layers: 0 links to 1 and 2 on the base layer and to 3 on layer 1 only. 4 links to 0, but nothing links to 4
+    std::vector<std::vector<std::vector<int32_t>>> links = {
+            {{1, 2}, {3}},
+            {{0}},
+            {{0, 1}},
+            {{}, {0}},
+            {{0}}
+    };
+    std::vector<int> topLayers = {1, 0, 0, 1, 0};
+    auto neighbors = [&links](int32_t node, int layer, std::vector<int32_t>& out) {
+        out.clear();
+        if ((size_t) layer < links[node].size()) {
+            out = links[node][layer];
+        }
+    };
+
+    auto summary = knn_jni::index_description::SummarizeGraph(5, topLayers, 0, neighbors);
+    ASSERT_EQ((std::vector<int64_t>{3, 2}), summary.levelCounts);
+    ASSERT_EQ((std::vector<int64_t>{1, 2, 2}), summary.degreeHistogram);
+    ASSERT_DOUBLE_EQ(1.2, summary.meanDegree);
+    ASSERT_EQ(1, summary.unreachable);
+
+    ASSERT_EQ(5, knn_jni::index_description::SummarizeGraph(5, topLayers, -1, neighbors).unreachable);
+    ASSERT_THROW(knn_jni::index_description::SummarizeGraph(4, topLayers, 0, neighbors), std::runtime_error);
+}
+
+TEST(IndexDescriptionTest, SummarizesLists) {
+    auto even = knn_jni::index_description::SummarizeLists({5, 5, 5, 5});
+    ASSERT_EQ(4, even.numLists);
+    ASSERT_EQ(20, even.total);
+    ASSERT_DOUBLE_EQ(1.0, even.imbalance);
+    ASSERT_EQ(0, even.empty);
+
+    auto skewed = knn_jni::index_description::SummarizeLists({0, 20, 0, 0});
+    ASSERT_EQ(0, skewed.min);
+    ASSERT_EQ(20, skewed.max);
+    ASSERT_DOUBLE_EQ(5.0, skewed.mean);
+    ASSERT_EQ(0, skewed.p50);
+    ASSERT_EQ(20, skewed.p99);
+    ASSERT_EQ(3, skewed.empty);
+    ASSERT_DOUBLE_EQ(4.0, skewed.imbalance);
+
+    ASSERT_EQ(0, knn_jni::index_description::SummarizeLists({}).numLists);
+}
+
+TEST(IndexDescriptionTest, WritesJson) {
+    knn_jni::index_description::JsonWriter writer;
+    writer.String("engine", "faiss");
+    writer.Number("count", (int64_t) 3);
+    writer.BeginObject("memory");
+    writer.Number("total", (int64_t) 120);
+    writer.EndObject();
+    writer.BeginObject("hnsw");
+    writer.Boolean("compressed", true);
+    writer.Graph({{2, 1}, {0, 3}, 1.0, 0});
+    writer.EndObject();
+    writer.Number("ratio", 0.5);
+
+    std::string text = writer.Finish();
+    ASSERT_EQ("{\"engine\":\"faiss\",\"count\":3,\"memory\":{\"total\":120},\"hnsw\":{\"compressed\":true,"
+              "\"level_counts\":[2,1],\"degree_histogram\":[0,3],\"mean_degree\":1,\"unreachable\":0},"
+              "\"ratio\":0.5}", text);
+    auto document = knn_jni::json::Value::Parse(text);
+    ASSERT_EQ(3, document.Find("count")->AsInt());
+
+    knn_jni::index_description::JsonWriter unbalanced;
+    ASSERT_THROW(unbalanced.EndObject(), std::runtime_error);
+    unbalanced.BeginObject("memory");
+    ASSERT_THROW(unbalanced.Finish(), std::runtime_error);
+}
@@ -0,0 +1,206 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+
+#include "index_spec.h"
+#include "json_value.h"
+#include "replay_jni_util.h"
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "gtest/gtest.h"
+
+using knn_jni::json::Value;
+using knn_jni::replay::FromJava;
+using knn_jni::replay::ToJava;
+
+TEST(JsonValueTest, BasicAssertions) {
+    auto value = Value::Parse(R"( {"a": [1, -2.5e-1, true, null], "b": {"c": "x\"é\n"}, "d": false} )");
+    ASSERT_TRUE(value.IsObject());
+    ASSERT_EQ(3, value.Members().size());
+
+    const auto& elements = value.Find("a")->Elements();
+    ASSERT_EQ(4, elements.size());
+    ASSERT_EQ(1, elements[0]->AsInt());
+    ASSERT_DOUBLE_EQ(-0.25, elements[1]->AsNumber());
+    ASSERT_TRUE(elements[2]->AsBool());
+    ASSERT_EQ(Value::Type::NUL, elements[3]->GetType());
+    ASSERT_EQ("x\"\xc3\xa9\n", value.Find("b")->Find("c")->AsString());
+    ASSERT_FALSE(value.Find("d")->AsBool());
+    ASSERT_EQ(nullptr, value.Find("e"));
+    ASSERT_EQ(nullptr, value.Find("d")->Find("e"));
+
+    ASSERT_THROW(elements[1]->AsInt(), std::runtime_error);
+    ASSERT_THROW(value.Find("d")->AsString(), std::runtime_error);
+    ASSERT_THROW(Value::Parse("{\"a\": 1,}"), std::runtime_error);
+    ASSERT_THROW(Value::Parse("[1, 2"), std::runtime_error);
+    ASSERT_THROW(Value::Parse("{} {}"), std::runtime_error);
+    ASSERT_THROW(Value::Parse("\"abc"), std::runtime_error);
+}
+
+TEST(IndexSpecParseTest, BasicAssertions) {
+    // sample-configs/nmslib-sift-hnsw/index-spec.json
+    auto nmslibSpec = knn_jni::index_spec::ParseIndexSpec(Value::Parse(R"({
+        "settings": {"index": {"knn": true, "knn.algo_param.ef_search": 512, "number_of_shards": 1}},
+        "mappings": {"properties": {"target_field": {"type": "knn_vector", "dimension": 128,
+            "method": {"name": "hnsw", "space_type": "l2", "engine": "nmslib",
+                       "parameters": {"ef_construction": 512, "m": 16}}}}}
+    })"), nullptr, "");
+    ASSERT_EQ(knn_jni::NMSLIB_NAME, nmslibSpec.engine);
+    ASSERT_EQ("hnsw", nmslibSpec.method);
+    ASSERT_EQ(knn_jni::L2, nmslibSpec.spaceType);
+    ASSERT_EQ(512, nmslibSpec.efSearch);
+    ASSERT_EQ(16, nmslibSpec.intParameters.at(knn_jni::M));
+    ASSERT_FALSE(knn_jni::index_spec::RequiresTraining(nmslibSpec));
+
+    // sample-configs/faiss-sift-ivf, where the field refers to a model trained with method-spec.json
+    auto modelIndexSpec = Value::Parse(R"({
+        "settings": {"index": {"knn": true, "number_of_shards": 3}},
+        "mappings": {"properties": {"target_field": {"type": "knn_vector", "model_id": "test-model"}}}
+    })");
+    auto methodSpec = Value::Parse(R"({"name": "ivf", "engine": "faiss", "parameters": {"nlist": 16, "nprobes": 4}})");
+    ASSERT_THROW(knn_jni::index_spec::ParseIndexSpec(modelIndexSpec, nullptr, "target_field"), std::runtime_error);
+    ASSERT_THROW(knn_jni::index_spec::ParseIndexSpec(modelIndexSpec, &methodSpec, "other_field"), std::runtime_error);
+
+    auto faissSpec = knn_jni::index_spec::ParseIndexSpec(modelIndexSpec, &methodSpec, "target_field");
+    ASSERT_EQ(knn_jni::FAISS_NAME, faissSpec.engine);
+    ASSERT_EQ(4, faissSpec.intParameters.at(knn_jni::NPROBES));
+    ASSERT_TRUE(knn_jni::index_spec::RequiresTraining(faissSpec));
+    ASSERT_EQ("IVF16,Flat", knn_jni::index_spec::FaissIndexDescription(faissSpec));
+
+    // Defaults of the plugin are filled in, and the encoder is part of the description
+    auto pqSpec = knn_jni::index_spec::ParseIndexSpec(Value::Parse(R"({
+        "mappings": {"properties": {"v": {"type": "knn_vector",
+            "method": {"name": "hnsw", "engine": "faiss", "space_type": "innerproduct",
+                       "parameters": {"encoder": {"name": "pq", "parameters": {"m": 4}}}}}}}
+    })"), nullptr, "");
+    ASSERT_EQ(knn_jni::INNER_PRODUCT, pqSpec.spaceType);
+    ASSERT_EQ(512, pqSpec.intParameters.at(knn_jni::EF_SEARCH));
+    ASSERT_EQ("HNSW16,PQ4x8", knn_jni::index_spec::FaissIndexDescription(pqSpec));
+
+    // Fields without a method use the index settings
+    auto legacySpec = knn_jni::index_spec::ParseIndexSpec(Value::Parse(R"({
+        "settings": {"index.knn.algo_param.m": "32", "index.knn.space_type": "cosinesimil"},
+        "mappings": {"properties": {"v": {"type": "knn_vector", "dimension": 2}}}
+    })"), nullptr, "v");
+    ASSERT_EQ(knn_jni::NMSLIB_NAME, legacySpec.engine);
+    ASSERT_EQ(knn_jni::COSINESIMIL, legacySpec.spaceType);
+    ASSERT_EQ(32, legacySpec.intParameters.at(knn_jni::M));
+
+    ASSERT_THROW(knn_jni::index_spec::ParseIndexSpec(Value::Parse(R"({
+        "mappings": {"properties": {"v": {"type": "knn_vector", "method": {"name": "ivf", "engine": "nmslib"}}}}
+    })"), nullptr, ""), std::runtime_error);
+}
+
+TEST(IndexSpecBuildParametersTest, BasicAssertions) {
+    knn_jni::replay::ReplayJNIUtil jniUtil;
+    auto methodSpec = Value::Parse(R"({"name": "hnsw", "engine": "faiss",
+                                       "parameters": {"m": 8, "ef_search": 100, "graph_encoding": "delta"}})");
+    auto spec = knn_jni::index_spec::ParseIndexSpec(Value::Parse(
+            R"({"mappings": {"properties": {"v": {"type": "knn_vector", "model_id": "m"}}}})"), &methodSpec, "");
+
+    // The wrappers read the parameters through the JNIUtilInterface, as they would from Java
+    auto parameters = knn_jni::index_spec::BuildParameters(spec, 3);
+    auto parametersCpp = jniUtil.ConvertJavaMapToCppMap(nullptr, ToJava<jobject>(parameters.get()));
+    ASSERT_EQ(knn_jni::L2, jniUtil.ConvertJavaObjectToCppString(nullptr, parametersCpp.at(knn_jni::SPACE_TYPE)));
+    ASSERT_EQ("HNSW8,Flat",
+              jniUtil.ConvertJavaObjectToCppString(nullptr, parametersCpp.at(knn_jni::INDEX_DESCRIPTION)));
+    ASSERT_EQ(3, jniUtil.ConvertJavaObjectToCppInteger(nullptr, parametersCpp.at(knn_jni::INDEX_THREAD_QUANTITY)));
+
+    auto subParametersCpp = jniUtil.ConvertJavaMapToCppMap(nullptr, parametersCpp.at(knn_jni::PARAMETERS));
+    ASSERT_EQ(subParametersCpp.end(), subParametersCpp.find(knn_jni::M));
+    ASSERT_EQ(100, jniUtil.ConvertJavaObjectToCppInteger(nullptr, subParametersCpp.at(knn_jni::EF_SEARCH)));
+    ASSERT_EQ(512, jniUtil.ConvertJavaObjectToCppInteger(nullptr, subParametersCpp.at(knn_jni::EF_CONSTRUCTION)));
+    ASSERT_EQ("delta", jniUtil.ConvertJavaObjectToCppString(nullptr, subParametersCpp.at(knn_jni::GRAPH_ENCODING)));
+    ASSERT_THROW(jniUtil.ConvertJavaObjectToCppInteger(nullptr, subParametersCpp.at(knn_jni::GRAPH_ENCODING)),
+                 std::runtime_error);
+
+    auto loadParameters = knn_jni::index_spec::LoadParameters(spec);
+    auto loadParametersCpp = jniUtil.ConvertJavaMapToCppMap(nullptr, ToJava<jobject>(loadParameters.get()));
+    ASSERT_EQ(512, jniUtil.ConvertJavaObjectToCppInteger(nullptr, loadParametersCpp.at("efSearch")));
+    ASSERT_EQ(loadParametersCpp.end(), loadParametersCpp.find(knn_jni::COSINE_MODE));
+    ASSERT_EQ(knn_jni::EARLY_TERMINATION_NONE,
+              jniUtil.ConvertJavaObjectToCppString(nullptr, loadParametersCpp.at(knn_jni::EARLY_TERMINATION)));
+
+    // Faiss reads the early termination index setting at load time
+    auto adaptiveSpec = knn_jni::index_spec::ParseIndexSpec(Value::Parse(
+            R"({"settings": {"index": {"knn.early_termination": "adaptive"}},
+                "mappings": {"properties": {"v": {"type": "knn_vector", "model_id": "m"}}}})"), &methodSpec, "");
+    auto adaptiveLoadParameters = knn_jni::index_spec::LoadParameters(adaptiveSpec);
+    auto adaptiveLoadParametersCpp = jniUtil.ConvertJavaMapToCppMap(nullptr,
+                                                                    ToJava<jobject>(adaptiveLoadParameters.get()));
+    ASSERT_EQ(knn_jni::EARLY_TERMINATION_ADAPTIVE,
+              jniUtil.ConvertJavaObjectToCppString(nullptr, adaptiveLoadParametersCpp.at(knn_jni::EARLY_TERMINATION)));
+
+    // nmslib string parameters are passed through, and the cosine mode is needed again at load time
+    auto nmslibMethodSpec = Value::Parse(R"({"name": "hnsw", "engine": "nmslib", "space_type": "cosinesimil",
+                                             "parameters": {"cosine_mode": "normalized", "index_layout": "regular"}})");
+    auto nmslibSpec = knn_jni::index_spec::ParseIndexSpec(Value::Parse(
+            R"({"mappings": {"properties": {"v": {"type": "knn_vector", "model_id": "m"}}}})"), &nmslibMethodSpec, "");
+    auto nmslibParameters = knn_jni::index_spec::BuildParameters(nmslibSpec, 1);
+    auto nmslibParametersCpp = jniUtil.ConvertJavaMapToCppMap(nullptr, ToJava<jobject>(nmslibParameters.get()));
+    auto nmslibSubParametersCpp = jniUtil.ConvertJavaMapToCppMap(nullptr,
+                                                                 nmslibParametersCpp.at(knn_jni::PARAMETERS));
+    ASSERT_EQ(knn_jni::INDEX_LAYOUT_REGULAR,
+              jniUtil.ConvertJavaObjectToCppString(nullptr, nmslibSubParametersCpp.at(knn_jni::INDEX_LAYOUT)));
+
+    auto nmslibLoadParameters = knn_jni::index_spec::LoadParameters(nmslibSpec);
+    auto nmslibLoadParametersCpp = jniUtil.ConvertJavaMapToCppMap(nullptr,
+                                                                  ToJava<jobject>(nmslibLoadParameters.get()));
+    ASSERT_EQ(knn_jni::COSINE_MODE_NORMALIZED,
+              jniUtil.ConvertJavaObjectToCppString(nullptr, nmslibLoadParametersCpp.at(knn_jni::COSINE_MODE)));
+}
+
+TEST(ReplayJNIUtilTest, BasicAssertions) {
+    knn_jni::replay::ReplayJNIUtil jniUtil;
+    knn_jni::replay::ObjectArray vectors;
+    for (int i = 0; i < 3; ++i) {
+        auto * vector = new knn_jni::replay::FloatArray();
+        vector->values = {(float) i, (float) i + 0.5f};
+        vectors.elements.emplace_back(vector);
+    }
+    auto vectorsJ = ToJava<jobjectArray>(&vectors);
+    ASSERT_EQ(3, jniUtil.GetJavaObjectArrayLength(nullptr, vectorsJ));
+    ASSERT_EQ(2, jniUtil.GetInnerDimensionOf2dJavaFloatArray(nullptr, vectorsJ));
+    std::vector<float> expected = {0, 0.5, 1, 1.5, 2, 2.5};
+    ASSERT_EQ(expected, jniUtil.Convert2dJavaObjectArrayToCppFloatVector(nullptr, vectorsJ, 2));
+    ASSERT_THROW(jniUtil.Convert2dJavaObjectArrayToCppFloatVector(nullptr, vectorsJ, 3), std::runtime_error);
+
+    knn_jni::replay::FloatArray flatVectors;
+    flatVectors.values = expected;
+    ASSERT_EQ(expected, jniUtil.ConvertFlatJavaVectorsToCppFloatVector(nullptr, ToJava<jobject>(&flatVectors), 2));
+    ASSERT_THROW(jniUtil.ConvertFlatJavaVectorsToCppFloatVector(nullptr, ToJava<jobject>(&flatVectors), 4),
+                 std::runtime_error);
+
+    // Result arrays own the results put into them
+    jclass resultClass = jniUtil.FindClass(nullptr, "org/opensearch/knn/index/KNNQueryResult");
+    jmethodID allArgs = jniUtil.FindMethod(nullptr, "org/opensearch/knn/index/KNNQueryResult", "<init>");
+    std::unique_ptr<knn_jni::replay::Object> results(reinterpret_cast<knn_jni::replay::Object *>(
+            jniUtil.NewObjectArray(nullptr, 2, resultClass, nullptr)));
+    for (int i = 0; i < 2; ++i) {
+        jniUtil.SetObjectArrayElement(nullptr, ToJava<jobjectArray>(results.get()), i,
+                                      jniUtil.NewObject(nullptr, resultClass, allArgs, i * 10, i * 0.5f));
+    }
+    auto & resultArray = FromJava<knn_jni::replay::ObjectArray>(results.get());
+    ASSERT_EQ(10, FromJava<knn_jni::replay::QueryResult>(resultArray.elements[1].get()).id);
+    ASSERT_FLOAT_EQ(0.5, FromJava<knn_jni::replay::QueryResult>(resultArray.elements[1].get()).score);
+
+    std::unique_ptr<knn_jni::replay::Object> bytes(reinterpret_cast<knn_jni::replay::Object *>(
+            jniUtil.NewByteArray(nullptr, 4)));
+    jbyte buffer[] = {1, 2, 3, 4};
+    jniUtil.SetByteArrayRegion(nullptr, ToJava<jbyteArray>(bytes.get()), 0, 4, buffer);
+    ASSERT_EQ(4, jniUtil.GetJavaBytesArrayLength(nullptr, ToJava<jbyteArray>(bytes.get())));
+    ASSERT_EQ(3, jniUtil.GetByteArrayElements(nullptr, ToJava<jbyteArray>(bytes.get()), nullptr)[2]);
+    ASSERT_THROW(jniUtil.SetByteArrayRegion(nullptr, ToJava<jbyteArray>(bytes.get()), 2, 4, buffer),
+                 std::runtime_error);
+}
@@ -0,0 +1,55 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "live_docs.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(LiveDocsTest, BasicAssertions) {
+    // 100 docs, every third one deleted
+    int numDocs = 100;
+    std::vector<uint64_t> words((numDocs + 63) / 64, 0);
+    for (int i = 0; i < numDocs; ++i) {
+        if (i % 3 != 0) {
+            words[i / 64] |= 1ull << (i % 64);
+        }
+    }
+
+    knn_jni::live_docs::LiveDocs liveDocs(words.data(), words.size());
+    for (int i = 0; i < numDocs; ++i) {
+        ASSERT_EQ(i % 3 != 0, liveDocs.IsLive(i));
+    }
+    ASSERT_TRUE(liveDocs.IsLive(128));
+    ASSERT_TRUE(liveDocs.IsLive(-1));
+
+    // 34 deleted docs plus the 28 unused bits of the last word
+    ASSERT_EQ(34 + 28, liveDocs.NumDeleted());
+}
+
+TEST(LiveDocsOverFetchSizeTest, BasicAssertions) {
+    // A few deletes are made up for one by one
+    std::vector<uint64_t> words(2, ~0ull);
+    words[0] &= ~7ull;
+    knn_jni::live_docs::LiveDocs fewDeleted(words.data(), words.size());
+    ASSERT_EQ(10 + 3, knn_jni::live_docs::OverFetchSize(fewDeleted, 10));
+
+    // A heavily deleted segment fetches a bounded multiple of k
+    std::vector<uint64_t> emptyWords(1000, 0);
+    knn_jni::live_docs::LiveDocs mostlyDeleted(emptyWords.data(), emptyWords.size());
+    ASSERT_EQ(10 * knn_jni::live_docs::MAX_OVER_FETCH_FACTOR, knn_jni::live_docs::OverFetchSize(mostlyDeleted, 10));
+
+    // Without deletes nothing extra is fetched
+    std::vector<uint64_t> liveWords(2, ~0ull);
+    knn_jni::live_docs::LiveDocs noneDeleted(liveWords.data(), liveWords.size());
+    ASSERT_EQ(10, knn_jni::live_docs::OverFetchSize(noneDeleted, 10));
+}
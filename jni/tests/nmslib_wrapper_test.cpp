@@ -10,7 +10,10 @@
  */
 
 #include "nmslib_wrapper.h"
+#include "json_value.h"
 
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -83,6 +86,171 @@ TEST(NmslibCreateIndexTest, BasicAssertions) {
     std::remove(indexPath.c_str());
 }
 
+TEST(NmslibCreateIndexFromFlatVectorsTest, BasicAssertions) {
+    // Initialize nmslib
+    similarity::initLibrary();
+
+    // Define index data
+    int numIds = 100;
+    std::vector<int> ids;
+    std::vector<float> vectors;
+    int dim = 2;
+    for (int i = 0; i < numIds; ++i) {
+        ids.push_back(i);
+        for (int j = 0; j < dim; ++j) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    std::string indexPath = test_util::RandomString(10, "tmp/", ".nmslib");
+    std::string spaceType = knn_jni::L2;
+
+    std::unordered_map<std::string, jobject> parametersMap;
+    parametersMap[knn_jni::SPACE_TYPE] = (jobject)&spaceType;
+
+    // Set up jni
+    JNIEnv *jniEnv = nullptr;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    EXPECT_CALL(mockJNIUtil,
+                GetJavaIntArrayLength(jniEnv, reinterpret_cast<jintArray>(&ids)))
+            .WillRepeatedly(Return(ids.size()));
+
+    // Create the index
+    knn_jni::nmslib_wrapper::CreateIndexFromFlatVectors(
+            &mockJNIUtil, jniEnv, reinterpret_cast<jintArray>(&ids),
+            (jobject)&vectors, dim, (jstring)&indexPath,
+            (jobject)&parametersMap);
+
+    // Make sure index can be loaded
+    std::unique_ptr<similarity::Space<float>> space(
+            similarity::SpaceFactoryRegistry<float>::Instance().CreateSpace(
+                    spaceType, similarity::AnyParams()));
+    std::vector<std::string> params;
+    std::unique_ptr<similarity::Index<float>> loadedIndex(
+            test_util::NmslibLoadIndex(indexPath, space.get(), spaceType, params));
+
+    // Clean up
+    std::remove(indexPath.c_str());
+}
+
+TEST(NmslibCreateIndexWithGraphReorderTest, BasicAssertions) {
+    // Initialize nmslib
+    similarity::initLibrary();
+
+    // Define index data
+    int numIds = 100;
+    std::vector<int> ids;
+    std::vector<float> vectors;
+    int dim = 8;
+    for (int i = 0; i < numIds; ++i) {
+        ids.push_back(i);
+        for (int j = 0; j < dim; ++j) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    std::string indexPath = test_util::RandomString(10, "tmp/", ".nmslib");
+    std::string spaceType = knn_jni::L2;
+
+    // Set up jni
+    JNIEnv *jniEnv = nullptr;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    EXPECT_CALL(mockJNIUtil,
+                GetJavaIntArrayLength(jniEnv, reinterpret_cast<jintArray>(&ids)))
+            .WillRepeatedly(Return(ids.size()));
+
+    auto build = [&](std::string strategy) {
+        std::unordered_map<std::string, jobject> subParametersMap;
+        subParametersMap[knn_jni::GRAPH_REORDER] = (jobject)&strategy;
+        std::unordered_map<std::string, jobject> parametersMap;
+        parametersMap[knn_jni::SPACE_TYPE] = (jobject)&spaceType;
+        parametersMap[knn_jni::PARAMETERS] = (jobject)&subParametersMap;
+
+        // The build releases the vectors it is given
+        std::vector<float> buildVectors(vectors);
+        knn_jni::nmslib_wrapper::CreateIndexFromFlatVectors(
+                &mockJNIUtil, jniEnv, reinterpret_cast<jintArray>(&ids),
+                (jobject)&buildVectors, dim, (jstring)&indexPath,
+                (jobject)&parametersMap);
+    };
+
+    // Locality ordering changes the insertion order only, so the index still finds every vector
+    build("locality");
+    std::unordered_map<std::string, jobject> loadParametersMap;
+    loadParametersMap[knn_jni::SPACE_TYPE] = (jobject)&spaceType;
+    std::unique_ptr<knn_jni::nmslib_wrapper::IndexWrapper> index(
+            reinterpret_cast<knn_jni::nmslib_wrapper::IndexWrapper *>(knn_jni::nmslib_wrapper::LoadIndex(
+                    &mockJNIUtil, jniEnv, (jstring)&indexPath, (jobject)&loadParametersMap)));
+    std::vector<float> query(vectors.begin() + 42 * dim, vectors.begin() + 43 * dim);
+    std::unique_ptr<std::vector<std::pair<int, float> *>> results(
+            reinterpret_cast<std::vector<std::pair<int, float> *> *>(knn_jni::nmslib_wrapper::QueryIndex(
+                    &mockJNIUtil, jniEnv, reinterpret_cast<jlong>(index.get()),
+                    reinterpret_cast<jfloatArray>(&query), 1)));
+    ASSERT_EQ(1, results->size());
+    ASSERT_EQ(42, results->at(0)->first);
+    for (auto &it : *results) {
+        delete it;
+    }
+
+    // Graph renumbering strategies need access to the graph, which nmslib does not give
+    ASSERT_THROW(build("bfs"), std::runtime_error);
+    ASSERT_THROW(build("rcm"), std::runtime_error);
+
+    // Clean up
+    std::remove(indexPath.c_str());
+}
+
+TEST(NmslibCreateIndexFromHalfVectorsTest, BasicAssertions) {
+    // Initialize nmslib
+    similarity::initLibrary();
+
+    // Define index data
+    int numIds = 100;
+    std::vector<int> ids;
+    std::vector<uint16_t> vectors;
+    int dim = 2;
+    for (int i = 0; i < numIds; ++i) {
+        ids.push_back(i);
+        for (int j = 0; j < dim; ++j) {
+            vectors.push_back(knn_jni::half_precision::FloatToBf16(test_util::RandomFloat(-500.0, 500.0)));
+        }
+    }
+
+    std::string indexPath = test_util::RandomString(10, "tmp/", ".nmslib");
+    std::string spaceType = knn_jni::L2;
+    std::string encoding = "bf16";
+
+    std::unordered_map<std::string, jobject> parametersMap;
+    parametersMap[knn_jni::SPACE_TYPE] = (jobject)&spaceType;
+
+    // Set up jni
+    JNIEnv *jniEnv = nullptr;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    EXPECT_CALL(mockJNIUtil,
+                GetJavaIntArrayLength(jniEnv, reinterpret_cast<jintArray>(&ids)))
+            .WillRepeatedly(Return(ids.size()));
+
+    // Create the index
+    knn_jni::nmslib_wrapper::CreateIndexFromHalfVectors(
+            &mockJNIUtil, jniEnv, reinterpret_cast<jintArray>(&ids),
+            (jobject)&vectors, dim, (jstring)&encoding, (jstring)&indexPath,
+            (jobject)&parametersMap);
+
+    // Make sure index can be loaded
+    std::unique_ptr<similarity::Space<float>> space(
+            similarity::SpaceFactoryRegistry<float>::Instance().CreateSpace(
+                    spaceType, similarity::AnyParams()));
+    std::vector<std::string> params;
+    std::unique_ptr<similarity::Index<float>> loadedIndex(
+            test_util::NmslibLoadIndex(indexPath, space.get(), spaceType, params));
+
+    // Clean up
+    std::remove(indexPath.c_str());
+}
+
 TEST(NmslibLoadIndexTest, BasicAssertions) {
     // Initialize nmslib
     similarity::initLibrary();
@@ -208,6 +376,332 @@ TEST(NmslibQueryIndexTest, BasicAssertions) {
     }
 }
 
+TEST(NmslibQueryIndexWithLiveDocsHeavilyDeletedTest, BasicAssertions) {
+    // Initialize nmslib
+    similarity::initLibrary();
+
+    // Define index data. Nineteen out of twenty docs are deleted
+    int numIds = 1000;
+    std::vector<int> ids;
+    std::vector<std::vector<float>> vectors;
+    int dim = 2;
+    for (int i = 0; i < numIds; ++i) {
+        ids.push_back(i);
+
+        std::vector<float> vect;
+        vect.reserve(dim);
+        for (int j = 0; j < dim; ++j) {
+            vect.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+        vectors.push_back(vect);
+    }
+
+    std::vector<int64_t> liveDocs((numIds + 63) / 64, 0);
+    for (int i = 0; i < numIds; i += 20) {
+        liveDocs[i / 64] |= 1ll << (i % 64);
+    }
+
+    std::string spaceType = knn_jni::L2;
+    std::unique_ptr<similarity::Space<float>> space(
+            similarity::SpaceFactoryRegistry<float>::Instance().CreateSpace(
+                    spaceType, similarity::AnyParams()));
+
+    std::vector<std::string> indexParameters;
+
+    // Create index
+    std::unique_ptr<knn_jni::nmslib_wrapper::IndexWrapper> indexWrapper(
+            new knn_jni::nmslib_wrapper::IndexWrapper(spaceType));
+    indexWrapper->index.reset(test_util::NmslibCreateIndex(
+            ids.data(), vectors, space.get(), spaceType, indexParameters));
+
+    // Setup jni
+    JNIEnv *jniEnv = nullptr;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    // The search fetches at most a bounded multiple of k results, so fewer than k may be left once the deleted docs
+    // are dropped, but only live docs are returned
+    int k = 10;
+    size_t numFound = 0;
+    for (int i = 0; i < 100; ++i) {
+        std::vector<float> query = vectors[i];
+        std::unique_ptr<std::vector<std::pair<int, float> *>> results(
+                reinterpret_cast<std::vector<std::pair<int, float> *> *>(
+                        knn_jni::nmslib_wrapper::QueryIndexWithLiveDocs(
+                                &mockJNIUtil, jniEnv,
+                                reinterpret_cast<jlong>(indexWrapper.get()),
+                                reinterpret_cast<jfloatArray>(&query), k,
+                                reinterpret_cast<jlongArray>(&liveDocs))));
+
+        ASSERT_LE(results->size(), (size_t) k);
+        numFound += results->size();
+        for (auto &it : *results) {
+            ASSERT_EQ(0, it->first % 20);
+            delete it;
+        }
+    }
+    ASSERT_GT(numFound, (size_t) 0);
+}
+
+TEST(NmslibQueryIndexWithHalfVectorTest, BasicAssertions) {
+    // Initialize nmslib
+    similarity::initLibrary();
+
+    // Define index data, already rounded to fp16
+    int numIds = 100;
+    std::vector<int> ids;
+    std::vector<std::vector<float>> vectors;
+    int dim = 2;
+    for (int i = 0; i < numIds; ++i) {
+        ids.push_back(i);
+
+        std::vector<float> vect;
+        vect.reserve(dim);
+        for (int j = 0; j < dim; ++j) {
+            vect.push_back(knn_jni::half_precision::Fp16ToFloat(
+                    knn_jni::half_precision::FloatToFp16(test_util::RandomFloat(-500.0, 500.0))));
+        }
+        vectors.push_back(vect);
+    }
+
+    std::string spaceType = knn_jni::L2;
+    std::unique_ptr<similarity::Space<float>> space(
+            similarity::SpaceFactoryRegistry<float>::Instance().CreateSpace(
+                    spaceType, similarity::AnyParams()));
+
+    std::vector<std::string> indexParameters;
+
+    // Create index
+    std::unique_ptr<knn_jni::nmslib_wrapper::IndexWrapper> indexWrapper(
+            new knn_jni::nmslib_wrapper::IndexWrapper(spaceType));
+    indexWrapper->index.reset(test_util::NmslibCreateIndex(
+            ids.data(), vectors, space.get(), spaceType, indexParameters));
+
+    // Setup jni
+    JNIEnv *jniEnv = nullptr;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    // A stored vector sent as fp16 decodes exactly, so it is its own nearest neighbor. nmslib returns the farthest
+    // neighbor first
+    int k = 10;
+    std::string encoding = "fp16";
+    std::vector<uint16_t> query;
+    for (float value : vectors[3]) {
+        query.push_back(knn_jni::half_precision::FloatToFp16(value));
+    }
+    std::unique_ptr<std::vector<std::pair<int, float> *>> results(
+            reinterpret_cast<std::vector<std::pair<int, float> *> *>(
+                    knn_jni::nmslib_wrapper::QueryIndexWithHalfVector(
+                            &mockJNIUtil, jniEnv,
+                            reinterpret_cast<jlong>(indexWrapper.get()),
+                            reinterpret_cast<jshortArray>(&query), (jstring)&encoding, k)));
+
+    ASSERT_EQ(k, results->size());
+    ASSERT_EQ(3, results->back()->first);
+
+    // Need to free up each result
+    for (auto &it : *results) {
+        delete it;
+    }
+}
+
+TEST(NmslibCosineNormalizedTest, BasicAssertions) {
+    // Initialize nmslib
+    similarity::initLibrary();
+
+    // Define index data
+    int numIds = 100;
+    std::vector<int> ids;
+    std::vector<float> vectors;
+    int dim = 8;
+    for (int i = 0; i < numIds; ++i) {
+        ids.push_back(i);
+        for (int j = 0; j < dim; ++j) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    std::string spaceType = knn_jni::COSINESIMIL;
+
+    // Setup jni
+    JNIEnv *jniEnv = nullptr;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    EXPECT_CALL(mockJNIUtil,
+                GetJavaIntArrayLength(jniEnv, reinterpret_cast<jintArray>(&ids)))
+            .WillRepeatedly(Return(ids.size()));
+
+    // Build and load one index per cosine mode
+    std::vector<std::string> modes = {knn_jni::COSINE_MODE_RAW, knn_jni::COSINE_MODE_NORMALIZED};
+    std::vector<std::unique_ptr<knn_jni::nmslib_wrapper::IndexWrapper>> indices;
+    for (auto & mode : modes) {
+        std::string indexPath = test_util::RandomString(10, "tmp/", ".nmslib");
+
+        std::unordered_map<std::string, jobject> subParametersMap;
+        subParametersMap[knn_jni::COSINE_MODE] = (jobject)&mode;
+        std::unordered_map<std::string, jobject> parametersMap;
+        parametersMap[knn_jni::SPACE_TYPE] = (jobject)&spaceType;
+        parametersMap[knn_jni::PARAMETERS] = (jobject)&subParametersMap;
+
+        // The build normalizes its own copies, so the same vectors serve both builds
+        knn_jni::nmslib_wrapper::CreateIndexFromFlatVectors(
+                &mockJNIUtil, jniEnv, reinterpret_cast<jintArray>(&ids),
+                (jobject)&vectors, dim, (jstring)&indexPath,
+                (jobject)&parametersMap);
+
+        std::unordered_map<std::string, jobject> loadParametersMap;
+        loadParametersMap[knn_jni::SPACE_TYPE] = (jobject)&spaceType;
+        loadParametersMap[knn_jni::COSINE_MODE] = (jobject)&mode;
+        indices.emplace_back(reinterpret_cast<knn_jni::nmslib_wrapper::IndexWrapper *>(
+                knn_jni::nmslib_wrapper::LoadIndex(&mockJNIUtil, jniEnv, (jstring)&indexPath,
+                                                   (jobject)&loadParametersMap)));
+        std::remove(indexPath.c_str());
+    }
+    ASSERT_FALSE(indices[0]->cosineNormalized);
+    ASSERT_TRUE(indices[1]->cosineNormalized);
+
+    // Both modes rank the same neighbors with the same cosine distances
+    int k = 10;
+    for (int i = 0; i < 10; i++) {
+        std::vector<float> query;
+        for (int j = 0; j < dim; j++) {
+            query.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+
+        std::vector<std::unique_ptr<std::vector<std::pair<int, float> *>>> results;
+        for (auto & index : indices) {
+            results.emplace_back(reinterpret_cast<std::vector<std::pair<int, float> *> *>(
+                    knn_jni::nmslib_wrapper::QueryIndex(&mockJNIUtil, jniEnv, reinterpret_cast<jlong>(index.get()),
+                                                        reinterpret_cast<jfloatArray>(&query), k)));
+        }
+
+        ASSERT_EQ(k, results[0]->size());
+        ASSERT_EQ(k, results[1]->size());
+        for (int j = 0; j < k; j++) {
+            ASSERT_EQ(results[0]->at(j)->first, results[1]->at(j)->first);
+            ASSERT_NEAR(results[0]->at(j)->second, results[1]->at(j)->second, 1e-4);
+        }
+
+        // Need to free up each result
+        for (auto & result : results) {
+            for (auto &it : *result) {
+                delete it;
+            }
+        }
+    }
+
+    // Unknown modes are rejected
+    std::string invalidMode = "invalid";
+    std::unordered_map<std::string, jobject> loadParametersMap;
+    loadParametersMap[knn_jni::SPACE_TYPE] = (jobject)&spaceType;
+    loadParametersMap[knn_jni::COSINE_MODE] = (jobject)&invalidMode;
+    std::string indexPath = "unused";
+    ASSERT_THROW(knn_jni::nmslib_wrapper::LoadIndex(&mockJNIUtil, jniEnv, (jstring)&indexPath,
+                                                    (jobject)&loadParametersMap), std::runtime_error);
+}
+
+TEST(NmslibIndexLayoutTest, BasicAssertions) {
+    // Initialize nmslib
+    similarity::initLibrary();
+
+    // Define index data
+    int numIds = 100;
+    std::vector<int> ids;
+    std::vector<float> vectors;
+    int dim = 16;
+    for (int i = 0; i < numIds; ++i) {
+        ids.push_back(i);
+        for (int j = 0; j < dim; ++j) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    std::string spaceType = knn_jni::L2;
+
+    // Setup jni
+    JNIEnv *jniEnv = nullptr;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    EXPECT_CALL(mockJNIUtil,
+                GetJavaIntArrayLength(jniEnv, reinterpret_cast<jintArray>(&ids)))
+            .WillRepeatedly(Return(ids.size()));
+
+    std::unordered_map<std::string, jobject> loadParametersMap;
+    loadParametersMap[knn_jni::SPACE_TYPE] = (jobject)&spaceType;
+
+    // The layout is reported from the file, and both layouts find the indexed vectors themselves
+    std::vector<std::string> layouts = {knn_jni::INDEX_LAYOUT_OPTIMIZED, knn_jni::INDEX_LAYOUT_REGULAR};
+    for (auto & layout : layouts) {
+        std::string indexPath = test_util::RandomString(10, "tmp/", ".nmslib");
+
+        std::unordered_map<std::string, jobject> subParametersMap;
+        subParametersMap[knn_jni::INDEX_LAYOUT] = (jobject)&layout;
+        std::unordered_map<std::string, jobject> parametersMap;
+        parametersMap[knn_jni::SPACE_TYPE] = (jobject)&spaceType;
+        parametersMap[knn_jni::PARAMETERS] = (jobject)&subParametersMap;
+
+        knn_jni::nmslib_wrapper::CreateIndexFromFlatVectors(
+                &mockJNIUtil, jniEnv, reinterpret_cast<jintArray>(&ids),
+                (jobject)&vectors, dim, (jstring)&indexPath,
+                (jobject)&parametersMap);
+
+        jlong indexPointer = knn_jni::nmslib_wrapper::LoadIndex(&mockJNIUtil, jniEnv, (jstring)&indexPath,
+                                                                (jobject)&loadParametersMap);
+
+        // The structure is read back from the file, the graph only in the optimized layout
+        std::unique_ptr<std::vector<uint8_t>> descriptionBytes(reinterpret_cast<std::vector<uint8_t> *>(
+                knn_jni::nmslib_wrapper::DescribeIndex(&mockJNIUtil, jniEnv, indexPointer)));
+        auto description = knn_jni::json::Value::Parse(
+                std::string(descriptionBytes->begin(), descriptionBytes->end()));
+        ASSERT_EQ(knn_jni::NMSLIB_NAME, description.Find("engine")->AsString());
+        ASSERT_EQ(spaceType, description.Find("metric")->AsString());
+        ASSERT_EQ(layout, description.Find("layout")->AsString());
+        ASSERT_GT(description.Find("memory")->Find("total")->AsNumber(), numIds * dim * sizeof(float));
+        if (layout == knn_jni::INDEX_LAYOUT_OPTIMIZED) {
+            ASSERT_EQ(numIds, description.Find("count")->AsInt());
+            ASSERT_EQ(dim, description.Find("dimension")->AsInt());
+            const auto *hnsw = description.Find("hnsw");
+            int64_t nodes = 0;
+            for (const auto &count : hnsw->Find("level_counts")->Elements()) {
+                nodes += count->AsInt();
+            }
+            ASSERT_EQ(numIds, nodes);
+            ASSERT_GT(hnsw->Find("mean_degree")->AsNumber(), 0);
+            ASSERT_LT(hnsw->Find("unreachable")->AsInt(), 5);
+        } else {
+            ASSERT_EQ(nullptr, description.Find("hnsw"));
+        }
+
+        std::remove(indexPath.c_str());
+        ASSERT_EQ(layout == knn_jni::INDEX_LAYOUT_OPTIMIZED, knn_jni::nmslib_wrapper::IsOptimizedLayout(indexPointer));
+
+        for (int i = 0; i < 10; i++) {
+            std::vector<float> query(vectors.begin() + i * dim, vectors.begin() + (i + 1) * dim);
+            std::unique_ptr<std::vector<std::pair<int, float> *>> results(
+                    reinterpret_cast<std::vector<std::pair<int, float> *> *>(
+                            knn_jni::nmslib_wrapper::QueryIndex(&mockJNIUtil, jniEnv, indexPointer,
+                                                                reinterpret_cast<jfloatArray>(&query), 1)));
+            ASSERT_EQ(1, results->size());
+            ASSERT_EQ(i, results->at(0)->first);
+            delete results->at(0);
+        }
+        knn_jni::nmslib_wrapper::Free(indexPointer);
+    }
+
+    // Unknown layouts are rejected
+    std::string invalidLayout = "invalid";
+    std::unordered_map<std::string, jobject> subParametersMap;
+    subParametersMap[knn_jni::INDEX_LAYOUT] = (jobject)&invalidLayout;
+    std::unordered_map<std::string, jobject> parametersMap;
+    parametersMap[knn_jni::SPACE_TYPE] = (jobject)&spaceType;
+    parametersMap[knn_jni::PARAMETERS] = (jobject)&subParametersMap;
+    std::string indexPath = test_util::RandomString(10, "tmp/", ".nmslib");
+    ASSERT_THROW(knn_jni::nmslib_wrapper::CreateIndexFromFlatVectors(
+            &mockJNIUtil, jniEnv, reinterpret_cast<jintArray>(&ids), (jobject)&vectors, dim,
+            (jstring)&indexPath, (jobject)&parametersMap), std::runtime_error);
+    ASSERT_THROW(knn_jni::nmslib_wrapper::IsOptimizedLayout(0), std::runtime_error);
+    ASSERT_THROW(knn_jni::nmslib_wrapper::DescribeIndex(&mockJNIUtil, jniEnv, 0), std::runtime_error);
+}
+
 TEST(NmslibFreeTest, BasicAssertions) {
     // Initialize nmslib
     similarity::initLibrary();
@@ -0,0 +1,73 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "qos.h"
+
+#include <stdexcept>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using knn_jni::qos::SchedulingPolicy;
+
+TEST(QosParseSchedulingPolicyTest, BasicAssertions) {
+    ASSERT_EQ(SchedulingPolicy::NORMAL, knn_jni::qos::ParseSchedulingPolicy("normal"));
+    ASSERT_EQ(SchedulingPolicy::NICE, knn_jni::qos::ParseSchedulingPolicy("nice"));
+    ASSERT_EQ(SchedulingPolicy::IDLE, knn_jni::qos::ParseSchedulingPolicy("idle"));
+    ASSERT_THROW(knn_jni::qos::ParseSchedulingPolicy("realtime"), std::runtime_error);
+}
+
+TEST(QosScopedQueryTest, BasicAssertions) {
+    int before = knn_jni::qos::ActiveQueries();
+    {
+        knn_jni::qos::ScopedQuery first;
+        knn_jni::qos::ScopedQuery second;
+        ASSERT_EQ(before + 2, knn_jni::qos::ActiveQueries());
+
+        // Yielding with queries in flight waits, but always returns
+        knn_jni::qos::YieldToQueries(SchedulingPolicy::NICE);
+
+        // Work at normal priority does not wait at all
+        auto start = std::chrono::steady_clock::now();
+        knn_jni::qos::YieldToQueries(SchedulingPolicy::NORMAL);
+        ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(before, knn_jni::qos::ActiveQueries());
+}
+
+TEST(QosRunWithPolicyTest, BasicAssertions) {
+    std::thread::id caller = std::this_thread::get_id();
+
+    std::thread::id normalThread;
+    knn_jni::qos::RunWithPolicy(SchedulingPolicy::NORMAL, [&normalThread]() {
+        normalThread = std::this_thread::get_id();
+    });
+    ASSERT_EQ(caller, normalThread);
+
+#ifdef __linux__
+    int niceValue = 0;
+    knn_jni::qos::RunWithPolicy(SchedulingPolicy::NICE, [&niceValue]() {
+        niceValue = getpriority(PRIO_PROCESS, (id_t) syscall(SYS_gettid));
+    });
+    ASSERT_GT(niceValue, getpriority(PRIO_PROCESS, (id_t) syscall(SYS_gettid)));
+#endif
+
+    // Exceptions cross back to the calling thread
+    ASSERT_THROW(knn_jni::qos::RunWithPolicy(SchedulingPolicy::IDLE, []() {
+        throw std::runtime_error("Build failed");
+    }), std::runtime_error);
+}
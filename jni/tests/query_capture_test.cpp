@@ -0,0 +1,166 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "query_capture.h"
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_util.h"
+
+namespace {
+    knn_jni::query_capture::IndexIdentity Identity(const std::string& path) {
+        return {knn_jni::query_capture::Engine::NMSLIB, path, {{"space_type", "l2"}, {"efSearch", "100"}}};
+    }
+
+    // Capture a query of dim floats whose first value is marker
+    void CaptureQuery(const void * index, int dim, float marker) {
+        std::vector<float> query(dim, 0.5f);
+        query[0] = marker;
+        std::vector<int64_t> ids = {7, 3, 11};
+        knn_jni::query_capture::Capture(index, query.data(), dim, 3, false, 1000, ids.data(), (int) ids.size());
+    }
+}
+
+TEST(QueryCaptureTest, CapturesRegisteredIndices) {
+    std::string logPath = test_util::RandomString(10, "tmp/", ".log");
+    int index = 0;
+    int unregistered = 0;
+    knn_jni::query_capture::RegisterIndex(&index, Identity("/data/index.hnsw"));
+
+    ASSERT_FALSE(knn_jni::query_capture::ShouldCapture());
+    knn_jni::query_capture::Start(logPath, knn_jni::query_capture::MIN_CAPACITY, 1.0);
+    ASSERT_TRUE(knn_jni::query_capture::ShouldCapture());
+
+    std::vector<float> query = {1.0f, 2.0f, 3.0f, 4.0f};
+    std::vector<int64_t> ids = {42, 7};
+    knn_jni::query_capture::Capture(&index, query.data(), 4, 10, true, 123456, ids.data(), (int) ids.size());
+    knn_jni::query_capture::Capture(&unregistered, query.data(), 4, 10, false, 1, ids.data(), (int) ids.size());
+    knn_jni::query_capture::Stop();
+    ASSERT_FALSE(knn_jni::query_capture::ShouldCapture());
+    CaptureQuery(&index, 4, 1.0f);
+
+    auto records = knn_jni::query_capture::ReadLog(logPath);
+    ASSERT_EQ(1, (int) records.size());
+    const auto& record = records[0];
+    ASSERT_EQ(knn_jni::query_capture::Engine::NMSLIB, record.index.engine);
+    ASSERT_EQ("/data/index.hnsw", record.index.path);
+    ASSERT_EQ(Identity("").parameters, record.index.parameters);
+    ASSERT_EQ(10, record.k);
+    ASSERT_TRUE(record.filtered);
+    ASSERT_EQ(123456u, record.latencyNanos);
+    ASSERT_GT(record.timestampMicros, 0u);
+    ASSERT_EQ(query, record.query);
+    ASSERT_EQ((std::vector<int32_t>{42, 7}), record.resultIds);
+
+    knn_jni::query_capture::UnregisterIndex(&index);
+    std::remove(logPath.c_str());
+}
+
+TEST(QueryCaptureTest, OverwritesOldestRecords) {
+    std::string logPath = test_util::RandomString(10, "tmp/", ".log");
+    int index = 0;
+    knn_jni::query_capture::RegisterIndex(&index, Identity("/data/index.hnsw"));
+    knn_jni::query_capture::Start(logPath, knn_jni::query_capture::MIN_CAPACITY, 1.0);
+
+    // About 400 bytes a record, so the ring laps several times
+    int numQueries = 1000;
+    for (int i = 0; i < numQueries; ++i) {
+        CaptureQuery(&index, 80, (float) i);
+    }
+    knn_jni::query_capture::Stop();
+
+    // The newest records survive, in order and without gaps
+    auto records = knn_jni::query_capture::ReadLog(logPath);
+    ASSERT_GT((int) records.size(), 100);
+    ASSERT_LT((int) records.size(), numQueries);
+    ASSERT_EQ(numQueries - 1, (int) records.back().query[0]);
+    for (size_t i = 1; i < records.size(); ++i) {
+        ASSERT_EQ(records[i - 1].query[0] + 1, records[i].query[0]);
+    }
+
+    knn_jni::query_capture::UnregisterIndex(&index);
+    std::remove(logPath.c_str());
+}
+
+TEST(QueryCaptureTest, WritesConcurrently) {
+    std::string logPath = test_util::RandomString(10, "tmp/", ".log");
+    int numThreads = 4;
+    int queriesPerThread = 500;
+    std::vector<int> indices(numThreads);
+    for (int t = 0; t < numThreads; ++t) {
+        knn_jni::query_capture::RegisterIndex(&indices[t], Identity("/data/index" + std::to_string(t)));
+    }
+    knn_jni::query_capture::Start(logPath, 4 * 1024 * 1024, 1.0);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < queriesPerThread; ++i) {
+                CaptureQuery(&indices[t], 16, (float) i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    knn_jni::query_capture::Stop();
+
+    // Nothing was overwritten, so every record is there, and those of one thread are in the order it wrote them
+    auto records = knn_jni::query_capture::ReadLog(logPath);
+    ASSERT_EQ(numThreads * queriesPerThread, (int) records.size());
+    std::vector<int> next(numThreads, 0);
+    for (const auto& record : records) {
+        int t = record.index.path.back() - '0';
+        ASSERT_EQ(next[t]++, (int) record.query[0]);
+    }
+
+    for (int t = 0; t < numThreads; ++t) {
+        knn_jni::query_capture::UnregisterIndex(&indices[t]);
+    }
+    std::remove(logPath.c_str());
+}
+
+TEST(QueryCaptureTest, ReopensLogs) {
+    std::string logPath = test_util::RandomString(10, "tmp/", ".log");
+    int index = 0;
+    knn_jni::query_capture::RegisterIndex(&index, Identity("/data/index.hnsw"));
+
+    knn_jni::query_capture::Start(logPath, knn_jni::query_capture::MIN_CAPACITY, 1.0);
+    CaptureQuery(&index, 4, 0.0f);
+    knn_jni::query_capture::Stop();
+
+    // A log of the same capacity is appended to, a log of another capacity replaced
+    knn_jni::query_capture::Start(logPath, knn_jni::query_capture::MIN_CAPACITY, 1.0);
+    CaptureQuery(&index, 4, 1.0f);
+    knn_jni::query_capture::Stop();
+    ASSERT_EQ(2, (int) knn_jni::query_capture::ReadLog(logPath).size());
+
+    knn_jni::query_capture::Start(logPath, 2 * knn_jni::query_capture::MIN_CAPACITY, 1.0);
+    knn_jni::query_capture::Stop();
+    ASSERT_EQ(0, (int) knn_jni::query_capture::ReadLog(logPath).size());
+
+    ASSERT_THROW(knn_jni::query_capture::Start("", knn_jni::query_capture::MIN_CAPACITY, 1.0), std::runtime_error);
+    ASSERT_THROW(knn_jni::query_capture::Start(logPath, 1024, 1.0), std::runtime_error);
+    ASSERT_THROW(knn_jni::query_capture::Start(logPath, knn_jni::query_capture::MIN_CAPACITY, 1.5),
+                 std::runtime_error);
+
+    std::ofstream(logPath, std::ios::trunc) << "not a log";
+    ASSERT_THROW(knn_jni::query_capture::ReadLog(logPath), std::runtime_error);
+
+    knn_jni::query_capture::UnregisterIndex(&index);
+    std::remove(logPath.c_str());
+}
@@ -23,6 +23,7 @@
 #include "faiss/impl/io.h"
 #include "faiss/index_factory.h"
 #include "faiss/index_io.h"
+#include "faiss_compressed_hnsw.h"
 #include "gmock/gmock.h"
 #include "index.h"
 #include "knnquery.h"
@@ -51,6 +52,29 @@ test_util::MockJNIUtil::MockJNIUtil() {
                 return *reinterpret_cast<std::vector<int64_t> *>(arrayJ);
             });
 
+    // vectorsJ is re-interpreted as std::vector<float> *
+    ON_CALL(*this, ConvertFlatJavaVectorsToCppFloatVector)
+            .WillByDefault([this](JNIEnv *env, jobject vectorsJ, int dim) {
+                return *reinterpret_cast<std::vector<float> *>(vectorsJ);
+            });
+
+    // vectorsJ is re-interpreted as std::vector<uint16_t> * and widened to float
+    ON_CALL(*this, ConvertHalfJavaVectorsToCppFloatVector)
+            .WillByDefault([this](JNIEnv *env, jobject vectorsJ, int dim,
+                                  knn_jni::half_precision::Encoding encoding) {
+                auto values = reinterpret_cast<std::vector<uint16_t> *>(vectorsJ);
+                std::vector<float> data(values->size());
+                knn_jni::half_precision::Decode(encoding, values->data(), values->size(), data.data());
+                return data;
+            });
+
+    // vectorsJ is re-interpreted as std::vector<int8_t> * and widened to float
+    ON_CALL(*this, ConvertByteJavaVectorsToCppFloatVector)
+            .WillByDefault([this](JNIEnv *env, jobject vectorsJ, int dim) {
+                auto values = reinterpret_cast<std::vector<int8_t> *>(vectorsJ);
+                return std::vector<float>(values->begin(), values->end());
+            });
+
     // parametersJ is re-interpreted as std::unordered_map<std::string, jobject> *
     ON_CALL(*this, ConvertJavaMapToCppMap)
             .WillByDefault([this](JNIEnv *env, jobject parametersJ) {
@@ -146,6 +170,21 @@ test_util::MockJNIUtil::MockJNIUtil() {
                 return reinterpret_cast<std::vector<int64_t> *>(arrayJ)->size();
             });
 
+    // arrayJ is re-interpreted as a std::vector<int64_t> * and the size is
+    // returned
+    ON_CALL(*this, GetJavaLongArrayLength)
+            .WillByDefault([this](JNIEnv *env, jlongArray arrayJ) {
+                return reinterpret_cast<std::vector<int64_t> *>(arrayJ)->size();
+            });
+
+    // arrayJ is re-interpreted as a std::vector<int64_t> * and then the data is
+    // re-interpreted as a jlong *
+    ON_CALL(*this, GetLongArrayElements)
+            .WillByDefault([this](JNIEnv *env, jlongArray arrayJ, jboolean *isCopy) {
+                return reinterpret_cast<jlong *>(
+                        reinterpret_cast<std::vector<int64_t> *>(arrayJ)->data());
+            });
+
     // arrayJ is re-interpreted as a std::vector<std::vector<float>> * and then
     // the 'index' element is re-interpreted as a jobject
     ON_CALL(*this, GetObjectArrayElement)
@@ -160,6 +199,16 @@ test_util::MockJNIUtil::MockJNIUtil() {
         return reinterpret_cast<jbyteArray>(new std::vector<uint8_t>());
     });
 
+    // Create a new std::vector<int32_t> of len values and re-interpret it as a jintArray
+    ON_CALL(*this, NewIntArray).WillByDefault([this](JNIEnv *env, jsize len) {
+        return reinterpret_cast<jintArray>(new std::vector<int32_t>(len));
+    });
+
+    // Create a new std::vector<float> of len values and re-interpret it as a jfloatArray
+    ON_CALL(*this, NewFloatArray).WillByDefault([this](JNIEnv *env, jsize len) {
+        return reinterpret_cast<jfloatArray>(new std::vector<float>(len));
+    });
+
     // Create a new std::pair<int, float> with the id and distance and then
     // re-interpret it as a jobject
     ON_CALL(*this, NewObject)
@@ -193,6 +242,11 @@ test_util::MockJNIUtil::MockJNIUtil() {
             .WillByDefault(
                     [this](JNIEnv *env, jintArray array, jint *elems, int mode) {});
 
+    // This function should not do anything meaningful in the unit tests
+    ON_CALL(*this, ReleaseLongArrayElements)
+            .WillByDefault(
+                    [this](JNIEnv *env, jlongArray array, jlong *elems, jint mode) {});
+
     // array is re-interpreted as a std::vector<uint8_t> * and then the bytes from
     // buf are copied to it
     ON_CALL(*this, SetByteArrayRegion)
@@ -204,6 +258,20 @@ test_util::MockJNIUtil::MockJNIUtil() {
                 }
             });
 
+    ON_CALL(*this, SetIntArrayRegion)
+            .WillByDefault([this](JNIEnv *env, jintArray array, jsize start,
+                                  jsize len, const jint *buf) {
+                auto intBuffer = reinterpret_cast<std::vector<int32_t> *>(array);
+                std::copy(buf, buf + len, intBuffer->begin() + start);
+            });
+
+    ON_CALL(*this, SetFloatArrayRegion)
+            .WillByDefault([this](JNIEnv *env, jfloatArray array, jsize start,
+                                  jsize len, const jfloat *buf) {
+                auto floatBuffer = reinterpret_cast<std::vector<float> *>(array);
+                std::copy(buf, buf + len, floatBuffer->begin() + start);
+            });
+
     // array is re-interpreted as a std::vector<std::pair<int, float> *> * and
     // then val is re-interpreted as a std::pair<int, float> * and added to the
     // vector
@@ -247,7 +315,7 @@ void test_util::FaissWriteIndex(faiss::Index *index,
 }
 
 faiss::Index *test_util::FaissLoadIndex(const std::string &indexPath) {
-    return faiss::read_index(indexPath.c_str(), faiss::IO_FLAG_READ_ONLY);
+    return knn_jni::faiss_wrapper::ReadIndex(indexPath, faiss::IO_FLAG_READ_ONLY);
 }
 
 void test_util::FaissQueryIndex(faiss::Index *index, float *query, int k,
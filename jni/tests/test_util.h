@@ -46,6 +46,12 @@ namespace test_util {
                     (JNIEnv * env, jobjectArray array2dJ, int dim));
         MOCK_METHOD(std::vector<int64_t>, ConvertJavaIntArrayToCppIntVector,
                     (JNIEnv * env, jintArray arrayJ));
+        MOCK_METHOD(std::vector<float>, ConvertFlatJavaVectorsToCppFloatVector,
+                    (JNIEnv * env, jobject vectorsJ, int dim));
+        MOCK_METHOD(std::vector<float>, ConvertHalfJavaVectorsToCppFloatVector,
+                    (JNIEnv * env, jobject vectorsJ, int dim, knn_jni::half_precision::Encoding encoding));
+        MOCK_METHOD(std::vector<float>, ConvertByteJavaVectorsToCppFloatVector,
+                    (JNIEnv * env, jobject vectorsJ, int dim));
         MOCK_METHOD2(ConvertJavaMapToCppMap,
                      std::unordered_map<std::string, jobject>(JNIEnv* env,
                                                               jobject parametersJ));
@@ -64,9 +70,12 @@ namespace test_util {
                     (JNIEnv * env, jobjectArray array2dJ));
         MOCK_METHOD(jint*, GetIntArrayElements,
                     (JNIEnv * env, jintArray array, jboolean* isCopy));
+        MOCK_METHOD(jlong*, GetLongArrayElements,
+                    (JNIEnv * env, jlongArray array, jboolean* isCopy));
         MOCK_METHOD(int, GetJavaBytesArrayLength, (JNIEnv * env, jbyteArray arrayJ));
         MOCK_METHOD(int, GetJavaFloatArrayLength, (JNIEnv * env, jfloatArray arrayJ));
         MOCK_METHOD(int, GetJavaIntArrayLength, (JNIEnv * env, jintArray arrayJ));
+        MOCK_METHOD(int, GetJavaLongArrayLength, (JNIEnv * env, jlongArray arrayJ));
         MOCK_METHOD(int, GetJavaObjectArrayLength,
                     (JNIEnv * env, jobjectArray arrayJ));
         MOCK_METHOD(jobject, GetObjectArrayElement,
@@ -75,6 +84,8 @@ namespace test_util {
         MOCK_METHOD(void, HasExceptionInStack,
                     (JNIEnv * env, const std::string& message));
         MOCK_METHOD(jbyteArray, NewByteArray, (JNIEnv * env, jsize len));
+        MOCK_METHOD(jintArray, NewIntArray, (JNIEnv * env, jsize len));
+        MOCK_METHOD(jfloatArray, NewFloatArray, (JNIEnv * env, jsize len));
         MOCK_METHOD(jobject, NewObject,
                     (JNIEnv * env, jclass clazz, jmethodID methodId, int id,
                             float distance));
@@ -86,9 +97,17 @@ namespace test_util {
                     (JNIEnv * env, jfloatArray array, jfloat* elems, int mode));
         MOCK_METHOD(void, ReleaseIntArrayElements,
                     (JNIEnv * env, jintArray array, jint* elems, jint mode));
+        MOCK_METHOD(void, ReleaseLongArrayElements,
+                    (JNIEnv * env, jlongArray array, jlong* elems, jint mode));
         MOCK_METHOD(void, SetByteArrayRegion,
                     (JNIEnv * env, jbyteArray array, jsize start, jsize len,
                             const jbyte* buf));
+        MOCK_METHOD(void, SetIntArrayRegion,
+                    (JNIEnv * env, jintArray array, jsize start, jsize len,
+                            const jint* buf));
+        MOCK_METHOD(void, SetFloatArrayRegion,
+                    (JNIEnv * env, jfloatArray array, jsize start, jsize len,
+                            const jfloat* buf));
         MOCK_METHOD(void, SetObjectArrayElement,
                     (JNIEnv * env, jobjectArray array, jsize index, jobject val));
         MOCK_METHOD(void, ThrowJavaException,
@@ -0,0 +1,122 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "thread_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using knn_jni::thread_pool::BackgroundWorker;
+using knn_jni::thread_pool::CpuBudget;
+using knn_jni::thread_pool::ThreadBudget;
+
+TEST(CpuBudgetAcquireThreadsTest, BasicAssertions) {
+    CpuBudget budget(4);
+
+    // Requests are reduced to what is left of the budget
+    int first = budget.AcquireThreads(3);
+    int second = budget.AcquireThreads(3);
+    ASSERT_EQ(3, first);
+    ASSERT_EQ(1, second);
+    ASSERT_EQ(4, budget.BorrowedThreads());
+
+    budget.ReleaseThreads(first + second);
+    ASSERT_EQ(0, budget.BorrowedThreads());
+}
+
+TEST(CpuBudgetWaitTest, BasicAssertions) {
+    CpuBudget budget(2);
+    int held = budget.AcquireThreads(2);
+    ASSERT_EQ(2, held);
+
+    // The budget is used up, so the next build waits instead of oversubscribing the node
+    std::atomic<int> granted(0);
+    std::thread waiter([&budget, &granted]() { granted = budget.AcquireThreads(2); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(0, granted.load());
+    ASSERT_EQ(2, budget.BorrowedThreads());
+
+    budget.ReleaseThreads(held);
+    waiter.join();
+    ASSERT_EQ(2, granted.load());
+    ASSERT_EQ(2, budget.BorrowedThreads());
+    budget.ReleaseThreads(granted);
+}
+
+TEST(CpuBudgetResizeTest, BasicAssertions) {
+    CpuBudget budget(1);
+    ASSERT_EQ(1, budget.Size());
+    int held = budget.AcquireThreads(1);
+
+    // Growing the budget lets a waiting build through
+    std::atomic<int> granted(0);
+    std::thread waiter([&budget, &granted]() { granted = budget.AcquireThreads(4); });
+    budget.Resize(3);
+    waiter.join();
+    ASSERT_EQ(3, budget.Size());
+    ASSERT_EQ(2, granted.load());
+
+    // 0 or less means one thread per hardware thread, and the size is capped
+    budget.Resize(0);
+    ASSERT_EQ(std::max(1, (int) std::thread::hardware_concurrency()), budget.Size());
+    budget.Resize(knn_jni::thread_pool::MAX_POOL_SIZE + 1);
+    ASSERT_EQ(knn_jni::thread_pool::MAX_POOL_SIZE, budget.Size());
+
+    budget.ReleaseThreads(held + granted);
+    ASSERT_EQ(0, budget.BorrowedThreads());
+}
+
+TEST(ThreadBudgetTest, BasicAssertions) {
+    CpuBudget& budget = CpuBudget::Instance();
+    int borrowed = budget.BorrowedThreads();
+    {
+        ThreadBudget threadBudget(1);
+        ASSERT_EQ(1, threadBudget.Count());
+        ASSERT_EQ(borrowed + 1, budget.BorrowedThreads());
+    }
+    ASSERT_EQ(borrowed, budget.BorrowedThreads());
+
+    // Without a request nothing is borrowed and the library default is kept
+    ThreadBudget defaultBudget(0);
+    ASSERT_EQ(0, defaultBudget.Count());
+    ASSERT_EQ(borrowed, budget.BorrowedThreads());
+}
+
+TEST(BackgroundWorkerTest, BasicAssertions) {
+    BackgroundWorker worker;
+
+    std::mutex mutex;
+    std::condition_variable done;
+    std::vector<int> order;
+    for (int i = 0; i < 10; ++i) {
+        worker.Submit([i, &mutex, &done, &order]() {
+            if (i == 3) {
+                throw std::runtime_error("Failed task");
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(i);
+            done.notify_all();
+        });
+    }
+
+    // Tasks run in submission order, and a failing task does not stop the ones after it
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&order]() { return order.size() == 9; });
+    std::vector<int> expected = {0, 1, 2, 4, 5, 6, 7, 8, 9};
+    ASSERT_EQ(expected, order);
+}
@@ -0,0 +1,325 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+
+// Micro-benchmarks for the JNI boundary. A JVM is embedded with JNI_CreateJavaVM, and every JNIUtil converter the
+// wrappers call on the query and build paths is timed against real Java objects, across vector sizes.
+//
+//   jni_benchmark --classpath build/classes/java/main [--min-time-ms 200] [--output baseline.csv]
+//                 [--library-path jni/release]
+//
+// The classpath must contain org.opensearch.knn.index.KNNQueryResult, which JNIUtil::Initialize looks up. The cost
+// of an empty native call is measured by calling FaissService.free(0) from native code, which needs the plugin's
+// runtime classpath and --library-path pointing at the JNI libraries; it is skipped when the class cannot be loaded.
+// Times are the mean per call, in nanoseconds, after one warm up batch.
+
+#include "jni_util.h"
+#include "tool_options.h"
+
+#include <jni.h>
+
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace {
+    using knn_jni::tools::Options;
+
+    // Iterations run between two local frames, so that the references a benchmark creates are freed regularly
+    const int BATCH_SIZE = 16;
+
+    class Reporter {
+    public:
+        explicit Reporter(const std::string& path) : csv(nullptr, &fclose) {
+            if (!path.empty()) {
+                csv.reset(fopen(path.c_str(), "w"));
+                if (csv == nullptr) {
+                    throw std::runtime_error("Unable to open " + path + " for writing");
+                }
+                fprintf(csv.get(), "benchmark,size,ns_per_call\n");
+            }
+            printf("%-56s %10s %14s\n", "benchmark", "size", "ns/call");
+        }
+
+        void Report(const std::string& name, const std::string& size, double nanos) {
+            printf("%-56s %10s %14.1f\n", name.c_str(), size.c_str(), nanos);
+            if (csv != nullptr) {
+                fprintf(csv.get(), "%s,%s,%.1f\n", name.c_str(), size.c_str(), nanos);
+            }
+        }
+
+    private:
+        std::unique_ptr<FILE, int(*)(FILE*)> csv;
+    };
+
+    // Run body in batches until minTime has passed, after a warm up batch, and return the mean time per call in
+    // nanoseconds. Each batch runs in its own local frame, whose cost is included but amortized over the batch
+    template <typename Body>
+    double Measure(JNIEnv* env, std::chrono::milliseconds minTime, Body body) {
+        auto runBatch = [&]() {
+            if (env->PushLocalFrame(BATCH_SIZE * 4) != 0) {
+                throw std::runtime_error("Unable to push a local frame");
+            }
+            for (int i = 0; i < BATCH_SIZE; ++i) {
+                body();
+            }
+            env->PopLocalFrame(nullptr);
+            if (env->ExceptionCheck()) {
+                env->ExceptionDescribe();
+                throw std::runtime_error("Java exception during benchmark");
+            }
+        };
+
+        runBatch();
+        int64_t calls = 0;
+        auto start = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::duration elapsed;
+        do {
+            runBatch();
+            calls += BATCH_SIZE;
+            elapsed = std::chrono::steady_clock::now() - start;
+        } while (elapsed < minTime);
+        return std::chrono::duration<double, std::nano>(elapsed).count() / calls;
+    }
+
+    jclass FindClassOrThrow(JNIEnv* env, const char* name) {
+        jclass clazz = env->FindClass(name);
+        if (clazz == nullptr) {
+            env->ExceptionClear();
+            throw std::runtime_error(std::string("Unable to find class ") + name);
+        }
+        return clazz;
+    }
+
+    // Java objects are created once as global references, so that only the conversions are timed
+
+    jobject Global(JNIEnv* env, jobject local) {
+        jobject global = env->NewGlobalRef(local);
+        env->DeleteLocalRef(local);
+        return global;
+    }
+
+    jfloatArray NewFloatArray(JNIEnv* env, int dim) {
+        std::vector<jfloat> values(dim);
+        for (int i = 0; i < dim; ++i) {
+            values[i] = (jfloat) i / dim;
+        }
+        jfloatArray array = env->NewFloatArray(dim);
+        env->SetFloatArrayRegion(array, 0, dim, values.data());
+        return array;
+    }
+
+    jobjectArray NewVectors(JNIEnv* env, int count, int dim) {
+        jobjectArray vectors = env->NewObjectArray(count, FindClassOrThrow(env, "[F"), nullptr);
+        for (int i = 0; i < count; ++i) {
+            jfloatArray vector = NewFloatArray(env, dim);
+            env->SetObjectArrayElement(vectors, i, vector);
+            env->DeleteLocalRef(vector);
+        }
+        return (jobjectArray) Global(env, vectors);
+    }
+
+    // The same vectors laid out back to back in one float[]
+    jfloatArray NewFlatVectors(JNIEnv* env, int count, int dim) {
+        return (jfloatArray) Global(env, NewFloatArray(env, count * dim));
+    }
+
+    jintArray NewIds(JNIEnv* env, int count) {
+        std::vector<jint> values(count);
+        for (int i = 0; i < count; ++i) {
+            values[i] = i;
+        }
+        jintArray ids = env->NewIntArray(count);
+        env->SetIntArrayRegion(ids, 0, count, values.data());
+        return (jintArray) Global(env, ids);
+    }
+
+    // HashMap<String, Object> shaped like the build parameters: string and integer values
+    jobject NewParameters(JNIEnv* env, int numEntries) {
+        jclass hashMapClass = FindClassOrThrow(env, "java/util/HashMap");
+        jclass integerClass = FindClassOrThrow(env, "java/lang/Integer");
+        jmethodID constructor = env->GetMethodID(hashMapClass, "<init>", "()V");
+        jmethodID put = env->GetMethodID(hashMapClass, "put", "(Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;");
+        jmethodID valueOf = env->GetStaticMethodID(integerClass, "valueOf", "(I)Ljava/lang/Integer;");
+
+        jobject map = env->NewObject(hashMapClass, constructor);
+        for (int i = 0; i < numEntries; ++i) {
+            jstring key = env->NewStringUTF(("parameter_" + std::to_string(i)).c_str());
+            jobject value = i % 2 == 0 ? env->CallStaticObjectMethod(integerClass, valueOf, i)
+                                       : env->NewStringUTF("value");
+            env->DeleteLocalRef(env->CallObjectMethod(map, put, key, value));
+            env->DeleteLocalRef(key);
+            env->DeleteLocalRef(value);
+        }
+        return Global(env, map);
+    }
+
+    void RunBenchmarks(JNIEnv* env, const Options& options) {
+        std::chrono::milliseconds minTime(options.GetInt("min-time-ms", 200));
+        Reporter reporter(options.Get("output", ""));
+        knn_jni::JNIUtil jniUtil;
+        jniUtil.Initialize(env);
+
+        const std::vector<int> dims = {16, 128, 768, 960};
+        const std::vector<int> ks = {1, 10, 100, 1000};
+
+        // Fixed costs: the cheapest JNIEnv function, a call from native code into a trivial Java method, and a round
+        // trip through an empty native method of the plugin
+        jintArray ids = NewIds(env, 1);
+        reporter.Report("JNIEnv::GetArrayLength", "-", Measure(env, minTime, [&]() {
+            env->GetArrayLength(ids);
+        }));
+
+        jclass mathClass = FindClassOrThrow(env, "java/lang/Math");
+        jmethodID abs = env->GetStaticMethodID(mathClass, "abs", "(I)I");
+        reporter.Report("upcall Math.abs", "-", Measure(env, minTime, [&]() {
+            env->CallStaticIntMethod(mathClass, abs, -1);
+        }));
+
+        jclass faissService = env->FindClass("org/opensearch/knn/jni/FaissService");
+        jmethodID freeMethod = faissService == nullptr ? nullptr
+                                                      : env->GetStaticMethodID(faissService, "free", "(J)V");
+        if (freeMethod != nullptr) {
+            env->CallStaticVoidMethod(faissService, freeMethod, (jlong) 0);
+        }
+        if (freeMethod == nullptr || env->ExceptionCheck()) {
+            env->ExceptionClear();
+            printf("%-56s %10s %14s\n", "upcall FaissService.free (empty native call)", "-", "skipped");
+        } else {
+            reporter.Report("upcall FaissService.free (empty native call)", "-", Measure(env, minTime, [&]() {
+                env->CallStaticVoidMethod(faissService, freeMethod, (jlong) 0);
+            }));
+        }
+
+        // Build path: ids and vectors of a segment
+        for (int count : {1000, 100000}) {
+            jintArray idsJ = NewIds(env, count);
+            reporter.Report("ConvertJavaIntArrayToCppIntVector", std::to_string(count), Measure(env, minTime, [&]() {
+                jniUtil.ConvertJavaIntArrayToCppIntVector(env, idsJ);
+            }));
+            env->DeleteGlobalRef(idsJ);
+        }
+
+        for (int dim : dims) {
+            jobjectArray vectors = NewVectors(env, 1000, dim);
+            // The converter deletes the reference it is given, so each call gets a fresh local one
+            reporter.Report("Convert2dJavaObjectArrayToCppFloatVector 1000x", std::to_string(dim),
+                            Measure(env, minTime, [&]() {
+                jniUtil.Convert2dJavaObjectArrayToCppFloatVector(env, (jobjectArray) env->NewLocalRef(vectors), dim);
+            }));
+            env->DeleteGlobalRef(vectors);
+
+            jfloatArray flatVectors = NewFlatVectors(env, 1000, dim);
+            reporter.Report("ConvertFlatJavaVectorsToCppFloatVector float[] 1000x", std::to_string(dim),
+                            Measure(env, minTime, [&]() {
+                jniUtil.ConvertFlatJavaVectorsToCppFloatVector(env, flatVectors, dim);
+            }));
+            env->DeleteGlobalRef(flatVectors);
+
+            std::vector<float> nativeVectors((size_t) 1000 * dim);
+            jobject buffer = Global(env, env->NewDirectByteBuffer(nativeVectors.data(),
+                                                                  (jlong) (nativeVectors.size() * sizeof(float))));
+            reporter.Report("ConvertFlatJavaVectorsToCppFloatVector direct 1000x", std::to_string(dim),
+                            Measure(env, minTime, [&]() {
+                jniUtil.ConvertFlatJavaVectorsToCppFloatVector(env, buffer, dim);
+            }));
+            env->DeleteGlobalRef(buffer);
+        }
+
+        for (int numEntries : {1, 4, 16}) {
+            jobject parameters = NewParameters(env, numEntries);
+            reporter.Report("ConvertJavaMapToCppMap", std::to_string(numEntries), Measure(env, minTime, [&]() {
+                jniUtil.ConvertJavaMapToCppMap(env, parameters);
+            }));
+            env->DeleteGlobalRef(parameters);
+        }
+
+        jobject parameters = NewParameters(env, 1);
+        jobject integer = jniUtil.ConvertJavaMapToCppMap(env, parameters)["parameter_0"];
+        reporter.Report("ConvertJavaObjectToCppInteger", "-", Measure(env, minTime, [&]() {
+            jniUtil.ConvertJavaObjectToCppInteger(env, integer);
+        }));
+        env->DeleteLocalRef(integer);
+        env->DeleteGlobalRef(parameters);
+
+        // Query path: reading the query vector and building the results, as the wrappers do for every query
+        for (int dim : dims) {
+            auto query = (jfloatArray) Global(env, NewFloatArray(env, dim));
+            reporter.Report("GetFloatArrayElements query", std::to_string(dim), Measure(env, minTime, [&]() {
+                jfloat* values = jniUtil.GetFloatArrayElements(env, query, nullptr);
+                jniUtil.ReleaseFloatArrayElements(env, query, values, JNI_ABORT);
+            }));
+            env->DeleteGlobalRef(query);
+        }
+
+        for (int k : ks) {
+            reporter.Report("KNNQueryResult array construction", std::to_string(k), Measure(env, minTime, [&]() {
+                jclass resultClass = jniUtil.FindClass(env, "org/opensearch/knn/index/KNNQueryResult");
+                jmethodID allArgs = jniUtil.FindMethod(env, "org/opensearch/knn/index/KNNQueryResult", "<init>");
+                jobjectArray results = jniUtil.NewObjectArray(env, k, resultClass, nullptr);
+                for (int i = 0; i < k; ++i) {
+                    jobject result = jniUtil.NewObject(env, resultClass, allArgs, i, (float) i);
+                    jniUtil.SetObjectArrayElement(env, results, i, result);
+                    jniUtil.DeleteLocalRef(env, result);
+                }
+                jniUtil.DeleteLocalRef(env, results);
+            }));
+        }
+
+        env->DeleteGlobalRef(ids);
+        jniUtil.Uninitialize(env);
+    }
+}
+
+int main(int argc, char** argv) {
+    try {
+        Options options(argc, argv, 1);
+
+        std::vector<std::string> jvmOptions = {"-Djava.class.path=" + options.Get("classpath")};
+        if (options.Has("library-path")) {
+            jvmOptions.push_back("-Djava.library.path=" + options.Get("library-path"));
+        }
+        std::vector<JavaVMOption> jvmOptionsJ(jvmOptions.size());
+        for (size_t i = 0; i < jvmOptions.size(); ++i) {
+            jvmOptionsJ[i].optionString = const_cast<char*>(jvmOptions[i].c_str());
+            jvmOptionsJ[i].extraInfo = nullptr;
+        }
+
+        JavaVMInitArgs initArgs;
+        initArgs.version = JNI_VERSION_1_8;
+        initArgs.nOptions = (jint) jvmOptionsJ.size();
+        initArgs.options = jvmOptionsJ.data();
+        initArgs.ignoreUnrecognized = JNI_FALSE;
+
+        JavaVM* jvm;
+        JNIEnv* env;
+        if (JNI_CreateJavaVM(&jvm, reinterpret_cast<void**>(&env), &initArgs) != JNI_OK) {
+            throw std::runtime_error("Unable to create the Java VM");
+        }
+
+        try {
+            RunBenchmarks(env, options);
+        } catch (...) {
+            jvm->DestroyJavaVM();
+            throw;
+        }
+        jvm->DestroyJavaVM();
+    } catch (const std::exception& e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,248 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+
+// Replays a query capture log, written by a node with knn.query_capture.sample_rate set, against the index files the
+// queries ran on, without a cluster.
+//
+//   knn_capture_replay --log knn_query_capture.log [--from /var/lib/opensearch --to /mnt/copy] [--threads 8]
+//
+// Each index is loaded once with the load parameters recorded with its queries. Paths starting with --from are read
+// from under --to instead, for index files copied off the node. Every query is run again through QueryIndex on one of
+// --threads threads. For each index the tool prints the captured and replayed latencies, and how many of the captured
+// result ids the replay returned again. Queries captured with deleted docs left out are skipped, since the live docs
+// are not part of the log.
+
+#include "faiss_wrapper.h"
+#include "jni_util.h"
+#include "nmslib_wrapper.h"
+#include "query_capture.h"
+#include "replay_jni_util.h"
+#include "tool_options.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+
+namespace {
+    using knn_jni::query_capture::Engine;
+    using knn_jni::query_capture::IndexIdentity;
+    using knn_jni::query_capture::Record;
+    using knn_jni::replay::FromJava;
+    using knn_jni::replay::ToJava;
+    using knn_jni::tools::Options;
+    using knn_jni::tools::Percentile;
+
+    // The queries of the log that ran on one index, loaded the same way
+    struct IndexReplay {
+        IndexIdentity identity;
+        std::vector<const Record *> records;
+        std::vector<double> capturedLatencies;
+        std::vector<double> replayedLatencies;
+        std::vector<double> agreements;
+    };
+
+    std::string Key(const IndexIdentity& identity) {
+        std::string key = std::to_string((int) identity.engine) + '\n' + identity.path;
+        for (const auto& parameter : identity.parameters) {
+            key += '\n' + parameter.first + '=' + parameter.second;
+        }
+        return key;
+    }
+
+    std::string MapPath(const std::string& path, const Options& options) {
+        std::string from = options.Get("from", "");
+        if (from.empty() || path.compare(0, from.size(), from) != 0) {
+            return path;
+        }
+        return options.Get("to") + path.substr(from.size());
+    }
+
+    bool FileExists(const std::string& path) {
+        return std::ifstream(path).good();
+    }
+
+    jlong LoadIndex(knn_jni::replay::ReplayJNIUtil& jniUtil, const IndexIdentity& identity, const std::string& path) {
+        knn_jni::replay::Map parameters;
+        for (const auto& parameter : identity.parameters) {
+            knn_jni::replay::Object * value;
+            if (parameter.first == "efSearch") {
+                value = new knn_jni::replay::Integer(std::stoi(parameter.second));
+            } else {
+                value = new knn_jni::replay::String(parameter.second);
+            }
+            parameters.entries[parameter.first].reset(value);
+        }
+
+        knn_jni::replay::String pathJ(path);
+        if (identity.engine == Engine::FAISS) {
+            return knn_jni::faiss_wrapper::LoadIndex(&jniUtil, nullptr, ToJava<jstring>(&pathJ),
+                                                    ToJava<jobject>(&parameters));
+        }
+        return knn_jni::nmslib_wrapper::LoadIndex(&jniUtil, nullptr, ToJava<jstring>(&pathJ),
+                                                  ToJava<jobject>(&parameters));
+    }
+
+    void FreeIndex(const IndexIdentity& identity, jlong indexPointer) {
+        if (identity.engine == Engine::FAISS) {
+            knn_jni::faiss_wrapper::Free(indexPointer);
+        } else {
+            knn_jni::nmslib_wrapper::Free(indexPointer);
+        }
+    }
+
+    // Fraction of the captured ids the replay returned again
+    double Agreement(const std::vector<int32_t>& captured, jobjectArray resultsJ) {
+        if (captured.empty()) {
+            return 1.0;
+        }
+        std::unordered_set<int32_t> replayed;
+        for (const auto& result : FromJava<knn_jni::replay::ObjectArray>(resultsJ).elements) {
+            replayed.insert(FromJava<knn_jni::replay::QueryResult>(result.get()).id);
+        }
+        size_t found = 0;
+        for (int32_t id : captured) {
+            found += replayed.count(id);
+        }
+        return (double) found / captured.size();
+    }
+
+    void ReplayIndex(knn_jni::replay::ReplayJNIUtil& jniUtil, IndexReplay& replay, jlong indexPointer,
+                     int numThreads) {
+        size_t numRecords = replay.records.size();
+        replay.replayedLatencies.resize(numRecords);
+        replay.agreements.resize(numRecords);
+
+        std::atomic<size_t> nextRecord(0);
+        std::exception_ptr failure;
+        std::atomic<bool> failed(false);
+        auto worker = [&]() {
+            try {
+                size_t i;
+                while (!failed && (i = nextRecord++) < numRecords) {
+                    const Record& record = *replay.records[i];
+                    knn_jni::replay::FloatArray query;
+                    query.values = record.query;
+                    auto queryJ = ToJava<jfloatArray>(&query);
+
+                    auto start = std::chrono::steady_clock::now();
+                    std::unique_ptr<knn_jni::replay::Object> resultsJ(reinterpret_cast<knn_jni::replay::Object *>(
+                            replay.identity.engine == Engine::FAISS
+                            ? knn_jni::faiss_wrapper::QueryIndex(&jniUtil, nullptr, indexPointer, queryJ, record.k)
+                            : knn_jni::nmslib_wrapper::QueryIndex(&jniUtil, nullptr, indexPointer, queryJ, record.k)));
+                    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+                    replay.replayedLatencies[i] = elapsed.count();
+                    replay.agreements[i] = Agreement(record.resultIds, ToJava<jobjectArray>(resultsJ.get()));
+                }
+            } catch (...) {
+                if (!failed.exchange(true)) {
+                    failure = std::current_exception();
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back(worker);
+        }
+        for (auto & thread : threads) {
+            thread.join();
+        }
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+
+    void Report(const IndexReplay& replay) {
+        std::vector<double> captured(replay.capturedLatencies);
+        std::vector<double> replayed(replay.replayedLatencies);
+        std::sort(captured.begin(), captured.end());
+        std::sort(replayed.begin(), replayed.end());
+        double agreement = 0;
+        for (double value : replay.agreements) {
+            agreement += value;
+        }
+
+        printf("%s (%s)\n", replay.identity.path.c_str(),
+               replay.identity.engine == Engine::FAISS ? knn_jni::FAISS_NAME.c_str() : knn_jni::NMSLIB_NAME.c_str());
+        printf("  queries %ld\n", (long) replay.records.size());
+        printf("  captured latency p50 %.3fms p99 %.3fms\n", Percentile(captured, 0.5), Percentile(captured, 0.99));
+        printf("  replayed latency p50 %.3fms p99 %.3fms\n", Percentile(replayed, 0.5), Percentile(replayed, 0.99));
+        printf("  result agreement %.4f\n", replay.agreements.empty() ? 0 : agreement / replay.agreements.size());
+    }
+
+    void Replay(const Options& options) {
+        int numThreads = options.GetInt("threads", (int) std::thread::hardware_concurrency());
+        auto records = knn_jni::query_capture::ReadLog(options.Get("log"));
+
+        // Indices are replayed in the order their first query was captured
+        std::map<std::string, size_t> replayIndices;
+        std::vector<IndexReplay> replays;
+        long filtered = 0;
+        for (const auto& record : records) {
+            if (record.filtered) {
+                filtered++;
+                continue;
+            }
+            auto entry = replayIndices.emplace(Key(record.index), replays.size());
+            if (entry.second) {
+                replays.push_back(IndexReplay{record.index, {}, {}, {}, {}});
+            }
+            IndexReplay& replay = replays[entry.first->second];
+            replay.records.push_back(&record);
+            replay.capturedLatencies.push_back(record.latencyNanos / 1e6);
+        }
+        printf("Read %ld queries on %ld indices, skipped %ld queries with deleted docs\n", (long) records.size(),
+               (long) replays.size(), filtered);
+
+        knn_jni::replay::ReplayJNIUtil jniUtil;
+        for (auto& replay : replays) {
+            std::string path = MapPath(replay.identity.path, options);
+            if (!FileExists(path)) {
+                printf("%s: not found, skipped %ld queries\n", path.c_str(), (long) replay.records.size());
+                continue;
+            }
+
+            jlong indexPointer = LoadIndex(jniUtil, replay.identity, path);
+            try {
+                ReplayIndex(jniUtil, replay, indexPointer, numThreads);
+            } catch (...) {
+                FreeIndex(replay.identity, indexPointer);
+                throw;
+            }
+            FreeIndex(replay.identity, indexPointer);
+            Report(replay);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    try {
+        Options options(argc, argv, 1);
+        Replay(options);
+    } catch (const std::exception& e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,180 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+// Command line tool that prepares ground truth for the perf-tool datasets and measures the recall of native indices.
+//
+//   knn_ground_truth ground-truth --dataset data.hdf5 --output out.hdf5 --k 100 --space l2
+//   knn_ground_truth ground-truth --base base.fvecs --queries query.fvecs --output gt.ivecs [--distances gt.fvecs]
+//                                 --k 100 --space l2
+//   knn_ground_truth recall (--index path | --method "HNSW32,Flat") (--dataset data.hdf5 |
+//                           --base base.fvecs --queries query.fvecs --ground-truth gt.ivecs) --k 10 --r 10 --space l2
+//                           [--ef-search 100] [--nprobes 16]
+//
+// Every command takes --threads, which defaults to the number of hardware threads. HDF5 files follow the
+// ann-benchmarks layout the perf-tool reads: "train", "test", "neighbors" and "distances" datasets. Indices given by
+// --index must have been built with the row numbers of the base vectors as ids.
+
+#include "faiss_compact_id_map_index.h"
+#include "faiss_compressed_hnsw.h"
+#include "ground_truth.h"
+#include "jni_util.h"
+#include "tool_options.h"
+#include "vecs_io.h"
+#ifdef KNN_WITH_HDF5
+#include "hdf5_io.h"
+#endif
+
+#include "faiss/index_factory.h"
+#include "faiss/index_io.h"
+#include "faiss/IndexHNSW.h"
+#include "faiss/IndexIVF.h"
+#include "faiss/IndexPreTransform.h"
+
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <omp.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace {
+    using knn_jni::tools::Options;
+    using knn_jni::tools::ReadHdf5Floats;
+    using knn_jni::vecs_io::Matrix;
+
+    void GroundTruth(const Options& options) {
+        int k = options.GetInt("k");
+        std::string spaceType = options.Get("space", knn_jni::L2);
+        int numThreads = options.GetInt("threads", (int) std::thread::hardware_concurrency());
+
+        Matrix<float> base;
+        Matrix<float> queries;
+        if (options.Has("dataset")) {
+            base = ReadHdf5Floats(options.Get("dataset"), "train");
+            queries = ReadHdf5Floats(options.Get("dataset"), "test");
+        } else {
+            base = knn_jni::vecs_io::ReadVectors(options.Get("base"));
+            queries = knn_jni::vecs_io::ReadVectors(options.Get("queries"));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        Matrix<int32_t> neighbors;
+        Matrix<float> distances;
+        knn_jni::ground_truth::ComputeGroundTruth(base, queries, k, spaceType, numThreads, neighbors, distances);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        printf("Computed top %d of %ld queries against %ld vectors in %.1fs\n", k, (long) queries.rows,
+               (long) base.rows, elapsed.count());
+
+        std::string output = options.Get("output");
+        if (options.Has("dataset")) {
+#ifdef KNN_WITH_HDF5
+            knn_jni::hdf5_io::CreateFile(output);
+            knn_jni::hdf5_io::WriteDataset(output, "train", base);
+            knn_jni::hdf5_io::WriteDataset(output, "test", queries);
+            knn_jni::hdf5_io::WriteDataset(output, "neighbors", neighbors);
+            knn_jni::hdf5_io::WriteDataset(output, "distances", distances);
+#endif
+            return;
+        }
+
+        knn_jni::vecs_io::WriteIvecs(output, neighbors);
+        if (options.Has("distances")) {
+            knn_jni::vecs_io::WriteFvecs(options.Get("distances"), distances);
+        }
+    }
+
+    // Apply the query time parameters to the HNSW or IVF index behind any id mapping and pre-transform
+    void SetSearchParameters(faiss::Index* index, const Options& options) {
+        if (auto *compressedIndex = dynamic_cast<knn_jni::faiss_wrapper::CompressedHnswIndex *>(index)) {
+            index = compressedIndex->GetIndexHnsw();
+        } else if (auto *compactIndex = dynamic_cast<knn_jni::faiss_wrapper::CompactIdMapIndex *>(index)) {
+            index = compactIndex->GetIndex();
+        } else if (auto *idMap = dynamic_cast<faiss::IndexIDMap *>(index)) {
+            index = idMap->index;
+        }
+        if (auto *indexPreTransform = dynamic_cast<faiss::IndexPreTransform *>(index)) {
+            index = indexPreTransform->index;
+        }
+
+        if (auto *indexHnsw = dynamic_cast<faiss::IndexHNSW *>(index)) {
+            indexHnsw->hnsw.efSearch = options.GetInt("ef-search", indexHnsw->hnsw.efSearch);
+        }
+        if (auto *indexIvf = dynamic_cast<faiss::IndexIVF *>(index)) {
+            indexIvf->nprobe = options.GetInt("nprobes", (int) indexIvf->nprobe);
+        }
+    }
+
+    void Recall(const Options& options) {
+        int k = options.GetInt("k");
+        int r = options.GetInt("r", k);
+        std::string spaceType = options.Get("space", knn_jni::L2);
+        omp_set_num_threads(options.GetInt("threads", (int) std::thread::hardware_concurrency()));
+
+        Matrix<float> base;
+        Matrix<float> queries;
+        Matrix<int32_t> groundTruth;
+        knn_jni::tools::ReadDataset(options, options.Has("method"), base, queries, groundTruth);
+
+        std::unique_ptr<faiss::Index> index;
+        if (options.Has("method")) {
+            auto metric = spaceType == knn_jni::INNER_PRODUCT ? faiss::METRIC_INNER_PRODUCT : faiss::METRIC_L2;
+            index.reset(faiss::index_factory((int) base.cols, options.Get("method").c_str(), metric));
+            if (!index->is_trained) {
+                index->train(base.rows, base.data.data());
+            }
+            index->add(base.rows, base.data.data());
+        } else {
+            index.reset(knn_jni::faiss_wrapper::ReadIndex(options.Get("index"), faiss::IO_FLAG_READ_ONLY));
+        }
+        SetSearchParameters(index.get(), options);
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<float> distances(queries.rows * k);
+        std::vector<faiss::Index::idx_t> labels(queries.rows * k);
+        index->search(queries.rows, queries.data.data(), k, distances.data(), labels.data());
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        Matrix<int32_t> results(queries.rows, k);
+        for (size_t i = 0; i < labels.size(); ++i) {
+            results.data[i] = (int32_t) labels[i];
+        }
+        printf("recall@K %.4f\n", knn_jni::ground_truth::RecallAtR(results, groundTruth, k, k));
+        printf("recall@%d %.4f\n", r, knn_jni::ground_truth::RecallAtR(results, groundTruth, r, k));
+        printf("search time %.3fs for %ld queries\n", elapsed.count(), (long) queries.rows);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s ground-truth|recall --option value ...\n", argv[0]);
+        return 2;
+    }
+
+    try {
+        std::string command(argv[1]);
+        Options options(argc, argv, 2);
+        if (command == "ground-truth") {
+            GroundTruth(options);
+        } else if (command == "recall") {
+            Recall(options);
+        } else {
+            throw std::runtime_error("Unknown command " + command);
+        }
+    } catch (const std::exception& e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
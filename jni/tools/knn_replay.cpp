@@ -0,0 +1,245 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+
+// Replays the queries of a perf-tool dataset against an index built and searched through faiss_wrapper and
+// nmslib_wrapper, without a cluster. Numbers exclude HTTP, JSON and Lucene overhead, so native changes can be compared
+// in isolation.
+//
+//   knn_replay --spec sample-configs/nmslib-sift-hnsw/index-spec.json [--method-spec method-spec.json]
+//              [--field target_field] --index path (--dataset data.hdf5 |
+//              --base base.fvecs --queries query.fvecs --ground-truth gt.ivecs)
+//              [--k 10] [--r 10] [--threads 8] [--build-threads 8] [--warmup 1000]
+//
+// The method of the field is resolved from the index spec like the plugin does; a field that refers to a model takes
+// its method from --method-spec. If no file exists at --index, the index is built from the base vectors with their row
+// numbers as ids and written there; otherwise it is loaded. Each query is timed individually around QueryIndex on one
+// of --threads threads, and the first --warmup queries are run once untimed before the replay.
+
+#include "faiss_wrapper.h"
+#include "ground_truth.h"
+#include "index_spec.h"
+#include "jni_util.h"
+#include "json_value.h"
+#include "nmslib_wrapper.h"
+#include "replay_jni_util.h"
+#include "tool_options.h"
+#include "vecs_io.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace {
+    using knn_jni::index_spec::IndexSpec;
+    using knn_jni::replay::FromJava;
+    using knn_jni::replay::ToJava;
+    using knn_jni::tools::Options;
+    using knn_jni::tools::Percentile;
+    using knn_jni::vecs_io::Matrix;
+
+    using QueryFunction = std::function<jobjectArray(jfloatArray, int)>;
+
+    bool FileExists(const std::string& path) {
+        return std::ifstream(path).good();
+    }
+
+    std::unique_ptr<knn_jni::replay::ObjectArray> ToJavaVectors(const Matrix<float>& matrix) {
+        std::unique_ptr<knn_jni::replay::ObjectArray> vectors(new knn_jni::replay::ObjectArray());
+        for (int64_t i = 0; i < matrix.rows; ++i) {
+            auto * vector = new knn_jni::replay::FloatArray();
+            vector->values.assign(matrix.Row(i), matrix.Row(i) + matrix.cols);
+            vectors->elements.emplace_back(vector);
+        }
+        return vectors;
+    }
+
+    // Build the index the way the plugin does when a segment is flushed. Methods that need training are trained on
+    // all base vectors first, as a model would be
+    void BuildIndex(knn_jni::replay::ReplayJNIUtil& jniUtil, const IndexSpec& spec, const Matrix<float>& base,
+                    const std::string& indexPath, int threadCount) {
+        knn_jni::replay::IntArray ids;
+        for (int64_t i = 0; i < base.rows; ++i) {
+            ids.values.push_back((int32_t) i);
+        }
+        auto vectors = ToJavaVectors(base);
+        knn_jni::replay::String path(indexPath);
+        auto idsJ = ToJava<jintArray>(&ids);
+        auto vectorsJ = ToJava<jobjectArray>(vectors.get());
+        auto pathJ = ToJava<jstring>(&path);
+
+        auto parameters = knn_jni::index_spec::BuildParameters(spec, threadCount);
+        auto parametersJ = ToJava<jobject>(parameters.get());
+        if (spec.engine == knn_jni::NMSLIB_NAME) {
+            knn_jni::nmslib_wrapper::CreateIndex(&jniUtil, nullptr, idsJ, vectorsJ, pathJ, parametersJ);
+            return;
+        }
+
+        if (!knn_jni::index_spec::RequiresTraining(spec)) {
+            knn_jni::faiss_wrapper::CreateIndex(&jniUtil, nullptr, idsJ, vectorsJ, pathJ, parametersJ);
+            return;
+        }
+
+        std::vector<float> trainingVectors(base.data);
+        std::unique_ptr<knn_jni::replay::Object> templateIndex(reinterpret_cast<knn_jni::replay::Object *>(
+                knn_jni::faiss_wrapper::TrainIndex(&jniUtil, nullptr, parametersJ, (jint) base.cols,
+                                                   (jlong) &trainingVectors)));
+        knn_jni::faiss_wrapper::CreateIndexFromTemplate(&jniUtil, nullptr, idsJ, vectorsJ, pathJ,
+                                                        ToJava<jbyteArray>(templateIndex.get()), parametersJ);
+    }
+
+    // Ids of the results of one query, nearest first. nmslib returns the farthest neighbor first
+    void CollectIds(jobjectArray resultsJ, bool farthestFirst, int32_t* ids) {
+        auto & results = FromJava<knn_jni::replay::ObjectArray>(resultsJ);
+        size_t numResults = results.elements.size();
+        for (size_t j = 0; j < numResults; ++j) {
+            size_t position = farthestFirst ? numResults - 1 - j : j;
+            ids[j] = FromJava<knn_jni::replay::QueryResult>(results.elements[position].get()).id;
+        }
+    }
+
+    void Replay(const Options& options) {
+        int k = options.GetInt("k", 10);
+        int r = options.GetInt("r", k);
+        int numThreads = options.GetInt("threads", (int) std::thread::hardware_concurrency());
+        int buildThreads = options.GetInt("build-threads", (int) std::thread::hardware_concurrency());
+        int warmup = options.GetInt("warmup", 0);
+
+        auto indexSpecJson = knn_jni::json::Value::ParseFile(options.Get("spec"));
+        std::unique_ptr<knn_jni::json::Value> methodSpecJson;
+        if (options.Has("method-spec")) {
+            methodSpecJson.reset(new knn_jni::json::Value(knn_jni::json::Value::ParseFile(options.Get("method-spec"))));
+        }
+        IndexSpec spec = knn_jni::index_spec::ParseIndexSpec(indexSpecJson, methodSpecJson.get(),
+                                                             options.Get("field", ""));
+        bool isFaiss = spec.engine == knn_jni::FAISS_NAME;
+
+        std::string indexPath = options.Get("index");
+        bool build = !FileExists(indexPath);
+        Matrix<float> base;
+        Matrix<float> queries;
+        Matrix<int32_t> groundTruth;
+        knn_jni::tools::ReadDataset(options, build, base, queries, groundTruth);
+
+        knn_jni::replay::ReplayJNIUtil jniUtil;
+        if (build) {
+            auto start = std::chrono::steady_clock::now();
+            BuildIndex(jniUtil, spec, base, indexPath, buildThreads);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            printf("Built %s %s index of %ld vectors in %.1fs\n", spec.engine.c_str(), spec.method.c_str(),
+                   (long) base.rows, elapsed.count());
+            base = Matrix<float>();
+        }
+
+        knn_jni::replay::String path(indexPath);
+        jlong indexPointer;
+        std::unique_ptr<knn_jni::replay::Map> loadParameters = knn_jni::index_spec::LoadParameters(spec);
+        if (isFaiss) {
+            indexPointer = knn_jni::faiss_wrapper::LoadIndex(&jniUtil, nullptr, ToJava<jstring>(&path),
+                                                            ToJava<jobject>(loadParameters.get()));
+        } else {
+            indexPointer = knn_jni::nmslib_wrapper::LoadIndex(&jniUtil, nullptr, ToJava<jstring>(&path),
+                                                              ToJava<jobject>(loadParameters.get()));
+            printf("Loaded nmslib index in the %s layout\n", knn_jni::nmslib_wrapper::IsOptimizedLayout(indexPointer)
+                    ? knn_jni::INDEX_LAYOUT_OPTIMIZED.c_str() : knn_jni::INDEX_LAYOUT_REGULAR.c_str());
+        }
+
+        QueryFunction query = [&](jfloatArray queryJ, int kJ) {
+            if (isFaiss) {
+                return knn_jni::faiss_wrapper::QueryIndex(&jniUtil, nullptr, indexPointer, queryJ, kJ);
+            }
+            return knn_jni::nmslib_wrapper::QueryIndex(&jniUtil, nullptr, indexPointer, queryJ, kJ);
+        };
+
+        auto queryVectors = ToJavaVectors(queries);
+        auto queryJ = [&](int64_t i) {
+            return ToJava<jfloatArray>(queryVectors->elements[i].get());
+        };
+
+        for (int64_t i = 0; i < std::min<int64_t>(warmup, queries.rows); ++i) {
+            std::unique_ptr<knn_jni::replay::Object> results(reinterpret_cast<knn_jni::replay::Object *>(
+                    query(queryJ(i), k)));
+        }
+
+        // Queries are handed out one at a time, so a slow query does not hold up a whole share of the others
+        Matrix<int32_t> results(queries.rows, k);
+        std::fill(results.data.begin(), results.data.end(), -1);
+        std::vector<double> latencies(queries.rows);
+        std::atomic<int64_t> nextQuery(0);
+        std::exception_ptr failure;
+        std::atomic<bool> failed(false);
+        auto worker = [&]() {
+            try {
+                int64_t i;
+                while (!failed && (i = nextQuery++) < queries.rows) {
+                    auto start = std::chrono::steady_clock::now();
+                    std::unique_ptr<knn_jni::replay::Object> resultsJ(reinterpret_cast<knn_jni::replay::Object *>(
+                            query(queryJ(i), k)));
+                    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+                    latencies[i] = elapsed.count();
+                    CollectIds(ToJava<jobjectArray>(resultsJ.get()), !isFaiss, results.Row(i));
+                }
+            } catch (...) {
+                if (!failed.exchange(true)) {
+                    failure = std::current_exception();
+                }
+            }
+        };
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back(worker);
+        }
+        for (auto & thread : threads) {
+            thread.join();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        if (isFaiss) {
+            knn_jni::faiss_wrapper::Free(indexPointer);
+        } else {
+            knn_jni::nmslib_wrapper::Free(indexPointer);
+        }
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        printf("Replayed %ld queries on %d threads in %.3fs\n", (long) queries.rows, numThreads, elapsed.count());
+        printf("qps %.1f\n", queries.rows / elapsed.count());
+        printf("latency p50 %.3fms p99 %.3fms p999 %.3fms\n", Percentile(latencies, 0.5),
+               Percentile(latencies, 0.99), Percentile(latencies, 0.999));
+        printf("recall@K %.4f\n", knn_jni::ground_truth::RecallAtR(results, groundTruth, k, k));
+        printf("recall@%d %.4f\n", r, knn_jni::ground_truth::RecallAtR(results, groundTruth, r, k));
+    }
+}
+
+int main(int argc, char** argv) {
+    try {
+        Options options(argc, argv, 1);
+        Replay(options);
+    } catch (const std::exception& e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
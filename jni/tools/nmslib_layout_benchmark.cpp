@@ -0,0 +1,195 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+
+
+// Compares nmslib's two hnsw index layouts on one dataset. The optimized layout keeps each node's vector and level 0
+// links in one flat block and uses nmslib's SIMD kernels for l2 and cosinesimil; the regular layout keeps vectors in
+// separate objects and goes through the generic space. Both indices are built from the same field method, with only
+// index_layout changed, so the numbers show which representation is faster for that field.
+//
+//   nmslib_layout_benchmark --spec sample-configs/nmslib-sift-hnsw/index-spec.json [--method-spec method-spec.json]
+//                           [--field target_field]
+//                           --index-dir /tmp/layouts (--dataset data.hdf5 |
+//                           --base base.fvecs --queries query.fvecs --ground-truth gt.ivecs)
+//                           [--k 10] [--build-threads 8] [--warmup 1000]
+//
+// Indices that already exist in --index-dir are loaded instead of rebuilt. Queries run one after another on a single
+// thread, so the latencies reflect the layout rather than contention. The layout reported for each index is the one
+// read back from the file, since nmslib falls back to the regular layout for spaces it has no kernels for.
+
+#include "ground_truth.h"
+#include "index_spec.h"
+#include "jni_util.h"
+#include "json_value.h"
+#include "nmslib_wrapper.h"
+#include "replay_jni_util.h"
+#include "tool_options.h"
+#include "vecs_io.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace {
+    using knn_jni::index_spec::IndexSpec;
+    using knn_jni::replay::FromJava;
+    using knn_jni::replay::ToJava;
+    using knn_jni::tools::Options;
+    using knn_jni::tools::Percentile;
+    using knn_jni::vecs_io::Matrix;
+
+    // Size of the file at path in bytes, or -1 if there is none
+    long FileSize(const std::string& path) {
+        std::ifstream input(path, std::ios::binary | std::ios::ate);
+        return input.good() ? (long) input.tellg() : -1;
+    }
+
+    std::unique_ptr<knn_jni::replay::ObjectArray> ToJavaVectors(const Matrix<float>& matrix) {
+        std::unique_ptr<knn_jni::replay::ObjectArray> vectors(new knn_jni::replay::ObjectArray());
+        for (int64_t i = 0; i < matrix.rows; ++i) {
+            auto * vector = new knn_jni::replay::FloatArray();
+            vector->values.assign(matrix.Row(i), matrix.Row(i) + matrix.cols);
+            vectors->elements.emplace_back(vector);
+        }
+        return vectors;
+    }
+
+    void BuildIndex(knn_jni::replay::ReplayJNIUtil& jniUtil, const IndexSpec& spec, const Matrix<float>& base,
+                    const std::string& indexPath, int threadCount) {
+        knn_jni::replay::IntArray ids;
+        for (int64_t i = 0; i < base.rows; ++i) {
+            ids.values.push_back((int32_t) i);
+        }
+        auto vectors = ToJavaVectors(base);
+        knn_jni::replay::String path(indexPath);
+        auto parameters = knn_jni::index_spec::BuildParameters(spec, threadCount);
+        knn_jni::nmslib_wrapper::CreateIndex(&jniUtil, nullptr, ToJava<jintArray>(&ids),
+                                             ToJava<jobjectArray>(vectors.get()), ToJava<jstring>(&path),
+                                             ToJava<jobject>(parameters.get()));
+    }
+
+    void Benchmark(const Options& options) {
+        int k = options.GetInt("k", 10);
+        int buildThreads = options.GetInt("build-threads", (int) std::thread::hardware_concurrency());
+        int warmup = options.GetInt("warmup", 0);
+        std::string indexDir = options.Get("index-dir");
+
+        auto indexSpecJson = knn_jni::json::Value::ParseFile(options.Get("spec"));
+        std::unique_ptr<knn_jni::json::Value> methodSpecJson;
+        if (options.Has("method-spec")) {
+            methodSpecJson.reset(new knn_jni::json::Value(knn_jni::json::Value::ParseFile(options.Get("method-spec"))));
+        }
+        IndexSpec spec = knn_jni::index_spec::ParseIndexSpec(indexSpecJson, methodSpecJson.get(),
+                                                             options.Get("field", ""));
+        if (spec.engine != knn_jni::NMSLIB_NAME) {
+            throw std::runtime_error("Field does not use nmslib");
+        }
+
+        std::vector<std::string> layouts = {knn_jni::INDEX_LAYOUT_OPTIMIZED, knn_jni::INDEX_LAYOUT_REGULAR};
+        std::vector<std::string> indexPaths;
+        bool build = false;
+        for (const auto& layout : layouts) {
+            indexPaths.push_back(indexDir + "/" + layout + ".hnsw");
+            build = build || FileSize(indexPaths.back()) < 0;
+        }
+
+        Matrix<float> base;
+        Matrix<float> queries;
+        Matrix<int32_t> groundTruth;
+        knn_jni::tools::ReadDataset(options, build, base, queries, groundTruth);
+
+        knn_jni::replay::ReplayJNIUtil jniUtil;
+        auto queryVectors = ToJavaVectors(queries);
+        printf("%-10s %-10s %10s %12s %10s %10s %10s %10s %10s\n", "requested", "layout", "build_s", "bytes",
+               "load_ms", "qps", "p50_ms", "p99_ms", "recall@K");
+        for (size_t l = 0; l < layouts.size(); ++l) {
+            IndexSpec layoutSpec = spec;
+            layoutSpec.stringParameters[knn_jni::INDEX_LAYOUT] = layouts[l];
+
+            double buildSeconds = 0;
+            if (FileSize(indexPaths[l]) < 0) {
+                auto start = std::chrono::steady_clock::now();
+                BuildIndex(jniUtil, layoutSpec, base, indexPaths[l], buildThreads);
+                buildSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            }
+
+            knn_jni::replay::String path(indexPaths[l]);
+            auto loadParameters = knn_jni::index_spec::LoadParameters(layoutSpec);
+            auto loadStart = std::chrono::steady_clock::now();
+            jlong indexPointer = knn_jni::nmslib_wrapper::LoadIndex(&jniUtil, nullptr, ToJava<jstring>(&path),
+                                                                    ToJava<jobject>(loadParameters.get()));
+            std::chrono::duration<double, std::milli> loadElapsed = std::chrono::steady_clock::now() - loadStart;
+
+            Matrix<int32_t> results(queries.rows, k);
+            std::fill(results.data.begin(), results.data.end(), -1);
+            std::vector<double> latencies(queries.rows);
+            try {
+                for (int64_t i = 0; i < std::min<int64_t>(warmup, queries.rows); ++i) {
+                    std::unique_ptr<knn_jni::replay::Object> resultsJ(reinterpret_cast<knn_jni::replay::Object *>(
+                            knn_jni::nmslib_wrapper::QueryIndex(&jniUtil, nullptr, indexPointer,
+                                    ToJava<jfloatArray>(queryVectors->elements[i].get()), k)));
+                }
+
+                for (int64_t i = 0; i < queries.rows; ++i) {
+                    auto start = std::chrono::steady_clock::now();
+                    std::unique_ptr<knn_jni::replay::Object> resultsJ(reinterpret_cast<knn_jni::replay::Object *>(
+                            knn_jni::nmslib_wrapper::QueryIndex(&jniUtil, nullptr, indexPointer,
+                                    ToJava<jfloatArray>(queryVectors->elements[i].get()), k)));
+                    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+                    latencies[i] = elapsed.count();
+
+                    // nmslib returns the farthest neighbor first
+                    auto & neighbors = FromJava<knn_jni::replay::ObjectArray>(resultsJ.get()).elements;
+                    for (size_t j = 0; j < neighbors.size(); ++j) {
+                        results.Row(i)[j] = FromJava<knn_jni::replay::QueryResult>(
+                                neighbors[neighbors.size() - 1 - j].get()).id;
+                    }
+                }
+            } catch (...) {
+                knn_jni::nmslib_wrapper::Free(indexPointer);
+                throw;
+            }
+            bool optimized = knn_jni::nmslib_wrapper::IsOptimizedLayout(indexPointer);
+            knn_jni::nmslib_wrapper::Free(indexPointer);
+
+            double totalMillis = 0;
+            for (double latency : latencies) {
+                totalMillis += latency;
+            }
+            std::sort(latencies.begin(), latencies.end());
+            printf("%-10s %-10s %10.1f %12ld %10.1f %10.1f %10.3f %10.3f %10.4f\n", layouts[l].c_str(),
+                   optimized ? knn_jni::INDEX_LAYOUT_OPTIMIZED.c_str() : knn_jni::INDEX_LAYOUT_REGULAR.c_str(),
+                   buildSeconds, FileSize(indexPaths[l]), loadElapsed.count(),
+                   totalMillis > 0 ? queries.rows * 1000 / totalMillis : 0, Percentile(latencies, 0.5),
+                   Percentile(latencies, 0.99), knn_jni::ground_truth::RecallAtR(results, groundTruth, k, k));
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    try {
+        Options options(argc, argv, 1);
+        Benchmark(options);
+    } catch (const std::exception& e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
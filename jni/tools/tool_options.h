@@ -0,0 +1,122 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+
+#ifndef OPENSEARCH_KNN_TOOL_OPTIONS_H
+#define OPENSEARCH_KNN_TOOL_OPTIONS_H
+
+#include "vecs_io.h"
+#ifdef KNN_WITH_HDF5
+#include "hdf5_io.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Helpers shared by the command line tools
+
+namespace knn_jni {
+    namespace tools {
+
+        // Options given as --name value pairs, starting at argv[first]
+        class Options {
+        public:
+            Options(int argc, char** argv, int first) {
+                for (int i = first; i < argc; i += 2) {
+                    std::string name(argv[i]);
+                    if (name.compare(0, 2, "--") != 0 || i + 1 >= argc) {
+                        throw std::runtime_error("Invalid option " + name);
+                    }
+                    values[name.substr(2)] = argv[i + 1];
+                }
+            }
+
+            bool Has(const std::string& name) const {
+                return values.find(name) != values.end();
+            }
+
+            std::string Get(const std::string& name) const {
+                auto value = values.find(name);
+                if (value == values.end()) {
+                    throw std::runtime_error("Missing option --" + name);
+                }
+                return value->second;
+            }
+
+            std::string Get(const std::string& name, const std::string& defaultValue) const {
+                return Has(name) ? Get(name) : defaultValue;
+            }
+
+            int GetInt(const std::string& name) const {
+                return std::stoi(Get(name));
+            }
+
+            int GetInt(const std::string& name, int defaultValue) const {
+                return Has(name) ? GetInt(name) : defaultValue;
+            }
+
+        private:
+            std::unordered_map<std::string, std::string> values;
+        };
+
+        // Latency at quantile q of sorted, by the nearest rank
+        inline double Percentile(const std::vector<double>& sorted, double q) {
+            if (sorted.empty()) {
+                return 0;
+            }
+            auto rank = (size_t) std::ceil(q * sorted.size());
+            return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+        }
+
+        inline knn_jni::vecs_io::Matrix<float> ReadHdf5Floats(const std::string& path, const std::string& name) {
+#ifdef KNN_WITH_HDF5
+            return knn_jni::hdf5_io::ReadFloatDataset(path, name);
+#else
+            throw std::runtime_error("Built without HDF5 support, use fvecs files instead");
+#endif
+        }
+
+        inline knn_jni::vecs_io::Matrix<int32_t> ReadHdf5Ints(const std::string& path, const std::string& name) {
+#ifdef KNN_WITH_HDF5
+            return knn_jni::hdf5_io::ReadIntDataset(path, name);
+#else
+            throw std::runtime_error("Built without HDF5 support, use ivecs files instead");
+#endif
+        }
+
+        // Read the queries and their ground truth, and the base vectors if readBase is set, either from the perf-tool
+        // HDF5 file given by --dataset or from the files given by --base, --queries and --ground-truth
+        inline void ReadDataset(const Options& options, bool readBase, knn_jni::vecs_io::Matrix<float>& base,
+                                knn_jni::vecs_io::Matrix<float>& queries,
+                                knn_jni::vecs_io::Matrix<int32_t>& groundTruth) {
+            if (options.Has("dataset")) {
+                queries = ReadHdf5Floats(options.Get("dataset"), "test");
+                groundTruth = ReadHdf5Ints(options.Get("dataset"), "neighbors");
+                if (readBase) {
+                    base = ReadHdf5Floats(options.Get("dataset"), "train");
+                }
+                return;
+            }
+
+            queries = knn_jni::vecs_io::ReadVectors(options.Get("queries"));
+            groundTruth = knn_jni::vecs_io::ReadIvecs(options.Get("ground-truth"));
+            if (readBase) {
+                base = knn_jni::vecs_io::ReadVectors(options.Get("base"));
+            }
+        }
+    }
+}
+
+#endif //OPENSEARCH_KNN_TOOL_OPTIONS_H
@@ -19,6 +19,20 @@ public class KNNConstants {
     public static final String METHOD_IVF = "ivf";
     public static final String METHOD_PARAMETER_NLIST = "nlist";
     public static final String METHOD_PARAMETER_SPACE_TYPE = "space_type"; // used for mapping parameter
+    public static final String METHOD_PARAMETER_GRAPH_REORDER = "graph_reorder";
+    public static final String GRAPH_REORDER_NONE = "none";
+    public static final String GRAPH_REORDER_BFS = "bfs";
+    public static final String GRAPH_REORDER_RCM = "rcm";
+    public static final String GRAPH_REORDER_LOCALITY = "locality";
+    public static final String METHOD_PARAMETER_GRAPH_ENCODING = "graph_encoding";
+    public static final String GRAPH_ENCODING_FIXED = "fixed";
+    public static final String GRAPH_ENCODING_DELTA = "delta";
+    public static final String METHOD_PARAMETER_COSINE_MODE = "cosine_mode";
+    public static final String COSINE_MODE_RAW = "raw";
+    public static final String COSINE_MODE_NORMALIZED = "normalized";
+    public static final String METHOD_PARAMETER_INDEX_LAYOUT = "index_layout";
+    public static final String INDEX_LAYOUT_OPTIMIZED = "optimized";
+    public static final String INDEX_LAYOUT_REGULAR = "regular";
     public static final String COMPOUND_EXTENSION = "c";
     public static final String MODEL = "model";
     public static final String MODELS = "models";
@@ -35,6 +49,7 @@ public class KNNConstants {
     public static final String MODEL_TIMESTAMP = "timestamp";
     public static final String MODEL_DESCRIPTION = "description";
     public static final String MODEL_ERROR = "error";
+    public static final String MODEL_LIST_SIZES = "list_sizes";
 
     public static final String KNN_THREAD_POOL_PREFIX = "knn";
     public static final String TRAIN_THREAD_POOL = "training";
@@ -54,6 +69,7 @@ public class KNNConstants {
     public static final String HNSW_ALGO_EF_CONSTRUCTION = "efConstruction";
     public static final String HNSW_ALGO_EF_SEARCH = "efSearch";
     public static final String INDEX_THREAD_QTY = "indexThreadQty";
+    public static final String BUILD_SCHEDULING_POLICY = "buildSchedulingPolicy";
 
     // Faiss specific constants
     public static final String FAISS_NAME = "faiss";
@@ -61,14 +77,27 @@ public class KNNConstants {
     public static final String INDEX_DESCRIPTION_PARAMETER = "index_description";
     public static final String METHOD_ENCODER_PARAMETER = "encoder";
     public static final String METHOD_PARAMETER_NPROBES = "nprobes";
+    public static final String METHOD_PARAMETER_CLUSTERING = "clustering";
+    public static final String CLUSTERING_KMEANS = "kmeans";
+    public static final String CLUSTERING_BALANCED = "balanced";
+    public static final String EARLY_TERMINATION = "early_termination"; // load parameter of faiss indices
+    public static final String RECALL_SAMPLING_RATE = "recall_sampling_rate"; // load parameter of faiss indices
     public static final String ENCODER_FLAT = "flat";
     public static final String ENCODER_PQ = "pq";
     public static final String ENCODER_PARAMETER_PQ_M = "m";
     public static final String ENCODER_PARAMETER_PQ_CODE_SIZE = "code_size";
+    public static final String ENCODER_SQ = "sq";
+    public static final String ENCODER_PARAMETER_SQ_TYPE = "type";
+    public static final String ENCODER_SQ_FP16 = "fp16";
     public static final String FAISS_HNSW_DESCRIPTION = "HNSW";
     public static final String FAISS_IVF_DESCRIPTION = "IVF";
     public static final String FAISS_FLAT_DESCRIPTION = "Flat";
     public static final String FAISS_PQ_DESCRIPTION = "PQ";
+    public static final String FAISS_SQ_DESCRIPTION = "SQ";
+
+    // Encodings of 16 bit float vectors passed to the native libraries
+    public static final String VECTOR_ENCODING_FP16 = "fp16";
+    public static final String VECTOR_ENCODING_BF16 = "bf16";
 
     // Parameter defaults/limits
     public static final Integer ENCODER_PARAMETER_PQ_CODE_COUNT_DEFAULT = 1;
@@ -5,7 +5,6 @@
 
 package org.opensearch.knn.index;
 
-import com.google.common.collect.ImmutableMap;
 import org.apache.lucene.index.FieldInfo;
 import org.apache.logging.log4j.LogManager;
 import org.apache.logging.log4j.Logger;
@@ -30,6 +29,9 @@ import java.util.Objects;
 import java.util.concurrent.ExecutionException;
 import java.util.stream.Collectors;
 
+import static org.opensearch.knn.common.KNNConstants.EARLY_TERMINATION;
+import static org.opensearch.knn.common.KNNConstants.RECALL_SAMPLING_RATE;
+import static org.opensearch.knn.common.KNNConstants.METHOD_PARAMETER_COSINE_MODE;
 import static org.opensearch.knn.common.KNNConstants.SPACE_TYPE;
 import static org.opensearch.knn.index.codec.util.KNNCodecUtil.buildEngineFileName;
 
@@ -80,13 +82,13 @@ public class KNNIndexShard {
     public void warmup() throws IOException {
         logger.info("[KNN] Warming up index: " + getIndexName());
         try (Engine.Searcher searcher = indexShard.acquireSearcher("knn-warmup")) {
-            getAllEnginePaths(searcher.getIndexReader()).forEach((key, value) -> {
+            getAllEngineFieldInfos(searcher.getIndexReader()).forEach((key, value) -> {
                 try {
                     nativeMemoryCacheManager.get(
                             new NativeMemoryEntryContext.IndexEntryContext(
                                     key,
                                     NativeMemoryLoadStrategy.IndexLoadStrategy.getInstance(),
-                                    ImmutableMap.of(SPACE_TYPE, value.getValue()),
+                                    getLoadParameters(value),
                                     getIndexName()
                             ), true);
                 } catch (ExecutionException ex) {
@@ -105,14 +107,34 @@ public class KNNIndexShard {
      */
     public Map<String, SpaceType> getAllEnginePaths(IndexReader indexReader) throws IOException {
         Map<String, SpaceType> engineFiles = new HashMap<>();
+        getAllEngineFieldInfos(indexReader).forEach((path, fieldInfo) ->
+                engineFiles.put(path, SpaceType.getSpace(fieldInfo.attributes().get(SPACE_TYPE))));
+        return engineFiles;
+    }
+
+    private Map<String, FieldInfo> getAllEngineFieldInfos(IndexReader indexReader) throws IOException {
+        Map<String, FieldInfo> engineFiles = new HashMap<>();
         for (KNNEngine knnEngine : KNNEngine.values()) {
             engineFiles.putAll(getEnginePaths(indexReader, knnEngine));
         }
         return engineFiles;
     }
 
-    private Map<String, SpaceType> getEnginePaths(IndexReader indexReader, KNNEngine knnEngine) throws IOException {
-        Map<String, SpaceType> engineFiles = new HashMap<>();
+    private Map<String, Object> getLoadParameters(FieldInfo fieldInfo) {
+        Map<String, Object> loadParameters = new HashMap<>();
+        loadParameters.put(SPACE_TYPE, fieldInfo.attributes().get(SPACE_TYPE));
+        String cosineMode = fieldInfo.getAttribute(METHOD_PARAMETER_COSINE_MODE);
+        if (cosineMode != null) {
+            loadParameters.put(METHOD_PARAMETER_COSINE_MODE, cosineMode);
+        }
+        // Only faiss reads it; nmslib ignores the entry
+        loadParameters.put(EARLY_TERMINATION, KNNSettings.getEarlyTermination(getIndexName()));
+        loadParameters.put(RECALL_SAMPLING_RATE, KNNSettings.getRecallSamplingRate(getIndexName()));
+        return loadParameters;
+    }
+
+    private Map<String, FieldInfo> getEnginePaths(IndexReader indexReader, KNNEngine knnEngine) throws IOException {
+        Map<String, FieldInfo> engineFiles = new HashMap<>();
 
         for (LeafReaderContext leafReaderContext : indexReader.leaves()) {
             SegmentReader reader = (SegmentReader) FilterLeafReader.unwrap(leafReaderContext.reader());
@@ -122,7 +144,6 @@ public class KNNIndexShard {
 
             for (FieldInfo fieldInfo : reader.getFieldInfos()) {
                 if (fieldInfo.attributes().containsKey(KNNVectorFieldMapper.KNN_FIELD)) {
-                    SpaceType spaceType = SpaceType.getSpace(fieldInfo.attributes().get(SPACE_TYPE));
                     String engineFileName = buildEngineFileName(reader.getSegmentInfo().info.name,
                             knnEngine.getLatestBuildVersion(), fieldInfo.name, fileExtension);
 
@@ -130,7 +151,7 @@ public class KNNIndexShard {
                             .filter(fileName -> fileName.equals(engineFileName))
                             .map(fileName -> shardPath.resolve(fileName).toString())
                             .filter(Objects::nonNull)
-                            .collect(Collectors.toMap(fileName -> fileName, fileName -> spaceType)));
+                            .collect(Collectors.toMap(fileName -> fileName, fileName -> fieldInfo)));
                 }
             }
         }
@@ -20,9 +20,11 @@ import org.opensearch.common.unit.ByteSizeValue;
 import org.opensearch.common.unit.TimeValue;
 import org.opensearch.index.IndexModule;
 import org.opensearch.knn.index.memory.NativeMemoryCacheManager;
+import org.opensearch.knn.jni.JNIService;
 import org.opensearch.monitor.jvm.JvmInfo;
 import org.opensearch.monitor.os.OsProbe;
 
+import java.nio.file.Path;
 import java.security.InvalidParameterException;
 import java.util.Arrays;
 import java.util.HashMap;
@@ -53,6 +55,7 @@ public class KNNSettings {
     private static OsProbe osProbe = OsProbe.getInstance();
 
     private static final int INDEX_THREAD_QTY_MAX = 32;
+    private static final int NATIVE_THREAD_POOL_SIZE_MAX = 512;
 
     /**
      * Settings name
@@ -61,7 +64,13 @@ public class KNNSettings {
     public static final String KNN_ALGO_PARAM_M = "index.knn.algo_param.m";
     public static final String KNN_ALGO_PARAM_EF_CONSTRUCTION = "index.knn.algo_param.ef_construction";
     public static final String KNN_ALGO_PARAM_EF_SEARCH = "index.knn.algo_param.ef_search";
+    public static final String KNN_EARLY_TERMINATION = "index.knn.early_termination";
+    public static final String KNN_RECALL_SAMPLING_RATE = "index.knn.recall_sampling_rate";
     public static final String KNN_ALGO_PARAM_INDEX_THREAD_QTY = "knn.algo_param.index_thread_qty";
+    public static final String KNN_NATIVE_THREAD_POOL_SIZE = "knn.native.thread_pool.size";
+    public static final String KNN_NATIVE_BUILD_SCHEDULING_POLICY = "knn.native.build.scheduling_policy";
+    public static final String KNN_QUERY_CAPTURE_SAMPLE_RATE = "knn.query_capture.sample_rate";
+    public static final String KNN_QUERY_CAPTURE_MAX_SIZE = "knn.query_capture.max_size";
     public static final String KNN_MEMORY_CIRCUIT_BREAKER_ENABLED = "knn.memory.circuit_breaker.enabled";
     public static final String KNN_MEMORY_CIRCUIT_BREAKER_LIMIT = "knn.memory.circuit_breaker.limit";
     public static final String KNN_CIRCUIT_BREAKER_TRIGGERED = "knn.circuit_breaker.triggered";
@@ -81,7 +90,14 @@ public class KNNSettings {
     public static final Integer INDEX_KNN_DEFAULT_ALGO_PARAM_M = 16;
     public static final Integer INDEX_KNN_DEFAULT_ALGO_PARAM_EF_SEARCH = 512;
     public static final Integer INDEX_KNN_DEFAULT_ALGO_PARAM_EF_CONSTRUCTION = 512;
+    public static final String INDEX_KNN_DEFAULT_EARLY_TERMINATION = "none";
+    public static final Double INDEX_KNN_DEFAULT_RECALL_SAMPLING_RATE = 0.0;
     public static final Integer KNN_DEFAULT_ALGO_PARAM_INDEX_THREAD_QTY = 1;
+    public static final Integer KNN_DEFAULT_NATIVE_THREAD_POOL_SIZE = 0; // 0 means one thread per processor
+    public static final String KNN_DEFAULT_NATIVE_BUILD_SCHEDULING_POLICY = "nice";
+    public static final Double KNN_DEFAULT_QUERY_CAPTURE_SAMPLE_RATE = 0.0;
+    public static final ByteSizeValue KNN_DEFAULT_QUERY_CAPTURE_MAX_SIZE = new ByteSizeValue(256, ByteSizeUnit.MB);
+    public static final String KNN_QUERY_CAPTURE_FILE_NAME = "knn_query_capture.log";
     public static final Integer KNN_DEFAULT_CIRCUIT_BREAKER_UNSET_PERCENTAGE = 75;
     public static final Integer KNN_DEFAULT_MODEL_CACHE_SIZE_LIMIT_PERCENTAGE = 10; // By default, set aside 10% of the JVM for the limit
     public static final Integer KNN_MAX_MODEL_CACHE_SIZE_LIMIT_PERCENTAGE = 25; // Model cache limit cannot exceed 25% of the JVM heap
@@ -119,6 +135,31 @@ public class KNNSettings {
             IndexScope,
             Dynamic);
 
+    /**
+     * early_termination - whether faiss searches may stop before ef_search or nprobes is exhausted. "none" always does
+     * the full search. "adaptive" ends HNSW searches once the nearest results stop changing and skips IVF lists that
+     * are too far from the query to hold any of them, so that easy queries cost less than the hard ones the parameters
+     * were tuned for. Like ef_search for nmslib, it is read when a segment's index is loaded.
+     */
+    public static final Setting<String> INDEX_KNN_EARLY_TERMINATION_SETTING = Setting.simpleString(KNN_EARLY_TERMINATION,
+            INDEX_KNN_DEFAULT_EARLY_TERMINATION,
+            new EarlyTerminationValidator(),
+            IndexScope,
+            Dynamic);
+
+    /**
+     * recall_sampling_rate - fraction of the queries of loaded faiss indices that are searched again exhaustively in
+     * the background, to measure the recall the index actually delivers. The rolling recall of each index is reported
+     * in the indices_in_cache stat. Changes apply to loaded indices right away.
+     */
+    public static final Setting<Double> INDEX_KNN_RECALL_SAMPLING_RATE_SETTING = Setting.doubleSetting(
+            KNN_RECALL_SAMPLING_RATE,
+            INDEX_KNN_DEFAULT_RECALL_SAMPLING_RATE,
+            0,
+            1,
+            IndexScope,
+            Dynamic);
+
     /**
      * ef_constrution - the parameter has the same meaning as ef, but controls the index_time/index_accuracy.
      * Bigger ef_construction leads to longer construction(more indexing time), but better index quality.
@@ -187,6 +228,54 @@ public class KNNSettings {
             NodeScope,
             Dynamic);
 
+    /**
+     * native_thread_pool_size - total number of threads the native libraries may use across concurrent graph builds
+     * and trainings. Each build borrows its indexThreadQty threads from this budget; it is granted fewer once the budget
+     * runs low, and waits when the budget is used up. 0 means one thread per processor.
+     */
+    public static final Setting<Integer> KNN_NATIVE_THREAD_POOL_SIZE_SETTING = Setting.intSetting(KNN_NATIVE_THREAD_POOL_SIZE,
+            KNN_DEFAULT_NATIVE_THREAD_POOL_SIZE,
+            0,
+            NATIVE_THREAD_POOL_SIZE_MAX,
+            NodeScope,
+            Dynamic);
+
+    /**
+     * native_build_scheduling_policy - how native graph builds and trainings are scheduled relative to queries on the
+     * same node. "normal" runs them at the priority of the calling thread, "nice" lowers the priority of the build
+     * threads and "idle" runs them under SCHED_IDLE. With "nice" and "idle", faiss builds and joins also pause between
+     * batches while queries are in flight.
+     */
+    public static final Setting<String> KNN_NATIVE_BUILD_SCHEDULING_POLICY_SETTING = Setting.simpleString(
+            KNN_NATIVE_BUILD_SCHEDULING_POLICY,
+            KNN_DEFAULT_NATIVE_BUILD_SCHEDULING_POLICY,
+            new SchedulingPolicyValidator(),
+            NodeScope,
+            Dynamic);
+
+    /**
+     * query_capture.sample_rate - fraction of the native queries of the node appended to a ring log in the logs
+     * directory, knn_query_capture.log, so they can be replayed offline with knn_capture_replay against copies of the
+     * same index files. 0 stops the capture.
+     */
+    public static final Setting<Double> KNN_QUERY_CAPTURE_SAMPLE_RATE_SETTING = Setting.doubleSetting(
+            KNN_QUERY_CAPTURE_SAMPLE_RATE,
+            KNN_DEFAULT_QUERY_CAPTURE_SAMPLE_RATE,
+            0,
+            1,
+            NodeScope,
+            Dynamic);
+
+    /**
+     * query_capture.max_size - size of the query capture log. Once it is full, the oldest queries are overwritten.
+     */
+    public static final Setting<ByteSizeValue> KNN_QUERY_CAPTURE_MAX_SIZE_SETTING = Setting.byteSizeSetting(
+            KNN_QUERY_CAPTURE_MAX_SIZE,
+            KNN_DEFAULT_QUERY_CAPTURE_MAX_SIZE,
+            new ByteSizeValue(64, ByteSizeUnit.KB),
+            new ByteSizeValue(16, ByteSizeUnit.GB),
+            NodeScope);
+
     public static final Setting<Boolean> KNN_CIRCUIT_BREAKER_TRIGGERED_SETTING =  Setting.boolSetting(KNN_CIRCUIT_BREAKER_TRIGGERED,
             false,
             NodeScope,
@@ -231,6 +320,8 @@ public class KNNSettings {
 
     private ClusterService clusterService;
     private Client client;
+    private Path queryCaptureLog;
+    private boolean queryCaptureStarted;
 
     private KNNSettings() {}
 
@@ -275,6 +366,27 @@ public class KNNSettings {
                     latestSettings.put(KNN_ALGO_PARAM_INDEX_THREAD_QTY, newVal);
                 }
         );
+        clusterService.getClusterSettings().addSettingsUpdateConsumer(
+                KNN_NATIVE_THREAD_POOL_SIZE_SETTING,
+                newVal -> {
+                    logger.debug("The value of setting [{}] changed to [{}]", KNN_NATIVE_THREAD_POOL_SIZE, newVal);
+                    latestSettings.put(KNN_NATIVE_THREAD_POOL_SIZE, newVal);
+                    updateNativeThreadPoolSize(newVal);
+                }
+        );
+        clusterService.getClusterSettings().addSettingsUpdateConsumer(
+                KNN_NATIVE_BUILD_SCHEDULING_POLICY_SETTING,
+                newVal -> {
+                    latestSettings.put(KNN_NATIVE_BUILD_SCHEDULING_POLICY, newVal);
+                }
+        );
+        clusterService.getClusterSettings().addSettingsUpdateConsumer(
+                KNN_QUERY_CAPTURE_SAMPLE_RATE_SETTING,
+                newVal -> {
+                    logger.debug("The value of setting [{}] changed to [{}]", KNN_QUERY_CAPTURE_SAMPLE_RATE, newVal);
+                    updateQueryCapture(newVal);
+                }
+        );
     }
 
     /**
@@ -306,6 +418,14 @@ public class KNNSettings {
             return KNN_ALGO_PARAM_INDEX_THREAD_QTY_SETTING;
         }
 
+        if (KNN_NATIVE_THREAD_POOL_SIZE.equals(key)) {
+            return KNN_NATIVE_THREAD_POOL_SIZE_SETTING;
+        }
+
+        if (KNN_NATIVE_BUILD_SCHEDULING_POLICY.equals(key)) {
+            return KNN_NATIVE_BUILD_SCHEDULING_POLICY_SETTING;
+        }
+
         throw new IllegalArgumentException("Cannot find setting by key [" + key + "]");
     }
 
@@ -314,7 +434,13 @@ public class KNNSettings {
                 INDEX_KNN_ALGO_PARAM_M_SETTING,
                 INDEX_KNN_ALGO_PARAM_EF_CONSTRUCTION_SETTING,
                 INDEX_KNN_ALGO_PARAM_EF_SEARCH_SETTING,
+                INDEX_KNN_EARLY_TERMINATION_SETTING,
+                INDEX_KNN_RECALL_SAMPLING_RATE_SETTING,
                 KNN_ALGO_PARAM_INDEX_THREAD_QTY_SETTING,
+                KNN_NATIVE_THREAD_POOL_SIZE_SETTING,
+                KNN_NATIVE_BUILD_SCHEDULING_POLICY_SETTING,
+                KNN_QUERY_CAPTURE_SAMPLE_RATE_SETTING,
+                KNN_QUERY_CAPTURE_MAX_SIZE_SETTING,
                 KNN_CIRCUIT_BREAKER_TRIGGERED_SETTING,
                 KNN_CIRCUIT_BREAKER_UNSET_PERCENTAGE_SETTING,
                 IS_KNN_INDEX_SETTING,
@@ -341,10 +467,47 @@ public class KNNSettings {
         return KNNSettings.state().getSettingValue(KNNSettings.KNN_CIRCUIT_BREAKER_UNSET_PERCENTAGE);
     }
 
-    public void initialize(Client client, ClusterService clusterService) {
+    public void initialize(Client client, ClusterService clusterService, Path logsDirectory) {
         this.client = client;
         this.clusterService = clusterService;
+        this.queryCaptureLog = logsDirectory.resolve(KNN_QUERY_CAPTURE_FILE_NAME);
         setSettingsUpdateConsumers();
+        updateQueryCapture(clusterService.getClusterSettings().get(KNN_QUERY_CAPTURE_SAMPLE_RATE_SETTING));
+        int nativeThreadPoolSize = clusterService.getClusterSettings().get(KNN_NATIVE_THREAD_POOL_SIZE_SETTING);
+        if (nativeThreadPoolSize != KNN_DEFAULT_NATIVE_THREAD_POOL_SIZE) {
+            updateNativeThreadPoolSize(nativeThreadPoolSize);
+        }
+    }
+
+    /**
+     * Resize the native thread budget. The native libraries start with the default size, so they are only touched once
+     * the setting is changed.
+     */
+    private synchronized void updateNativeThreadPoolSize(int numThreads) {
+        try {
+            JNIService.setThreadPoolSize(numThreads);
+        } catch (Exception e) {
+            logger.error("Unable to resize the native thread pool to [" + numThreads + "] threads", e);
+        }
+    }
+
+    /**
+     * Start, retune or stop the native query capture. The native libraries are only touched once a capture is
+     * requested, and a failure to open the log leaves queries unaffected.
+     */
+    private synchronized void updateQueryCapture(double sampleRate) {
+        try {
+            if (sampleRate > 0) {
+                long capacity = KNN_QUERY_CAPTURE_MAX_SIZE_SETTING.get(clusterService.getSettings()).getBytes();
+                JNIService.startQueryCapture(queryCaptureLog.toString(), capacity, (float) sampleRate);
+                queryCaptureStarted = true;
+            } else if (queryCaptureStarted) {
+                JNIService.stopQueryCapture();
+                queryCaptureStarted = false;
+            }
+        } catch (Exception e) {
+            logger.error("Unable to update the query capture in [" + queryCaptureLog + "]", e);
+        }
     }
 
     /**
@@ -419,6 +582,26 @@ public class KNNSettings {
         return getIndexSettingValue(index, KNN_ALGO_PARAM_EF_SEARCH, 512);
     }
 
+    /**
+     *
+     * @param index Name of the index
+     * @return early termination of faiss searches
+     */
+    public static String getEarlyTermination(String index) {
+        return KNNSettings.state().clusterService.state().getMetadata()
+            .index(index).getSettings().get(KNN_EARLY_TERMINATION, INDEX_KNN_DEFAULT_EARLY_TERMINATION);
+    }
+
+    /**
+     *
+     * @param index Name of the index
+     * @return fraction of the queries of faiss indices whose recall is measured
+     */
+    public static double getRecallSamplingRate(String index) {
+        return KNNSettings.state().clusterService.state().getMetadata()
+            .index(index).getSettings().getAsDouble(KNN_RECALL_SAMPLING_RATE, INDEX_KNN_DEFAULT_RECALL_SAMPLING_RATE);
+    }
+
     /**
      *
      * @param index Name of the index
@@ -450,6 +633,30 @@ public class KNNSettings {
         }
     }
 
+    static class SchedulingPolicyValidator implements Setting.Validator<String> {
+
+        private static final List<String> POLICIES = Arrays.asList("normal", "nice", "idle");
+
+        @Override public void validate(String value) {
+            if (!POLICIES.contains(value)) {
+                throw new InvalidParameterException("Invalid scheduling policy [" + value + "]. Must be one of "
+                        + POLICIES);
+            }
+        }
+    }
+
+    static class EarlyTerminationValidator implements Setting.Validator<String> {
+
+        private static final List<String> MODES = Arrays.asList("none", "adaptive");
+
+        @Override public void validate(String value) {
+            if (!MODES.contains(value)) {
+                throw new InvalidParameterException("Invalid early termination [" + value + "]. Must be one of "
+                        + MODES);
+            }
+        }
+    }
+
     public void onIndexModule(IndexModule module) {
         module.addSettingsUpdateConsumer(
                 INDEX_KNN_ALGO_PARAM_EF_SEARCH_SETTING,
@@ -459,6 +666,20 @@ public class KNNSettings {
                     // TODO: replace cache-rebuild with index reload into the cache
                     NativeMemoryCacheManager.getInstance().rebuildCache();
                 });
+        module.addSettingsUpdateConsumer(
+                INDEX_KNN_EARLY_TERMINATION_SETTING,
+                newVal -> {
+                    logger.debug("The value of [KNN] setting [{}] changed to [{}]", KNN_EARLY_TERMINATION, newVal);
+                    latestSettings.put(KNN_EARLY_TERMINATION, newVal);
+                    // Loaded indices keep the value they were loaded with
+                    NativeMemoryCacheManager.getInstance().rebuildCache();
+                });
+        module.addSettingsUpdateConsumer(
+                INDEX_KNN_RECALL_SAMPLING_RATE_SETTING,
+                newVal -> {
+                    logger.debug("The value of [KNN] setting [{}] changed to [{}]", KNN_RECALL_SAMPLING_RATE, newVal);
+                    NativeMemoryCacheManager.getInstance().setRecallSamplingRate(module.getIndex().getName(), newVal);
+                });
     }
 
     private static String percentageAsString(Integer percentage) {
@@ -54,6 +54,7 @@ import static org.opensearch.knn.common.KNNConstants.HNSW_ALGO_EF_CONSTRUCTION;
 import static org.opensearch.knn.common.KNNConstants.HNSW_ALGO_M;
 import static org.opensearch.knn.common.KNNConstants.KNN_ENGINE;
 import static org.opensearch.knn.common.KNNConstants.KNN_METHOD;
+import static org.opensearch.knn.common.KNNConstants.METHOD_PARAMETER_COSINE_MODE;
 import static org.opensearch.knn.common.KNNConstants.METHOD_PARAMETER_SPACE_TYPE;
 import static org.opensearch.knn.common.KNNConstants.MODEL_ID;
 import static org.opensearch.knn.common.KNNConstants.PARAMETERS;
@@ -594,6 +595,13 @@ public abstract class KNNVectorFieldMapper extends ParametrizedFieldMapper {
             KNNEngine knnEngine = knnMethodContext.getEngine();
             this.fieldType.putAttribute(KNN_ENGINE, knnEngine.getName());
 
+            // The cosine mode is needed at load time, so it is kept as its own attribute
+            Map<String, Object> methodParameters = knnMethodContext.getMethodComponent().getParameters();
+            if (methodParameters != null && methodParameters.containsKey(METHOD_PARAMETER_COSINE_MODE)) {
+                this.fieldType.putAttribute(METHOD_PARAMETER_COSINE_MODE,
+                        (String) methodParameters.get(METHOD_PARAMETER_COSINE_MODE));
+            }
+
             try {
                 this.fieldType.putAttribute(PARAMETERS, Strings.toString(XContentFactory.jsonBuilder()
                         .map(knnEngine.getMethodAsMap(knnMethodContext))));
@@ -26,7 +26,9 @@ import org.apache.lucene.search.Scorer;
 import org.apache.lucene.search.Weight;
 import org.apache.lucene.store.FSDirectory;
 import org.apache.lucene.store.FilterDirectory;
+import org.apache.lucene.util.Bits;
 import org.apache.lucene.util.DocIdSetBuilder;
+import org.apache.lucene.util.FixedBitSet;
 import org.opensearch.common.io.PathUtils;
 import org.opensearch.knn.indices.ModelDao;
 import org.opensearch.knn.indices.ModelMetadata;
@@ -144,6 +146,19 @@ public class KNNWeight extends Weight {
             // update this value, which we cannot do at the moment for mapping parameters.
             if (knnEngine.equals(KNNEngine.NMSLIB)) {
                 loadParameters.put(KNNConstants.HNSW_ALGO_EF_SEARCH, KNNSettings.getEfSearchParam(knnQuery.getIndexName()));
+
+                // nmslib index files do not record how cosine vectors were stored, so the mode travels with the field
+                String cosineMode = fieldInfo.getAttribute(KNNConstants.METHOD_PARAMETER_COSINE_MODE);
+                if (cosineMode != null) {
+                    loadParameters.put(KNNConstants.METHOD_PARAMETER_COSINE_MODE, cosineMode);
+                }
+            }
+
+            // Early termination of faiss searches is an index setting too, read when the index is loaded
+            if (knnEngine.equals(KNNEngine.FAISS)) {
+                loadParameters.put(KNNConstants.EARLY_TERMINATION, KNNSettings.getEarlyTermination(knnQuery.getIndexName()));
+                loadParameters.put(KNNConstants.RECALL_SAMPLING_RATE,
+                        KNNSettings.getRecallSamplingRate(knnQuery.getIndexName()));
             }
 
             try {
@@ -167,7 +182,8 @@ public class KNNWeight extends Weight {
                     throw new RuntimeException("Index has already been closed");
                 }
 
-                results = JNIService.queryIndex(indexAllocation.getMemoryAddress(), knnQuery.getQueryVector(), knnQuery.getK(), knnEngine.getName());
+                results = JNIService.queryIndex(indexAllocation.getMemoryAddress(), knnQuery.getQueryVector(), knnQuery.getK(),
+                        getLiveDocsWords(reader.getLiveDocs()), knnEngine.getName());
             } catch (Exception e) {
                 GRAPH_QUERY_ERRORS.increment();
                 throw new RuntimeException(e);
@@ -196,6 +212,32 @@ public class KNNWeight extends Weight {
             return new KNNScorer(this, docIdSetIter, scores, boost);
     }
 
+    /**
+     * Deleted documents are skipped by the native search so that they do not take up any of the k results. The
+     * segment's live docs are passed along with every query rather than attached to the cached index, because readers
+     * opened at different points in time share the index but not the deletes.
+     *
+     * @param liveDocs live docs of the segment, null if no document is deleted
+     * @return words of a bitset with bit i set when doc i is live, or null if no document is deleted
+     */
+    static long[] getLiveDocsWords(Bits liveDocs) {
+        if (liveDocs == null) {
+            return null;
+        }
+
+        if (liveDocs instanceof FixedBitSet) {
+            return ((FixedBitSet) liveDocs).getBits();
+        }
+
+        FixedBitSet bitSet = new FixedBitSet(liveDocs.length());
+        for (int i = 0; i < liveDocs.length(); i++) {
+            if (liveDocs.get(i)) {
+                bitSet.set(i);
+            }
+        }
+        return bitSet.getBits();
+    }
+
     @Override
     public boolean isCacheable(LeafReaderContext context) {
         return true;
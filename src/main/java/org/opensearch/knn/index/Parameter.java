@@ -94,6 +94,34 @@ public abstract class Parameter<T> {
         }
     }
 
+    /**
+     * String method parameter
+     */
+    public static class StringParameter extends Parameter<String> {
+        public StringParameter(String name, String defaultValue, Predicate<String> validator)
+        {
+            super(name, defaultValue, validator);
+        }
+
+        @Override
+        public ValidationException validate(Object value) {
+            ValidationException validationException = null;
+            if (!(value instanceof String)) {
+                validationException = new ValidationException();
+                validationException.addValidationError(String.format("Value not of type String for String " +
+                        "parameter \"%s\".", getName()));
+                return validationException;
+            }
+
+            if (!validator.test((String) value)) {
+                validationException = new ValidationException();
+                validationException.addValidationError(String.format("Parameter validation failed for String " +
+                        "parameter \"%s\".", getName()));
+            }
+            return validationException;
+        }
+    }
+
 
     /**
      * MethodContext parameter. Some methods require sub-methods in order to implement some kind of functionality. For
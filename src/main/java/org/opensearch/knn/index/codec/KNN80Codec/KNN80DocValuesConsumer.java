@@ -149,7 +149,8 @@ class KNN80DocValuesConsumer extends DocValuesConsumer implements Closeable {
     private void createKNNIndexFromTemplate(byte[] model, KNNCodecUtil.Pair pair, KNNEngine knnEngine,
                                             String indexPath) {
         Map<String, Object> parameters = ImmutableMap.of(KNNConstants.INDEX_THREAD_QTY, KNNSettings.state().getSettingValue(
-                KNNSettings.KNN_ALGO_PARAM_INDEX_THREAD_QTY));
+                KNNSettings.KNN_ALGO_PARAM_INDEX_THREAD_QTY), KNNConstants.BUILD_SCHEDULING_POLICY,
+                KNNSettings.state().getSettingValue(KNNSettings.KNN_NATIVE_BUILD_SCHEDULING_POLICY));
         AccessController.doPrivileged(
                 (PrivilegedAction<Void>) () -> {
                     JNIService.createIndexFromTemplate(pair.docs, pair.vectors, indexPath, model, parameters,
@@ -191,6 +192,8 @@ class KNN80DocValuesConsumer extends DocValuesConsumer implements Closeable {
         // Used to determine how many threads to use when indexing
         parameters.put(KNNConstants.INDEX_THREAD_QTY, KNNSettings.state().getSettingValue(
                 KNNSettings.KNN_ALGO_PARAM_INDEX_THREAD_QTY));
+        parameters.put(KNNConstants.BUILD_SCHEDULING_POLICY, KNNSettings.state().getSettingValue(
+                KNNSettings.KNN_NATIVE_BUILD_SCHEDULING_POLICY));
 
         // Pass the path for the nms library to save the file
         AccessController.doPrivileged(
@@ -22,16 +22,20 @@ import org.apache.logging.log4j.Logger;
 import org.opensearch.common.unit.TimeValue;
 import org.opensearch.knn.common.exception.OutOfNativeMemoryException;
 import org.opensearch.knn.index.KNNSettings;
+import org.opensearch.knn.index.util.KNNEngine;
+import org.opensearch.knn.jni.JNIService;
 import org.opensearch.knn.plugin.stats.StatNames;
 
 import java.io.Closeable;
 import java.util.HashMap;
+import java.util.List;
 import java.util.Map;
 import java.util.concurrent.ExecutionException;
 import java.util.concurrent.ExecutorService;
 import java.util.concurrent.Executors;
 import java.util.concurrent.TimeUnit;
 import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.stream.Collectors;
 
 /**
  * Manages native memory allocations made by JNI.
@@ -39,6 +43,8 @@ import java.util.concurrent.atomic.AtomicBoolean;
 public class NativeMemoryCacheManager implements Closeable {
 
     public static String GRAPH_COUNT = "graph_count";
+    public static String RECALL_SAMPLES = "recall_samples";
+    public static String SAMPLED_RECALL = "sampled_recall";
 
     private static Logger logger = LogManager.getLogger(NativeMemoryCacheManager.class);
     private static NativeMemoryCacheManager INSTANCE;
@@ -222,6 +228,53 @@ public class NativeMemoryCacheManager implements Closeable {
                 .count()).intValue();
     }
 
+    /**
+     * Set the fraction of the queries of the loaded faiss graphs of an index whose recall is measured
+     *
+     * @param indexName name of OpenSearch index
+     * @param rate fraction of the queries sampled, between 0 and 1
+     */
+    public void setRecallSamplingRate(String indexName, double rate) {
+        Validate.notNull(indexName, "Index name cannot be null");
+        for (NativeMemoryAllocation.IndexAllocation indexAllocation : getFaissIndexAllocations(indexName)) {
+            indexAllocation.readLock();
+            try {
+                if (!indexAllocation.isClosed()) {
+                    JNIService.setRecallSampling(indexAllocation.getMemoryAddress(), (float) rate,
+                            KNNEngine.FAISS.getName());
+                }
+            } finally {
+                indexAllocation.readUnlock();
+            }
+        }
+    }
+
+    /**
+     * Get the recall measured on the sampled queries of the loaded faiss graphs of an index
+     *
+     * @param indexName name of OpenSearch index
+     * @return samples in the rolling windows of the graphs and their mean recall, weighted by samples
+     */
+    public float[] getIndexSampledRecall(String indexName) {
+        Validate.notNull(indexName, "Index name cannot be null");
+        float samples = 0;
+        float recallSum = 0;
+        for (NativeMemoryAllocation.IndexAllocation indexAllocation : getFaissIndexAllocations(indexName)) {
+            indexAllocation.readLock();
+            try {
+                if (!indexAllocation.isClosed()) {
+                    float[] recallStats = JNIService.getRecallStats(indexAllocation.getMemoryAddress(),
+                            KNNEngine.FAISS.getName());
+                    samples += recallStats[0];
+                    recallSum += recallStats[0] * recallStats[1];
+                }
+            } finally {
+                indexAllocation.readUnlock();
+            }
+        }
+        return new float[] {samples, samples == 0 ? 0 : recallSum / samples};
+    }
+
     /**
      * Getter for cache stats.
      *
@@ -310,6 +363,15 @@ public class NativeMemoryCacheManager implements Closeable {
                         getIndexSizeInKilobytes(indexName));
                 indexMap.computeIfAbsent(StatNames.GRAPH_MEMORY_USAGE_PERCENTAGE.getName(), key ->
                         getIndexSizeAsPercentage(indexName));
+
+                // Only indices whose queries are sampled report a recall
+                if (!indexMap.containsKey(RECALL_SAMPLES)) {
+                    float[] sampledRecall = getIndexSampledRecall(indexName);
+                    if (sampledRecall[0] > 0) {
+                        indexMap.put(RECALL_SAMPLES, (long) sampledRecall[0]);
+                        indexMap.put(SAMPLED_RECALL, sampledRecall[1]);
+                    }
+                }
             }
         }
 
@@ -330,6 +392,15 @@ public class NativeMemoryCacheManager implements Closeable {
                 removalNotification.getCause());
     }
 
+    private List<NativeMemoryAllocation.IndexAllocation> getFaissIndexAllocations(String indexName) {
+        return cache.asMap().values().stream()
+                .filter(nativeMemoryAllocation -> nativeMemoryAllocation instanceof NativeMemoryAllocation.IndexAllocation)
+                .map(nativeMemoryAllocation -> (NativeMemoryAllocation.IndexAllocation) nativeMemoryAllocation)
+                .filter(indexAllocation -> indexName.equals(indexAllocation.getOpenSearchIndexName()))
+                .filter(indexAllocation -> indexAllocation.getKnnEngine() == KNNEngine.FAISS)
+                .collect(Collectors.toList());
+    }
+
     private Float getSizeAsPercentage(long size) {
         long cbLimit = KNNSettings.getCircuitBreakerLimit().getKb();
         if (cbLimit == 0) {
@@ -12,6 +12,7 @@
 package org.opensearch.knn.index.memory;
 
 import org.opensearch.action.ActionListener;
+import org.opensearch.knn.common.KNNConstants;
 import org.opensearch.knn.jni.JNIService;
 import org.opensearch.knn.index.util.KNNEngine;
 import org.opensearch.knn.training.TrainingDataConsumer;
@@ -92,6 +93,14 @@ public interface NativeMemoryLoadStrategy<T extends NativeMemoryAllocation, U ex
             KNNEngine knnEngine = KNNEngine.getEngineNameFromPath(indexPath.toString());
             long memoryAddress = JNIService.loadIndex(indexPath.toString(), indexEntryContext.getParameters(),
                     knnEngine.getName());
+
+            // Recall sampling is set up on the loaded index, so that the rate can change without a reload
+            Object recallSamplingRate = indexEntryContext.getParameters().get(KNNConstants.RECALL_SAMPLING_RATE);
+            if (knnEngine == KNNEngine.FAISS && recallSamplingRate instanceof Number
+                    && ((Number) recallSamplingRate).floatValue() > 0) {
+                JNIService.setRecallSampling(memoryAddress, ((Number) recallSamplingRate).floatValue(),
+                        knnEngine.getName());
+            }
             final WatcherHandle<FileWatcher> watcherHandle = resourceWatcherService.add(fileWatcher);
 
             return new NativeMemoryAllocation.IndexAllocation(
@@ -22,33 +22,55 @@ import org.opensearch.knn.index.MethodComponentContext;
 import org.opensearch.knn.index.Parameter;
 import org.opensearch.knn.index.SpaceType;
 import com.google.common.collect.ImmutableMap;
+import com.google.common.collect.ImmutableSet;
 
 import java.util.Collections;
 import java.util.HashMap;
 import java.util.Map;
+import java.util.Set;
 import java.util.concurrent.atomic.AtomicBoolean;
 import java.util.function.Function;
 
 import static org.opensearch.knn.common.KNNConstants.BYTES_PER_KILOBYTES;
+import static org.opensearch.knn.common.KNNConstants.CLUSTERING_BALANCED;
+import static org.opensearch.knn.common.KNNConstants.CLUSTERING_KMEANS;
+import static org.opensearch.knn.common.KNNConstants.COSINE_MODE_NORMALIZED;
+import static org.opensearch.knn.common.KNNConstants.COSINE_MODE_RAW;
 import static org.opensearch.knn.common.KNNConstants.ENCODER_PARAMETER_PQ_M;
 import static org.opensearch.knn.common.KNNConstants.ENCODER_PARAMETER_PQ_CODE_COUNT_DEFAULT;
 import static org.opensearch.knn.common.KNNConstants.ENCODER_PARAMETER_PQ_CODE_COUNT_LIMIT;
 import static org.opensearch.knn.common.KNNConstants.ENCODER_PARAMETER_PQ_CODE_SIZE;
 import static org.opensearch.knn.common.KNNConstants.ENCODER_PARAMETER_PQ_CODE_SIZE_DEFAULT;
 import static org.opensearch.knn.common.KNNConstants.ENCODER_PARAMETER_PQ_CODE_SIZE_LIMIT;
+import static org.opensearch.knn.common.KNNConstants.ENCODER_PARAMETER_SQ_TYPE;
+import static org.opensearch.knn.common.KNNConstants.ENCODER_SQ_FP16;
 import static org.opensearch.knn.common.KNNConstants.FAISS_HNSW_DESCRIPTION;
 import static org.opensearch.knn.common.KNNConstants.FAISS_IVF_DESCRIPTION;
 import static org.opensearch.knn.common.KNNConstants.FAISS_PQ_DESCRIPTION;
+import static org.opensearch.knn.common.KNNConstants.FAISS_SQ_DESCRIPTION;
+import static org.opensearch.knn.common.KNNConstants.GRAPH_ENCODING_DELTA;
+import static org.opensearch.knn.common.KNNConstants.GRAPH_ENCODING_FIXED;
+import static org.opensearch.knn.common.KNNConstants.GRAPH_REORDER_BFS;
+import static org.opensearch.knn.common.KNNConstants.GRAPH_REORDER_LOCALITY;
+import static org.opensearch.knn.common.KNNConstants.GRAPH_REORDER_NONE;
+import static org.opensearch.knn.common.KNNConstants.GRAPH_REORDER_RCM;
+import static org.opensearch.knn.common.KNNConstants.INDEX_LAYOUT_OPTIMIZED;
+import static org.opensearch.knn.common.KNNConstants.INDEX_LAYOUT_REGULAR;
 import static org.opensearch.knn.common.KNNConstants.METHOD_ENCODER_PARAMETER;
 import static org.opensearch.knn.common.KNNConstants.METHOD_HNSW;
 import static org.opensearch.knn.common.KNNConstants.METHOD_IVF;
+import static org.opensearch.knn.common.KNNConstants.METHOD_PARAMETER_COSINE_MODE;
 import static org.opensearch.knn.common.KNNConstants.METHOD_PARAMETER_EF_CONSTRUCTION;
 import static org.opensearch.knn.common.KNNConstants.METHOD_PARAMETER_EF_SEARCH;
+import static org.opensearch.knn.common.KNNConstants.METHOD_PARAMETER_GRAPH_ENCODING;
+import static org.opensearch.knn.common.KNNConstants.METHOD_PARAMETER_GRAPH_REORDER;
+import static org.opensearch.knn.common.KNNConstants.METHOD_PARAMETER_INDEX_LAYOUT;
 import static org.opensearch.knn.common.KNNConstants.METHOD_PARAMETER_M;
 import static org.opensearch.knn.common.KNNConstants.METHOD_PARAMETER_NLIST;
 import static org.opensearch.knn.common.KNNConstants.METHOD_PARAMETER_NLIST_DEFAULT;
 import static org.opensearch.knn.common.KNNConstants.METHOD_PARAMETER_NLIST_LIMIT;
 import static org.opensearch.knn.common.KNNConstants.METHOD_PARAMETER_NPROBES;
+import static org.opensearch.knn.common.KNNConstants.METHOD_PARAMETER_CLUSTERING;
 import static org.opensearch.knn.common.KNNConstants.METHOD_PARAMETER_NPROBES_DEFAULT;
 import static org.opensearch.knn.common.KNNConstants.METHOD_PARAMETER_NPROBES_LIMIT;
 import static org.opensearch.knn.common.KNNConstants.NAME;
@@ -160,6 +182,13 @@ public interface KNNLibrary {
      * are common across different underlying libraries.
      */
     abstract class NativeLibrary implements KNNLibrary {
+        // Node reorder strategies of the graph based methods. faiss renumbers its graph after the build, nmslib can
+        // only order the vectors it inserts
+        protected final static Set<String> FAISS_GRAPH_REORDER_STRATEGIES = ImmutableSet.of(GRAPH_REORDER_NONE,
+                GRAPH_REORDER_BFS, GRAPH_REORDER_RCM);
+        protected final static Set<String> NMSLIB_GRAPH_REORDER_STRATEGIES = ImmutableSet.of(GRAPH_REORDER_NONE,
+                GRAPH_REORDER_LOCALITY);
+
         protected Map<String, KNNMethod> methods;
         private Map<SpaceType, Function<Float, Float>> scoreTranslation;
         private String latestLibraryBuildVersion;
@@ -276,6 +305,12 @@ public interface KNNLibrary {
         public final static String HNSW_LIB_NAME = "hnsw";
         public final static String EXTENSION = ".hnsw";
 
+        // "normalized" stores unit vectors and searches cosinesimil fields by inner product
+        public final static Set<String> COSINE_MODES = ImmutableSet.of(COSINE_MODE_RAW, COSINE_MODE_NORMALIZED);
+
+        // "optimized" keeps vectors and level 0 links in one flat block for the spaces nmslib has kernels for
+        public final static Set<String> INDEX_LAYOUTS = ImmutableSet.of(INDEX_LAYOUT_OPTIMIZED, INDEX_LAYOUT_REGULAR);
+
         public final static Map<String, KNNMethod> METHODS = ImmutableMap.of(
                 METHOD_HNSW,
                 KNNMethod.Builder.builder(
@@ -285,6 +320,14 @@ public interface KNNLibrary {
                                 .addParameter(METHOD_PARAMETER_EF_CONSTRUCTION, new Parameter.IntegerParameter(
                                         METHOD_PARAMETER_EF_CONSTRUCTION,
                                         KNNSettings.INDEX_KNN_DEFAULT_ALGO_PARAM_EF_CONSTRUCTION, v -> v > 0))
+                                .addParameter(METHOD_PARAMETER_GRAPH_REORDER, new Parameter.StringParameter(
+                                        METHOD_PARAMETER_GRAPH_REORDER, GRAPH_REORDER_NONE,
+                                        NMSLIB_GRAPH_REORDER_STRATEGIES::contains))
+                                .addParameter(METHOD_PARAMETER_COSINE_MODE, new Parameter.StringParameter(
+                                        METHOD_PARAMETER_COSINE_MODE, COSINE_MODE_RAW, COSINE_MODES::contains))
+                                .addParameter(METHOD_PARAMETER_INDEX_LAYOUT, new Parameter.StringParameter(
+                                        METHOD_PARAMETER_INDEX_LAYOUT, INDEX_LAYOUT_OPTIMIZED,
+                                        INDEX_LAYOUTS::contains))
                                 .build())
                         .addSpaces(SpaceType.L2, SpaceType.L1, SpaceType.LINF, SpaceType.COSINESIMIL,
                                 SpaceType.INNER_PRODUCT)
@@ -352,6 +395,12 @@ public interface KNNLibrary {
         public final static MethodComponentContext ENCODER_DEFAULT = new MethodComponentContext(
                 KNNConstants.ENCODER_FLAT, Collections.emptyMap());
 
+        // Scalar quantizer types; fp16 keeps each component as a 16 bit float, halving the size of the vectors
+        protected final static Set<String> ENCODER_SQ_TYPES = ImmutableSet.of(ENCODER_SQ_FP16);
+
+        // How IVF training places its centroids; balanced evens out the number of vectors per list
+        protected final static Set<String> CLUSTERING_TYPES = ImmutableSet.of(CLUSTERING_KMEANS, CLUSTERING_BALANCED);
+
         //TODO: To think about in future: for PQ, if dimension is not divisible by code count, PQ will fail. Right now,
         // we do not have a way to base validation off of dimension. Failure will happen during training in JNI.
         public final static Map<String, MethodComponent> encoderComponents = ImmutableMap.of(
@@ -399,6 +448,15 @@ public interface KNNLibrary {
                             int codeSize = (Integer) codeSizeObject;
                             return ((4L *  (1 << codeSize) * dimension) / BYTES_PER_KILOBYTES) + 1;
                         })
+                        .build(),
+                KNNConstants.ENCODER_SQ, MethodComponent.Builder.builder(KNNConstants.ENCODER_SQ)
+                        .addParameter(ENCODER_PARAMETER_SQ_TYPE,
+                                new Parameter.StringParameter(ENCODER_PARAMETER_SQ_TYPE, ENCODER_SQ_FP16,
+                                        ENCODER_SQ_TYPES::contains))
+                        .setMapGenerator(((methodComponent, methodComponentContext) ->
+                                MethodAsMapBuilder.builder(FAISS_SQ_DESCRIPTION, methodComponent, methodComponentContext)
+                                        .addParameter(ENCODER_PARAMETER_SQ_TYPE, "", "")
+                                        .build()))
                         .build()
         );
 
@@ -414,6 +472,12 @@ public interface KNNLibrary {
                         .addParameter(METHOD_PARAMETER_EF_SEARCH,
                                 new Parameter.IntegerParameter(METHOD_PARAMETER_EF_SEARCH,
                                         KNNSettings.INDEX_KNN_DEFAULT_ALGO_PARAM_EF_SEARCH, v -> v > 0))
+                        .addParameter(METHOD_PARAMETER_GRAPH_REORDER,
+                                new Parameter.StringParameter(METHOD_PARAMETER_GRAPH_REORDER, GRAPH_REORDER_NONE,
+                                        FAISS_GRAPH_REORDER_STRATEGIES::contains))
+                        .addParameter(METHOD_PARAMETER_GRAPH_ENCODING,
+                                new Parameter.StringParameter(METHOD_PARAMETER_GRAPH_ENCODING, GRAPH_ENCODING_FIXED,
+                                        v -> GRAPH_ENCODING_FIXED.equals(v) || GRAPH_ENCODING_DELTA.equals(v)))
                         .addParameter(METHOD_ENCODER_PARAMETER,
                                 new Parameter.MethodComponentContextParameter(METHOD_ENCODER_PARAMETER,
                                         ENCODER_DEFAULT, encoderComponents))
@@ -432,6 +496,9 @@ public interface KNNLibrary {
                         .addParameter(METHOD_PARAMETER_NLIST,
                                 new Parameter.IntegerParameter(METHOD_PARAMETER_NLIST, METHOD_PARAMETER_NLIST_DEFAULT,
                                         v -> v > 0 && v < METHOD_PARAMETER_NLIST_LIMIT))
+                        .addParameter(METHOD_PARAMETER_CLUSTERING,
+                                new Parameter.StringParameter(METHOD_PARAMETER_CLUSTERING, CLUSTERING_KMEANS,
+                                        CLUSTERING_TYPES::contains))
                         .addParameter(METHOD_ENCODER_PARAMETER,
                                 new Parameter.MethodComponentContextParameter(METHOD_ENCODER_PARAMETER,
                                         ENCODER_DEFAULT, encoderComponents))
@@ -267,6 +267,10 @@ public interface ModelDao {
                 put(KNNConstants.MODEL_ERROR, modelMetadata.getError());
             }};
 
+            if (!modelMetadata.getListSizes().isEmpty()) {
+                parameters.put(KNNConstants.MODEL_LIST_SIZES, modelMetadata.getListSizes());
+            }
+
             byte[] modelBlob = model.getModelBlob();
 
             if (modelBlob == null && ModelState.CREATED.equals(modelMetadata.getState())) {
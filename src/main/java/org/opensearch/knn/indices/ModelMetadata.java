@@ -13,6 +13,7 @@ package org.opensearch.knn.indices;
 
 import org.apache.commons.lang.builder.EqualsBuilder;
 import org.apache.commons.lang.builder.HashCodeBuilder;
+import org.opensearch.Version;
 import org.opensearch.common.io.stream.StreamInput;
 import org.opensearch.common.io.stream.StreamOutput;
 import org.opensearch.common.io.stream.Writeable;
@@ -34,6 +35,7 @@ import static org.opensearch.knn.common.KNNConstants.METHOD_PARAMETER_SPACE_TYPE
 import static org.opensearch.knn.common.KNNConstants.MODEL_BLOB_PARAMETER;
 import static org.opensearch.knn.common.KNNConstants.MODEL_DESCRIPTION;
 import static org.opensearch.knn.common.KNNConstants.MODEL_ERROR;
+import static org.opensearch.knn.common.KNNConstants.MODEL_LIST_SIZES;
 import static org.opensearch.knn.common.KNNConstants.MODEL_STATE;
 import static org.opensearch.knn.common.KNNConstants.MODEL_TIMESTAMP;
 import static org.opensearch.knn.index.KNNVectorFieldMapper.MAX_DIMENSION;
@@ -50,6 +52,7 @@ public class ModelMetadata implements Writeable, ToXContentObject {
     final private String timestamp;
     final private String description;
     private String error;
+    private String listSizes;
 
     /**
      * Constructor
@@ -67,6 +70,9 @@ public class ModelMetadata implements Writeable, ToXContentObject {
         // which is checked in constructor and setters
         this.description = in.readString();
         this.error = in.readString();
+
+        // Nodes before 1.3.0 do not send the list sizes
+        this.listSizes = in.getVersion().onOrAfter(Version.V_1_3_0) ? in.readString() : "";
     }
 
     /**
@@ -94,6 +100,7 @@ public class ModelMetadata implements Writeable, ToXContentObject {
         this.timestamp = Objects.requireNonNull(timestamp, "timestamp must not be null");
         this.description = Objects.requireNonNull(description, "description must not be null");
         this.error = Objects.requireNonNull(error, "error must not be null");
+        this.listSizes = "";
     }
 
     /**
@@ -159,6 +166,15 @@ public class ModelMetadata implements Writeable, ToXContentObject {
         return error;
     }
 
+    /**
+     * getter for the summary of how many training vectors fall in each list of an IVF model
+     *
+     * @return list sizes summary, empty if the model has no lists
+     */
+    public String getListSizes() {
+        return listSizes;
+    }
+
     /**
      * setter for model's state
      *
@@ -177,6 +193,19 @@ public class ModelMetadata implements Writeable, ToXContentObject {
         this.error = error;
     }
 
+    /**
+     * setter for model's list sizes summary
+     *
+     * @param listSizes set after training an IVF model
+     */
+    public synchronized void setListSizes(String listSizes) {
+        this.listSizes = Objects.requireNonNull(listSizes, "listSizes must not be null");
+    }
+
+    /**
+     * The list sizes are left out, so that the cluster state keeps the format older nodes parse. They are kept with
+     * the model document instead.
+     */
     @Override
     public String toString() {
         return String.join(DELIMITER, knnEngine.getName(), spaceType.getValue(), Integer.toString(dimension),
@@ -199,6 +228,7 @@ public class ModelMetadata implements Writeable, ToXContentObject {
         equalsBuilder.append(getTimestamp(), other.getTimestamp());
         equalsBuilder.append(getDescription(), other.getDescription());
         equalsBuilder.append(getError(), other.getError());
+        equalsBuilder.append(getListSizes(), other.getListSizes());
 
         return equalsBuilder.isEquals();
     }
@@ -206,7 +236,7 @@ public class ModelMetadata implements Writeable, ToXContentObject {
     @Override
     public int hashCode() {
         return new HashCodeBuilder().append(getKnnEngine()).append(getSpaceType()).append(getDimension())
-                .append(getState()).append(getTimestamp()).append(getDescription()).append(getError()).toHashCode();
+                .append(getState()).append(getTimestamp()).append(getDescription()).append(getError()).append(getListSizes()).toHashCode();
     }
 
     /**
@@ -264,6 +294,12 @@ public class ModelMetadata implements Writeable, ToXContentObject {
         ModelMetadata modelMetadata = new ModelMetadata(KNNEngine.getEngine(objectToString(engine)),
             SpaceType.getSpace(objectToString( space)), objectToInteger(dimension), ModelState.getModelState(objectToString(state)),
             objectToString(timestamp), objectToString(description), objectToString( error));
+
+        // Models trained before the list sizes were recorded have none
+        Object listSizes = modelSourceMap.get(KNNConstants.MODEL_LIST_SIZES);
+        if (listSizes != null) {
+            modelMetadata.setListSizes(objectToString(listSizes));
+        }
         return modelMetadata;
     }
 
@@ -276,6 +312,9 @@ public class ModelMetadata implements Writeable, ToXContentObject {
         out.writeString(getTimestamp());
         out.writeString(getDescription());
         out.writeString(getError());
+        if (out.getVersion().onOrAfter(Version.V_1_3_0)) {
+            out.writeString(getListSizes());
+        }
     }
 
     @Override
@@ -284,6 +323,9 @@ public class ModelMetadata implements Writeable, ToXContentObject {
         builder.field(MODEL_TIMESTAMP, getTimestamp());
         builder.field(MODEL_DESCRIPTION, getDescription());
         builder.field(MODEL_ERROR, getError());
+        if (!getListSizes().isEmpty()) {
+            builder.field(MODEL_LIST_SIZES, getListSizes());
+        }
 
         builder.field(METHOD_PARAMETER_SPACE_TYPE, getSpaceType().getValue());
         builder.field(DIMENSION, getDimension());
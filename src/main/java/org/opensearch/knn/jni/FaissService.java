@@ -48,6 +48,58 @@ class FaissService {
      */
     public static native void createIndex(int[] ids, float[][] data, String indexPath, Map<String, Object> parameters);
 
+    /**
+     * Create an index for the native library from vectors laid out back to back
+     *
+     * @param ids array of ids mapping to the data passed in
+     * @param data float[] or direct ByteBuffer in native byte order holding the vectors back to back
+     * @param dimension dimension of the vectors
+     * @param indexPath path to save index file to
+     * @param parameters parameters to build index
+     */
+    public static native void createIndexFromFlatVectors(int[] ids, Object data, int dimension, String indexPath,
+                                                         Map<String, Object> parameters);
+
+    /**
+     * Create an index for the native library from 16 bit float vectors laid out back to back
+     *
+     * @param ids array of ids mapping to the data passed in
+     * @param data short[] or direct ByteBuffer in native byte order holding the vectors back to back
+     * @param dimension dimension of the vectors
+     * @param encoding encoding of the vectors, fp16 or bf16
+     * @param indexPath path to save index file to
+     * @param parameters parameters to build index
+     */
+    public static native void createIndexFromHalfVectors(int[] ids, Object data, int dimension, String encoding,
+                                                         String indexPath, Map<String, Object> parameters);
+
+    /**
+     * Create an index for the native library from int8 vectors laid out back to back. An 8 bit scalar quantizer in
+     * the index description is set to the int8 range instead of being trained
+     *
+     * @param ids array of ids mapping to the data passed in
+     * @param data byte[] or direct ByteBuffer holding the vectors back to back
+     * @param dimension dimension of the vectors
+     * @param indexPath path to save index file to
+     * @param parameters parameters to build index
+     */
+    public static native void createIndexFromByteVectors(int[] ids, Object data, int dimension, String indexPath,
+                                                         Map<String, Object> parameters);
+
+    /**
+     * Create an index for the native library with a provided template index from vectors laid out back to back
+     *
+     * @param ids array of ids mapping to the data passed in
+     * @param data float[] or direct ByteBuffer in native byte order holding the vectors back to back
+     * @param dimension dimension of the vectors
+     * @param indexPath path to save index file to
+     * @param templateIndex empty template index
+     * @param parameters additional build time parameters
+     */
+    public static native void createIndexFromTemplateWithFlatVectors(int[] ids, Object data, int dimension,
+                                                                     String indexPath, byte[] templateIndex,
+                                                                     Map<String, Object> parameters);
+
     /**
      * Create an index for the native library with a provided template index
      *
@@ -64,9 +116,10 @@ class FaissService {
      * Load an index into memory
      *
      * @param indexPath path to index file
+     * @param parameters load time parameters, such as early termination; may be empty
      * @return pointer to location in memory the index resides in
      */
-    public static native long loadIndex(String indexPath);
+    public static native long loadIndex(String indexPath, Map<String, Object> parameters);
 
     /**
      * Query an index
@@ -78,11 +131,120 @@ class FaissService {
      */
     public static native KNNQueryResult[] queryIndex(long indexPointer, float[] queryVector, int k);
 
+    /**
+     * Query an index with a 16 bit float vector
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVector vector to be used for query
+     * @param encoding encoding of the query vector, fp16 or bf16
+     * @param k neighbors to be returned
+     * @return KNNQueryResult array of k neighbors
+     */
+    public static native KNNQueryResult[] queryIndexWithHalfVector(long indexPointer, short[] queryVector,
+                                                                   String encoding, int k);
+
+    /**
+     * Query an index with an int8 vector
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVector vector to be used for query
+     * @param k neighbors to be returned
+     * @return KNNQueryResult array of k neighbors
+     */
+    public static native KNNQueryResult[] queryIndexWithByteVector(long indexPointer, byte[] queryVector, int k);
+
+    /**
+     * Query an index, skipping deleted documents
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVector vector to be used for query
+     * @param k neighbors to be returned
+     * @param liveDocs words of the segment's live docs bitset, bit i set when doc i is live. Null if all docs are live
+     * @return KNNQueryResult array of up to k live neighbors
+     */
+    public static native KNNQueryResult[] queryIndexWithLiveDocs(long indexPointer, float[] queryVector, int k,
+                                                                 long[] liveDocs);
+
+    /**
+     * Find the k nearest neighbors of every vector in an index, leaving each vector out of its own neighbors. Results
+     * are written to outputPath: a native order int k, then for each vector its int id, the int ids of its k
+     * neighbors (-1 when missing) and their k float distances
+     *
+     * @param indexPointer pointer to index in memory
+     * @param k neighbors to be found for each vector
+     * @param exact whether to scan the vectors instead of searching the index structure
+     * @param outputPath path of the file results are written to
+     * @param parameters thread count and scheduling policy
+     */
+    public static native void selfJoin(long indexPointer, int k, boolean exact, String outputPath,
+                                       Map<String, Object> parameters);
+
+    /**
+     * Find the k nearest neighbors in an index of every query vector. Results are written to outputPath in the format
+     * of selfJoin; the id of a query is its position among the query vectors
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVectorsPointer pointer to the query vectors in native memory, see transferVectors
+     * @param k neighbors to be found for each query
+     * @param exact whether to scan the vectors instead of searching the index structure
+     * @param outputPath path of the file results are written to
+     * @param parameters thread count and scheduling policy
+     */
+    public static native void knnJoin(long indexPointer, long queryVectorsPointer, int k, boolean exact,
+                                      String outputPath, Map<String, Object> parameters);
+
     /**
      * Free native memory pointer
      */
     public static native void free(long indexPointer);
 
+    /**
+     * Sample a fraction of the queries of a loaded index and measure their recall with exact searches run in the
+     * background
+     *
+     * @param indexPointer pointer to index in memory
+     * @param rate fraction of the queries sampled, between 0 and 1. 0 stops sampling and drops the stats
+     */
+    public static native void setRecallSampling(long indexPointer, float rate);
+
+    /**
+     * Get the recall measured on the sampled queries of a loaded index
+     *
+     * @param indexPointer pointer to index in memory
+     * @return samples in the rolling window, mean recall@k over them, samples checked in total and samples dropped
+     *         because the native pool was busy. All 0 when the queries of the index are not sampled
+     */
+    public static native float[] getRecallStats(long indexPointer);
+
+    /**
+     * Describe the structure of a loaded index
+     *
+     * @param indexPointer pointer to index in memory
+     * @return UTF-8 JSON description, see JNIService.describeIndex
+     */
+    public static native byte[] describeIndex(long indexPointer);
+
+    /**
+     * Start capturing a fraction of the queries into a ring log on local disk
+     *
+     * @param path file of the log
+     * @param capacity bytes of queries the log holds before the oldest are overwritten
+     * @param sampleRate fraction of the queries captured, between 0 and 1
+     */
+    public static native void startQueryCapture(String path, long capacity, float sampleRate);
+
+    /**
+     * Stop capturing queries
+     */
+    public static native void stopQueryCapture();
+
+    /**
+     * Resize the budget of threads that native builds and trainings borrow from
+     *
+     * @param numThreads threads in the budget; 0 means one per processor
+     */
+    public static native void setThreadPoolSize(int numThreads);
+
     /**
      * Initialize library
      *
@@ -100,6 +262,43 @@ class FaissService {
     public static native byte[] trainIndex(Map<String, Object> indexParameters, int dimension,
                                            long trainVectorsPointer);
 
+    /**
+     * Count how many of the training vectors each inverted list of a trained IVF template would receive
+     *
+     * @param templateIndex bytes array of trained template index
+     * @param trainVectorsPointer pointer to where training vectors are stored in native memory
+     * @return number of vectors assigned to each list
+     */
+    public static native int[] listSizes(byte[] templateIndex, long trainVectorsPointer);
+
+    /**
+     * Sweep the search parameter of a loaded index, efSearch for HNSW or nprobes for IVF, over sample queries and
+     * measure recall against the exact k nearest neighbors among the vectors the index stores. The swept values are
+     * passed to each search and never set on the index, so it can keep serving queries while it is calibrated.
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVectorsPointer pointer to the sample queries in native memory, see transferVectors
+     * @param k number of neighbors recall is measured on
+     * @param targetRecall recall the recommended setting should reach
+     * @return (value, recall, mean latency in microseconds) triples: the recommended setting, then the recall/latency
+     *         Pareto frontier by increasing value
+     */
+    public static native float[] calibrate(long indexPointer, long queryVectorsPointer, int k, float targetRecall);
+
+    /**
+     * Same as calibrate for an index built from a trained template index and its training vectors, which are the
+     * exact ground truth
+     *
+     * @param templateIndex bytes array of trained template index
+     * @param trainVectorsPointer pointer to where training vectors are stored in native memory
+     * @param queryVectorsPointer pointer to the sample queries in native memory, see transferVectors
+     * @param k number of neighbors recall is measured on
+     * @param targetRecall recall the recommended setting should reach
+     * @return same as calibrate
+     */
+    public static native float[] calibrateTemplate(byte[] templateIndex, long trainVectorsPointer,
+                                                   long queryVectorsPointer, int k, float targetRecall);
+
     /**
      * Transfer vectors from Java to native
      *
@@ -109,6 +308,28 @@ class FaissService {
      */
     public static native long transferVectors(long vectorsPointer, float[][] trainingData);
 
+    /**
+     * Transfer vectors laid out back to back from Java to native
+     *
+     * @param vectorsPointer pointer to vectors in native memory. Should be 0 to create vector as well
+     * @param trainingData float[] or direct ByteBuffer in native byte order holding the vectors back to back
+     * @param dimension dimension of the vectors
+     * @return pointer to native memory location of training data
+     */
+    public static native long transferFlatVectors(long vectorsPointer, Object trainingData, int dimension);
+
+    /**
+     * Transfer 16 bit float vectors laid out back to back from Java to native. They are widened to float
+     *
+     * @param vectorsPointer pointer to vectors in native memory. Should be 0 to create vector as well
+     * @param trainingData short[] or direct ByteBuffer in native byte order holding the vectors back to back
+     * @param dimension dimension of the vectors
+     * @param encoding encoding of the vectors, fp16 or bf16
+     * @return pointer to native memory location of training data
+     */
+    public static native long transferHalfVectors(long vectorsPointer, Object trainingData, int dimension,
+                                                  String encoding);
+
     /**
      * Free vectors from memory
      *
@@ -11,9 +11,17 @@
 
 package org.opensearch.knn.jni;
 
+import org.opensearch.common.xcontent.DeprecationHandler;
+import org.opensearch.common.xcontent.NamedXContentRegistry;
+import org.opensearch.common.xcontent.XContentFactory;
+import org.opensearch.common.xcontent.XContentParser;
+import org.opensearch.common.xcontent.XContentType;
 import org.opensearch.knn.index.KNNQueryResult;
 import org.opensearch.knn.index.util.KNNEngine;
 
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.util.Map;
 
 /**
@@ -45,6 +53,125 @@ public class JNIService {
         throw new IllegalArgumentException("CreateIndex not supported for provided engine");
     }
 
+    /**
+     * Create an index for the native library from vectors laid out back to back. The vectors are copied to native
+     * memory in one bulk copy instead of one array at a time
+     *
+     * @param ids array of ids mapping to the data passed in
+     * @param data vectors to be indexed, back to back
+     * @param dimension dimension of the vectors
+     * @param indexPath path to save index file to
+     * @param parameters parameters to build index
+     * @param engineName name of engine to build index for
+     */
+    public static void createIndex(int[] ids, float[] data, int dimension, String indexPath,
+                                   Map<String, Object> parameters, String engineName) {
+        createIndexFromFlatVectors(ids, data, dimension, indexPath, parameters, engineName);
+    }
+
+    /**
+     * Create an index for the native library from vectors laid out back to back in a direct buffer. The remaining
+     * bytes of the buffer are read in place, without copying them to the Java heap first
+     *
+     * @param ids array of ids mapping to the data passed in
+     * @param data direct buffer in native byte order holding the vectors to be indexed, back to back
+     * @param dimension dimension of the vectors
+     * @param indexPath path to save index file to
+     * @param parameters parameters to build index
+     * @param engineName name of engine to build index for
+     */
+    public static void createIndex(int[] ids, ByteBuffer data, int dimension, String indexPath,
+                                   Map<String, Object> parameters, String engineName) {
+        createIndexFromFlatVectors(ids, remainingNativeBytes(data), dimension, indexPath, parameters, engineName);
+    }
+
+    private static void createIndexFromFlatVectors(int[] ids, Object data, int dimension, String indexPath,
+                                                   Map<String, Object> parameters, String engineName) {
+        if (KNNEngine.NMSLIB.getName().equals(engineName)) {
+            NmslibService.createIndexFromFlatVectors(ids, data, dimension, indexPath, parameters);
+            return;
+        }
+
+        if (KNNEngine.FAISS.getName().equals(engineName)) {
+            FaissService.createIndexFromFlatVectors(ids, data, dimension, indexPath, parameters);
+            return;
+        }
+
+        throw new IllegalArgumentException("CreateIndex not supported for provided engine");
+    }
+
+    /**
+     * Create an index for the native library from 16 bit float vectors laid out back to back. Sending the vectors
+     * as fp16 or bf16 halves the bytes copied across the JNI boundary; they are widened to float natively
+     *
+     * @param ids array of ids mapping to the data passed in
+     * @param data vectors to be indexed, back to back
+     * @param dimension dimension of the vectors
+     * @param encoding encoding of the vectors, fp16 or bf16
+     * @param indexPath path to save index file to
+     * @param parameters parameters to build index
+     * @param engineName name of engine to build index for
+     */
+    public static void createIndex(int[] ids, short[] data, int dimension, String encoding, String indexPath,
+                                   Map<String, Object> parameters, String engineName) {
+        createIndexFromHalfVectors(ids, data, dimension, encoding, indexPath, parameters, engineName);
+    }
+
+    /**
+     * Create an index for the native library from 16 bit float vectors laid out back to back in a direct buffer
+     *
+     * @param ids array of ids mapping to the data passed in
+     * @param data direct buffer in native byte order holding the vectors to be indexed, back to back
+     * @param dimension dimension of the vectors
+     * @param encoding encoding of the vectors, fp16 or bf16
+     * @param indexPath path to save index file to
+     * @param parameters parameters to build index
+     * @param engineName name of engine to build index for
+     */
+    public static void createIndex(int[] ids, ByteBuffer data, int dimension, String encoding, String indexPath,
+                                   Map<String, Object> parameters, String engineName) {
+        createIndexFromHalfVectors(ids, remainingNativeBytes(data), dimension, encoding, indexPath, parameters,
+            engineName);
+    }
+
+    /**
+     * Create an index for the native library from int8 vectors laid out back to back. Only faiss supports int8
+     * vectors. With an 8 bit scalar quantizer in the index description, such as "HNSW32,SQ8", the index keeps each
+     * value in one byte and needs no training
+     *
+     * @param ids array of ids mapping to the data passed in
+     * @param data vectors to be indexed, back to back
+     * @param dimension dimension of the vectors
+     * @param indexPath path to save index file to
+     * @param parameters parameters to build index
+     * @param engineName name of engine to build index for
+     */
+    public static void createIndex(int[] ids, byte[] data, int dimension, String indexPath,
+                                   Map<String, Object> parameters, String engineName) {
+        if (KNNEngine.FAISS.getName().equals(engineName)) {
+            FaissService.createIndexFromByteVectors(ids, data, dimension, indexPath, parameters);
+            return;
+        }
+
+        throw new IllegalArgumentException("CreateIndex with int8 vectors not supported for provided engine");
+    }
+
+    private static void createIndexFromHalfVectors(int[] ids, Object data, int dimension, String encoding,
+                                                   String indexPath, Map<String, Object> parameters,
+                                                   String engineName) {
+        if (KNNEngine.NMSLIB.getName().equals(engineName)) {
+            NmslibService.createIndexFromHalfVectors(ids, data, dimension, encoding, indexPath, parameters);
+            return;
+        }
+
+        if (KNNEngine.FAISS.getName().equals(engineName)) {
+            FaissService.createIndexFromHalfVectors(ids, data, dimension, encoding, indexPath, parameters);
+            return;
+        }
+
+        throw new IllegalArgumentException("CreateIndex not supported for provided engine");
+    }
+
     /**
      * Create an index for the native library with a provided template index
      *
@@ -65,6 +192,54 @@ public class JNIService {
         throw new IllegalArgumentException("CreateIndexFromTemplate not supported for provided engine");
     }
 
+    /**
+     * Create an index for the native library with a provided template index from vectors laid out back to back
+     *
+     * @param ids array of ids mapping to the data passed in
+     * @param data vectors to be indexed, back to back
+     * @param dimension dimension of the vectors
+     * @param indexPath path to save index file to
+     * @param templateIndex empty template index
+     * @param parameters parameters to build index
+     * @param engineName name of engine to build index for
+     */
+    public static void createIndexFromTemplate(int[] ids, float[] data, int dimension, String indexPath,
+                                               byte[] templateIndex, Map<String, Object> parameters,
+                                               String engineName) {
+        createIndexFromTemplateWithFlatVectors(ids, data, dimension, indexPath, templateIndex, parameters, engineName);
+    }
+
+    /**
+     * Create an index for the native library with a provided template index from vectors laid out back to back in a
+     * direct buffer
+     *
+     * @param ids array of ids mapping to the data passed in
+     * @param data direct buffer in native byte order holding the vectors to be indexed, back to back
+     * @param dimension dimension of the vectors
+     * @param indexPath path to save index file to
+     * @param templateIndex empty template index
+     * @param parameters parameters to build index
+     * @param engineName name of engine to build index for
+     */
+    public static void createIndexFromTemplate(int[] ids, ByteBuffer data, int dimension, String indexPath,
+                                               byte[] templateIndex, Map<String, Object> parameters,
+                                               String engineName) {
+        createIndexFromTemplateWithFlatVectors(ids, remainingNativeBytes(data), dimension, indexPath, templateIndex,
+                parameters, engineName);
+    }
+
+    private static void createIndexFromTemplateWithFlatVectors(int[] ids, Object data, int dimension, String indexPath,
+                                                               byte[] templateIndex, Map<String, Object> parameters,
+                                                               String engineName) {
+        if (KNNEngine.FAISS.getName().equals(engineName)) {
+            FaissService.createIndexFromTemplateWithFlatVectors(ids, data, dimension, indexPath, templateIndex,
+                    parameters);
+            return;
+        }
+
+        throw new IllegalArgumentException("CreateIndexFromTemplate not supported for provided engine");
+    }
+
     /**
      * Load an index into memory
      *
@@ -79,7 +254,7 @@ public class JNIService {
         }
 
         if (KNNEngine.FAISS.getName().equals(engineName)) {
-            return FaissService.loadIndex(indexPath);
+            return FaissService.loadIndex(indexPath, parameters);
         }
 
         throw new IllegalArgumentException("LoadIndex not supported for provided engine");
@@ -106,6 +281,116 @@ public class JNIService {
         throw new IllegalArgumentException("QueryIndex not supported for provided engine");
     }
 
+    /**
+     * Query an index with a 16 bit float vector
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVector vector to be used for query
+     * @param encoding encoding of the query vector, fp16 or bf16
+     * @param k neighbors to be returned
+     * @param engineName name of engine to query index
+     * @return KNNQueryResult array of k neighbors
+     */
+    public static KNNQueryResult[] queryIndex(long indexPointer, short[] queryVector, String encoding, int k,
+                                              String engineName) {
+        if (KNNEngine.NMSLIB.getName().equals(engineName)) {
+            return NmslibService.queryIndexWithHalfVector(indexPointer, queryVector, encoding, k);
+        }
+
+        if (KNNEngine.FAISS.getName().equals(engineName)) {
+            return FaissService.queryIndexWithHalfVector(indexPointer, queryVector, encoding, k);
+        }
+
+        throw new IllegalArgumentException("QueryIndex not supported for provided engine");
+    }
+
+    /**
+     * Query an index with an int8 vector
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVector vector to be used for query
+     * @param k neighbors to be returned
+     * @param engineName name of engine to query index
+     * @return KNNQueryResult array of k neighbors
+     */
+    public static KNNQueryResult[] queryIndex(long indexPointer, byte[] queryVector, int k, String engineName) {
+        if (KNNEngine.FAISS.getName().equals(engineName)) {
+            return FaissService.queryIndexWithByteVector(indexPointer, queryVector, k);
+        }
+
+        throw new IllegalArgumentException("QueryIndex with int8 vectors not supported for provided engine");
+    }
+
+    /**
+     * Query an index, skipping deleted documents
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVector vector to be used for query
+     * @param k neighbors to be returned
+     * @param liveDocs words of the segment's live docs bitset, bit i set when doc i is live. Null if all docs are live
+     * @param engineName name of engine to query index
+     * @return KNNQueryResult array of up to k live neighbors
+     */
+    public static KNNQueryResult[] queryIndex(long indexPointer, float[] queryVector, int k, long[] liveDocs,
+                                              String engineName) {
+        if (liveDocs == null) {
+            return queryIndex(indexPointer, queryVector, k, engineName);
+        }
+
+        if (KNNEngine.NMSLIB.getName().equals(engineName)) {
+            return NmslibService.queryIndexWithLiveDocs(indexPointer, queryVector, k, liveDocs);
+        }
+
+        if (KNNEngine.FAISS.getName().equals(engineName)) {
+            return FaissService.queryIndexWithLiveDocs(indexPointer, queryVector, k, liveDocs);
+        }
+
+        throw new IllegalArgumentException("QueryIndex not supported for provided engine");
+    }
+
+    /**
+     * Check whether a loaded index uses nmslib's optimized layout, which stores each node's vector next to its links.
+     * nmslib falls back to the regular layout for spaces it has no optimized kernels for.
+     *
+     * @param indexPointer pointer to index in memory
+     * @param engineName engine the index was loaded with
+     * @return true if the index uses the optimized layout
+     */
+    public static boolean isOptimizedLayout(long indexPointer, String engineName) {
+        if (KNNEngine.NMSLIB.getName().equals(engineName)) {
+            return NmslibService.isOptimizedLayout(indexPointer);
+        }
+
+        throw new IllegalArgumentException("IsOptimizedLayout not supported for provided engine");
+    }
+
+    /**
+     * Describe the structure of a loaded index: vector count, dimension, metric, memory by component and, for HNSW
+     * graphs, the level distribution, the degree histogram and the number of unreachable nodes, or, for IVF indices,
+     * the distribution of list sizes and their imbalance. nmslib indices are described from the file they were
+     * loaded from. Every node of the graph is visited, so this is meant for debugging rather than for every request.
+     *
+     * @param indexPointer pointer to index in memory
+     * @param engineName engine the index was loaded with
+     * @return description as nested maps
+     * @throws IOException if the description cannot be parsed
+     */
+    public static Map<String, Object> describeIndex(long indexPointer, String engineName) throws IOException {
+        byte[] description;
+        if (KNNEngine.NMSLIB.getName().equals(engineName)) {
+            description = NmslibService.describeIndex(indexPointer);
+        } else if (KNNEngine.FAISS.getName().equals(engineName)) {
+            description = FaissService.describeIndex(indexPointer);
+        } else {
+            throw new IllegalArgumentException("DescribeIndex not supported for provided engine");
+        }
+
+        try (XContentParser parser = XContentFactory.xContent(XContentType.JSON).createParser(
+                NamedXContentRegistry.EMPTY, DeprecationHandler.THROW_UNSUPPORTED_OPERATION, description)) {
+            return parser.map();
+        }
+    }
+
     /**
      * Free native memory pointer
      *
@@ -126,6 +411,72 @@ public class JNIService {
         throw new IllegalArgumentException("Free not supported for provided engine");
     }
 
+    /**
+     * Sample a fraction of the queries of a loaded index and measure their recall with exact searches run in the
+     * background
+     *
+     * @param indexPointer pointer to index in memory
+     * @param rate fraction of the queries sampled, between 0 and 1. 0 stops sampling and drops the stats
+     * @param engineName engine of the index
+     */
+    public static void setRecallSampling(long indexPointer, float rate, String engineName) {
+        if (KNNEngine.FAISS.getName().equals(engineName)) {
+            FaissService.setRecallSampling(indexPointer, rate);
+            return;
+        }
+
+        throw new IllegalArgumentException("SetRecallSampling not supported for provided engine");
+    }
+
+    /**
+     * Get the recall measured on the sampled queries of a loaded index
+     *
+     * @param indexPointer pointer to index in memory
+     * @param engineName engine of the index
+     * @return samples in the rolling window, mean recall@k over them, samples checked in total and samples dropped
+     *         because the native pool was busy. All 0 when the queries of the index are not sampled
+     */
+    public static float[] getRecallStats(long indexPointer, String engineName) {
+        if (KNNEngine.FAISS.getName().equals(engineName)) {
+            return FaissService.getRecallStats(indexPointer);
+        }
+
+        throw new IllegalArgumentException("GetRecallStats not supported for provided engine");
+    }
+
+    /**
+     * Start capturing a fraction of the queries of both engines into a ring log on local disk, for offline replay with
+     * knn_capture_replay. Each record holds the index file and load parameters, k, the query, the search latency and
+     * the result ids. A log at path of the same capacity is appended to; calling this again while capturing switches to
+     * the new path and rate.
+     *
+     * @param path file of the log
+     * @param capacity bytes of queries the log holds before the oldest are overwritten
+     * @param sampleRate fraction of the queries captured, between 0 and 1
+     */
+    public static void startQueryCapture(String path, long capacity, float sampleRate) {
+        // The capture lives in the common library that both engines link, so one call covers nmslib queries as well
+        FaissService.startQueryCapture(path, capacity, sampleRate);
+    }
+
+    /**
+     * Stop capturing queries. The records captured so far stay in the log
+     */
+    public static void stopQueryCapture() {
+        FaissService.stopQueryCapture();
+    }
+
+    /**
+     * Resize the budget of threads that native builds and trainings borrow from. Builds that would exceed it wait for
+     * threads to be returned.
+     *
+     * @param numThreads threads in the budget; 0 means one per processor
+     */
+    public static void setThreadPoolSize(int numThreads) {
+        // The budget lives in the common library that both engines link, so one call covers nmslib builds as well
+        FaissService.setThreadPoolSize(numThreads);
+    }
+
     /**
      * Train an empty index
      *
@@ -144,6 +495,106 @@ public class JNIService {
         throw new IllegalArgumentException("TrainIndex not supported for provided engine");
     }
 
+    /**
+     * Count how many of the training vectors each inverted list of a trained IVF template would receive
+     *
+     * @param templateIndex bytes array of trained template index
+     * @param trainVectorsPointer pointer to where training vectors are stored in native memory
+     * @param engineName engine that trained the template
+     * @return number of vectors assigned to each list
+     */
+    public static int[] listSizes(byte[] templateIndex, long trainVectorsPointer, String engineName) {
+        if (KNNEngine.FAISS.getName().equals(engineName)) {
+            return FaissService.listSizes(templateIndex, trainVectorsPointer);
+        }
+
+        throw new IllegalArgumentException("ListSizes not supported for provided engine");
+    }
+
+    /**
+     * Measure recall and latency of a loaded index over sample queries for a range of values of its search parameter,
+     * efSearch for HNSW or nprobes for IVF. The index can keep serving queries while it is calibrated.
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVectorsPointer pointer to the sample queries in native memory, see transferVectors
+     * @param k number of neighbors recall is measured on
+     * @param targetRecall recall the recommended setting should reach
+     * @param engineName name of engine of the index
+     * @return (value, recall, mean latency in microseconds) triples: the recommended setting, then the recall/latency
+     *         Pareto frontier by increasing value
+     */
+    public static float[] calibrate(long indexPointer, long queryVectorsPointer, int k, float targetRecall,
+                                    String engineName) {
+        if (KNNEngine.FAISS.getName().equals(engineName)) {
+            return FaissService.calibrate(indexPointer, queryVectorsPointer, k, targetRecall);
+        }
+
+        throw new IllegalArgumentException("Calibrate not supported for provided engine");
+    }
+
+    /**
+     * Same as calibrate for an index built from a trained template index and its training vectors
+     *
+     * @param templateIndex bytes array of trained template index
+     * @param trainVectorsPointer pointer to where training vectors are stored in native memory
+     * @param queryVectorsPointer pointer to the sample queries in native memory, see transferVectors
+     * @param k number of neighbors recall is measured on
+     * @param targetRecall recall the recommended setting should reach
+     * @param engineName engine that trained the template
+     * @return same as calibrate
+     */
+    public static float[] calibrateTemplate(byte[] templateIndex, long trainVectorsPointer, long queryVectorsPointer,
+                                            int k, float targetRecall, String engineName) {
+        if (KNNEngine.FAISS.getName().equals(engineName)) {
+            return FaissService.calibrateTemplate(templateIndex, trainVectorsPointer, queryVectorsPointer, k,
+                    targetRecall);
+        }
+
+        throw new IllegalArgumentException("Calibrate not supported for provided engine");
+    }
+
+    /**
+     * Find the k nearest neighbors of every vector in an index, leaving each vector out of its own neighbors, and
+     * write them to outputPath
+     *
+     * @param indexPointer pointer to index in memory
+     * @param k neighbors to be found for each vector
+     * @param exact whether to scan the vectors instead of searching the index structure
+     * @param outputPath path of the file results are written to
+     * @param parameters thread count and scheduling policy
+     * @param engineName name of engine of the index
+     */
+    public static void selfJoin(long indexPointer, int k, boolean exact, String outputPath,
+                                Map<String, Object> parameters, String engineName) {
+        if (KNNEngine.FAISS.getName().equals(engineName)) {
+            FaissService.selfJoin(indexPointer, k, exact, outputPath, parameters);
+            return;
+        }
+
+        throw new IllegalArgumentException("SelfJoin not supported for provided engine");
+    }
+
+    /**
+     * Find the k nearest neighbors in an index of every query vector and write them to outputPath
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVectorsPointer pointer to the query vectors in native memory, see transferVectors
+     * @param k neighbors to be found for each query
+     * @param exact whether to scan the vectors instead of searching the index structure
+     * @param outputPath path of the file results are written to
+     * @param parameters thread count and scheduling policy
+     * @param engineName name of engine of the index
+     */
+    public static void knnJoin(long indexPointer, long queryVectorsPointer, int k, boolean exact, String outputPath,
+                               Map<String, Object> parameters, String engineName) {
+        if (KNNEngine.FAISS.getName().equals(engineName)) {
+            FaissService.knnJoin(indexPointer, queryVectorsPointer, k, exact, outputPath, parameters);
+            return;
+        }
+
+        throw new IllegalArgumentException("KnnJoin not supported for provided engine");
+    }
+
     /**
      * Transfer vectors from Java to native
      *
@@ -155,6 +606,57 @@ public class JNIService {
         return FaissService.transferVectors(vectorsPointer, trainingData);
     }
 
+    /**
+     * Transfer vectors laid out back to back from Java to native
+     *
+     * @param vectorsPointer pointer to vectors in native memory. Should be 0 to create vector as well
+     * @param trainingData data to be transferred, back to back
+     * @param dimension dimension of the vectors
+     * @return pointer to native memory location of training data
+     */
+    public static long transferVectors(long vectorsPointer, float[] trainingData, int dimension) {
+        return FaissService.transferFlatVectors(vectorsPointer, trainingData, dimension);
+    }
+
+    /**
+     * Transfer vectors laid out back to back in a direct buffer from Java to native
+     *
+     * @param vectorsPointer pointer to vectors in native memory. Should be 0 to create vector as well
+     * @param trainingData direct buffer in native byte order holding the data to be transferred, back to back
+     * @param dimension dimension of the vectors
+     * @return pointer to native memory location of training data
+     */
+    public static long transferVectors(long vectorsPointer, ByteBuffer trainingData, int dimension) {
+        return FaissService.transferFlatVectors(vectorsPointer, remainingNativeBytes(trainingData), dimension);
+    }
+
+    /**
+     * Transfer 16 bit float vectors laid out back to back from Java to native
+     *
+     * @param vectorsPointer pointer to vectors in native memory. Should be 0 to create vector as well
+     * @param trainingData data to be transferred, back to back
+     * @param dimension dimension of the vectors
+     * @param encoding encoding of the vectors, fp16 or bf16
+     * @return pointer to native memory location of training data
+     */
+    public static long transferVectors(long vectorsPointer, short[] trainingData, int dimension, String encoding) {
+        return FaissService.transferHalfVectors(vectorsPointer, trainingData, dimension, encoding);
+    }
+
+    /**
+     * Transfer 16 bit float vectors laid out back to back in a direct buffer from Java to native
+     *
+     * @param vectorsPointer pointer to vectors in native memory. Should be 0 to create vector as well
+     * @param trainingData direct buffer in native byte order holding the data to be transferred, back to back
+     * @param dimension dimension of the vectors
+     * @param encoding encoding of the vectors, fp16 or bf16
+     * @return pointer to native memory location of training data
+     */
+    public static long transferVectors(long vectorsPointer, ByteBuffer trainingData, int dimension, String encoding) {
+        return FaissService.transferHalfVectors(vectorsPointer, remainingNativeBytes(trainingData), dimension,
+            encoding);
+    }
+
     /**
      * Free vectors from memory
      *
@@ -163,4 +665,22 @@ public class JNIService {
     public static void freeVectors(long vectorsPointer) {
         FaissService.freeVectors(vectorsPointer);
     }
+
+    // The native layer reads a direct buffer from its address through its capacity, so hand it a view of just the
+    // remaining bytes
+    private static ByteBuffer remainingNativeBytes(ByteBuffer data) {
+        if (data == null) {
+            return null;
+        }
+
+        if (!data.isDirect()) {
+            throw new IllegalArgumentException("Vectors buffer must be direct");
+        }
+
+        if (data.order() != ByteOrder.nativeOrder()) {
+            throw new IllegalArgumentException("Vectors buffer must be in native byte order");
+        }
+
+        return data.slice();
+    }
 }
@@ -48,6 +48,31 @@ class NmslibService {
      */
     public static native void createIndex(int[] ids, float[][] data, String indexPath, Map<String, Object> parameters);
 
+    /**
+     * Create an index for the native library from vectors laid out back to back
+     *
+     * @param ids array of ids mapping to the data passed in
+     * @param data float[] or direct ByteBuffer in native byte order holding the vectors back to back
+     * @param dimension dimension of the vectors
+     * @param indexPath path to save index file to
+     * @param parameters parameters to build index
+     */
+    public static native void createIndexFromFlatVectors(int[] ids, Object data, int dimension, String indexPath,
+                                                         Map<String, Object> parameters);
+
+    /**
+     * Create an index for the native library from 16 bit float vectors laid out back to back
+     *
+     * @param ids array of ids mapping to the data passed in
+     * @param data short[] or direct ByteBuffer in native byte order holding the vectors back to back
+     * @param dimension dimension of the vectors
+     * @param encoding encoding of the vectors, fp16 or bf16
+     * @param indexPath path to save index file to
+     * @param parameters parameters to build index
+     */
+    public static native void createIndexFromHalfVectors(int[] ids, Object data, int dimension, String encoding,
+                                                         String indexPath, Map<String, Object> parameters);
+
     /**
      * Load an index into memory
      *
@@ -67,6 +92,46 @@ class NmslibService {
      */
     public static native KNNQueryResult[] queryIndex(long indexPointer, float[] queryVector, int k);
 
+    /**
+     * Query an index with a 16 bit float vector
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVector vector to be used for query
+     * @param encoding encoding of the query vector, fp16 or bf16
+     * @param k neighbors to be returned
+     * @return KNNQueryResult array of k neighbors
+     */
+    public static native KNNQueryResult[] queryIndexWithHalfVector(long indexPointer, short[] queryVector,
+                                                                   String encoding, int k);
+
+    /**
+     * Query an index, skipping deleted documents
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVector vector to be used for query
+     * @param k neighbors to be returned
+     * @param liveDocs words of the segment's live docs bitset, bit i set when doc i is live. Null if all docs are live
+     * @return KNNQueryResult array of up to k live neighbors
+     */
+    public static native KNNQueryResult[] queryIndexWithLiveDocs(long indexPointer, float[] queryVector, int k,
+                                                                 long[] liveDocs);
+
+    /**
+     * Check which layout a loaded index uses
+     *
+     * @param indexPointer pointer to index in memory
+     * @return true if the index uses the optimized layout, false if it uses the regular one
+     */
+    public static native boolean isOptimizedLayout(long indexPointer);
+
+    /**
+     * Describe the structure of a loaded index, read back from the file it was loaded from
+     *
+     * @param indexPointer pointer to index in memory
+     * @return UTF-8 JSON description, see JNIService.describeIndex
+     */
+    public static native byte[] describeIndex(long indexPointer);
+
     /**
      * Free native memory pointer
      */
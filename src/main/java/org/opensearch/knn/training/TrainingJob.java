@@ -29,6 +29,8 @@ import org.opensearch.knn.plugin.stats.KNNCounter;
 
 import java.time.ZoneOffset;
 import java.time.ZonedDateTime;
+import java.util.Arrays;
+import java.util.Locale;
 import java.util.Map;
 import java.util.Objects;
 
@@ -173,6 +175,8 @@ public class TrainingJob implements Runnable {
             Map<String, Object> trainParameters = model.getModelMetadata().getKnnEngine().getMethodAsMap(knnMethodContext);
             trainParameters.put(KNNConstants.INDEX_THREAD_QTY, KNNSettings.state().getSettingValue(
                     KNNSettings.KNN_ALGO_PARAM_INDEX_THREAD_QTY));
+            trainParameters.put(KNNConstants.BUILD_SCHEDULING_POLICY, KNNSettings.state().getSettingValue(
+                    KNNSettings.KNN_NATIVE_BUILD_SCHEDULING_POLICY));
 
             byte[] modelBlob = JNIService.trainIndex(
                     trainParameters,
@@ -181,6 +185,10 @@ public class TrainingJob implements Runnable {
                     model.getModelMetadata().getKnnEngine().getName()
             );
 
+            if (KNNConstants.METHOD_IVF.equals(knnMethodContext.getMethodComponent().getName())) {
+                modelMetadata.setListSizes(reportListSizes(modelBlob, trainingDataAllocation.getMemoryAddress()));
+            }
+
             // Once training finishes, update model
             model.setModelBlob(modelBlob);
             modelMetadata.setState(ModelState.CREATED);
@@ -200,4 +208,46 @@ public class TrainingJob implements Runnable {
             nativeMemoryCacheManager.invalidate(modelAnonymousEntryContext.getKey());
         }
     }
+
+    /**
+     * Report how evenly the training vectors spread over the inverted lists of a trained IVF model. Uneven lists make
+     * query latency depend on which lists a query probes. The report is stored with the model and logged. It is
+     * informational, so failing to compute it does not fail the job.
+     *
+     * @param modelBlob trained template index
+     * @param trainVectorsPointer pointer to the training vectors in native memory
+     * @return summary of the list sizes, or an empty string if they could not be computed
+     */
+    private String reportListSizes(byte[] modelBlob, long trainVectorsPointer) {
+        try {
+            String summary = summarizeListSizes(JNIService.listSizes(modelBlob, trainVectorsPointer,
+                    model.getModelMetadata().getKnnEngine().getName()));
+            if (!summary.isEmpty()) {
+                logger.info("Model \"" + modelId + "\" list sizes: " + summary);
+            }
+            return summary;
+        } catch (Exception e) {
+            logger.warn("Failed to compute list sizes for model \"" + modelId + "\": " + e.getMessage());
+            return "";
+        }
+    }
+
+    /**
+     * Summarize the number of vectors in each inverted list
+     *
+     * @param listSizes number of vectors in each list
+     * @return summary of the list sizes, or an empty string if there are no lists
+     */
+    static String summarizeListSizes(int[] listSizes) {
+        if (listSizes.length == 0) {
+            return "";
+        }
+
+        int[] sorted = Arrays.copyOf(listSizes, listSizes.length);
+        Arrays.sort(sorted);
+        int median = sorted[sorted.length / 2];
+        int max = sorted[sorted.length - 1];
+        return String.format(Locale.ROOT, "lists=%d, min=%d, median=%d, max=%d, max/median=%.2f", sorted.length,
+                sorted[0], median, max, median == 0 ? Double.POSITIVE_INFINITY : (double) max / median);
+    }
 }
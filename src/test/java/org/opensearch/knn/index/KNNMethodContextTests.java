@@ -28,6 +28,7 @@ import java.util.Map;
 import static org.opensearch.knn.common.KNNConstants.BYTES_PER_KILOBYTES;
 import static org.opensearch.knn.common.KNNConstants.ENCODER_PARAMETER_PQ_CODE_SIZE;
 import static org.opensearch.knn.common.KNNConstants.ENCODER_PQ;
+import static org.opensearch.knn.common.KNNConstants.ENCODER_SQ;
 import static org.opensearch.knn.common.KNNConstants.KNN_ENGINE;
 import static org.opensearch.knn.common.KNNConstants.METHOD_ENCODER_PARAMETER;
 import static org.opensearch.knn.common.KNNConstants.METHOD_HNSW;
@@ -138,6 +139,12 @@ public class KNNMethodContextTests extends KNNTestCase {
         knnMethodContext = new KNNMethodContext(KNNEngine.FAISS, SpaceType.L2, hnswMethodPq);
         assertTrue(knnMethodContext.isTrainingRequired());
 
+        // Check FAISS fp16 scalar quantizer not required
+        MethodComponentContext sq = new MethodComponentContext(ENCODER_SQ, Collections.emptyMap());
+        MethodComponentContext hnswMethodSq = new MethodComponentContext(METHOD_HNSW, ImmutableMap.of(METHOD_ENCODER_PARAMETER, sq));
+        knnMethodContext = new KNNMethodContext(KNNEngine.FAISS, SpaceType.L2, hnswMethodSq);
+        assertFalse(knnMethodContext.isTrainingRequired());
+
         MethodComponentContext ivfMethod = new MethodComponentContext(METHOD_IVF, Collections.emptyMap());
         knnMethodContext = new KNNMethodContext(KNNEngine.FAISS, SpaceType.L2, ivfMethod);
         assertTrue(knnMethodContext.isTrainingRequired());
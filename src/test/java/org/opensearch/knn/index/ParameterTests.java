@@ -16,6 +16,7 @@ import org.opensearch.knn.KNNTestCase;
 import org.opensearch.common.ValidationException;
 import org.opensearch.knn.index.Parameter.IntegerParameter;
 import org.opensearch.knn.index.Parameter.MethodComponentContextParameter;
+import org.opensearch.knn.index.Parameter.StringParameter;
 
 import java.util.Map;
 
@@ -52,6 +53,23 @@ public class ParameterTests extends KNNTestCase {
         assertNull(parameter.validate(12));
     }
 
+    /**
+     * Test string parameter validate
+     */
+    public void testStringParameter_validate() {
+        final StringParameter parameter = new StringParameter("test", "a",
+                v -> v.equals("a") || v.equals("b"));
+
+        // Invalid type
+        assertNotNull(parameter.validate(1));
+
+        // Invalid value
+        assertNotNull(parameter.validate("c"));
+
+        // valid value
+        assertNull(parameter.validate("b"));
+    }
+
     public void testMethodComponentContextParameter_validate() {
         String methodComponentName1 = "method-1";
         String parameterKey1 = "parameter_key_1";
@@ -222,6 +222,24 @@ public class KNNLibraryTests extends KNNTestCase {
         assertEquals(expectedMap, methodAsMap);
     }
 
+    public void testFaiss_ivfClustering() {
+        // The clustering choice stays out of the description and reaches the jni with the other IVF parameters
+        KNNMethodContext balancedContext = new KNNMethodContext(KNNEngine.FAISS, SpaceType.L2,
+                new MethodComponentContext(KNNConstants.METHOD_IVF, ImmutableMap.of(
+                        KNNConstants.METHOD_PARAMETER_NLIST, 16,
+                        KNNConstants.METHOD_PARAMETER_CLUSTERING, KNNConstants.CLUSTERING_BALANCED)));
+        assertNull(KNNLibrary.Faiss.INSTANCE.validateMethod(balancedContext));
+        Map<String, Object> methodAsMap = KNNLibrary.Faiss.INSTANCE.getMethodAsMap(balancedContext);
+        assertEquals("IVF16,Flat", methodAsMap.get(INDEX_DESCRIPTION_PARAMETER));
+        assertEquals(KNNConstants.CLUSTERING_BALANCED,
+                ((Map<?, ?>) methodAsMap.get(PARAMETERS)).get(KNNConstants.METHOD_PARAMETER_CLUSTERING));
+
+        KNNMethodContext unknownContext = new KNNMethodContext(KNNEngine.FAISS, SpaceType.L2,
+                new MethodComponentContext(KNNConstants.METHOD_IVF, ImmutableMap.of(
+                        KNNConstants.METHOD_PARAMETER_CLUSTERING, "spectral")));
+        assertNotNull(KNNLibrary.Faiss.INSTANCE.validateMethod(unknownContext));
+    }
+
     static class TestNativeLibrary extends KNNLibrary.NativeLibrary {
         /**
          * Constructor for TestNativeLibrary
@@ -11,7 +11,12 @@
 
 package org.opensearch.knn.indices;
 
+import org.opensearch.Version;
 import org.opensearch.common.io.stream.BytesStreamOutput;
+import org.opensearch.common.io.stream.StreamInput;
+import org.opensearch.common.xcontent.ToXContent;
+import org.opensearch.common.xcontent.XContentBuilder;
+import org.opensearch.common.xcontent.XContentFactory;
 import org.opensearch.knn.KNNTestCase;
 import org.opensearch.knn.common.KNNConstants;
 import org.opensearch.knn.index.SpaceType;
@@ -122,6 +127,47 @@ public class ModelMetadataTests extends KNNTestCase {
         assertEquals(updatedError, modelMetadata.getError());
     }
 
+    public void testSetListSizes() {
+        ModelMetadata modelMetadata = new ModelMetadata(KNNEngine.FAISS, SpaceType.L2, 12, ModelState.TRAINING,
+                ZonedDateTime.now(ZoneOffset.UTC).toString(), "", "");
+        assertEquals("", modelMetadata.getListSizes());
+
+        String listSizes = "lists=4, min=1, median=3, max=6, max/median=2.00";
+        modelMetadata.setListSizes(listSizes);
+        assertEquals(listSizes, modelMetadata.getListSizes());
+        expectThrows(NullPointerException.class, () -> modelMetadata.setListSizes(null));
+    }
+
+    public void testListSizesSerialization() throws IOException {
+        String listSizes = "lists=4, min=1, median=3, max=6, max/median=2.00";
+        ModelMetadata modelMetadata = new ModelMetadata(KNNEngine.FAISS, SpaceType.L2, 12, ModelState.CREATED,
+                ZonedDateTime.now(ZoneOffset.UTC).toString(), "", "");
+        modelMetadata.setListSizes(listSizes);
+
+        BytesStreamOutput streamOutput = new BytesStreamOutput();
+        modelMetadata.writeTo(streamOutput);
+        assertEquals(modelMetadata, new ModelMetadata(streamOutput.bytes().streamInput()));
+
+        // Nodes before 1.3.0 neither send nor expect the list sizes
+        streamOutput = new BytesStreamOutput();
+        streamOutput.setVersion(Version.V_1_2_0);
+        modelMetadata.writeTo(streamOutput);
+        StreamInput streamInput = streamOutput.bytes().streamInput();
+        streamInput.setVersion(Version.V_1_2_0);
+        ModelMetadata oldNodeCopy = new ModelMetadata(streamInput);
+        assertEquals("", oldNodeCopy.getListSizes());
+        assertEquals(modelMetadata.toString(), oldNodeCopy.toString());
+
+        // The cluster state form keeps the format older nodes parse
+        assertEquals(7, modelMetadata.toString().split(",", -1).length);
+
+        XContentBuilder builder = XContentFactory.jsonBuilder().startObject();
+        modelMetadata.toXContent(builder, ToXContent.EMPTY_PARAMS).endObject();
+        Map<String, Object> metadataAsMap = xContentBuilderToMap(builder);
+        assertEquals(listSizes, metadataAsMap.get(KNNConstants.MODEL_LIST_SIZES));
+        assertEquals(modelMetadata, ModelMetadata.getMetadataFromSourceMap(metadataAsMap));
+    }
+
     public void testToString() {
         KNNEngine knnEngine = KNNEngine.DEFAULT;
         SpaceType spaceType = SpaceType.L2;
@@ -13,6 +13,7 @@ package org.opensearch.knn.jni;
 
 import com.google.common.collect.ImmutableList;
 import com.google.common.collect.ImmutableMap;
+import org.apache.lucene.util.FixedBitSet;
 import org.junit.BeforeClass;
 import org.opensearch.knn.KNNTestCase;
 import org.opensearch.knn.TestUtils;
@@ -25,8 +26,13 @@ import org.opensearch.knn.index.util.KNNEngine;
 
 import java.io.IOException;
 import java.net.URL;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.file.Files;
 import java.nio.file.Path;
+import java.util.Arrays;
 import java.util.Collections;
+import java.util.HashMap;
 import java.util.List;
 import java.util.Map;
 
@@ -34,9 +40,11 @@ import static org.opensearch.knn.common.KNNConstants.ENCODER_PARAMETER_PQ_M;
 import static org.opensearch.knn.common.KNNConstants.ENCODER_PARAMETER_PQ_CODE_SIZE;
 import static org.opensearch.knn.common.KNNConstants.ENCODER_PQ;
 import static org.opensearch.knn.common.KNNConstants.FAISS_NAME;
+import static org.opensearch.knn.common.KNNConstants.NMSLIB_NAME;
 import static org.opensearch.knn.common.KNNConstants.INDEX_DESCRIPTION_PARAMETER;
 import static org.opensearch.knn.common.KNNConstants.INDEX_THREAD_QTY;
 import static org.opensearch.knn.common.KNNConstants.METHOD_ENCODER_PARAMETER;
+import static org.opensearch.knn.common.KNNConstants.METHOD_HNSW;
 import static org.opensearch.knn.common.KNNConstants.METHOD_IVF;
 import static org.opensearch.knn.common.KNNConstants.METHOD_PARAMETER_NLIST;
 
@@ -334,6 +342,64 @@ public class JNIServiceTests extends KNNTestCase {
         assertNotEquals(0, pointer);
     }
 
+    public void testLoadIndex_nmslib_indexLayout() throws IOException {
+
+        for (String layout : ImmutableList.of(KNNConstants.INDEX_LAYOUT_OPTIMIZED, KNNConstants.INDEX_LAYOUT_REGULAR)) {
+            Path tmpFile = createTempFile();
+
+            JNIService.createIndex(testData.indexData.docs, testData.indexData.vectors,
+                    tmpFile.toAbsolutePath().toString(), ImmutableMap.of(KNNConstants.SPACE_TYPE,
+                            SpaceType.L2.getValue(), KNNConstants.PARAMETERS,
+                            ImmutableMap.of(KNNConstants.METHOD_PARAMETER_INDEX_LAYOUT, layout)),
+                    KNNEngine.NMSLIB.getName());
+            assertTrue(tmpFile.toFile().length() > 0);
+
+            long pointer = JNIService.loadIndex(tmpFile.toAbsolutePath().toString(),
+                    ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()), KNNEngine.NMSLIB.getName());
+            assertNotEquals(0, pointer);
+            assertEquals(KNNConstants.INDEX_LAYOUT_OPTIMIZED.equals(layout),
+                    JNIService.isOptimizedLayout(pointer, KNNEngine.NMSLIB.getName()));
+            JNIService.free(pointer, KNNEngine.NMSLIB.getName());
+        }
+
+        expectThrows(IllegalArgumentException.class, () -> JNIService.isOptimizedLayout(0L, FAISS_NAME));
+    }
+
+    @SuppressWarnings("unchecked")
+    public void testDescribeIndex() throws IOException {
+        int numVectors = testData.indexData.docs.length;
+        int dimension = testData.indexData.vectors[0].length;
+        for (String engine : ImmutableList.of(FAISS_NAME, NMSLIB_NAME)) {
+            Path tmpFile = createTempFile();
+            Map<String, Object> parameters = FAISS_NAME.equals(engine)
+                    ? ImmutableMap.of(INDEX_DESCRIPTION_PARAMETER, faissMethod,
+                        KNNConstants.SPACE_TYPE, SpaceType.L2.getValue())
+                    : ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.L2.getValue());
+            JNIService.createIndex(testData.indexData.docs, testData.indexData.vectors,
+                    tmpFile.toAbsolutePath().toString(), parameters, engine);
+            long pointer = JNIService.loadIndex(tmpFile.toAbsolutePath().toString(),
+                    ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()), engine);
+
+            Map<String, Object> description = JNIService.describeIndex(pointer, engine);
+            assertEquals(engine, description.get("engine"));
+            assertEquals(numVectors, ((Number) description.get("count")).intValue());
+            assertEquals(dimension, ((Number) description.get("dimension")).intValue());
+            assertEquals(SpaceType.L2.getValue(), description.get("metric"));
+            Map<String, Object> memory = (Map<String, Object>) description.get("memory");
+            assertTrue(((Number) memory.get("total")).longValue() >= (long) numVectors * dimension * Float.BYTES);
+
+            Map<String, Object> hnsw = (Map<String, Object>) description.get("hnsw");
+            long nodes = 0;
+            for (Object count : (List<Object>) hnsw.get("level_counts")) {
+                nodes += ((Number) count).longValue();
+            }
+            assertEquals(numVectors, nodes);
+            JNIService.free(pointer, engine);
+        }
+
+        expectThrows(IllegalArgumentException.class, () -> JNIService.describeIndex(0L, "invalid"));
+    }
+
     public void testLoadIndex_faiss_invalid_fileDoesNotExist() {
         expectThrows(Exception.class, () -> JNIService.loadIndex(
                 "invalid", Collections.emptyMap(), FAISS_NAME));
@@ -414,6 +480,48 @@ public class JNIServiceTests extends KNNTestCase {
         }
     }
 
+    public void testQueryIndex_nmslib_cosineNormalized() throws IOException {
+
+        int k = 10;
+        Map<String, Object> loadParameters = new HashMap<>();
+        loadParameters.put(KNNConstants.SPACE_TYPE, SpaceType.COSINESIMIL.getValue());
+        Map<String, Long> pointers = new HashMap<>();
+
+        for (String cosineMode : ImmutableList.of(KNNConstants.COSINE_MODE_RAW, KNNConstants.COSINE_MODE_NORMALIZED)) {
+            Path tmpFile = createTempFile();
+
+            JNIService.createIndex(testData.indexData.docs, testData.indexData.vectors,
+                    tmpFile.toAbsolutePath().toString(), ImmutableMap.of(KNNConstants.SPACE_TYPE,
+                            SpaceType.COSINESIMIL.getValue(), KNNConstants.PARAMETERS,
+                            ImmutableMap.of(KNNConstants.METHOD_PARAMETER_COSINE_MODE, cosineMode)),
+                    KNNEngine.NMSLIB.getName());
+            assertTrue(tmpFile.toFile().length() > 0);
+
+            loadParameters.put(KNNConstants.METHOD_PARAMETER_COSINE_MODE, cosineMode);
+            long pointer = JNIService.loadIndex(tmpFile.toAbsolutePath().toString(), loadParameters,
+                    KNNEngine.NMSLIB.getName());
+            assertNotEquals(0, pointer);
+            pointers.put(cosineMode, pointer);
+        }
+
+        for (float[] query : testData.queries) {
+            KNNQueryResult[] raw = JNIService.queryIndex(pointers.get(KNNConstants.COSINE_MODE_RAW), query, k,
+                    KNNEngine.NMSLIB.getName());
+            KNNQueryResult[] normalized = JNIService.queryIndex(pointers.get(KNNConstants.COSINE_MODE_NORMALIZED),
+                    query, k, KNNEngine.NMSLIB.getName());
+            assertEquals(raw.length, normalized.length);
+            assertEquals(raw[0].getScore(), normalized[0].getScore(), 1e-4);
+        }
+
+        expectThrows(Exception.class, () -> JNIService.createIndex(testData.indexData.docs,
+                testData.indexData.vectors, createTempFile().toAbsolutePath().toString(),
+                ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.COSINESIMIL.getValue(), KNNConstants.PARAMETERS,
+                        ImmutableMap.of(KNNConstants.METHOD_PARAMETER_COSINE_MODE, "invalid")),
+                KNNEngine.NMSLIB.getName()));
+
+        pointers.values().forEach(pointer -> JNIService.free(pointer, KNNEngine.NMSLIB.getName()));
+    }
+
     public void testQueryIndex_faiss_invalid_badPointer() {
 
         expectThrows(Exception.class, () -> JNIService.queryIndex(0L, new float[]{}, 0, FAISS_NAME));
@@ -466,6 +574,172 @@ public class JNIServiceTests extends KNNTestCase {
         }
     }
 
+    public void testQueryIndex_faiss_earlyTermination() throws IOException {
+
+        int k = 10;
+        Path hnswFile = createTempFile();
+        JNIService.createIndex(testData.indexData.docs, testData.indexData.vectors,
+                hnswFile.toAbsolutePath().toString(), ImmutableMap.of(INDEX_DESCRIPTION_PARAMETER,
+                        faissMethod, KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()),
+                FAISS_NAME);
+        assertTrue(hnswFile.toFile().length() > 0);
+
+        // IVF searches probe several lists, so that some of them can be skipped
+        long trainPointer = JNIService.transferVectors(0, testData.indexData.vectors);
+        Map<String, Object> ivfParameters = ImmutableMap.of(
+                INDEX_DESCRIPTION_PARAMETER, "IVF8,Flat",
+                KNNConstants.SPACE_TYPE, SpaceType.L2.getValue(),
+                KNNConstants.PARAMETERS, ImmutableMap.of(KNNConstants.METHOD_PARAMETER_NPROBES, 4)
+        );
+        byte[] template = JNIService.trainIndex(ivfParameters, 128, trainPointer, FAISS_NAME);
+        JNIService.freeVectors(trainPointer);
+        Path ivfFile = createTempFile();
+        JNIService.createIndexFromTemplate(testData.indexData.docs, testData.indexData.vectors,
+                ivfFile.toAbsolutePath().toString(), template,
+                ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()), FAISS_NAME);
+        assertTrue(ivfFile.toFile().length() > 0);
+
+        for (Path tmpFile : ImmutableList.of(hnswFile, ivfFile)) {
+            long pointer = JNIService.loadIndex(tmpFile.toAbsolutePath().toString(),
+                    ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.L2.getValue(),
+                            KNNConstants.EARLY_TERMINATION, "adaptive"), FAISS_NAME);
+            assertNotEquals(0, pointer);
+
+            for (float[] query : testData.queries) {
+                KNNQueryResult[] results = JNIService.queryIndex(pointer, query, k, FAISS_NAME);
+                assertEquals(k, results.length);
+            }
+            JNIService.free(pointer, FAISS_NAME);
+        }
+
+        expectThrows(Exception.class, () -> JNIService.loadIndex(hnswFile.toAbsolutePath().toString(),
+                ImmutableMap.of(KNNConstants.EARLY_TERMINATION, "always"), FAISS_NAME));
+    }
+
+    public void testQueryIndex_faiss_withLiveDocs_valid() throws IOException {
+
+        int k = 10;
+        Path tmpFile = createTempFile();
+        JNIService.createIndex(testData.indexData.docs, testData.indexData.vectors,
+                tmpFile.toAbsolutePath().toString(), ImmutableMap.of(INDEX_DESCRIPTION_PARAMETER,
+                        faissMethod, KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()),
+                FAISS_NAME);
+        assertTrue(tmpFile.toFile().length() > 0);
+
+        long pointer = JNIService.loadIndex(tmpFile.toAbsolutePath().toString(),
+                ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()), FAISS_NAME);
+        assertNotEquals(0, pointer);
+
+        // Delete every doc with an odd id
+        int maxDoc = Arrays.stream(testData.indexData.docs).max().getAsInt() + 1;
+        FixedBitSet liveDocs = new FixedBitSet(maxDoc);
+        for (int doc = 0; doc < maxDoc; doc += 2) {
+            liveDocs.set(doc);
+        }
+
+        for (float[] query : testData.queries) {
+            KNNQueryResult[] results = JNIService.queryIndex(pointer, query, k, liveDocs.getBits(), FAISS_NAME);
+            assertEquals(k, results.length);
+            for (KNNQueryResult result : results) {
+                assertEquals(0, result.getId() % 2);
+            }
+        }
+    }
+
+    public void testQueryIndex_nmslib_withLiveDocs_valid() throws IOException {
+
+        int k = 10;
+        Path tmpFile = createTempFile();
+        JNIService.createIndex(testData.indexData.docs, testData.indexData.vectors,
+                tmpFile.toAbsolutePath().toString(), ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()),
+                KNNEngine.NMSLIB.getName());
+        assertTrue(tmpFile.toFile().length() > 0);
+
+        long pointer = JNIService.loadIndex(tmpFile.toAbsolutePath().toString(),
+                ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()), KNNEngine.NMSLIB.getName());
+        assertNotEquals(0, pointer);
+
+        // Delete every doc with an odd id
+        int maxDoc = Arrays.stream(testData.indexData.docs).max().getAsInt() + 1;
+        FixedBitSet liveDocs = new FixedBitSet(maxDoc);
+        for (int doc = 0; doc < maxDoc; doc += 2) {
+            liveDocs.set(doc);
+        }
+
+        for (float[] query : testData.queries) {
+            KNNQueryResult[] results = JNIService.queryIndex(pointer, query, k, liveDocs.getBits(),
+                    KNNEngine.NMSLIB.getName());
+            assertEquals(k, results.length);
+            for (KNNQueryResult result : results) {
+                assertEquals(0, result.getId() % 2);
+            }
+        }
+    }
+
+    public void testSelfJoin_invalidEngine() {
+        expectThrows(IllegalArgumentException.class, () -> JNIService.selfJoin(0L, 10, false, "output",
+                Collections.emptyMap(), KNNEngine.NMSLIB.getName()));
+    }
+
+    public void testSelfJoin_faiss_valid() throws IOException {
+
+        int k = 5;
+        Path tmpFile = createTempFile();
+        JNIService.createIndex(testData.indexData.docs, testData.indexData.vectors,
+                tmpFile.toAbsolutePath().toString(), ImmutableMap.of(INDEX_DESCRIPTION_PARAMETER,
+                        faissMethod, KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()),
+                FAISS_NAME);
+        long pointer = JNIService.loadIndex(tmpFile.toAbsolutePath().toString(),
+                ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()), FAISS_NAME);
+        assertNotEquals(0, pointer);
+
+        for (boolean exact : new boolean[]{false, true}) {
+            Path outputFile = createTempFile();
+            JNIService.selfJoin(pointer, k, exact, outputFile.toAbsolutePath().toString(),
+                    ImmutableMap.of(INDEX_THREAD_QTY, 2), FAISS_NAME);
+
+            ByteBuffer output = ByteBuffer.wrap(Files.readAllBytes(outputFile)).order(ByteOrder.nativeOrder());
+            assertEquals(k, output.getInt());
+            for (int doc : testData.indexData.docs) {
+                assertEquals(doc, output.getInt());
+                for (int i = 0; i < k; i++) {
+                    assertNotEquals(doc, output.getInt());
+                }
+                for (int i = 0; i < k; i++) {
+                    output.getFloat();
+                }
+            }
+            assertFalse(output.hasRemaining());
+        }
+    }
+
+    public void testKnnJoin_faiss_valid() throws IOException {
+
+        int k = 5;
+        Path tmpFile = createTempFile();
+        JNIService.createIndex(testData.indexData.docs, testData.indexData.vectors,
+                tmpFile.toAbsolutePath().toString(), ImmutableMap.of(INDEX_DESCRIPTION_PARAMETER,
+                        faissMethod, KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()),
+                FAISS_NAME);
+        long pointer = JNIService.loadIndex(tmpFile.toAbsolutePath().toString(),
+                ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()), FAISS_NAME);
+        assertNotEquals(0, pointer);
+
+        long queryVectorsPointer = JNIService.transferVectors(0, testData.queries);
+        Path outputFile = createTempFile();
+        JNIService.knnJoin(pointer, queryVectorsPointer, k, false, outputFile.toAbsolutePath().toString(),
+                Collections.emptyMap(), FAISS_NAME);
+        JNIService.freeVectors(queryVectorsPointer);
+
+        ByteBuffer output = ByteBuffer.wrap(Files.readAllBytes(outputFile)).order(ByteOrder.nativeOrder());
+        assertEquals(k, output.getInt());
+        assertEquals(testData.queries.length * (1 + 2 * k) * Integer.BYTES, output.remaining());
+        for (int query = 0; query < testData.queries.length; query++) {
+            assertEquals(query, output.getInt());
+            output.position(output.position() + 2 * k * Integer.BYTES);
+        }
+    }
+
     public void testFree_invalidEngine() {
         expectThrows(IllegalArgumentException.class, () -> JNIService.free(0L, "invalid-engine"));
     }
@@ -505,6 +779,282 @@ public class JNIServiceTests extends KNNTestCase {
         JNIService.free(pointer, FAISS_NAME);
     }
 
+    public void testRecallSampling_faiss() throws Exception {
+        int k = 10;
+        Path tmpFile = createTempFile();
+        JNIService.createIndex(testData.indexData.docs, testData.indexData.vectors, tmpFile.toAbsolutePath().toString(),
+                ImmutableMap.of(
+                        INDEX_DESCRIPTION_PARAMETER, faissMethod,
+                        KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()
+                ),
+                FAISS_NAME);
+        long pointer = JNIService.loadIndex(tmpFile.toAbsolutePath().toString(), Collections.emptyMap(),
+                FAISS_NAME);
+        assertArrayEquals(new float[] {0, 0, 0, 0}, JNIService.getRecallStats(pointer, FAISS_NAME), 0);
+
+        // Every query is sampled; the checks run in the background
+        JNIService.setRecallSampling(pointer, 1.0f, FAISS_NAME);
+        for (float[] query : testData.queries) {
+            JNIService.queryIndex(pointer, query, k, FAISS_NAME);
+        }
+        assertBusy(() -> {
+            float[] recallStats = JNIService.getRecallStats(pointer, FAISS_NAME);
+            assertEquals(testData.queries.length, recallStats[2] + recallStats[3], 0);
+        });
+        float[] recallStats = JNIService.getRecallStats(pointer, FAISS_NAME);
+        assertTrue(recallStats[1] > 0 && recallStats[1] <= 1);
+
+        JNIService.setRecallSampling(pointer, 0, FAISS_NAME);
+        assertArrayEquals(new float[] {0, 0, 0, 0}, JNIService.getRecallStats(pointer, FAISS_NAME), 0);
+        expectThrows(Exception.class, () -> JNIService.setRecallSampling(pointer, 2.0f, FAISS_NAME));
+        expectThrows(IllegalArgumentException.class, () -> JNIService.getRecallStats(pointer, NMSLIB_NAME));
+        JNIService.free(pointer, FAISS_NAME);
+    }
+
+    public void testQueryCapture() throws IOException {
+        int k = 10;
+        int capacity = 1024 * 1024;
+        Path indexFile = createTempFile();
+        JNIService.createIndex(testData.indexData.docs, testData.indexData.vectors,
+                indexFile.toAbsolutePath().toString(),
+                ImmutableMap.of(
+                        INDEX_DESCRIPTION_PARAMETER, faissMethod,
+                        KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()
+                ),
+                FAISS_NAME);
+        long pointer = JNIService.loadIndex(indexFile.toAbsolutePath().toString(), Collections.emptyMap(),
+                FAISS_NAME);
+
+        Path logFile = createTempFile();
+        JNIService.startQueryCapture(logFile.toAbsolutePath().toString(), capacity, 1.0f);
+        try {
+            for (float[] query : testData.queries) {
+                JNIService.queryIndex(pointer, query, k, FAISS_NAME);
+            }
+        } finally {
+            JNIService.stopQueryCapture();
+        }
+        JNIService.free(pointer, FAISS_NAME);
+
+        // The ring is allocated up front behind a 64 byte header, whose write cursor counts the bytes captured
+        byte[] log = Files.readAllBytes(logFile);
+        assertEquals(64 + capacity, log.length);
+        long cursor = ByteBuffer.wrap(log).order(ByteOrder.nativeOrder()).getLong(24);
+        assertTrue(cursor >= (long) testData.queries.length * testData.queries[0].length * Float.BYTES);
+
+        expectThrows(Exception.class, () -> JNIService.startQueryCapture(logFile.toAbsolutePath().toString(), 1024,
+                1.0f));
+        expectThrows(Exception.class, () -> JNIService.startQueryCapture(logFile.toAbsolutePath().toString(),
+                capacity, 2.0f));
+    }
+
+    public void testCreateIndex_faiss_flatVectors() throws IOException {
+        int dimension = testData.indexData.vectors[0].length;
+        float[] flatVectors = flatten(testData.indexData.vectors);
+        Map<String, Object> parameters = ImmutableMap.of(
+                INDEX_DESCRIPTION_PARAMETER, faissMethod,
+                KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()
+        );
+
+        Path arrayFile = createTempFile();
+        JNIService.createIndex(testData.indexData.docs, flatVectors, dimension, arrayFile.toAbsolutePath().toString(),
+                parameters, FAISS_NAME);
+        assertTrue(arrayFile.toFile().length() > 0);
+
+        ByteBuffer buffer = ByteBuffer.allocateDirect(flatVectors.length * Float.BYTES).order(ByteOrder.nativeOrder());
+        buffer.asFloatBuffer().put(flatVectors);
+        Path bufferFile = createTempFile();
+        JNIService.createIndex(testData.indexData.docs, buffer, dimension, bufferFile.toAbsolutePath().toString(),
+                parameters, FAISS_NAME);
+        assertTrue(bufferFile.toFile().length() > 0);
+
+        long arrayPointer = JNIService.loadIndex(arrayFile.toAbsolutePath().toString(), Collections.emptyMap(),
+                FAISS_NAME);
+        long bufferPointer = JNIService.loadIndex(bufferFile.toAbsolutePath().toString(), Collections.emptyMap(),
+                FAISS_NAME);
+        for (float[] query : testData.queries) {
+            KNNQueryResult[] arrayResults = JNIService.queryIndex(arrayPointer, query, 10, FAISS_NAME);
+            KNNQueryResult[] bufferResults = JNIService.queryIndex(bufferPointer, query, 10, FAISS_NAME);
+            assertEquals(10, arrayResults.length);
+            assertEquals(arrayResults.length, bufferResults.length);
+            for (int i = 0; i < arrayResults.length; i++) {
+                assertEquals(arrayResults[i].getId(), bufferResults[i].getId());
+            }
+        }
+        JNIService.free(arrayPointer, FAISS_NAME);
+        JNIService.free(bufferPointer, FAISS_NAME);
+    }
+
+    public void testCreateIndex_nmslib_flatVectors() throws IOException {
+        int dimension = testData.indexData.vectors[0].length;
+        Path tmpFile = createTempFile();
+        JNIService.createIndex(testData.indexData.docs, flatten(testData.indexData.vectors), dimension,
+                tmpFile.toAbsolutePath().toString(), ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()),
+                KNNEngine.NMSLIB.getName());
+        assertTrue(tmpFile.toFile().length() > 0);
+
+        long pointer = JNIService.loadIndex(tmpFile.toAbsolutePath().toString(),
+                ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()), KNNEngine.NMSLIB.getName());
+        assertNotEquals(0, pointer);
+        JNIService.free(pointer, KNNEngine.NMSLIB.getName());
+    }
+
+    public void testCreateIndex_flatVectors_invalid() throws IOException {
+        int[] docIds = new int[]{1, 2};
+        Path tmpFile = createTempFile();
+        Map<String, Object> parameters = ImmutableMap.of(
+                INDEX_DESCRIPTION_PARAMETER, faissMethod,
+                KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()
+        );
+
+        // Number of floats is not a multiple of the dimension
+        expectThrows(Exception.class, () -> JNIService.createIndex(docIds, new float[]{1, 2, 3}, 2,
+                tmpFile.toAbsolutePath().toString(), parameters, FAISS_NAME));
+
+        // Number of vectors does not match number of ids
+        expectThrows(Exception.class, () -> JNIService.createIndex(docIds, new float[]{1, 2}, 2,
+                tmpFile.toAbsolutePath().toString(), parameters, FAISS_NAME));
+
+        // Heap buffers cannot be read in place
+        expectThrows(IllegalArgumentException.class, () -> JNIService.createIndex(docIds, ByteBuffer.allocate(16), 2,
+                tmpFile.toAbsolutePath().toString(), parameters, FAISS_NAME));
+
+        // Unsupported engine
+        expectThrows(IllegalArgumentException.class, () -> JNIService.createIndex(docIds, new float[]{1, 2, 3, 4}, 2,
+                tmpFile.toAbsolutePath().toString(), parameters, "invalid-engine"));
+    }
+
+    public void testTransferVectors_flatVectors() {
+        int dimension = testData.indexData.vectors[0].length;
+        float[] flatVectors = flatten(testData.indexData.vectors);
+        long trainPointer1 = JNIService.transferVectors(0, flatVectors, dimension);
+        assertNotEquals(0, trainPointer1);
+
+        ByteBuffer buffer = ByteBuffer.allocateDirect(flatVectors.length * Float.BYTES).order(ByteOrder.nativeOrder());
+        buffer.asFloatBuffer().put(flatVectors);
+        long trainPointer2 = JNIService.transferVectors(trainPointer1, buffer, dimension);
+        assertEquals(trainPointer1, trainPointer2);
+
+        Map<String, Object> parameters = ImmutableMap.of(
+                INDEX_DESCRIPTION_PARAMETER, "IVF16,Flat",
+                KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()
+        );
+        byte[] faissIndex = JNIService.trainIndex(parameters, dimension, trainPointer1, FAISS_NAME);
+        assertNotEquals(0, faissIndex.length);
+        JNIService.freeVectors(trainPointer1);
+
+        expectThrows(Exception.class, () -> JNIService.transferVectors(0, new float[]{1, 2, 3}, 2));
+    }
+
+    public void testCreateIndex_halfVectors() throws IOException {
+        int dimension = testData.indexData.vectors[0].length;
+        short[] halfVectors = toBf16(flatten(testData.indexData.vectors));
+
+        // Keep the vectors as fp16 in the index too
+        KNNMethodContext knnMethodContext = new KNNMethodContext(KNNEngine.FAISS, SpaceType.L2,
+                new MethodComponentContext(METHOD_HNSW, ImmutableMap.of(
+                        METHOD_ENCODER_PARAMETER, new MethodComponentContext(KNNConstants.ENCODER_SQ,
+                                ImmutableMap.of(KNNConstants.ENCODER_PARAMETER_SQ_TYPE, KNNConstants.ENCODER_SQ_FP16)))));
+        String description = knnMethodContext.getEngine().getMethodAsMap(knnMethodContext)
+                .get(INDEX_DESCRIPTION_PARAMETER).toString();
+        assertTrue(description.endsWith(",SQfp16"));
+
+        Map<String, Object> parameters = ImmutableMap.of(
+                INDEX_DESCRIPTION_PARAMETER, description,
+                KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()
+        );
+
+        Path arrayFile = createTempFile();
+        JNIService.createIndex(testData.indexData.docs, halfVectors, dimension, KNNConstants.VECTOR_ENCODING_BF16,
+                arrayFile.toAbsolutePath().toString(), parameters, FAISS_NAME);
+        assertTrue(arrayFile.toFile().length() > 0);
+
+        ByteBuffer buffer = ByteBuffer.allocateDirect(halfVectors.length * Short.BYTES).order(ByteOrder.nativeOrder());
+        buffer.asShortBuffer().put(halfVectors);
+        Path bufferFile = createTempFile();
+        JNIService.createIndex(testData.indexData.docs, buffer, dimension, KNNConstants.VECTOR_ENCODING_BF16,
+                bufferFile.toAbsolutePath().toString(), parameters, FAISS_NAME);
+        assertTrue(bufferFile.toFile().length() > 0);
+
+        Path nmslibFile = createTempFile();
+        JNIService.createIndex(testData.indexData.docs, halfVectors, dimension, KNNConstants.VECTOR_ENCODING_BF16,
+                nmslibFile.toAbsolutePath().toString(),
+                ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()), KNNEngine.NMSLIB.getName());
+        assertTrue(nmslibFile.toFile().length() > 0);
+
+        long arrayPointer = JNIService.loadIndex(arrayFile.toAbsolutePath().toString(), Collections.emptyMap(),
+                FAISS_NAME);
+        long bufferPointer = JNIService.loadIndex(bufferFile.toAbsolutePath().toString(), Collections.emptyMap(),
+                FAISS_NAME);
+        long nmslibPointer = JNIService.loadIndex(nmslibFile.toAbsolutePath().toString(),
+                ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()), KNNEngine.NMSLIB.getName());
+        for (float[] query : testData.queries) {
+            short[] halfQuery = toBf16(query);
+            KNNQueryResult[] arrayResults = JNIService.queryIndex(arrayPointer, halfQuery,
+                    KNNConstants.VECTOR_ENCODING_BF16, 10, FAISS_NAME);
+            KNNQueryResult[] bufferResults = JNIService.queryIndex(bufferPointer, halfQuery,
+                    KNNConstants.VECTOR_ENCODING_BF16, 10, FAISS_NAME);
+            KNNQueryResult[] nmslibResults = JNIService.queryIndex(nmslibPointer, halfQuery,
+                    KNNConstants.VECTOR_ENCODING_BF16, 10, KNNEngine.NMSLIB.getName());
+            assertEquals(10, arrayResults.length);
+            assertEquals(arrayResults.length, bufferResults.length);
+            assertEquals(10, nmslibResults.length);
+            for (int i = 0; i < arrayResults.length; i++) {
+                assertEquals(arrayResults[i].getId(), bufferResults[i].getId());
+            }
+        }
+        JNIService.free(arrayPointer, FAISS_NAME);
+        JNIService.free(bufferPointer, FAISS_NAME);
+        JNIService.free(nmslibPointer, KNNEngine.NMSLIB.getName());
+
+        // Unknown encoding
+        expectThrows(Exception.class, () -> JNIService.createIndex(testData.indexData.docs, halfVectors, dimension,
+                "fp8", arrayFile.toAbsolutePath().toString(), parameters, FAISS_NAME));
+    }
+
+    public void testCreateIndex_byteVectors() throws IOException {
+        int dimension = testData.indexData.vectors[0].length;
+        byte[] byteVectors = toInt8(flatten(testData.indexData.vectors));
+        Map<String, Object> parameters = ImmutableMap.of(
+                INDEX_DESCRIPTION_PARAMETER, "HNSW32,SQ8",
+                KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()
+        );
+
+        Path tmpFile = createTempFile();
+        JNIService.createIndex(testData.indexData.docs, byteVectors, dimension, tmpFile.toAbsolutePath().toString(),
+                parameters, FAISS_NAME);
+        assertTrue(tmpFile.toFile().length() > 0);
+
+        long pointer = JNIService.loadIndex(tmpFile.toAbsolutePath().toString(), Collections.emptyMap(), FAISS_NAME);
+        for (float[] query : testData.queries) {
+            KNNQueryResult[] results = JNIService.queryIndex(pointer, toInt8(query), 10, FAISS_NAME);
+            assertEquals(10, results.length);
+        }
+        JNIService.free(pointer, FAISS_NAME);
+
+        // Only faiss takes int8 vectors
+        expectThrows(IllegalArgumentException.class, () -> JNIService.createIndex(testData.indexData.docs,
+                byteVectors, dimension, tmpFile.toAbsolutePath().toString(),
+                ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()), KNNEngine.NMSLIB.getName()));
+    }
+
+    public void testTransferVectors_halfVectors() {
+        int dimension = testData.indexData.vectors[0].length;
+        short[] halfVectors = toBf16(flatten(testData.indexData.vectors));
+        long trainPointer1 = JNIService.transferVectors(0, halfVectors, dimension, KNNConstants.VECTOR_ENCODING_BF16);
+        assertNotEquals(0, trainPointer1);
+
+        ByteBuffer buffer = ByteBuffer.allocateDirect(halfVectors.length * Short.BYTES).order(ByteOrder.nativeOrder());
+        buffer.asShortBuffer().put(halfVectors);
+        long trainPointer2 = JNIService.transferVectors(trainPointer1, buffer, dimension,
+                KNNConstants.VECTOR_ENCODING_BF16);
+        assertEquals(trainPointer1, trainPointer2);
+        JNIService.freeVectors(trainPointer1);
+
+        expectThrows(Exception.class, () -> JNIService.transferVectors(0, new short[]{1, 2, 3}, 2,
+                KNNConstants.VECTOR_ENCODING_FP16));
+    }
+
     public void testTransferVectors() {
         long trainPointer1 = JNIService.transferVectors(0, testData.indexData.vectors);
         assertNotEquals(0, trainPointer1);
@@ -541,6 +1091,74 @@ public class JNIServiceTests extends KNNTestCase {
         JNIService.freeVectors(trainPointer1);
     }
 
+    public void testListSizes() {
+        long trainPointer = JNIService.transferVectors(0, testData.indexData.vectors);
+        assertNotEquals(0, trainPointer);
+
+        Map<String, Object> parameters = ImmutableMap.of(
+                INDEX_DESCRIPTION_PARAMETER, "IVF16,Flat",
+                KNNConstants.SPACE_TYPE, SpaceType.L2.getValue(),
+                KNNConstants.PARAMETERS, ImmutableMap.of(
+                        KNNConstants.METHOD_PARAMETER_CLUSTERING, KNNConstants.CLUSTERING_BALANCED)
+        );
+        byte[] faissIndex = JNIService.trainIndex(parameters, 128, trainPointer, FAISS_NAME);
+
+        // Every training vector is counted in exactly one list
+        int[] listSizes = JNIService.listSizes(faissIndex, trainPointer, FAISS_NAME);
+        assertEquals(16, listSizes.length);
+        assertEquals(testData.indexData.vectors.length, Arrays.stream(listSizes).sum());
+
+        expectThrows(IllegalArgumentException.class, () -> JNIService.listSizes(faissIndex, trainPointer, NMSLIB_NAME));
+        JNIService.freeVectors(trainPointer);
+    }
+
+    public void testCalibrate_faiss() throws IOException {
+        int k = 5;
+        Path tmpFile = createTempFile();
+        JNIService.createIndex(testData.indexData.docs, testData.indexData.vectors,
+                tmpFile.toAbsolutePath().toString(), ImmutableMap.of(INDEX_DESCRIPTION_PARAMETER,
+                        faissMethod, KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()),
+                FAISS_NAME);
+        long pointer = JNIService.loadIndex(tmpFile.toAbsolutePath().toString(),
+                ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()), FAISS_NAME);
+        long queryVectorsPointer = JNIService.transferVectors(0, testData.queries);
+
+        // The recommended setting comes first, followed by the frontier
+        float[] calibration = JNIService.calibrate(pointer, queryVectorsPointer, k, 0.9f, FAISS_NAME);
+        assertEquals(0, calibration.length % 3);
+        assertTrue(calibration.length >= 6);
+        assertTrue(calibration[1] >= 0.9f);
+
+        expectThrows(IllegalArgumentException.class,
+                () -> JNIService.calibrate(pointer, queryVectorsPointer, k, 0.9f, NMSLIB_NAME));
+        JNIService.freeVectors(queryVectorsPointer);
+        JNIService.free(pointer, FAISS_NAME);
+    }
+
+    public void testCalibrateTemplate_faiss() {
+        long trainPointer = JNIService.transferVectors(0, testData.indexData.vectors);
+        long queryVectorsPointer = JNIService.transferVectors(0, testData.queries);
+        Map<String, Object> parameters = ImmutableMap.of(
+                INDEX_DESCRIPTION_PARAMETER, "IVF16,Flat",
+                KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()
+        );
+        byte[] faissIndex = JNIService.trainIndex(parameters, 128, trainPointer, FAISS_NAME);
+
+        // Probing all 16 lists of a flat IVF index finds the exact neighbors
+        float[] calibration = JNIService.calibrateTemplate(faissIndex, trainPointer, queryVectorsPointer, 10, 0.99f,
+                FAISS_NAME);
+        assertEquals(0, calibration.length % 3);
+        float bestRecall = 0;
+        for (int i = 3; i < calibration.length; i += 3) {
+            assertTrue(calibration[i] >= 1 && calibration[i] <= 16);
+            bestRecall = Math.max(bestRecall, calibration[i + 1]);
+        }
+        assertEquals(1.0f, bestRecall, 0.0f);
+
+        JNIService.freeVectors(queryVectorsPointer);
+        JNIService.freeVectors(trainPointer);
+    }
+
     public void testCreateIndexFromTemplate() throws IOException {
 
         long trainPointer1 = JNIService.transferVectors(0, testData.indexData.vectors);
@@ -585,4 +1203,31 @@ public class JNIServiceTests extends KNNTestCase {
                 FAISS_NAME);
         assertNotEquals(0, pointer);
     }
+
+    private static float[] flatten(float[][] vectors) {
+        int dimension = vectors[0].length;
+        float[] flatVectors = new float[vectors.length * dimension];
+        for (int i = 0; i < vectors.length; i++) {
+            System.arraycopy(vectors[i], 0, flatVectors, i * dimension, dimension);
+        }
+        return flatVectors;
+    }
+
+    // Round to int8, clamping to its range
+    private static byte[] toInt8(float[] vectors) {
+        byte[] byteVectors = new byte[vectors.length];
+        for (int i = 0; i < vectors.length; i++) {
+            byteVectors[i] = (byte) Math.max(Byte.MIN_VALUE, Math.min(Byte.MAX_VALUE, Math.round(vectors[i])));
+        }
+        return byteVectors;
+    }
+
+    // Truncate to bfloat16, the upper half of the float's bits
+    private static short[] toBf16(float[] vectors) {
+        short[] halfVectors = new short[vectors.length];
+        for (int i = 0; i < vectors.length; i++) {
+            halfVectors[i] = (short) (Float.floatToIntBits(vectors[i]) >>> 16);
+        }
+        return halfVectors;
+    }
 }
@@ -164,6 +164,7 @@ public class TrainingJobTests extends KNNTestCase {
         assertNotNull(model);
 
         assertEquals(ModelState.CREATED, model.getModelMetadata().getState());
+        assertTrue(model.getModelMetadata().getListSizes().startsWith("lists=" + nlists + ","));
 
         // Simple test that creates the index from template and doesnt fail
         int[] ids = { 1, 2, 3, 4};
@@ -355,6 +356,14 @@ public class TrainingJobTests extends KNNTestCase {
         assertEquals(ModelState.FAILED, trainingJob.getModel().getModelMetadata().getState());
     }
 
+    public void testSummarizeListSizes() {
+        assertEquals("lists=4, min=1, median=3, max=6, max/median=2.00",
+                TrainingJob.summarizeListSizes(new int[]{3, 6, 1, 2}));
+        assertEquals("lists=2, min=0, median=0, max=0, max/median=Infinity",
+                TrainingJob.summarizeListSizes(new int[]{0, 0}));
+        assertEquals("", TrainingJob.summarizeListSizes(new int[0]));
+    }
+
     public void testRun_failure_notEnoughTrainingData() throws ExecutionException {
         // In this test case, we ensure that failure happens gracefully when there isnt enough training data
         String modelId = "test-model-id";